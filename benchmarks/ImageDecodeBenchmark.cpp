@@ -0,0 +1,182 @@
+// Image decode throughput.
+//
+//   ImageDecodeBenchmark [file or directory]... [--iterations N]
+//
+// Decodes every image under the given paths (default: assets) from memory-mapped
+// bytes and reports the best of N passes over the whole set, in decoded MB/s:
+//   image  - DecodeImage into ImageData (the decoder's buffer adopted by its PixelBuffer)
+//   adopt  - DecodeImage into DecodedImage (the decoder's buffer kept as it is)
+//   arena  - DecodeImage with every allocation from a FrameAllocator, reset per image
+//   batch  - DecodeBatch at every thread count from 1 up to the hardware
+//            concurrency (doubling; the main thread counts as one)
+
+#include "core/FrameAllocator.hpp"
+#include "core/ImageLoader.hpp"
+#include "core/JobSystem.hpp"
+#include "core/VirtualFileSystem.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ShadowEngine;
+
+namespace {
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool IsImage(const std::filesystem::path& path) {
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" ||
+           extension == ".bmp";
+}
+
+void CollectImages(const std::string& path, std::vector<std::string>& out) {
+    namespace fs = std::filesystem;
+    std::error_code error;
+    if (fs::is_regular_file(path, error)) {
+        out.push_back(path);
+        return;
+    }
+    for (const fs::directory_entry& entry : fs::recursive_directory_iterator(path, error)) {
+        if (entry.is_regular_file() && IsImage(entry.path())) {
+            out.push_back(entry.path().generic_string());
+        }
+    }
+}
+
+// Best of iterations passes; pass returns the decoded bytes
+void Report(const char* name, unsigned threads, int iterations, const std::function<size_t()>& pass) {
+    pass();  // Warm up
+    double bestMs = 0.0;
+    size_t bytes = 0;
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        bytes = pass();
+        const double ms = MillisecondsSince(start);
+        bestMs = i == 0 ? ms : std::min(bestMs, ms);
+    }
+    std::printf("%-6s %3u threads  %9.2f ms  %8.1f MB/s\n", name, threads, bestMs,
+                bytes / (1024.0 * 1024.0) / (bestMs / 1000.0));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int iterations = 5;
+    std::vector<std::string> roots;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = std::max(1, std::atoi(argv[++i]));
+        } else if (argv[i][0] == '-') {
+            std::cerr << "Usage: ImageDecodeBenchmark [file or directory]... [--iterations N]" << std::endl;
+            return 1;
+        } else {
+            roots.push_back(argv[i]);
+        }
+    }
+    if (roots.empty()) {
+        roots.push_back("assets");
+    }
+
+    std::vector<std::string> paths;
+    for (const std::string& root : roots) {
+        CollectImages(root, paths);
+    }
+
+    // Map everything up front so only decoding is timed
+    std::vector<VirtualFileSystem::File> files;
+    std::vector<ImageLoader::EncodedImage> inputs;
+    size_t encodedBytes = 0;
+    for (const std::string& path : paths) {
+        VirtualFileSystem::File file;
+        if (!VirtualFileSystem::Get().Read(path, file)) {
+            std::cerr << "Failed to open: " << path << std::endl;
+            return 1;
+        }
+        ImageLoader::EncodedImage input;
+        input.data = file.GetData();
+        input.size = file.GetSize();
+        inputs.push_back(input);
+        encodedBytes += file.GetSize();
+        files.push_back(std::move(file));
+    }
+    if (inputs.empty()) {
+        std::cerr << "No images found" << std::endl;
+        return 1;
+    }
+
+    std::printf("Image decode, %zu images, %.2f MB encoded, %d iterations\n", inputs.size(),
+                encodedBytes / (1024.0 * 1024.0), iterations);
+
+    Report("image", 1, iterations, [&inputs] {
+        size_t bytes = 0;
+        for (const ImageLoader::EncodedImage& input : inputs) {
+            ImageLoader::ImageData image;
+            if (ImageLoader::DecodeImage(input.data, input.size, image)) {
+                bytes += image.data.size();
+            }
+        }
+        return bytes;
+    });
+
+    Report("adopt", 1, iterations, [&inputs] {
+        size_t bytes = 0;
+        for (const ImageLoader::EncodedImage& input : inputs) {
+            ImageLoader::DecodedImage image;
+            if (ImageLoader::DecodeImage(input.data, input.size, image)) {
+                bytes += image.GetSize();
+            }
+        }
+        return bytes;
+    });
+
+    FrameAllocator arena(64 << 20);
+    Report("arena", 1, iterations, [&inputs, &arena] {
+        size_t bytes = 0;
+        for (const ImageLoader::EncodedImage& input : inputs) {
+            ImageLoader::DecodedImage image;
+            if (ImageLoader::DecodeImage(input.data, input.size, arena, image)) {
+                bytes += image.GetSize();
+            }
+            arena.Reset();
+        }
+        return bytes;
+    });
+
+    const unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    if (threadCounts.back() != maxThreads) {
+        threadCounts.push_back(maxThreads);
+    }
+
+    for (unsigned threads : threadCounts) {
+        JobSystem::Settings settings;
+        settings.workerCount = static_cast<int>(threads) - 1;
+        JobSystem jobs(settings);
+        Report("batch", threads, iterations, [&inputs, &jobs] {
+            std::vector<ImageLoader::DecodedImage> images;
+            ImageLoader::DecodeBatch(jobs, inputs, images);
+            size_t bytes = 0;
+            for (const ImageLoader::DecodedImage& image : images) {
+                bytes += image.GetSize();
+            }
+            return bytes;
+        });
+    }
+    return 0;
+}
@@ -0,0 +1,176 @@
+// Job system scaling benchmark.
+//
+//   JobSystemBenchmark [--iterations N] [--pin]
+//
+// Runs three workloads at every thread count from 1 up to the hardware
+// concurrency (doubling; the main thread counts as one) and reports throughput
+// and speedup over the single-threaded run:
+//   tiny    - many empty jobs submitted from the main thread (scheduling overhead)
+//   compute - ParallelFor over an arithmetic kernel (scaling with little memory traffic)
+//   fanout  - a tree of jobs, each spawning children from its worker, joined
+//             through dependency counters (stealing and dependency release)
+
+#include "core/JobSystem.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ShadowEngine;
+
+namespace {
+
+constexpr size_t TinyJobCount = 200000;
+constexpr size_t ComputeCount = 1 << 22;
+constexpr int FanoutDepth = 6;
+constexpr int FanoutWidth = 8;  // 8^6 leaves
+
+struct Result {
+    double ms = 0.0;
+    size_t items = 0;
+};
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+Result RunTiny(JobSystem& jobs) {
+    std::atomic<size_t> executed{0};
+    auto start = std::chrono::steady_clock::now();
+    JobCounter counter;
+    for (size_t i = 0; i < TinyJobCount; ++i) {
+        jobs.Run([&executed] { executed.fetch_add(1, std::memory_order_relaxed); }, &counter);
+    }
+    jobs.Wait(counter);
+    Result result;
+    result.ms = MillisecondsSince(start);
+    result.items = executed.load();
+    return result;
+}
+
+Result RunCompute(JobSystem& jobs, std::vector<float>& output) {
+    auto start = std::chrono::steady_clock::now();
+    jobs.ParallelFor(output.size(), 4096, [&output](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            float x = static_cast<float>(i) * 1e-6f;
+            for (int k = 0; k < 16; ++k) {
+                x = std::sin(x) * 0.5f + std::sqrt(x + 1.0f);
+            }
+            output[i] = x;
+        }
+    });
+    Result result;
+    result.ms = MillisecondsSince(start);
+    result.items = output.size();
+    return result;
+}
+
+void SpawnLevel(JobSystem& jobs, int depth, JobCounter& done, std::atomic<size_t>& leaves) {
+    if (depth == 0) {
+        // A little work per leaf so stealing has something to balance
+        volatile float x = 1.0f;
+        for (int k = 0; k < 200; ++k) {
+            x = x * 1.0001f + 0.5f;
+        }
+        leaves.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    for (int i = 0; i < FanoutWidth; ++i) {
+        jobs.Run([&jobs, depth, &done, &leaves] { SpawnLevel(jobs, depth - 1, done, leaves); }, &done);
+    }
+}
+
+Result RunFanout(JobSystem& jobs) {
+    std::atomic<size_t> leaves{0};
+    auto start = std::chrono::steady_clock::now();
+
+    // The tree shares one counter; a final job gated on it checks the total
+    JobCounter tree;
+    JobCounter joined;
+    bool complete = false;
+    jobs.Run([&jobs, &tree, &leaves] { SpawnLevel(jobs, FanoutDepth, tree, leaves); }, &tree);
+    jobs.Run([&complete] { complete = true; }, &joined, &tree);
+    jobs.Wait(joined);
+
+    Result result;
+    result.ms = MillisecondsSince(start);
+    result.items = complete ? leaves.load() : 0;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int iterations = 5;
+    bool pin = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--pin") == 0) {
+            pin = true;
+        } else {
+            std::cerr << "Usage: JobSystemBenchmark [--iterations N] [--pin]" << std::endl;
+            return 1;
+        }
+    }
+
+    const unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    if (threadCounts.back() != maxThreads) {
+        threadCounts.push_back(maxThreads);
+    }
+
+    std::vector<float> output(ComputeCount);
+    const char* names[3] = {"tiny", "compute", "fanout"};
+    double baseline[3] = {0.0, 0.0, 0.0};
+
+    std::printf("Job system, %d iterations%s\n", iterations, pin ? ", pinned workers" : "");
+    for (unsigned threads : threadCounts) {
+        JobSystem::Settings settings;
+        settings.workerCount = static_cast<int>(threads) - 1;
+        settings.pinWorkers = pin;
+        JobSystem jobs(settings);
+
+        for (int workload = 0; workload < 3; ++workload) {
+            auto run = [&]() {
+                switch (workload) {
+                    case 0:  return RunTiny(jobs);
+                    case 1:  return RunCompute(jobs, output);
+                    default: return RunFanout(jobs);
+                }
+            };
+            run();  // Warm up
+
+            double bestMs = 0.0;
+            size_t items = 0;
+            for (int i = 0; i < iterations; ++i) {
+                Result result = run();
+                bestMs = i == 0 ? result.ms : std::min(bestMs, result.ms);
+                items = result.items;
+            }
+            if (threads == 1) {
+                baseline[workload] = bestMs;
+            }
+            std::printf("%-8s %3u threads  %9.2f ms  %8.2f M items/s  %5.2fx\n",
+                        names[workload], threads, bestMs, items / (bestMs * 1000.0),
+                        baseline[workload] / bestMs);
+        }
+
+        const JobSystem::Stats stats = jobs.GetStats();
+        std::printf("         %3u threads  %llu jobs, %llu stolen\n", threads,
+                    static_cast<unsigned long long>(stats.executed),
+                    static_cast<unsigned long long>(stats.stolen));
+    }
+    return 0;
+}
@@ -0,0 +1,195 @@
+// Software rasterizer throughput benchmark.
+//
+//   RasterizerBenchmark [--size WIDTHxHEIGHT] [--iterations N]
+//
+// Renders three workloads at every thread count from 1 up to the hardware
+// concurrency (doubling) and reports triangles per second:
+//   cubes  - many small indexed meshes, each with its own transform (draw-call bound)
+//   soup   - one large mesh of tiny triangles (setup and binning bound)
+//   fill   - few screen-sized overlapping triangles (fill-rate bound)
+
+#include "rendering/SoftwareRasterizer.hpp"
+#include "math/Matrix.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ShadowEngine;
+
+namespace {
+
+struct MeshData {
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+};
+
+struct Workload {
+    std::string name;
+    std::vector<MeshData> meshes;
+    std::vector<Math::Matrix4> transforms;  // One per draw, indexing meshes modulo size
+    size_t triangleCount = 0;
+};
+
+MeshData MakeCube() {
+    MeshData cube;
+    const float corners[8][3] = {
+        {-0.5f, -0.5f,  0.5f}, { 0.5f, -0.5f,  0.5f}, { 0.5f,  0.5f,  0.5f}, {-0.5f,  0.5f,  0.5f},
+        {-0.5f, -0.5f, -0.5f}, { 0.5f, -0.5f, -0.5f}, { 0.5f,  0.5f, -0.5f}, {-0.5f,  0.5f, -0.5f},
+    };
+    for (int i = 0; i < 8; ++i) {
+        cube.vertices.insert(cube.vertices.end(), {corners[i][0], corners[i][1], corners[i][2],
+                                                   (i & 1) ? 1.0f : 0.2f, (i & 2) ? 1.0f : 0.2f,
+                                                   (i & 4) ? 1.0f : 0.2f});
+    }
+    cube.indices = {0, 1, 2, 2, 3, 0,  5, 4, 7, 7, 6, 5,  4, 0, 3, 3, 7, 4,
+                    1, 5, 6, 6, 2, 1,  3, 2, 6, 6, 7, 3,  4, 5, 1, 1, 0, 4};
+    return cube;
+}
+
+Math::Matrix4 ViewProjection(int width, int height) {
+    auto projection = Math::CreatePerspective(45.0f, static_cast<float>(width) / height, 0.1f, 200.0f);
+    auto view = Math::CreateLookAt(0.0f, 0.0f, 40.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f);
+    return view * projection;  // Column-major: projection * view
+}
+
+Workload MakeCubeField(int width, int height, int count) {
+    Workload workload;
+    workload.name = "cubes";
+    workload.meshes.push_back(MakeCube());
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> position(-18.0f, 18.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+    const Math::Matrix4 viewProjection = ViewProjection(width, height);
+    for (int i = 0; i < count; ++i) {
+        auto model = Math::CreateRotation(angle(rng), 0.3f, 1.0f, 0.2f) *
+                     Math::CreateTranslation(position(rng), position(rng) * 0.6f, position(rng));
+        workload.transforms.push_back(model * viewProjection);
+    }
+    workload.triangleCount = static_cast<size_t>(count) * 12;
+    return workload;
+}
+
+Workload MakeSoup(int triangles) {
+    Workload workload;
+    workload.name = "soup";
+    MeshData soup;
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> centre(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> offset(-0.01f, 0.01f);
+    std::uniform_real_distribution<float> color(0.0f, 1.0f);
+    for (int t = 0; t < triangles; ++t) {
+        float cx = centre(rng), cy = centre(rng), cz = centre(rng) * 0.9f;
+        for (int v = 0; v < 3; ++v) {
+            soup.vertices.insert(soup.vertices.end(), {cx + offset(rng), cy + offset(rng), cz,
+                                                       color(rng), color(rng), color(rng)});
+            soup.indices.push_back(static_cast<unsigned int>(t * 3 + v));
+        }
+    }
+    workload.meshes.push_back(std::move(soup));
+    workload.transforms.push_back(Math::Matrix4());  // Already in clip space
+    workload.triangleCount = static_cast<size_t>(triangles);
+    return workload;
+}
+
+Workload MakeFill(int layers) {
+    Workload workload;
+    workload.name = "fill";
+    MeshData quads;
+    for (int layer = 0; layer < layers; ++layer) {
+        // Back to front so every layer passes the depth test and writes
+        float z = 0.9f - 1.8f * layer / layers;
+        unsigned int base = static_cast<unsigned int>(quads.vertices.size() / 6);
+        const float corners[4][2] = {{-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}, {-1.0f, 1.0f}};
+        for (const auto& corner : corners) {
+            quads.vertices.insert(quads.vertices.end(), {corner[0], corner[1], z,
+                                                         layer % 2 ? 1.0f : 0.0f, 0.5f, 1.0f});
+        }
+        quads.indices.insert(quads.indices.end(), {base, base + 1, base + 2, base + 2, base + 3, base});
+    }
+    workload.meshes.push_back(std::move(quads));
+    workload.transforms.push_back(Math::Matrix4());
+    workload.triangleCount = static_cast<size_t>(layers) * 2;
+    return workload;
+}
+
+void Run(const Workload& workload, int width, int height, unsigned threads, int iterations) {
+    Rendering::SoftwareRasterizer rasterizer(threads);
+    rasterizer.Resize(width, height);
+
+    auto submit = [&]() {
+        rasterizer.Clear(0.0f, 0.0f, 0.0f, 1.0f);
+        for (size_t d = 0; d < workload.transforms.size(); ++d) {
+            const MeshData& mesh = workload.meshes[d % workload.meshes.size()];
+            rasterizer.DrawIndexed(mesh.vertices.data(), mesh.vertices.size() / 6,
+                                   mesh.indices.data(), mesh.indices.size(), workload.transforms[d]);
+        }
+        rasterizer.Flush();
+    };
+
+    submit();  // Warm up allocations and caches
+
+    double totalMs = 0.0, frontEndMs = 0.0, backEndMs = 0.0;
+    size_t rasterized = 0;
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        submit();
+        totalMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        frontEndMs += rasterizer.GetLastFrameStats().frontEndMs;
+        backEndMs += rasterizer.GetLastFrameStats().backEndMs;
+        rasterized = rasterizer.GetLastFrameStats().rasterizedTriangles;
+    }
+
+    const double frameMs = totalMs / iterations;
+    const double mtris = workload.triangleCount / (frameMs * 1000.0);
+    std::printf("%-6s %8zu tris %3u threads  %8.2f ms/frame (front %6.2f, back %6.2f)  %7.2f Mtri/s  [%zu visible]\n",
+                workload.name.c_str(), workload.triangleCount, threads, frameMs,
+                frontEndMs / iterations, backEndMs / iterations, mtris, rasterized);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int width = 1280;
+    int height = 720;
+    int iterations = 10;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            if (std::sscanf(argv[++i], "%dx%d", &width, &height) != 2) {
+                std::cerr << "Invalid size, expected WIDTHxHEIGHT" << std::endl;
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::cerr << "Usage: RasterizerBenchmark [--size WIDTHxHEIGHT] [--iterations N]" << std::endl;
+            return 1;
+        }
+    }
+
+    const std::vector<Workload> workloads = {
+        MakeCubeField(width, height, 20000),
+        MakeSoup(1000000),
+        MakeFill(64),
+    };
+
+    const unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("Software rasterizer, %dx%d, %d iterations\n", width, height, iterations);
+    for (const Workload& workload : workloads) {
+        for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+            Run(workload, width, height, threads, iterations);
+            if (threads < maxThreads && threads * 2 > maxThreads) {
+                Run(workload, width, height, maxThreads, iterations);
+            }
+        }
+    }
+    return 0;
+}
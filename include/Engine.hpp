@@ -2,16 +2,58 @@
 
 #include <glad/glad.h>
 #include "Window.hpp"
+#include "HeadlessContext.hpp"
+#include "core/EventBus.hpp"
+#include "core/FrameAllocator.hpp"
+#include "core/FramePacer.hpp"
+#include "core/JobSystem.hpp"
+#include "core/PixelConversion.hpp"
+#include "core/RenderThread.hpp"
+#include "core/SystemScheduler.hpp"
 #include "rendering/RenderSystem.hpp"
 #include "input/InputManager.hpp"
 #include "scene/Scene.hpp"
+#include <cstdint>
+#include <fstream>
+#include <functional>
 #include <string>
 #include <memory>
 
 namespace ShadowEngine {
 
+namespace Rendering {
+class FrameFences;
+}
+
 class Engine {
 public:
+    // Offscreen benchmark/CI run: no window or input, fixed simulation step,
+    // exits after a frame count or duration and prints frame-time statistics
+    struct HeadlessOptions {
+        int Width = 1280;
+        int Height = 720;
+        int FrameCount = 600;
+        double DurationSeconds = 0.0;  // When > 0, overrides FrameCount
+        int WarmupFrames = 10;         // Rendered, but neither captured nor in any report
+        Rendering::BackendType Backend = Rendering::BackendType::OpenGL;  // Null runs without a context
+    };
+
+    // Scenes simulate in fixed steps, decoupled from the render rate. Leftover
+    // time carries into the next frame; after a hitch at most MaxStepsPerFrame
+    // run and the rest of the backlog is dropped, so a slow frame cannot make
+    // the next one slower still.
+    struct TimestepOptions {
+        double FixedDeltaTime = 1.0 / 60.0;
+        int MaxStepsPerFrame = 8;
+    };
+
+    // Per-subsystem memory accounting (see MemoryTracker). With a log path,
+    // a CSV snapshot is appended every LogInterval frames and once at exit.
+    struct MemoryOptions {
+        std::string LogPath;
+        int LogInterval = 60;
+    };
+
     Engine();
     ~Engine();
 
@@ -22,7 +64,45 @@ public:
     // Initialize the engine
     bool Initialize(const std::string& windowTitle = "Shadow Engine", 
                    int windowWidth = 1280, 
-                   int windowHeight = 720);
+                   int windowHeight = 720,
+                   Rendering::BackendType backend = Rendering::BackendType::OpenGL);
+
+    // Initialize without a display, rendering into an offscreen framebuffer
+    bool InitializeHeadless(const HeadlessOptions& options);
+    bool IsHeadless() const { return m_IsHeadless; }
+
+    // Frame pacing mode, limiter rate, VSync and GPU queue depth. May be called
+    // before Initialize (VSync then applies when the window is created).
+    void SetFramePacing(const FramePacer::Settings& settings);
+    const FramePacer::Settings& GetFramePacing() const { return m_PacingSettings; }
+
+    // Simulation rate and catch-up limit; takes effect on the next frame
+    void SetTimestep(const TimestepOptions& options);
+    const TimestepOptions& GetTimestep() const { return m_Timestep; }
+
+    // Overlap simulation and rendering: while the render thread draws frame N
+    // from its published snapshot, this thread simulates frame N+1. The GL
+    // context moves to the render thread for the duration of Run, so scenes
+    // must create meshes, shaders and textures in OnAttach, before Run. Adds
+    // one frame of latency. Set before Run.
+    void SetPipelined(bool enabled) { m_Pipelined = enabled; }
+    bool IsPipelined() const { return m_Pipelined; }
+
+    // Worker count and affinity of the engine job system. Set before Initialize.
+    void SetJobSystemSettings(const JobSystem::Settings& settings) { m_JobSettings = settings; }
+
+    // Format opaque textures are streamed in (see AssetManager::SetOpaqueTextureFormat).
+    // Set before Initialize so the scene's first loads use it.
+    void SetOpaqueTextureFormat(PixelConversion::Format format) { m_OpaqueTextureFormat = format; }
+
+    // Record profiler zones from now until shutdown, then write them to path as
+    // Chrome trace JSON. Call before Initialize to include startup (shader
+    // compiles, asset loads). Fails if zones are compiled out of this build.
+    bool SetProfileOutput(const std::string& path);
+
+    // Memory snapshot log; budgets are set on MemoryTracker directly. Call
+    // before Initialize so startup allocations are part of the first snapshot.
+    bool SetMemoryOptions(const MemoryOptions& options);
 
     // Shutdown the engine
     void Shutdown();
@@ -33,10 +113,34 @@ public:
     // Get engine instance (singleton pattern)
     static Engine& GetInstance();
 
-    // Window access
+    // Window access (not available in headless mode)
     Window& GetWindow() { return *m_Window; }
     const Window& GetWindow() const { return *m_Window; }
 
+    // Job system shared by every engine service; created first and destroyed last
+    JobSystem& GetJobSystem() { return *m_JobSystem; }
+
+    // Events from any thread, delivered on this one once per frame, after input
+    // is polled and before the simulation runs. The window posts WindowEvents,
+    // the input manager InputEvents and the asset manager AssetEvents.
+    EventBus& GetEventBus() { return m_EventBus; }
+
+    // Per-frame systems, run as a dependency graph on the job system. Initialize
+    // registers three main-thread systems for games to order theirs against:
+    //   "Input"       polls the window and dispatches events; writes Input, Events
+    //   "Simulation"  fixed steps and Scene::Update; after Input, reads Input,
+    //                 writes Scene, RenderQueue
+    //   "Render"      draws or publishes the frame; after Simulation, writes
+    //                 RenderQueue, Gpu
+    // Register before Run; systems stay registered until the engine is destroyed.
+    SystemScheduler& GetScheduler() { return m_Scheduler; }
+
+    // Scratch memory for the current frame on the simulation thread, reset at
+    // the start of every frame. Use it for transient per-frame data instead of
+    // the heap; nothing allocated from it may be kept past Update or handed to
+    // the render thread.
+    FrameAllocator& GetFrameAllocator() { return m_FrameAllocator; }
+
     // Render system access
     Rendering::RenderSystem& GetRenderSystem() { return *m_RenderSystem; }
     const Rendering::RenderSystem& GetRenderSystem() const { return *m_RenderSystem; }
@@ -55,18 +159,79 @@ private:
     bool InitializeWindow();
     bool InitializeSystems();
     void ShutdownSystems();
+    void RunWindowed();
+    void RunHeadless();
+    void ConfigurePacing();
+    void RegisterEngineSystems();
+    void AdvanceSimulation(double frameSeconds);
+    void PrintSimulationSummary() const;
+    void PrintMemorySummary();
+    void ResetStats();  // Engine-side counters, at the end of warmup
+    void WriteMemorySnapshot();
+    void WriteProfile();
+    void BeginFrameMemory();
+    void EndFrameMemory();
+    void StartRenderThread(std::function<void()> frame);
+    void StopRenderThread();
 
     // Engine state
     bool m_IsInitialized;
     bool m_IsRunning;
+    bool m_IsHeadless;
+    HeadlessOptions m_HeadlessOptions;
+    Rendering::BackendType m_Backend;
+
+    // Frame pacing, and fences bounding how many frames the GPU lags behind
+    FramePacer::Settings m_PacingSettings;
+    FramePacer m_FramePacer;
+    std::unique_ptr<Rendering::FrameFences> m_FrameFences;
+
+    // Fixed-step simulation: unsimulated time and totals for the exit summary
+    TimestepOptions m_Timestep;
+    double m_Accumulator = 0.0;
+    uint64_t m_FixedSteps = 0;
+    uint64_t m_CappedFrames = 0;
+    double m_DroppedSeconds = 0.0;
+
+    // Pipelined mode: the thread that owns the context while Run draws
+    bool m_Pipelined = false;
+    std::unique_ptr<RenderThread> m_RenderThread;
     
+    // Per-frame scratch memory
+    FrameAllocator m_FrameAllocator;
+
+    // Memory snapshots: frames completed so far and the CSV they go to
+    MemoryOptions m_MemoryOptions;
+    std::ofstream m_MemoryLog;
+    uint64_t m_FrameIndex = 0;
+
+    // Chrome trace written at shutdown; empty when not profiling
+    std::string m_ProfileOutput;
+
+    // Engine-wide worker threads
+    JobSystem::Settings m_JobSettings;
+    std::unique_ptr<JobSystem> m_JobSystem;
+
+    PixelConversion::Format m_OpaqueTextureFormat = PixelConversion::Format::RGBA8;
+
+    // Declared before the systems that post to it, so it outlives them
+    EventBus m_EventBus;
+
+    // Frame graph. The engine's systems read the frame time from
+    // m_FrameSeconds; RunWindowed and RunHeadless set m_RenderFrame to the way
+    // their loop renders and presents.
+    SystemScheduler m_Scheduler;
+    double m_FrameSeconds = 0.0;
+    std::function<void()> m_RenderFrame;
+
     // Window parameters
     std::string m_WindowTitle;
     int m_WindowWidth;
     int m_WindowHeight;
     
-    // Window
+    // Window, or the offscreen context in headless mode
     std::unique_ptr<Window> m_Window;
+    std::unique_ptr<HeadlessContext> m_HeadlessContext;
     
     // Render system
     std::unique_ptr<Rendering::RenderSystem> m_RenderSystem;
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <glad/glad.h>
+
+namespace ShadowEngine {
+
+// Offscreen OpenGL context for machines without a display. Uses EGL: the Mesa
+// surfaceless platform when available (works with llvmpipe and no GPU), otherwise
+// the default display with a small pbuffer. Rendering is expected to go to an FBO.
+class HeadlessContext {
+public:
+    HeadlessContext();
+    ~HeadlessContext();
+
+    // Prevent copying
+    HeadlessContext(const HeadlessContext&) = delete;
+    HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+    // Create a 3.3 core context and make it current on this thread
+    bool Initialize();
+    void Shutdown();
+
+    void MakeContextCurrent();
+    void ReleaseContext();  // Detach the context from this thread so another can take it
+    bool IsInitialized() const { return m_Context != nullptr; }
+
+    // GL entry point loader for glad
+    static GLADloadproc GetProcLoader();
+
+private:
+    // EGL handles are opaque pointers; kept untyped so EGL headers stay out of here
+    void* m_Display;
+    void* m_Context;
+    void* m_Surface;
+};
+
+} // namespace ShadowEngine
@@ -1,12 +1,28 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
-#include <functional>
 #include <memory>
 #include <GLFW/glfw3.h>
 
 namespace ShadowEngine {
 
+class EventBus;
+
+enum class WindowEventType : uint8_t {
+    Resized,
+    CloseRequested,
+    FocusGained,
+    FocusLost
+};
+
+// Posted to the window's event bus from the GLFW callbacks
+struct WindowEvent {
+    WindowEventType type;
+    int width = 0;   // Resized: the new size in screen coordinates
+    int height = 0;
+};
+
 class Window {
 public:
     // Window properties structure
@@ -56,6 +72,7 @@ public:
     void Close();
     bool ShouldClose() const;
     void MakeContextCurrent();
+    void ReleaseContext();  // Detach the context from this thread so another can take it
     void SwapBuffers();
     void PollEvents();
     void Update();
@@ -73,9 +90,9 @@ public:
     void SetTitle(const std::string& title);
     bool SetIcon(const std::string& iconPath);
 
-    // Event callbacks
-    using EventCallbackFn = std::function<void(void*)>;
-    void SetEventCallback(const EventCallbackFn& callback) { m_Data.EventCallback = callback; }
+    // Resize, close and focus changes are posted here as WindowEvents; null
+    // stops them
+    void SetEventBus(EventBus* events) { m_Data.Events = events; }
 
 private:
     // Window data structure
@@ -86,7 +103,7 @@ private:
         bool VSync;
         bool Fullscreen;
         std::string IconPath;
-        EventCallbackFn EventCallback;
+        EventBus* Events;
 
         WindowData(const Properties& props)
             : Title(props.Title)
@@ -95,7 +112,7 @@ private:
             , VSync(props.VSync)
             , Fullscreen(props.Fullscreen)
             , IconPath(props.IconPath)
-            , EventCallback(nullptr)
+            , Events(nullptr)
         {}
     };
 
@@ -109,6 +126,12 @@ private:
 
     // Helper methods
     bool LoadIcon(const std::string& iconPath);
+    void PostEvent(const WindowEvent& event);
+
+    // GLFW callbacks; the window is found through the GLFW user pointer
+    static void SizeCallback(GLFWwindow* window, int width, int height);
+    static void CloseCallback(GLFWwindow* window);
+    static void FocusCallback(GLFWwindow* window, int focused);
 };
 
 } // namespace ShadowEngine 
\ No newline at end of file
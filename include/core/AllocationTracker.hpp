@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace ShadowEngine {
+
+// Counts heap allocations made through global operator new, on every thread.
+// Counting is compiled in only with SHADOW_TRACK_ALLOCATIONS (the CMake option
+// of the same name), which replaces the global allocation operators; otherwise
+// every count stays zero and IsEnabled returns false.
+//
+// The engine brackets each frame with BeginFrame/EndFrame and reports the
+// per-frame counts on exit. After warmup a frame should allocate nothing.
+class AllocationTracker {
+public:
+    struct Counts {
+        uint64_t allocations = 0;
+        uint64_t frees = 0;
+        uint64_t bytes = 0;  // Requested, not including allocator overhead
+    };
+
+    static AllocationTracker& Get();
+
+    static constexpr bool IsEnabled() {
+#ifdef SHADOW_TRACK_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // Process totals since startup
+    Counts GetTotals() const;
+
+    // Frames before the first counted one are excluded, so loading and
+    // first-frame growth do not hide steady-state allocations
+    void SetWarmupFrames(int frames) { m_WarmupFrames = frames; }
+    void BeginFrame();
+    void EndFrame();
+
+    const Counts& GetLastFrame() const { return m_LastFrame; }
+    void PrintSummary(std::ostream& out) const;
+
+    // Called by the replacement operators
+    static void RecordAllocation(size_t size);
+    static void RecordFree();
+
+private:
+    AllocationTracker() = default;
+
+    Counts m_FrameStart;
+    Counts m_LastFrame;
+    int m_WarmupFrames = 10;
+    uint64_t m_Frames = 0;
+    uint64_t m_CountedFrames = 0;
+    uint64_t m_AllocatingFrames = 0;  // Counted frames with at least one allocation
+    uint64_t m_CountedAllocations = 0;
+    uint64_t m_CountedBytes = 0;
+    uint64_t m_MaxFrameAllocations = 0;
+};
+
+} // namespace ShadowEngine
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ShadowEngine {
+
+// Block-compressed (BCn) texture encoders used by the offline texture cooker.
+// All encoders take tightly packed RGBA8 input and emit 4x4 blocks in row order.
+namespace BlockCompression {
+
+enum class Format : uint32_t {
+    BC1 = 1,  // RGB, 4 bpp
+    BC3 = 3,  // RGBA with interpolated alpha, 8 bpp
+    BC4 = 4,  // Single channel (red), 4 bpp
+    BC5 = 5,  // Two channels (red, green), 8 bpp; normal maps
+    BC7 = 7   // RGBA, 8 bpp; mode 6 only
+};
+
+// Bytes per 4x4 block
+size_t GetBlockSize(Format format);
+
+// Size of a compressed image including partial edge blocks
+size_t GetCompressedSize(Format format, int width, int height);
+
+const char* GetFormatName(Format format);
+
+// Compress a whole image. Edge blocks replicate the last row/column.
+void CompressImage(Format format, const uint8_t* rgba, int width, int height, std::vector<uint8_t>& out);
+
+// Single-block encoders; block is 16 RGBA8 pixels in row order
+void EncodeBC1Block(const uint8_t* block, uint8_t* out);
+void EncodeBC3Block(const uint8_t* block, uint8_t* out);
+void EncodeBC4Block(const uint8_t* block, int channel, uint8_t* out);
+void EncodeBC5Block(const uint8_t* block, uint8_t* out);
+void EncodeBC7Block(const uint8_t* block, uint8_t* out);
+
+} // namespace BlockCompression
+} // namespace ShadowEngine
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "core/BlockCompression.hpp"
+#include "core/VirtualFileSystem.hpp"
+
+namespace ShadowEngine {
+
+// Cooked texture container (.shtx). Little-endian layout:
+//
+//   FileHeader                      32 bytes
+//   MipEntry[mipCount]              24 bytes each, level 0 first
+//   mip payloads                    each 16-byte aligned, BCn blocks in row order
+//
+// Readers map the file (or its pack entry) through the VirtualFileSystem and
+// hand the payload ranges straight to the driver.
+class CompressedTextureFile {
+public:
+    static constexpr uint32_t Magic = 0x58544853;  // "SHTX"
+    static constexpr uint32_t Version = 1;
+
+    enum Flags : uint32_t {
+        FlagSRGB = 1u << 0  // Colour data is sRGB encoded
+    };
+
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t format;    // BlockCompression::Format
+        uint32_t width;
+        uint32_t height;
+        uint32_t mipCount;
+        uint32_t flags;
+        uint32_t reserved;
+    };
+
+    struct MipEntry {
+        uint32_t width;
+        uint32_t height;
+        uint64_t offset;    // From the start of the file
+        uint64_t size;
+    };
+
+    struct Mip {
+        int width = 0;
+        int height = 0;
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+    };
+
+    CompressedTextureFile() = default;
+
+    // Read and validate a container
+    bool Open(const std::string& path);
+    void Close();
+
+    BlockCompression::Format GetFormat() const { return m_Format; }
+    int GetWidth() const { return m_Width; }
+    int GetHeight() const { return m_Height; }
+    uint32_t GetFlags() const { return m_Flags; }
+    bool IsSRGB() const { return (m_Flags & FlagSRGB) != 0; }
+    int GetMipCount() const { return static_cast<int>(m_Mips.size()); }
+    const Mip& GetMip(int level) const { return m_Mips[static_cast<size_t>(level)]; }
+    size_t GetTotalPayloadSize() const;
+
+    // Write a container; mips[0] is the full-resolution level
+    static bool Write(const std::string& path, BlockCompression::Format format,
+                      int width, int height, uint32_t flags,
+                      const std::vector<std::vector<uint8_t>>& mips);
+
+private:
+    VirtualFileSystem::File m_File;
+    BlockCompression::Format m_Format = BlockCompression::Format::BC1;
+    int m_Width = 0;
+    int m_Height = 0;
+    uint32_t m_Flags = 0;
+    std::vector<Mip> m_Mips;
+};
+
+} // namespace ShadowEngine
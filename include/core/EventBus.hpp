@@ -0,0 +1,148 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ShadowEngine {
+
+namespace EventBusDetail {
+
+uint32_t NextTypeId();
+
+// Dense id per event type, assigned on first use
+template <typename Event>
+uint32_t GetTypeId() {
+    static const uint32_t id = NextTypeId();
+    return id;
+}
+
+} // namespace EventBusDetail
+
+// Typed events from any thread, delivered on one. Producers copy events into
+// a bounded ring without locks (a multi-producer, single-consumer queue: each
+// claims a slot with one compare-and-swap and publishes it with a release
+// store). The owning thread calls Dispatch at a fixed point in its frame,
+// which drains the ring in batches and calls each type's subscribers in the
+// order the events were posted.
+//
+//   bus.Subscribe<InputEvent>([](const InputEvent& event) { ... });
+//   bus.Post(InputEvent{...});  // Any thread
+//   bus.Dispatch();             // Owning thread, once per frame
+//
+// Events must be trivially copyable and at most PayloadBytes. When the ring is
+// full a post fails and is counted rather than blocking or allocating.
+class EventBus {
+public:
+    using SubscriptionId = uint32_t;  // Zero is never issued
+
+    static constexpr size_t PayloadBytes = 112;
+    static constexpr size_t DefaultCapacity = 2048;
+    static constexpr size_t BatchSize = 64;  // Events copied out of the ring per batch
+
+    struct Stats {
+        uint64_t posted = 0;
+        uint64_t dispatched = 0;
+        uint64_t dropped = 0;      // Ring was full
+        uint64_t batches = 0;
+        size_t lastDepth = 0;      // Events waiting when the last Dispatch began
+        size_t peakDepth = 0;
+        size_t capacity = 0;
+    };
+
+    // Capacity is rounded up to a power of two
+    explicit EventBus(size_t capacity = DefaultCapacity);
+    ~EventBus();
+
+    // Prevent copying
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    // Any thread. False if the ring is full; the event is dropped.
+    template <typename Event>
+    bool Post(const Event& event) {
+        CheckEventType<Event>();
+        return PostRaw(EventBusDetail::GetTypeId<Event>(), &event, sizeof(Event), 1);
+    }
+
+    // Any thread. Claims count consecutive slots at once, so the events stay
+    // together; all are posted or, if they do not fit, none.
+    template <typename Event>
+    bool PostBatch(const Event* events, size_t count) {
+        CheckEventType<Event>();
+        return count == 0 || PostRaw(EventBusDetail::GetTypeId<Event>(), events, sizeof(Event), count);
+    }
+
+    // The functions below are for the owning thread only. Subscribing from a
+    // handler takes effect after the current Dispatch; unsubscribing takes
+    // effect at once.
+    template <typename Event>
+    SubscriptionId Subscribe(std::function<void(const Event&)> handler) {
+        CheckEventType<Event>();
+        return SubscribeRaw(EventBusDetail::GetTypeId<Event>(),
+                            [handler = std::move(handler)](const void* event) {
+                                handler(*static_cast<const Event*>(event));
+                            });
+    }
+
+    void Unsubscribe(SubscriptionId id);
+
+    // Deliver the events posted before this call; ones posted by handlers wait
+    // for the next Dispatch. Returns the number delivered.
+    size_t Dispatch();
+
+    // Discard pending events and every subscription
+    void Clear();
+
+    // Events posted but not yet dispatched
+    size_t GetDepth() const;
+
+    Stats GetStats() const;
+
+private:
+    struct Slot;
+
+    struct Subscriber {
+        SubscriptionId id;  // 0 once unsubscribed during a dispatch; removed afterwards
+        std::function<void(const void*)> handler;
+    };
+
+    template <typename Event>
+    static void CheckEventType() {
+        static_assert(std::is_trivially_copyable_v<Event>, "Events are copied into the ring as bytes");
+        static_assert(sizeof(Event) <= PayloadBytes, "Event is larger than EventBus::PayloadBytes");
+        static_assert(alignof(Event) <= 16, "Events are stored 16-byte aligned");
+    }
+
+    bool PostRaw(uint32_t type, const void* events, size_t size, size_t count);
+    SubscriptionId SubscribeRaw(uint32_t type, std::function<void(const void*)> handler);
+    void Deliver(uint32_t type, const void* event);
+
+    std::unique_ptr<Slot[]> m_Slots;
+    size_t m_Mask;
+
+    // Producers claim from head; the owning thread alone advances tail. Kept
+    // on separate cache lines so posting does not contend with draining.
+    alignas(64) std::atomic<uint64_t> m_Head;
+    alignas(64) std::atomic<uint64_t> m_Dropped;
+    alignas(64) std::atomic<uint64_t> m_Tail;
+
+    // Owning thread only
+    std::vector<std::vector<Subscriber>> m_Subscribers;  // Indexed by event type id
+    std::vector<std::pair<uint32_t, Subscriber>> m_PendingSubscribers;
+    SubscriptionId m_NextSubscription;
+    bool m_Dispatching;
+    bool m_HasRemovals;
+    uint64_t m_ReportedDrops;
+    uint64_t m_Dispatched;
+    uint64_t m_Batches;
+    size_t m_LastDepth;
+    size_t m_PeakDepth;
+};
+
+} // namespace ShadowEngine
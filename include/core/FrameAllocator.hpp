@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace ShadowEngine {
+
+// Linear arena for data that lives for one frame. Allocation bumps a pointer;
+// nothing is freed individually, and Reset releases everything at once. When
+// the block fills up, overflow goes to extra heap blocks, and the next Reset
+// replaces them all with one block big enough for the whole frame, so the
+// arena stops touching the heap after the first few frames.
+//
+// Also a std::pmr::memory_resource, so standard containers can use it:
+//   std::pmr::vector<Item> items(&engine.GetFrameAllocator());
+// Containers built on it must not outlive the frame. Not thread-safe.
+class FrameAllocator : public std::pmr::memory_resource {
+public:
+    struct Stats {
+        size_t capacity = 0;          // Main block size
+        size_t used = 0;              // This frame, including overflow
+        size_t highWater = 0;         // Most used in any frame
+        uint64_t overflowBlocks = 0;  // Heap blocks taken since startup
+    };
+
+    explicit FrameAllocator(size_t capacity = 1 << 20);
+    ~FrameAllocator() override;
+
+    // Prevent copying
+    FrameAllocator(const FrameAllocator&) = delete;
+    FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    // Uninitialized storage for count objects of T
+    template <typename T>
+    T* AllocateArray(size_t count) {
+        return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    // Invalidates everything allocated since the last Reset
+    void Reset();
+
+    Stats GetStats() const;
+    void ResetStats();  // High water and overflow count start over; the block is kept
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}  // Freed by Reset
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+    struct Block {
+        std::unique_ptr<unsigned char[]> memory;
+        size_t size = 0;
+    };
+
+    void* AllocateOverflow(size_t size, size_t alignment);
+
+    Block m_Block;
+    size_t m_Offset;
+    std::vector<Block> m_Overflow;
+    size_t m_OverflowOffset;  // Into m_Overflow.back()
+    size_t m_OverflowUsed;    // Bytes in full overflow blocks
+    size_t m_HighWater;
+    uint64_t m_OverflowBlocks;
+};
+
+} // namespace ShadowEngine
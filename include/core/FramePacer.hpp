@@ -0,0 +1,65 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+
+namespace ShadowEngine {
+
+// Decides when each frame starts. Call BeginFrame before sampling input and
+// EndFrame after presenting.
+//   Uncapped  - no waiting (beyond VSync, if enabled)
+//   Limited   - after presenting, wait for the next slot at the target rate
+//   LateLatch - wait *before* sampling input, until only the predicted frame
+//               work is left before the next slot, so input and camera are as
+//               fresh as possible at submission
+// Waits sleep in short steps while the measured oversleep allows, then spin
+// for the rest of the wait. This is accurate to tens of microseconds even
+// with a coarse OS timer.
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Mode { Uncapped, Limited, LateLatch };
+
+    struct Settings {
+        Mode mode = Mode::Uncapped;
+        double targetFps = 0.0;         // 0 uses the display refresh rate
+        bool vsync = true;
+        int maxQueuedFrames = 2;        // Frames the GPU may lag the CPU (1-2; 0 = driver default)
+        double lateLatchMarginMs = 1.0; // Safety margin added to the predicted work
+    };
+
+    // "uncapped", "limit" or "late-latch"
+    static const char* GetModeName(Mode mode);
+    static bool ParseMode(const std::string& name, Mode& outMode);
+
+    FramePacer();
+    explicit FramePacer(const Settings& settings);
+
+    // refreshRate is used when targetFps is 0; pass 0 if unknown (60 Hz is assumed)
+    void Configure(const Settings& settings, double refreshRate);
+    const Settings& GetSettings() const { return m_Settings; }
+
+    void BeginFrame();
+    void EndFrame();
+
+    // Time from BeginFrame's return to EndFrame, smoothed with fast attack
+    double GetPredictedWorkMs() const { return m_PredictedWorkMs; }
+
+    // Sleep and spin until the deadline
+    void WaitUntil(Clock::time_point deadline);
+
+private:
+    Settings m_Settings;
+    Clock::duration m_Period;
+    Clock::time_point m_NextDeadline;
+    Clock::time_point m_WorkStart;
+    bool m_HasDeadline;
+    double m_PredictedWorkMs;
+
+    // Running estimate of how long a 1 ms sleep really takes
+    double m_SleepMeanMs;
+    double m_SleepVariance;
+};
+
+} // namespace ShadowEngine
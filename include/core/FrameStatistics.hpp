@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ShadowEngine {
+
+// Collects per-frame durations and summarises them (mean, percentiles, jitter)
+class FrameStatistics {
+public:
+    void Reserve(size_t frames) { m_Samples.reserve(frames); }
+    void AddSample(double milliseconds) { m_Samples.push_back(milliseconds); }
+    void Clear() { m_Samples.clear(); }
+
+    size_t GetCount() const { return m_Samples.size(); }
+    double GetTotal() const;
+    double GetMean() const;
+    double GetMin() const;
+    double GetMax() const;
+    double GetStandardDeviation() const;
+
+    // Nearest-rank percentile, p in [0, 100]
+    double GetPercentile(double p) const;
+
+    void Print(std::ostream& out, const std::string& label) const;
+
+    // Same distribution without the frame-rate view, for durations that are
+    // not whole frames (latencies, phases)
+    void PrintDurations(std::ostream& out, const std::string& label) const;
+
+private:
+    std::vector<double> m_Samples;
+};
+
+} // namespace ShadowEngine
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ShadowEngine {
+
+// 64-bit content hashing for cache keys. XXH64: output matches the reference
+// implementation for the same seed, and large inputs hash at several GB/s.
+namespace Hash {
+
+uint64_t Compute(const void* data, size_t size, uint64_t seed = 0);
+
+} // namespace Hash
+} // namespace ShadowEngine
@@ -1,20 +1,128 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
 namespace ShadowEngine {
 
+class FrameAllocator;
+class JobSystem;
+
 class ImageLoader {
 public:
+    // Owning byte buffer with the part of std::vector's interface that pixel
+    // code uses, named alike so it reads like one. Unlike a vector it can take
+    // over the buffer the decoder allocated, so decoded pixels are never copied
+    // into place. Memory comes from operator new, like a vector's.
+    class PixelBuffer {
+    public:
+        PixelBuffer() = default;
+        ~PixelBuffer();
+
+        PixelBuffer(const PixelBuffer& other);
+        PixelBuffer& operator=(const PixelBuffer& other);
+        PixelBuffer(PixelBuffer&& other) noexcept;
+        PixelBuffer& operator=(PixelBuffer&& other) noexcept;
+
+        unsigned char* data() { return m_Data; }
+        const unsigned char* data() const { return m_Data; }
+        size_t size() const { return m_Size; }
+        bool empty() const { return m_Size == 0; }
+        unsigned char* begin() { return m_Data; }
+        unsigned char* end() { return m_Data + m_Size; }
+        const unsigned char* begin() const { return m_Data; }
+        const unsigned char* end() const { return m_Data + m_Size; }
+        unsigned char& operator[](size_t index) { return m_Data[index]; }
+        const unsigned char& operator[](size_t index) const { return m_Data[index]; }
+
+        // Bytes kept up to the new size; added ones are zero
+        void resize(size_t size);
+        void assign(size_t size, unsigned char value);
+        void assign(const unsigned char* first, const unsigned char* last);
+        void clear() { m_Size = 0; }
+
+    private:
+        friend class ImageLoader;
+
+        void Adopt(unsigned char* data, size_t size);  // From operator new
+
+        unsigned char* m_Data = nullptr;
+        size_t m_Size = 0;
+        size_t m_Capacity = 0;
+    };
+
     struct ImageData {
         int width;
         int height;
         int channels;
-        std::vector<unsigned char> data;
+        PixelBuffer data;
+    };
+
+    // RGBA8 pixels left where the decoder put them, so nothing is copied:
+    // either stb_image's own buffer, freed with the image, or an arena, valid
+    // until the arena is reset
+    class DecodedImage {
+    public:
+        DecodedImage() = default;
+        ~DecodedImage();
+
+        // Prevent copying
+        DecodedImage(const DecodedImage&) = delete;
+        DecodedImage& operator=(const DecodedImage&) = delete;
+
+        DecodedImage(DecodedImage&& other) noexcept;
+        DecodedImage& operator=(DecodedImage&& other) noexcept;
+
+        bool IsEmpty() const { return m_Pixels == nullptr; }
+        int GetWidth() const { return m_Width; }
+        int GetHeight() const { return m_Height; }
+        const unsigned char* GetPixels() const { return m_Pixels; }
+        size_t GetSize() const { return static_cast<size_t>(m_Width) * static_cast<size_t>(m_Height) * 4; }
+
+        // Copy into an ImageData
+        ImageData ToImageData() const;
+
+        // Hand the pixels to an ImageData, leaving this empty. Heap pixels
+        // change owner without a copy; arena pixels are copied.
+        ImageData TakeImageData();
+
+    private:
+        friend class ImageLoader;
+
+        void Reset();
+
+        unsigned char* m_Pixels = nullptr;
+        int m_Width = 0;
+        int m_Height = 0;
+        bool m_OwnsPixels = false;  // False for arena memory
+    };
+
+    // Encoded bytes, e.g. a VirtualFileSystem::File
+    struct EncodedImage {
+        const uint8_t* data = nullptr;
+        size_t size = 0;
     };
 
+    // Read through the VirtualFileSystem and decode to RGBA8
     static bool LoadImage(const std::string& path, ImageData& outImage);
+    static bool LoadImage(const std::string& path, DecodedImage& outImage);
+
+    // Decode an encoded image (PNG, JPEG, ...) already in memory to RGBA8.
+    // Both forms keep the decoder's buffer; neither copies the pixels.
+    static bool DecodeImage(const uint8_t* data, size_t size, ImageData& outImage);
+    static bool DecodeImage(const uint8_t* data, size_t size, DecodedImage& outImage);
+
+    // Same, with every allocation the decoder makes (working buffers too) taken
+    // from arena instead of the heap. outImage points into the arena.
+    static bool DecodeImage(const uint8_t* data, size_t size, FrameAllocator& arena, DecodedImage& outImage);
+
+    // Decode many images across the job system's threads. outImages gets one
+    // entry per input, left empty where decoding failed. Returns how many
+    // decoded.
+    static size_t DecodeBatch(JobSystem& jobs, const std::vector<EncodedImage>& inputs,
+                              std::vector<DecodedImage>& outImages);
 };
 
-} // namespace ShadowEngine 
\ No newline at end of file
+} // namespace ShadowEngine
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "core/ImageLoader.hpp"
+
+namespace ShadowEngine {
+
+// Writes 8-bit RGB/RGBA images without external dependencies. PNG data uses
+// stored (uncompressed) deflate blocks: files are about as large as raw
+// pixels, but encoding costs little more than a copy and two checksums, which
+// is what frame capture needs. Any PNG reader accepts them.
+class ImageWriter {
+public:
+    // Encode width x height pixels with the given channel count (3 or 4).
+    // bottomUp takes rows in OpenGL readback order and flips them.
+    static bool EncodePNG(const unsigned char* pixels, int width, int height, int channels,
+                          bool bottomUp, std::vector<unsigned char>& out);
+
+    static bool WritePNG(const std::string& path, const ImageLoader::ImageData& image);
+};
+
+} // namespace ShadowEngine
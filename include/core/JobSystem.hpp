@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "core/PoolAllocator.hpp"
+
+namespace ShadowEngine {
+
+class JobSystem;
+
+// Counts unfinished jobs. Run increments it, completion decrements it, and
+// JobSystem::Wait returns once it reaches zero. A counter may also gate other
+// jobs (see Run); those start on whichever thread finishes its last job.
+// Reuse a counter only after waiting on it.
+class JobCounter {
+public:
+    JobCounter() = default;
+
+    // Prevent copying
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool IsDone() const { return m_Value.load(std::memory_order_acquire) == 0; }
+    int GetValue() const { return m_Value.load(std::memory_order_acquire) & ~LockBit; }
+
+private:
+    friend class JobSystem;
+
+    // Guards m_Dependents. Kept in the value so the last job releases the lock
+    // and signals completion in one store, and never touches the counter after
+    // a waiter may have destroyed it.
+    static constexpr int LockBit = 1 << 30;
+
+    std::atomic<int> m_Value{0};
+    std::vector<void*> m_Dependents;  // Jobs held back until the value reaches zero
+};
+
+// Work-stealing job scheduler. Each worker owns a Chase-Lev deque: it pushes
+// and pops at the bottom without locks while idle threads steal from the top.
+// The thread that creates the system owns a deque too and runs jobs whenever it
+// waits, so it never idles while work is queued. Other threads may submit and
+// wait as well; their jobs go through a shared queue.
+class JobSystem {
+public:
+    struct Settings {
+        int workerCount = -1;         // -1: one per hardware thread besides the creating thread
+        bool pinWorkers = false;      // Worker i runs only on core i + 1; core 0 is left to the main thread
+        size_t queueCapacity = 4096;  // Per-deque; overflow goes to the shared queue
+    };
+
+    struct Stats {
+        uint64_t executed = 0;
+        uint64_t stolen = 0;
+    };
+
+    JobSystem();
+    explicit JobSystem(const Settings& settings);
+    ~JobSystem();
+
+    // Prevent copying
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Queue a job. counter, if given, is incremented now and decremented when
+    // the job finishes. The job is held back until dependency reaches zero.
+    void Run(std::function<void()> job, JobCounter* counter = nullptr,
+             JobCounter* dependency = nullptr);
+
+    // Run queued jobs on this thread until counter reaches zero
+    void Wait(const JobCounter& counter);
+
+    // Run one queued job on this thread, if any. For callers that wait on
+    // something other than a counter; false when nothing was queued.
+    bool TryRunJob();
+
+    // Call body(begin, end) over [0, count) in chunks of grainSize (0 picks
+    // about four chunks per thread) and return when all are done. The calling
+    // thread takes part.
+    void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& body);
+
+    unsigned GetWorkerCount() const { return static_cast<unsigned>(m_Workers.size()); }
+    unsigned GetThreadCount() const { return GetWorkerCount() + 1; }  // Workers plus the waiting caller
+
+    Stats GetStats() const;
+
+private:
+    struct Job;
+    class WorkQueue;
+
+    int CurrentQueueIndex() const;
+    Job* CreateJob(JobCounter* counter);
+    void DestroyJob(Job* job);
+    void Submit(Job* job, JobCounter* dependency);
+    void Push(Job* job);
+    Job* FindJob(int queueIndex);
+    void Execute(Job* job);
+    void Complete(JobCounter* counter);
+    void WorkerLoop(unsigned queueIndex);
+    void PinWorker(std::thread& thread, unsigned core);
+
+    Settings m_Settings;
+    std::thread::id m_OwnerThread;
+    std::vector<std::unique_ptr<WorkQueue>> m_Queues;  // 0 belongs to the owner thread
+    std::vector<std::thread> m_Workers;
+
+    // Job storage, recycled so steady-state scheduling never touches the heap
+    std::mutex m_JobPoolMutex;
+    PoolAllocator m_JobPool;
+
+    // Jobs from threads without a deque, and deque overflow
+    std::mutex m_SharedMutex;
+    std::deque<Job*> m_Shared;
+
+    // Idle workers sleep here until a job is queued
+    std::mutex m_SleepMutex;
+    std::condition_variable m_Wake;
+    std::atomic<int64_t> m_QueuedJobs;
+    std::atomic<int> m_Sleeping;
+    std::atomic<bool> m_Quit;
+
+    std::atomic<uint64_t> m_Executed;
+    std::atomic<uint64_t> m_Stolen;
+};
+
+} // namespace ShadowEngine
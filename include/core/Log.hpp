@@ -0,0 +1,257 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Messages below SHADOW_LOG_LEVEL, or in a category missing from the
+// SHADOW_LOG_CATEGORIES bit mask, are compiled out: the macros expand to a
+// discarded branch, so neither the call nor its arguments cost anything. Both
+// can be set through CMake (options of the same name).
+//   0 Trace, 1 Debug, 2 Info, 3 Warning, 4 Error
+#ifndef SHADOW_LOG_LEVEL
+#ifdef NDEBUG
+#define SHADOW_LOG_LEVEL 2
+#else
+#define SHADOW_LOG_LEVEL 1
+#endif
+#endif
+
+#ifndef SHADOW_LOG_CATEGORIES
+#define SHADOW_LOG_CATEGORIES 0xFFFFFFFFu
+#endif
+
+namespace ShadowEngine {
+
+enum class LogLevel : uint8_t {
+    Trace,
+    Debug,
+    Info,
+    Warning,  // Warnings and errors go to stderr, the rest to stdout
+    Error
+};
+
+// Subsystem a message comes from; bit N of SHADOW_LOG_CATEGORIES enables value N
+enum class LogCategory : uint8_t {
+    Core,
+    Rendering,
+    Input,
+    Scene,
+    Assets,
+    Count
+};
+
+namespace LogDetail {
+
+enum class ArgType : uint8_t { Int, UInt, Double, Bool, Char, String, Pointer };
+
+constexpr size_t MaxStringBytes = 16 * 1024;  // Longer string arguments are cut
+
+template <typename T>
+constexpr bool IsString = std::is_convertible_v<const T&, std::string_view>;
+
+template <typename T>
+std::string_view ToStringView(const T& value) {
+    if constexpr (std::is_pointer_v<T>) {
+        if (value == nullptr) {
+            return "(null)";
+        }
+    }
+    const std::string_view text(value);
+    return text.substr(0, MaxStringBytes);
+}
+
+template <typename T>
+size_t ArgSize(const T& value) {
+    if constexpr (IsString<T>) {
+        return 1 + sizeof(uint32_t) + ToStringView(value).size();
+    } else if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, char>) {
+        return 2;
+    } else {
+        static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>,
+                      "Log arguments must be numbers, enums, pointers or strings");
+        return 1 + 8;
+    }
+}
+
+template <typename T>
+void Put(uint8_t*& out, const T& value) {
+    std::memcpy(out, &value, sizeof(value));
+    out += sizeof(value);
+}
+
+template <typename T>
+void EncodeArg(uint8_t*& out, const T& value) {
+    if constexpr (IsString<T>) {
+        const std::string_view text = ToStringView(value);
+        *out++ = static_cast<uint8_t>(ArgType::String);
+        Put(out, static_cast<uint32_t>(text.size()));
+        std::memcpy(out, text.data(), text.size());
+        out += text.size();
+    } else if constexpr (std::is_same_v<T, bool>) {
+        *out++ = static_cast<uint8_t>(ArgType::Bool);
+        *out++ = value ? 1 : 0;
+    } else if constexpr (std::is_same_v<T, char>) {
+        *out++ = static_cast<uint8_t>(ArgType::Char);
+        *out++ = static_cast<uint8_t>(value);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        *out++ = static_cast<uint8_t>(ArgType::Double);
+        Put(out, static_cast<double>(value));
+    } else if constexpr (std::is_pointer_v<T>) {
+        *out++ = static_cast<uint8_t>(ArgType::Pointer);
+        Put(out, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+    } else if constexpr (std::is_enum_v<T>) {
+        EncodeArg(out, static_cast<std::underlying_type_t<T>>(value));
+    } else if constexpr (std::is_signed_v<T>) {
+        *out++ = static_cast<uint8_t>(ArgType::Int);
+        Put(out, static_cast<int64_t>(value));
+    } else {
+        *out++ = static_cast<uint8_t>(ArgType::UInt);
+        Put(out, static_cast<uint64_t>(value));
+    }
+}
+
+} // namespace LogDetail
+
+// Asynchronous logger. A message is stored as a compact binary record: the
+// format string's pointer and the arguments' raw values (strings copied). Each
+// thread appends records to its own fixed-size ring without locks; a
+// background thread formats them, orders them by time and writes them out,
+// flushing once per batch. A full ring drops the message and counts it, so a
+// burst never blocks the caller or grows memory; the writer reports the drops.
+//
+//   SHADOW_LOG_INFO(Rendering, "Created {}x{} target", width, height);
+//   SHADOW_LOG_ERROR(Assets, "Failed to open: {}", path);
+//
+// Format strings must be string literals (only the pointer is stored). Each
+// {} takes the next argument; {:.N} prints a number with N decimals and {:x}
+// an integer in hex; {{ and }} are literal braces. Arguments may be numbers,
+// enums, bools, chars, pointers and strings.
+class Log {
+public:
+    // Per-thread ring size. Messages are usually well under 100 bytes.
+    static constexpr size_t QueueBytes = 256 * 1024;
+
+    struct Stats {
+        uint64_t written = 0;
+        uint64_t dropped = 0;  // Rings were full
+        unsigned threads = 0;  // Rings allocated
+    };
+
+    static Log& Get();
+
+    static constexpr bool IsEnabled(LogLevel level, LogCategory category) {
+        return static_cast<int>(level) >= SHADOW_LOG_LEVEL &&
+               ((static_cast<uint32_t>(SHADOW_LOG_CATEGORIES) >> static_cast<uint32_t>(category)) & 1u) != 0;
+    }
+
+    static const char* GetLevelName(LogLevel level);
+    static const char* GetCategoryName(LogCategory category);
+
+    ~Log();
+
+    // Prevent copying
+    Log(const Log&) = delete;
+    Log& operator=(const Log&) = delete;
+
+    template <typename... Args>
+    void Write(LogLevel level, LogCategory category, const char* format, const Args&... args) {
+        const size_t payload = (size_t(0) + ... + LogDetail::ArgSize(args));
+        uint8_t* out = BeginRecord(level, category, format, sizeof...(Args), payload);
+        if (out == nullptr) {
+            return;
+        }
+        (LogDetail::EncodeArg(out, args), ...);
+        EndRecord();
+    }
+
+    // Block until everything this thread logged so far has been written
+    void Flush();
+
+    // Write what is queued and stop the writer thread; later messages are
+    // formatted and written by the caller. Called on destruction.
+    void Shutdown();
+
+    Stats GetStats() const;
+
+private:
+    struct ThreadQueue;
+    struct RecordHeader;
+    struct Line;
+
+    Log();
+
+    uint64_t Now() const;
+    ThreadQueue& GetThreadQueue();
+    uint8_t* BeginRecord(LogLevel level, LogCategory category, const char* format, size_t argCount, size_t payload);
+    void EndRecord();
+
+    void WriterLoop();
+    void Drain(std::vector<Line>& lines);
+    void Output(std::vector<Line>& lines);
+
+    std::chrono::steady_clock::time_point m_Epoch;
+    std::atomic<bool> m_Running;
+
+    mutable std::mutex m_QueuesMutex;
+    std::vector<std::unique_ptr<ThreadQueue>> m_Queues;
+
+    // The writer sleeps here between polls; Flush and Shutdown wake it
+    std::mutex m_WakeMutex;
+    std::condition_variable m_Wake;
+    std::condition_variable m_Flushed;
+    uint64_t m_FlushRequested;
+    uint64_t m_FlushCompleted;
+    bool m_Quit;
+    bool m_Stopped;
+
+    std::atomic<uint64_t> m_Written;
+    std::thread m_Writer;
+};
+
+// Log what a report prints to a std::ostream (the Print functions of the
+// statistics classes) as one message. The report is not run at all when the
+// level or category is compiled out.
+template <LogLevel Level, LogCategory Category, typename Report>
+void LogReport(const Report& report) {
+    if constexpr (Log::IsEnabled(Level, Category)) {
+        std::ostringstream text;
+        report(text);
+        Log::Get().Write(Level, Category, "{}", text.str());
+    }
+}
+
+} // namespace ShadowEngine
+
+#define SHADOW_LOG(level, category, ...)                                                                       \
+    do {                                                                                                       \
+        if constexpr (::ShadowEngine::Log::IsEnabled(level, category)) {                                       \
+            ::ShadowEngine::Log::Get().Write(level, category, __VA_ARGS__);                                    \
+        }                                                                                                      \
+    } while (0)
+
+#define SHADOW_LOG_TRACE(category, ...) \
+    SHADOW_LOG(::ShadowEngine::LogLevel::Trace, ::ShadowEngine::LogCategory::category, __VA_ARGS__)
+#define SHADOW_LOG_DEBUG(category, ...) \
+    SHADOW_LOG(::ShadowEngine::LogLevel::Debug, ::ShadowEngine::LogCategory::category, __VA_ARGS__)
+#define SHADOW_LOG_INFO(category, ...) \
+    SHADOW_LOG(::ShadowEngine::LogLevel::Info, ::ShadowEngine::LogCategory::category, __VA_ARGS__)
+#define SHADOW_LOG_WARNING(category, ...) \
+    SHADOW_LOG(::ShadowEngine::LogLevel::Warning, ::ShadowEngine::LogCategory::category, __VA_ARGS__)
+#define SHADOW_LOG_ERROR(category, ...) \
+    SHADOW_LOG(::ShadowEngine::LogLevel::Error, ::ShadowEngine::LogCategory::category, __VA_ARGS__)
+
+// SHADOW_LOG_REPORT(Info, Core, [&](std::ostream& out) { stats.Print(out, "Frame times"); });
+#define SHADOW_LOG_REPORT(level, category, ...) \
+    ::ShadowEngine::LogReport<::ShadowEngine::LogLevel::level, ::ShadowEngine::LogCategory::category>(__VA_ARGS__)
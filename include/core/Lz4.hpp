@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ShadowEngine {
+
+// LZ4 block format (no frame header or checksum), as used for pack entries.
+// Output is readable by the reference decoder and vice versa. The compressor is
+// the greedy single-probe variant: fast, and close to the reference ratio on
+// text and uncompressed images.
+namespace Lz4 {
+
+// Largest output Compress can produce for size input bytes
+size_t GetMaxCompressedSize(size_t size);
+
+// Largest output any valid block of size bytes can decompress to. A length
+// byte of 255 adds at most 255 bytes of output, so nothing expands further.
+size_t GetMaxDecompressedSize(size_t size);
+
+// Compress into out, which must hold GetMaxCompressedSize(size) bytes.
+// Returns the compressed size.
+size_t Compress(const uint8_t* data, size_t size, uint8_t* out);
+
+// Decompress a block that expands to exactly outSize bytes. Fails on any
+// malformed or truncated input without reading or writing out of bounds.
+bool Decompress(const uint8_t* data, size_t size, uint8_t* out, size_t outSize);
+
+} // namespace Lz4
+} // namespace ShadowEngine
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ShadowEngine {
+
+// Read-only memory mapping of a whole file. The mapping stays valid for the
+// lifetime of the object, so loaders can hand out pointers into it directly.
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    // Prevent copying
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const { return m_Data != nullptr; }
+    const uint8_t* GetData() const { return m_Data; }
+    size_t GetSize() const { return m_Size; }
+    const std::string& GetPath() const { return m_Path; }
+
+private:
+    const uint8_t* m_Data;
+    size_t m_Size;
+    std::string m_Path;
+
+#ifdef _WIN32
+    void* m_FileHandle;
+    void* m_MappingHandle;
+#else
+    int m_FileDescriptor;
+#endif
+};
+
+} // namespace ShadowEngine
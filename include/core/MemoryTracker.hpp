@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace ShadowEngine {
+
+// Subsystem a piece of memory is charged to
+enum class MemoryTag : uint8_t {
+    Core,
+    Rendering,
+    Input,
+    Scene,
+    Assets,
+    Count
+};
+
+enum class MemoryDomain : uint8_t {
+    Heap,  // CPU heap through global operator new
+    Gpu,   // Driver-side estimates: buffers, textures, programs, render targets
+    Count
+};
+
+// Memory use per subsystem tag, with high-water marks and budgets.
+//
+// GPU memory is charged explicitly by whoever creates the object (meshes,
+// textures, programs, framebuffers, staging buffers) from the size it asked
+// the driver for, so it is an estimate that ignores driver padding.
+//
+// Heap memory is charged to the calling thread's current tag (see MemoryScope)
+// by the replacement operator new, and credited back to the same tag on
+// delete. That needs SHADOW_TRACK_ALLOCATIONS; without it heap figures stay
+// zero and IsHeapTracked returns false.
+class MemoryTracker {
+public:
+    struct Usage {
+        int64_t current = 0;       // Bytes
+        int64_t peak = 0;          // Highest current since startup or ResetPeaks
+        uint64_t allocations = 0;  // Total Add calls
+    };
+
+    struct Snapshot {
+        uint64_t frame = 0;
+        Usage usage[static_cast<size_t>(MemoryTag::Count)][static_cast<size_t>(MemoryDomain::Count)];
+    };
+
+    static MemoryTracker& Get();
+
+    static bool IsHeapTracked();
+
+    static const char* GetTagName(MemoryTag tag);
+    static const char* GetDomainName(MemoryDomain domain);
+
+    // Parse "rendering", "assets", ... and "heap"/"gpu"
+    static bool ParseTag(const std::string& text, MemoryTag& out);
+    static bool ParseDomain(const std::string& text, MemoryDomain& out);
+
+    // Parse a budget as "tag.domain=MB", e.g. "assets.gpu=256"
+    static bool ParseBudget(const std::string& text, MemoryTag& tag, MemoryDomain& domain, size_t& bytes);
+
+    // Charge or credit bytes; safe from any thread, never allocates
+    static void Add(MemoryTag tag, MemoryDomain domain, size_t bytes);
+    static void Remove(MemoryTag tag, MemoryDomain domain, size_t bytes);
+
+    Usage GetUsage(MemoryTag tag, MemoryDomain domain) const;
+    int64_t GetTotal(MemoryDomain domain) const;
+
+    // Warn once when current use of a tag goes over budget, and again after it
+    // has dropped back under. 0 removes the budget.
+    void SetBudget(MemoryTag tag, MemoryDomain domain, size_t bytes);
+    size_t GetBudget(MemoryTag tag, MemoryDomain domain) const;
+
+    // Log budgets crossed since the last call. Warnings are deferred to here
+    // because Add runs inside operator new, where logging could recurse; the
+    // engine calls this once per frame.
+    void CheckBudgets();
+
+    Snapshot TakeSnapshot(uint64_t frame) const;
+
+    // Lower every peak to the current use, so later reports only show peaks
+    // reached from here on (e.g. after loading or warmup)
+    void ResetPeaks();
+
+    // Table of current, peak and budget per tag and domain
+    static void PrintReport(std::ostream& out, const Snapshot& snapshot);
+
+    // One CSV row per tag and domain, for diffing runs and builds
+    static void WriteCsvHeader(std::ostream& out);
+    static void WriteCsvRows(std::ostream& out, const Snapshot& snapshot);
+
+private:
+    MemoryTracker() = default;
+};
+
+// Charges heap allocations made on this thread to a tag until destroyed.
+// Scopes nest; the innermost wins. Jobs run under the tag that was current
+// when they were queued.
+class MemoryScope {
+public:
+    explicit MemoryScope(MemoryTag tag);
+    ~MemoryScope();
+
+    // Prevent copying
+    MemoryScope(const MemoryScope&) = delete;
+    MemoryScope& operator=(const MemoryScope&) = delete;
+
+    static MemoryTag GetCurrent();
+
+private:
+    MemoryTag m_Previous;
+};
+
+} // namespace ShadowEngine
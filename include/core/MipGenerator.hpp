@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "core/ImageLoader.hpp"
+
+namespace ShadowEngine {
+
+class JobSystem;
+
+// Builds RGBA8 mip chains on the CPU. Each level is resampled from the one
+// above it with a separable filter sized to the exact ratio between them, so
+// odd dimensions are averaged rather than dropped. Colour channels can be
+// filtered in linear light and re-encoded to sRGB, and alpha can be rescaled
+// per level so alpha-tested textures keep their coverage as they shrink.
+//
+// The filters run on SSE2 where the compiler targets it, one RGBA pixel per
+// register, and split each level's rows across a job system when given one.
+namespace MipGenerator {
+
+enum class Filter : uint8_t {
+    Box,      // Area average; 2x2 for even dimensions
+    Kaiser,   // Kaiser-windowed sinc, 3 destination texels each side; sharper
+    Lanczos   // Lanczos-3; sharpest, with slight ringing on hard edges
+};
+
+struct Settings {
+    Filter filter = Filter::Box;
+    bool srgb = true;          // Colour is sRGB-encoded: decode, filter, re-encode. Alpha is always linear.
+    float alphaCutoff = 0.0f;  // Above 0: scale each level's alpha so the share of texels at or above the
+                               // cutoff matches level 0 (the alpha test threshold of the material)
+    int maxLevels = 0;         // 0: down to 1x1
+};
+
+const char* GetFilterName(Filter filter);
+
+// Number of levels in a full chain for the given size, 1x1 included
+int GetLevelCount(int width, int height);
+
+// Build the chain. The base image (RGBA8) is moved in as level 0. jobs may be
+// null or have no workers; the rows then run on the calling thread.
+std::vector<ImageLoader::ImageData> Build(ImageLoader::ImageData base, const Settings& settings = Settings(),
+                                          JobSystem* jobs = nullptr);
+
+// The same filters in plain scalar code with exact sRGB curves, to check and
+// time Build against. Each level agrees to within one step per channel given
+// the same source; rounding ties compound down the chain, and alpha rescaled
+// for coverage amplifies them, so whole chains can differ by a few steps.
+std::vector<ImageLoader::ImageData> BuildReference(ImageLoader::ImageData base,
+                                                   const Settings& settings = Settings());
+
+} // namespace MipGenerator
+} // namespace ShadowEngine
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "core/MappedFile.hpp"
+
+namespace ShadowEngine {
+
+// Asset pack (.shpk). Little-endian layout:
+//
+//   FileHeader                      32 bytes
+//   IndexEntry[entryCount]          40 bytes each, sorted by path hash
+//   path strings                    not terminated, referenced by the index
+//   entry payloads                  each 16-byte aligned; stored, or LZ4 blocks
+//
+// The index is searched in place in the mapping: a binary search on the
+// 64-bit path hash, then the stored path is compared to rule out collisions.
+class PackFile {
+public:
+    static constexpr uint32_t Magic = 0x4B504853;  // "SHPK"
+    static constexpr uint32_t Version = 1;
+
+    enum EntryFlags : uint16_t {
+        FlagLz4 = 1u << 0  // Payload is an LZ4 block that expands to size bytes
+    };
+
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t reserved;
+        uint64_t stringsOffset;  // From the start of the file
+        uint64_t stringsSize;
+    };
+
+    struct IndexEntry {
+        uint64_t hash;        // HashPath of the entry's path
+        uint64_t offset;      // Payload, from the start of the file
+        uint64_t storedSize;  // Payload bytes in the pack
+        uint64_t size;        // Bytes once decompressed
+        uint32_t pathOffset;  // From the start of the strings
+        uint16_t pathLength;
+        uint16_t flags;
+    };
+
+    struct Entry {
+        std::string_view path;
+        const uint8_t* data = nullptr;  // Into the mapping
+        size_t storedSize = 0;
+        size_t size = 0;
+        bool compressed = false;
+    };
+
+    // A file to write into a pack
+    struct Source {
+        std::string path;
+        std::vector<uint8_t> data;
+    };
+
+    PackFile() = default;
+
+    // Map and validate a pack
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const { return m_File.IsOpen(); }
+    const std::string& GetPath() const { return m_File.GetPath(); }
+
+    // Look up an entry by its normalized path
+    bool Find(std::string_view path, Entry& out) const;
+
+    size_t GetEntryCount() const { return m_EntryCount; }
+    Entry GetEntry(size_t index) const;
+
+    // FNV-1a over the path bytes
+    static uint64_t HashPath(std::string_view path);
+
+    // Write a pack. With compress, each entry is stored as an LZ4 block when
+    // that saves at least an eighth of its size, and uncompressed otherwise.
+    static bool Write(const std::string& path, const std::vector<Source>& files, bool compress);
+
+private:
+    MappedFile m_File;
+    const uint8_t* m_Index = nullptr;
+    const char* m_Strings = nullptr;
+    size_t m_EntryCount = 0;
+};
+
+} // namespace ShadowEngine
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "core/ImageLoader.hpp"
+
+namespace ShadowEngine {
+
+class JobSystem;
+
+// Converts RGBA8 pixels to and from the uncompressed GPU formats the cooker
+// and uploads can use instead of RGBA8. Values are unsigned normalized:
+// RGBA16F holds 0..1, RGB565 drops alpha and rounds to the nearest step.
+// The conversions use SSE2 where the compiler targets it; the Reference forms
+// are plain scalar code that give bit-identical results.
+namespace PixelConversion {
+
+enum class Format : uint8_t {
+    RGBA8,
+    RGBA16F,  // Four IEEE half floats
+    RGB565    // Red in the top 5 bits, blue in the bottom 5
+};
+
+size_t GetBytesPerPixel(Format format);
+const char* GetFormatName(Format format);
+
+void Rgba8ToRgba16F(const uint8_t* src, uint16_t* dst, size_t pixelCount);
+void Rgba16FToRgba8(const uint16_t* src, uint8_t* dst, size_t pixelCount);  // Clamped to 0..1; NaN becomes 0
+void Rgba8ToRgb565(const uint8_t* src, uint16_t* dst, size_t pixelCount);
+void Rgb565ToRgba8(const uint16_t* src, uint8_t* dst, size_t pixelCount);   // Alpha is 255
+
+void Rgba8ToRgba16FReference(const uint8_t* src, uint16_t* dst, size_t pixelCount);
+void Rgba16FToRgba8Reference(const uint16_t* src, uint8_t* dst, size_t pixelCount);
+void Rgba8ToRgb565Reference(const uint8_t* src, uint16_t* dst, size_t pixelCount);
+void Rgb565ToRgba8Reference(const uint16_t* src, uint8_t* dst, size_t pixelCount);
+
+// Convert every level of an RGBA8 mip chain to format, e.g. before streaming
+// it. out gets one tightly packed buffer per level. All levels are cut into
+// chunks together and spread over the job system, so small levels don't
+// leave threads idle; jobs may be null.
+void ConvertLevels(const std::vector<ImageLoader::ImageData>& levels, Format format,
+                   std::vector<ImageLoader::PixelBuffer>& out, JobSystem* jobs = nullptr);
+
+} // namespace PixelConversion
+} // namespace ShadowEngine
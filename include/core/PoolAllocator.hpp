@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace ShadowEngine {
+
+// Fixed-size block allocator for objects that are created and destroyed
+// often, such as jobs or per-frame nodes. Free blocks form an intrusive list,
+// so Allocate and Free are a pointer swap. Blocks come from chunks that are
+// never returned to the heap while the pool lives; once the pool has grown to
+// its working set it stops allocating.
+//
+// As a std::pmr::memory_resource, requests that do not fit a block (too big
+// or over-aligned) go to the upstream resource. Not thread-safe; guard shared
+// pools externally.
+class PoolAllocator : public std::pmr::memory_resource {
+public:
+    struct Stats {
+        size_t blockSize = 0;
+        size_t capacity = 0;  // Blocks in all chunks
+        size_t inUse = 0;
+        size_t peakInUse = 0;
+        size_t chunks = 0;
+    };
+
+    PoolAllocator(size_t blockSize, size_t blocksPerChunk = 256,
+                  std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    ~PoolAllocator() override;
+
+    // Prevent copying
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+    // One block of GetBlockSize() bytes, aligned to GetBlockAlignment()
+    void* Allocate();
+    void Free(void* block);
+
+    // Pre-grow so the first blockCount allocations take no new chunk
+    void Reserve(size_t blockCount);
+
+    size_t GetBlockSize() const { return m_BlockSize; }
+    size_t GetBlockAlignment() const { return alignof(std::max_align_t); }
+    Stats GetStats() const;
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* memory, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    void AddChunk();
+
+    size_t m_BlockSize;
+    size_t m_BlocksPerChunk;
+    std::pmr::memory_resource* m_Upstream;
+    std::vector<std::unique_ptr<unsigned char[]>> m_Chunks;
+    FreeBlock* m_FreeList;
+    size_t m_InUse;
+    size_t m_PeakInUse;
+};
+
+} // namespace ShadowEngine
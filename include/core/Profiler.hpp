@@ -0,0 +1,153 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Zones are compiled into debug builds, and into release builds only when
+// SHADOW_ENABLE_PROFILER is defined (CMake option of the same name). Compiled
+// out, the macros expand to nothing and cost nothing.
+#if defined(SHADOW_ENABLE_PROFILER) || !defined(NDEBUG)
+#define SHADOW_PROFILER_ENABLED 1
+#else
+#define SHADOW_PROFILER_ENABLED 0
+#endif
+
+namespace ShadowEngine {
+
+// Instrumentation profiler. Scoped zones record begin/end timestamps into a
+// ring buffer owned by the calling thread, so recording takes no locks and
+// never allocates after a thread's first zone. Nothing is recorded until
+// Start, and a thread's ring is only allocated by its first zone while
+// capturing. Rings of exited threads are handed to new threads once they hold
+// nothing from the current capture. WriteChromeTrace exports every thread's
+// zones as Chrome trace JSON (chrome://tracing, ui.perfetto.dev).
+//
+//   SHADOW_PROFILE_ZONE("Cull");         // Until the end of the enclosing scope
+//   SHADOW_PROFILE_FUNCTION();           // Zone named after the function
+//   SHADOW_PROFILE_THREAD("Render");     // Label this thread in the trace
+//
+// Zone and thread names must be string literals (or otherwise outlive the
+// export): only the pointer is stored.
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Per-thread ring size; once full, the oldest zones are overwritten
+    static constexpr size_t EventsPerThread = 1 << 16;
+
+    struct Stats {
+        uint64_t recorded = 0;
+        uint64_t overwritten = 0;
+        unsigned threads = 0;
+    };
+
+    static Profiler& Get();
+
+    static constexpr bool IsCompiledIn() { return SHADOW_PROFILER_ENABLED != 0; }
+
+    // Begin recording, discarding anything recorded before
+    void Start();
+    void Stop();
+    bool IsCapturing() const { return m_Capturing.load(std::memory_order_relaxed); }
+
+    // Write the recorded zones as Chrome trace JSON. Call after Stop, once the
+    // instrumented threads are idle; a thread still recording may overwrite
+    // zones while they are read.
+    bool WriteChromeTrace(const std::string& path) const;
+
+    Stats GetStats() const;
+
+    // Name the calling thread in exported traces
+    void SetThreadName(const char* name);
+
+    // Nanoseconds since the profiler was created
+    uint64_t Now() const {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_Epoch).count());
+    }
+
+    void Record(const char* name, uint64_t begin, uint64_t end);
+
+private:
+    struct Event {
+        const char* name;
+        uint64_t begin;
+        uint64_t end;
+    };
+
+    // Written only by its thread; the head is published with release so a
+    // reader sees every event before it
+    struct ThreadBuffer {
+        std::vector<Event> events;            // Empty until the thread records
+        std::atomic<uint64_t> head{0};
+        std::atomic<uint64_t> generation{0};  // Capture the events belong to
+        const char* name = nullptr;
+        uint32_t id = 0;
+        bool retired = false;                 // Its thread exited; guarded by m_ThreadsMutex
+    };
+
+    // Hands the calling thread's buffer back when the thread exits
+    struct ThreadBufferOwner {
+        ThreadBuffer* buffer = nullptr;
+        ~ThreadBufferOwner();
+    };
+
+    Profiler();
+
+    ThreadBuffer& GetThreadBuffer();
+    ThreadBuffer& AcquireThreadBuffer();
+
+    Clock::time_point m_Epoch;
+    std::atomic<bool> m_Capturing;
+    std::atomic<uint64_t> m_Generation;  // Bumped by Start so stale rings read as empty
+
+    mutable std::mutex m_ThreadsMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_Threads;
+};
+
+// Records one zone from construction to destruction, if capturing began first
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name)
+        : m_Name(name)
+        , m_Begin(Profiler::Get().IsCapturing() ? Profiler::Get().Now() : NotCapturing) {
+    }
+
+    ~ProfileZone() {
+        if (m_Begin != NotCapturing) {
+            Profiler& profiler = Profiler::Get();
+            profiler.Record(m_Name, m_Begin, profiler.Now());
+        }
+    }
+
+    // Prevent copying
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    static constexpr uint64_t NotCapturing = ~uint64_t(0);
+
+    const char* m_Name;
+    uint64_t m_Begin;
+};
+
+} // namespace ShadowEngine
+
+#define SHADOW_PROFILE_CONCAT_INNER(a, b) a##b
+#define SHADOW_PROFILE_CONCAT(a, b) SHADOW_PROFILE_CONCAT_INNER(a, b)
+
+#if SHADOW_PROFILER_ENABLED
+#define SHADOW_PROFILE_ZONE(name) \
+    ::ShadowEngine::ProfileZone SHADOW_PROFILE_CONCAT(shadowProfileZone, __LINE__)(name)
+#define SHADOW_PROFILE_FUNCTION() SHADOW_PROFILE_ZONE(__func__)
+#define SHADOW_PROFILE_THREAD(name) ::ShadowEngine::Profiler::Get().SetThreadName(name)
+#else
+#define SHADOW_PROFILE_ZONE(name) ((void)0)
+#define SHADOW_PROFILE_FUNCTION() ((void)0)
+#define SHADOW_PROFILE_THREAD(name) ((void)0)
+#endif
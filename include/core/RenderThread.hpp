@@ -0,0 +1,62 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace ShadowEngine {
+
+// Dedicated thread that owns the GL context while the engine runs pipelined.
+// The frame function is fixed at Start; Kick runs it once on the thread while
+// the caller goes on simulating the next frame. At most one frame is in
+// flight: Kick waits for the previous one, and Wait blocks until it is done.
+// The mutex hand-off orders everything the caller wrote before Kick ahead of
+// the frame, and everything the frame wrote ahead of Wait returning.
+class RenderThread {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    RenderThread();
+    ~RenderThread();
+
+    // Prevent copying
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    // onStart runs first on the new thread (make the context current there),
+    // onStop last (release it so the caller can take it back)
+    void Start(std::function<void()> onStart, std::function<void()> frame, std::function<void()> onStop);
+
+    // Finish the frame in flight, run onStop and join
+    void Stop();
+
+    void Kick();
+    void Wait();
+
+    bool IsRunning() const { return m_Thread.joinable(); }
+
+    // Frames run, time the thread spent running them, and time the caller
+    // spent in Wait. Read after Stop.
+    uint64_t GetFrameCount() const { return m_FrameCount; }
+    double GetBusyMs() const { return m_BusyMs; }
+    double GetWaitMs() const { return m_WaitMs; }
+
+private:
+    void ThreadLoop(std::function<void()> onStart, std::function<void()> onStop);
+
+    std::thread m_Thread;
+    std::function<void()> m_Frame;
+    std::mutex m_Mutex;
+    std::condition_variable m_Wake;
+    std::condition_variable m_Done;
+    bool m_Pending;
+    bool m_Quit;
+    uint64_t m_FrameCount;
+    double m_BusyMs;
+    double m_WaitMs;
+};
+
+} // namespace ShadowEngine
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "core/FrameStatistics.hpp"
+
+namespace ShadowEngine {
+
+class JobSystem;
+
+// One unit of per-frame work. Resources are free-form names for the data a
+// system touches ("Input", "Scene", ...); they are only used to find conflicts.
+struct SystemDesc {
+    std::string name;
+    std::function<void()> run;
+    std::vector<std::string> reads;
+    std::vector<std::string> writes;
+    std::vector<std::string> after;   // Registered systems that must finish first
+    std::vector<std::string> before;  // Registered systems that must wait for this one
+    bool mainThread = false;          // Run on the thread calling Run (GLFW, GL, the frame allocator)
+};
+
+// Runs the registered systems once per frame as a dependency graph. Edges come
+// from the after/before constraints; systems with no path between them run at
+// the same time, on the job system or, for main-thread systems, on the caller.
+//
+// Registration rejects a system whose access conflicts with a system it is not
+// ordered against (one writes what the other reads or writes), so two systems
+// that share data always run in a fixed order and never race.
+//
+// Every frame records each system's time and the critical path: the longest
+// chain of dependent systems, which bounds the frame however many workers
+// there are.
+class SystemScheduler {
+public:
+    struct FrameStats {
+        double wallMs = 0.0;          // Run, start to finish
+        double workMs = 0.0;          // Sum over systems
+        double criticalPathMs = 0.0;  // Longest dependent chain
+    };
+
+    SystemScheduler();
+    ~SystemScheduler();
+
+    // Prevent copying
+    SystemScheduler(const SystemScheduler&) = delete;
+    SystemScheduler& operator=(const SystemScheduler&) = delete;
+
+    // Constraints may only name systems registered earlier. False, with the
+    // reason logged, if the name is taken, a constraint names an unknown
+    // system, the constraints form a cycle or the access conflicts. Not to be
+    // called while Run is executing.
+    bool Register(SystemDesc desc);
+
+    bool HasSystem(const std::string& name) const { return FindSystem(name) >= 0; }
+    size_t GetSystemCount() const { return m_Systems.size(); }
+
+    // Run every system once and return when all have finished. Without a job
+    // system, or one without workers, they run in order on this thread.
+    void Run(JobSystem* jobs);
+
+    const FrameStats& GetLastFrame() const { return m_LastFrame; }
+    const FrameStatistics& GetCriticalPath() const { return m_CriticalPath; }
+
+    // Forget the frames recorded so far (warmup); not while Run is executing
+    void ResetStats();
+
+    // Critical path distribution, then each system's mean time and how often
+    // it was on the critical path
+    void Print(std::ostream& out) const;
+
+private:
+    struct System;
+
+    int FindSystem(const std::string& name) const;
+    uint32_t GetResource(const std::string& name);
+    bool Reaches(uint32_t from, uint32_t to) const;
+    int FindConflict(const System& a, const System& b) const;  // Shared resource id, or -1
+    void Sort();
+    void Dispatch(uint32_t index);
+    void Execute(uint32_t index);
+    void RecordFrame(double wallMs);
+
+    std::vector<std::unique_ptr<System>> m_Systems;  // Not moved: the profiler keeps name pointers
+    std::vector<std::string> m_Resources;            // Indexed by resource id
+    std::vector<uint32_t> m_Order;                   // Topological, rebuilt after registration
+    bool m_Sorted;
+
+    // Current Run; m_Jobs is null when it runs serially. Main-thread systems
+    // that became ready on a worker wait in m_MainReady for the caller.
+    JobSystem* m_Jobs;
+    std::chrono::steady_clock::time_point m_FrameStart;
+    std::atomic<size_t> m_Remaining;
+    std::mutex m_MainMutex;
+    std::vector<uint32_t> m_MainReady;
+
+    FrameStats m_LastFrame;
+    FrameStatistics m_CriticalPath;
+    uint64_t m_Frames;
+    double m_TotalWallMs;
+    double m_TotalWorkMs;
+};
+
+} // namespace ShadowEngine
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "core/MappedFile.hpp"
+
+namespace ShadowEngine {
+
+class PackFile;
+
+// Resolves asset paths ("shaders/basic.vert") against mounted packs and loose
+// files relative to the working directory.
+//
+// Packs are mapped once at mount; reading an entry stored uncompressed hands
+// out a view into the mapping with no copy, and LZ4 entries are decompressed
+// into a buffer owned by the returned File. Loose files are mapped one by one.
+//
+// With loose overrides on (the default in debug builds) a loose file shadows a
+// pack entry of the same path, so assets can be edited without rebuilding
+// packs. Off, packs are searched first and loose files only fill the paths no
+// pack contains.
+//
+// Mount and configure before loading anything; reads are then safe from any
+// thread.
+class VirtualFileSystem {
+public:
+    // Contents of one file, valid until destroyed or the pack it came from is
+    // unmounted
+    class File {
+    public:
+        File() = default;
+
+        // Prevent copying
+        File(const File&) = delete;
+        File& operator=(const File&) = delete;
+
+        File(File&& other) noexcept;
+        File& operator=(File&& other) noexcept;
+
+        const uint8_t* GetData() const { return m_Data; }
+        size_t GetSize() const { return m_Size; }
+        std::string_view GetText() const { return std::string_view(reinterpret_cast<const char*>(m_Data), m_Size); }
+
+    private:
+        friend class VirtualFileSystem;
+
+        const uint8_t* m_Data = nullptr;
+        size_t m_Size = 0;
+        std::vector<uint8_t> m_Buffer;  // Decompressed entries
+        MappedFile m_Mapping;           // Loose files
+    };
+
+    struct Stats {
+        uint64_t packReads = 0;
+        uint64_t looseReads = 0;
+        uint64_t decompressedBytes = 0;
+    };
+
+    static VirtualFileSystem& Get();
+
+    // Mount a pack; packs mounted later take precedence over earlier ones
+    bool Mount(const std::string& packPath);
+    void UnmountAll();
+    size_t GetMountCount() const { return m_Packs.size(); }
+
+    void SetLooseOverrides(bool enabled) { m_LooseOverrides = enabled; }
+    bool GetLooseOverrides() const { return m_LooseOverrides; }
+
+    bool Exists(const std::string& path) const;
+
+    // Read a whole file. Fails quietly when the path does not exist anywhere;
+    // callers report it.
+    bool Read(const std::string& path, File& out) const;
+
+    Stats GetStats() const;
+
+    // Forward slashes, no leading "./"
+    static std::string NormalizePath(const std::string& path);
+
+private:
+    VirtualFileSystem();
+    ~VirtualFileSystem();
+
+    bool ReadFromPacks(const std::string& path, File& out) const;
+    bool ReadLoose(const std::string& path, File& out) const;
+    static bool IsLooseFile(const std::string& path);
+
+    std::vector<std::unique_ptr<PackFile>> m_Packs;
+    bool m_LooseOverrides;
+
+    mutable std::atomic<uint64_t> m_PackReads;
+    mutable std::atomic<uint64_t> m_LooseReads;
+    mutable std::atomic<uint64_t> m_DecompressedBytes;
+};
+
+} // namespace ShadowEngine
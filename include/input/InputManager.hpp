@@ -1,13 +1,19 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 #include <functional>
 #include <vector>
 #include <string>
+#include <utility>
 #include <GLFW/glfw3.h>
 
 namespace ShadowEngine {
+
+class EventBus;
+
 namespace Input {
 
 // Forward declarations
@@ -137,12 +143,13 @@ enum class GamepadAxis {
     RightTrigger = GLFW_GAMEPAD_AXIS_RIGHT_TRIGGER
 };
 
-// Input state tracking
+// Input state tracking. Fixed arrays indexed by GLFW code, so the per-frame
+// copy into the previous state never touches the heap.
 struct InputState {
-    std::unordered_map<int, bool> keyStates;
-    std::unordered_map<int, bool> mouseButtonStates;
-    std::unordered_map<int, bool> gamepadButtonStates;
-    std::unordered_map<int, float> gamepadAxisStates;
+    std::array<bool, GLFW_KEY_LAST + 1> keyStates{};
+    std::array<bool, GLFW_MOUSE_BUTTON_LAST + 1> mouseButtonStates{};
+    std::array<bool, GLFW_GAMEPAD_BUTTON_LAST + 1> gamepadButtonStates{};
+    std::array<float, GLFW_GAMEPAD_AXIS_LAST + 1> gamepadAxisStates{};
     
     double mouseX = 0.0;
     double mouseY = 0.0;
@@ -185,6 +192,7 @@ struct InputMapping {
 
 // Event callback type
 using InputEventCallback = std::function<void(const InputEvent&)>;
+using InputCallbackId = uint32_t;  // Zero is never issued
 
 class InputManager {
 public:
@@ -197,9 +205,14 @@ public:
     // Update input state (call once per frame)
     void Update();
     
-    // Event handling
-    void AddEventCallback(EventType type, InputEventCallback callback);
-    void RemoveEventCallback(EventType type, InputEventCallback callback);
+    // Events are posted from the GLFW callbacks and delivered to the
+    // callbacks below when the bus dispatches (once per frame, on the main
+    // thread). Without a bus they are delivered from the GLFW callbacks.
+    void SetEventBus(EventBus* events);
+
+    // Event handling. Callbacks must not be added or removed from inside one.
+    InputCallbackId AddEventCallback(EventType type, InputEventCallback callback);
+    void RemoveEventCallback(EventType type, InputCallbackId id);
     
     // Input state queries
     bool IsKeyPressed(KeyCode key) const;
@@ -238,7 +251,11 @@ private:
     InputState m_CurrentState;
     InputState m_PreviousState;
     
-    std::vector<InputEventCallback> m_EventCallbacks[static_cast<int>(EventType::GamepadAxisMoved) + 1];
+    EventBus* m_EventBus;
+    uint32_t m_EventSubscription;
+    InputCallbackId m_NextCallbackId;
+    std::vector<std::pair<InputCallbackId, InputEventCallback>>
+        m_EventCallbacks[static_cast<int>(EventType::GamepadAxisMoved) + 1];
     std::unordered_map<std::string, InputMapping> m_InputMappings;
     
     // GLFW callback functions
@@ -249,6 +266,7 @@ private:
     static void GamepadCallback(int gamepadId, int event);
     
     // Helper functions
+    void PostEvent(const InputEvent& event);
     void ProcessEvent(const InputEvent& event);
     void UpdateGamepadStates();
 };
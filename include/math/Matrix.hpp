@@ -45,5 +45,10 @@ Matrix4 CreateTranslation(float x, float y, float z);
 Matrix4 CreateRotation(float angle, float x, float y, float z);
 Matrix4 CreateScale(float x, float y, float z);
 
+// Blend two translate-rotate-scale transforms: translation and scale are
+// interpolated linearly, rotation spherically. Shears are not preserved.
+// Used to draw fixed-step simulation state between two steps.
+Matrix4 InterpolateTransforms(const Matrix4& from, const Matrix4& to, float alpha);
+
 } // namespace Math
 } // namespace ShadowEngine 
\ No newline at end of file
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+#include "core/FrameStatistics.hpp"
+#include "core/JobSystem.hpp"
+#include "core/PixelConversion.hpp"
+
+namespace ShadowEngine {
+
+class EventBus;
+
+namespace Rendering {
+
+class Shader;
+class Mesh;
+class Material;
+class Texture;
+class TextureStreamer;
+class ResourceCache;
+
+enum class AssetPriority : uint8_t {
+    Low,
+    Normal,
+    High
+};
+
+enum class AssetState : uint8_t {
+    Queued,        // Waiting for the I/O thread
+    Reading,
+    Decoding,
+    Waiting,       // Material whose textures and shader are still loading
+    Uploading,     // Decoded, waiting for the GL thread
+    Ready,
+    Failed,
+    Cancelled,
+    Released       // Results handed back with Release
+};
+
+// Refers to one load request. Id zero is never issued. Ids of released
+// requests are reused; the generation tells the requests sharing an id apart,
+// so a handle kept past Release never resolves to a later request.
+struct AssetHandle {
+    uint32_t id = 0;
+    uint32_t generation = 0;
+
+    bool IsValid() const { return id != 0; }
+    bool operator==(const AssetHandle& other) const { return id == other.id && generation == other.generation; }
+    bool operator!=(const AssetHandle& other) const { return !(*this == other); }
+};
+
+// Posted when a request reaches Ready, Failed or Cancelled, from whichever
+// thread got it there
+struct AssetEvent {
+    AssetHandle handle;
+    AssetState state;
+};
+
+// Loads assets in the background. Requests return a handle at once; the file
+// is read on a dedicated I/O thread, decoded or parsed on the job system's
+// workers, and the GPU objects are created by ProcessUploads on the thread that
+// owns the GL context, under a per-frame time budget. Every queue is ordered by
+// priority, then by request order.
+//
+// A material is loaded after its shader and textures: it stays Waiting until
+// they are Ready, fails if any of them fails, and cancelling it cancels them.
+//
+// Requests, state queries and results are safe from any thread.
+class AssetManager {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Stats {
+        size_t queuedReads = 0;    // Queue depths
+        size_t decoding = 0;
+        size_t waiting = 0;
+        size_t queuedUploads = 0;
+        uint64_t ready = 0;        // Totals
+        uint64_t failed = 0;
+        uint64_t cancelled = 0;
+        uint64_t released = 0;
+        int lastFrameUploads = 0;
+        double lastFrameUploadMilliseconds = 0.0;
+    };
+
+    // Shaders and meshes come from cache, so identical content is shared with
+    // everything else that uses it. hasContext false (null backend): textures
+    // are Ready but null, as with RenderSystem::CreateTexture. jobs may be null
+    // or have no workers; decoding then runs on the I/O thread.
+    AssetManager(JobSystem* jobs, TextureStreamer* streamer, ResourceCache* cache, bool hasContext);
+    ~AssetManager();
+
+    // Prevent copying
+    AssetManager(const AssetManager&) = delete;
+    AssetManager& operator=(const AssetManager&) = delete;
+
+    // Image (PNG, JPEG, ...) streamed through the TextureStreamer, or a cooked
+    // .shtx container
+    AssetHandle LoadTexture(const std::string& path, AssetPriority priority = AssetPriority::Normal);
+    AssetHandle LoadShader(const std::string& vertexPath, const std::string& fragmentPath,
+                           AssetPriority priority = AssetPriority::Normal);
+
+    // Wavefront OBJ: positions with optional per-vertex colours ("v x y z r g b"),
+    // polygonal faces triangulated as fans
+    AssetHandle LoadMesh(const std::string& path, AssetPriority priority = AssetPriority::Normal);
+
+    // .shmat text file, one directive per line, '#' starts a comment:
+    //   shader shaders/basic.vert shaders/basic.frag
+    //   texture assets/albedo.png      (bound to unit 0, the next to unit 1, ...)
+    AssetHandle LoadMaterial(const std::string& path, AssetPriority priority = AssetPriority::Normal);
+
+    // Drop a request that has not completed; its data is discarded at the next
+    // stage it reaches
+    void Cancel(AssetHandle handle);
+
+    // Drop the manager's references to a request's results (a material's
+    // dependencies included); the handle no longer resolves and its id goes
+    // back to be reused once no stage is working on the request. The objects
+    // live on while callers hold them. Requests not yet Ready are cancelled.
+    void Release(AssetHandle handle);
+
+    // Released for handles released earlier, Failed for handles this manager
+    // did not issue
+    AssetState GetState(AssetHandle handle) const;
+
+    // Results, null until the request is Ready
+    std::shared_ptr<Texture> GetTexture(AssetHandle handle) const;
+    std::shared_ptr<Shader> GetShader(AssetHandle handle) const;
+    std::shared_ptr<Mesh> GetMesh(AssetHandle handle) const;
+    std::shared_ptr<Material> GetMaterial(AssetHandle handle) const;
+
+    // Milliseconds ProcessUploads may spend per call; at least one upload is
+    // always made so a large asset cannot stall the queue forever
+    void SetUploadBudget(double milliseconds) { m_UploadBudgetMilliseconds.store(milliseconds, std::memory_order_relaxed); }
+    double GetUploadBudget() const { return m_UploadBudgetMilliseconds.load(std::memory_order_relaxed); }
+
+    // Format textures without any transparency are streamed in (RGBA8 by
+    // default). RGB565 halves their GPU memory; textures with alpha stay RGBA8.
+    void SetOpaqueTextureFormat(PixelConversion::Format format) { m_OpaqueTextureFormat.store(format, std::memory_order_relaxed); }
+    PixelConversion::Format GetOpaqueTextureFormat() const { return m_OpaqueTextureFormat.load(std::memory_order_relaxed); }
+
+    // Post an AssetEvent here whenever a request finishes; null stops them
+    void SetEventBus(EventBus* events);
+
+    // Create GPU objects for decoded assets (call once per frame on the GL thread)
+    void ProcessUploads();
+
+    // True once no request is still loading
+    bool IsIdle() const;
+
+    Stats GetStats() const;
+
+    // Totals and the request-to-ready latency distribution; prints nothing
+    // when no asset was requested
+    void PrintSummary(std::ostream& out) const;
+
+private:
+    struct Record;
+
+    struct QueueEntry {
+        AssetPriority priority;
+        uint64_t sequence;
+        AssetHandle handle;  // Stale once the request is released; skipped then
+
+        bool operator<(const QueueEntry& other) const {
+            // Highest priority first, then oldest first
+            return priority != other.priority ? priority < other.priority : sequence > other.sequence;
+        }
+    };
+
+    static constexpr size_t StateCount = static_cast<size_t>(AssetState::Released) + 1;
+
+    // All of these expect m_Mutex to be held
+    AssetHandle Enqueue(std::unique_ptr<Record> record);
+    Record* Find(AssetHandle handle) const;
+    void SetState(Record& record, AssetState state);
+    void Fail(Record& record, const std::string& reason);
+    void CancelRecord(Record& record);
+    void ReleaseRecord(Record& record);
+    void Retire(Record& record);
+    void Complete(Record& record);
+    bool AssembleMaterial(Record& record);
+
+    // Stages. Each works on its record outside the lock; a request cancelled
+    // meanwhile is noticed when the stage hands the record on.
+    void IoLoop();
+    bool Read(Record& record, std::string& error);
+    void Decode(Record& record);
+    bool DecodeRecord(Record& record, std::string& error);
+    bool Upload(Record& record);
+
+    JobSystem* m_Jobs;
+    TextureStreamer* m_Streamer;
+    ResourceCache* m_Cache;
+    bool m_HasContext;
+    EventBus* m_Events;  // Guarded by m_Mutex
+    std::atomic<double> m_UploadBudgetMilliseconds;
+    std::atomic<PixelConversion::Format> m_OpaqueTextureFormat;
+
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_ReadAvailable;
+    std::vector<std::unique_ptr<Record>> m_Records;  // Indexed by id - 1; null once retired
+    std::vector<uint32_t> m_Generations;             // Latest generation issued for each id
+    std::vector<uint32_t> m_FreeIds;                 // Retired ids, reused before new ones
+    uint64_t m_Requested;
+    std::priority_queue<QueueEntry> m_ReadQueue;
+    std::priority_queue<QueueEntry> m_UploadQueue;
+    uint64_t m_NextSequence;
+    size_t m_StateCounts[StateCount];  // Requests in each state; retired ones stay counted
+    int m_LastFrameUploads;
+    double m_LastFrameUploadMilliseconds;
+    FrameStatistics m_Latency;  // Milliseconds from request to Ready
+    bool m_Quit;
+
+    JobCounter m_DecodeJobs;
+    std::thread m_IoThread;
+};
+
+} // namespace Rendering
+} // namespace ShadowEngine
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace ShadowEngine {
+namespace Rendering {
+
+// Picks the scene render scale from measured GPU frame times. Cost is taken to
+// be proportional to pixel count (scale squared). A hysteresis band around the
+// budget keeps the scale steady: it drops at once when the frame is over
+// budget, but only rises after a sustained run of cheap frames. After each
+// change, the controller waits for timer results rendered at the new scale
+// before reacting again.
+class DynamicResolution {
+public:
+    struct Settings {
+        double targetFrameMs = 16.0;     // GPU budget per frame
+        float minScale = 0.5f;           // Per-axis bounds
+        float maxScale = 1.0f;
+        double overBudget = 1.05;        // Shrink when smoothed time exceeds target * this
+        double underBudget = 0.80;       // Grow when it stays below target * this ...
+        int growDelayFrames = 30;        // ... for this many consecutive frames
+        float maxGrowStep = 0.05f;       // Largest per-change increase
+        int settleFrames = 6;            // Frames ignored after a change (timer latency)
+        double smoothing = 0.2;          // Exponential moving average weight
+        size_t historyLength = 600;      // Samples kept for GetHistorySample
+    };
+
+    struct Sample {
+        uint64_t frame;
+        float gpuMs;
+        float smoothedMs;
+        float scale;
+    };
+
+    DynamicResolution();
+    explicit DynamicResolution(const Settings& settings);
+
+    // Feed one GPU frame time; returns true if the scale changed
+    bool Update(double gpuMilliseconds);
+
+    float GetScale() const { return m_Scale; }
+    const Settings& GetSettings() const { return m_Settings; }
+
+    // The last historyLength samples, oldest at index 0. Kept in a ring
+    // allocated up front, so recording never touches the heap.
+    size_t GetHistorySize() const { return m_HistorySize; }
+    const Sample& GetHistorySample(size_t index) const {
+        return m_History[(m_HistoryStart + index) % m_History.size()];
+    }
+
+    uint64_t GetChangeCount() const { return m_ChangeCount; }
+
+    // Scale range and change count since construction or the last ResetStats
+    void PrintSummary(std::ostream& out) const;
+    void ResetStats();  // The controller and its history are kept
+
+private:
+    void SetScale(float scale, double gpuMilliseconds);
+
+    Settings m_Settings;
+    float m_Scale;
+    double m_SmoothedMs;
+    int m_CheapFrames;
+    int m_SettleFrames;
+    uint64_t m_Frame;
+    uint64_t m_StatsStartFrame;  // m_Frame at the last ResetStats
+    uint64_t m_ChangeCount;
+    double m_ScaleSum;
+    float m_LowestScale;
+    std::vector<Sample> m_History;  // historyLength entries
+    size_t m_HistoryStart;          // Oldest sample
+    size_t m_HistorySize;
+};
+
+} // namespace Rendering
+} // namespace ShadowEngine
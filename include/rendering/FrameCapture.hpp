@@ -0,0 +1,125 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <glad/glad.h>
+
+namespace ShadowEngine {
+namespace Rendering {
+
+struct RenderTarget;
+
+// Captures rendered frames without stalling the frame loop. Each frame is read
+// into one of a ring of pixel-pack buffers and fenced. Buffers whose fence has
+// passed are mapped a frame or more later, once the copy is done, and handed
+// to a writer thread that encodes and writes them. Nothing ever blocks on the
+// GPU or the disk. When every buffer is still in flight, or the writer has
+// fallen too far behind, the frame is dropped and counted instead.
+//
+//   PNG - one frame_NNNNNN.png per frame, numbered by engine frame so dropped
+//         frames leave gaps (stored deflate, cheap to encode)
+//   Raw - top-down RGBA8 frames appended to frames_FIRST_WxH.rgba, e.g. for
+//         ffmpeg -f rawvideo -pix_fmt rgba -s WxH -i frames_FIRST_WxH.rgba
+class FrameCapture {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Format { PNG, Raw };
+
+    struct Settings {
+        std::string directory = "capture";
+        Format format = Format::PNG;
+        int frameInterval = 1;     // Capture every Nth frame
+        int readbackSlots = 3;     // Pixel-pack buffers in flight
+        int maxQueuedFrames = 8;   // Frames waiting for the writer before new ones are dropped
+    };
+
+    struct Stats {
+        uint64_t captured = 0;          // Readbacks issued
+        uint64_t written = 0;
+        uint64_t droppedReadback = 0;   // Every buffer was still in flight
+        uint64_t droppedWriter = 0;     // Writer queue full
+        uint64_t bytesRead = 0;
+        uint64_t bytesWritten = 0;
+        double writeSeconds = 0.0;      // Writer thread time spent encoding and writing
+        double elapsedSeconds = 0.0;    // Since the first capture
+    };
+
+    // "png" or "raw"
+    static const char* GetFormatName(Format format);
+    static bool ParseFormat(const std::string& name, Format& outFormat);
+
+    FrameCapture();
+    ~FrameCapture();
+
+    // Prevent copying
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    // Creates the output directory, the readback buffers and the writer thread.
+    // Needs a current GL context.
+    bool Initialize(const Settings& settings);
+
+    // Waits for outstanding readbacks and writes, then releases everything
+    void Shutdown();
+
+    // Call once per frame after the frame is complete in source: starts its
+    // readback and forwards finished ones to the writer. frame is the engine's
+    // frame index; frameInterval counts in it, and files are named by it.
+    void Capture(const RenderTarget& source, uint64_t frame);
+
+    Stats GetStats() const;
+    void PrintSummary(std::ostream& out) const;
+
+private:
+    struct Slot {
+        GLuint buffer = 0;
+        size_t capacity = 0;
+        GLsync fence = nullptr;
+        uint64_t frame = 0;     // Engine frame index
+        int width = 0;
+        int height = 0;
+    };
+
+    struct Job {
+        std::vector<unsigned char> pixels;  // Bottom-up RGBA8, as read back
+        uint64_t frame = 0;
+        int width = 0;
+        int height = 0;
+    };
+
+    void Retire(bool wait);
+    void WriterLoop();
+    bool WriteJob(Job& job, std::vector<unsigned char>& encoded);
+
+    Settings m_Settings;
+    std::vector<Slot> m_Slots;
+    size_t m_NextSlot;      // Next slot to issue into; also the oldest in flight
+    Clock::time_point m_FirstCapture;
+    bool m_IsInitialized;
+
+    // Writer thread state, guarded by m_Mutex
+    std::thread m_Writer;
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_WorkAvailable;
+    std::deque<Job> m_Jobs;
+    std::vector<std::vector<unsigned char>> m_FreeBuffers;
+    bool m_Quit;
+    Stats m_Stats;
+
+    // Raw sequence output, owned by the writer thread
+    std::ofstream m_RawFile;
+    int m_RawWidth;
+    int m_RawHeight;
+};
+
+} // namespace Rendering
+} // namespace ShadowEngine
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+#include <glad/glad.h>
+
+namespace ShadowEngine {
+
+class FrameStatistics;
+
+namespace Rendering {
+
+// Caps how far the CPU may run ahead of the GPU. A fence goes in after each
+// present; before the next frame samples input, WaitForSlot blocks until at
+// most maxQueuedFrames - 1 frames are still executing. Drivers otherwise queue
+// up to three frames, each adding a frame of input latency.
+//
+// Each fence carries the time its frame sampled input plus a GL_TIMESTAMP
+// query. Retiring it yields an input-to-present latency sample: input sampling
+// until the GPU finished the frame, converted to the CPU clock. The sample is
+// exact even when the CPU only notices the fence much later.
+class FrameFences {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit FrameFences(int maxQueuedFrames = 2);
+    ~FrameFences();
+
+    // Prevent copying
+    FrameFences(const FrameFences&) = delete;
+    FrameFences& operator=(const FrameFences&) = delete;
+
+    void SetMaxQueuedFrames(int maxQueuedFrames) { m_MaxQueuedFrames = maxQueuedFrames; }
+    int GetMaxQueuedFrames() const { return m_MaxQueuedFrames; }
+
+    // After presenting the frame whose input was sampled at inputTime
+    void Insert(Clock::time_point inputTime);
+
+    // Before sampling input for the next frame. Retired frames add their
+    // latency to latencyOut when given.
+    void WaitForSlot(FrameStatistics* latencyOut);
+
+private:
+    struct Pending {
+        GLsync fence;
+        GLuint timestampQuery;
+        Clock::time_point inputTime;
+    };
+
+    void Retire(FrameStatistics* latencyOut);
+
+    int m_MaxQueuedFrames;
+    std::vector<Pending> m_Pending;  // Oldest first; only a few frames deep
+    std::vector<GLuint> m_FreeQueries;
+};
+
+} // namespace Rendering
+} // namespace ShadowEngine
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <glad/glad.h>
+
+namespace ShadowEngine {
+namespace Rendering {
+
+// Offscreen render target: an RGBA8 colour texture plus a depth/stencil
+// renderbuffer. Used as the back buffer in headless mode and as the scaled
+// scene target for dynamic resolution.
+class Framebuffer {
+public:
+    Framebuffer();
+    ~Framebuffer();
+
+    // Prevent copying
+    Framebuffer(const Framebuffer&) = delete;
+    Framebuffer& operator=(const Framebuffer&) = delete;
+
+    // (Re)create the attachments at the given size; the label names them in debug output
+    bool Create(int width, int height, const std::string& label = "Offscreen");
+    void Destroy();
+
+    // Bind as the draw and read framebuffer
+    void Bind() const;
+
+    GLuint GetID() const { return m_FramebufferID; }
+    GLuint GetColorTexture() const { return m_ColorTexture; }
+    int GetWidth() const { return m_Width; }
+    int GetHeight() const { return m_Height; }
+
+    // RGBA8 colour plus 24/8 depth-stencil
+    size_t GetGpuBytes() const { return static_cast<size_t>(m_Width) * static_cast<size_t>(m_Height) * 8; }
+
+private:
+    GLuint m_FramebufferID;
+    GLuint m_ColorTexture;
+    GLuint m_DepthRenderbuffer;
+    int m_Width;
+    int m_Height;
+};
+
+} // namespace Rendering
+} // namespace ShadowEngine
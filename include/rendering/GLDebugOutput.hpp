@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glad/glad.h>
+
+namespace ShadowEngine {
+namespace Rendering {
+
+// KHR_debug integration. Routes driver messages into per-type counters and a
+// deduplicated log, and attributes each message to the engine objects (program,
+// vertex array, debug group) that were active when the driver raised it.
+class GLDebugOutput {
+public:
+    struct Counters {
+        uint32_t errors = 0;
+        uint32_t performance = 0;
+        uint32_t deprecated = 0;
+        uint32_t undefinedBehavior = 0;
+        uint32_t portability = 0;
+        uint32_t other = 0;
+        uint32_t duplicates = 0;  // Messages folded into an existing log entry
+    };
+
+    // One log entry per distinct message
+    struct LogEntry {
+        GLenum source = 0;
+        GLenum type = 0;
+        GLenum severity = 0;
+        GLuint id = 0;
+        std::string message;
+        std::string attribution;  // Objects bound when the message was first seen
+        uint32_t count = 0;
+    };
+
+    static GLDebugOutput& Get();
+
+    // Enable debug output on the current context. The loader is used to fetch the
+    // KHR_debug entry points when the context is older than GL 4.3.
+    bool Initialize(GLADloadproc loader);
+    void Shutdown();
+    bool IsAvailable() const { return m_Available; }
+
+    // Object labels are forwarded to glObjectLabel and kept for attribution
+    void LabelObject(GLenum identifier, GLuint name, const std::string& label);
+    void ForgetObject(GLenum identifier, GLuint name);
+    std::string GetLabel(GLenum identifier, GLuint name) const;
+
+    // Debug groups bracket render passes in captures and in attribution
+    void PushGroup(const char* name);
+    void PopGroup();
+
+    Counters GetCounters() const;
+    std::vector<LogEntry> GetLog() const;
+    void PrintSummary() const;
+
+private:
+    GLDebugOutput() = default;
+
+    static void APIENTRY MessageCallback(GLenum source, GLenum type, GLuint id, GLenum severity,
+                                         GLsizei length, const GLchar* message, const void* userParam);
+    void HandleMessage(GLenum source, GLenum type, GLuint id, GLenum severity,
+                       GLsizei length, const GLchar* message);
+    std::string DescribeBoundObjects() const;
+    bool LoadExtensionEntryPoints(GLADloadproc loader);
+
+    static uint64_t MakeLabelKey(GLenum identifier, GLuint name) {
+        return (static_cast<uint64_t>(identifier) << 32) | name;
+    }
+
+    bool m_Available = false;
+
+    mutable std::mutex m_Mutex;
+    Counters m_Counters;
+    std::unordered_multimap<uint64_t, LogEntry> m_Log;  // Keyed by a hash of the entry's identity
+    std::unordered_map<uint64_t, std::string> m_Labels;
+    std::vector<const char*> m_GroupStack;
+};
+
+// Pushes a debug group for the lifetime of the scope
+class ScopedDebugGroup {
+public:
+    explicit ScopedDebugGroup(const char* name) { GLDebugOutput::Get().PushGroup(name); }
+    ~ScopedDebugGroup() { GLDebugOutput::Get().PopGroup(); }
+
+    ScopedDebugGroup(const ScopedDebugGroup&) = delete;
+    ScopedDebugGroup& operator=(const ScopedDebugGroup&) = delete;
+};
+
+} // namespace Rendering
+} // namespace ShadowEngine
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <glad/glad.h>
+
+namespace ShadowEngine {
+namespace Rendering {
+
+// Shadow copy of the OpenGL binding and fixed-function state.
+// All rendering code binds objects and toggles state through this cache so that
+// redundant calls are filtered before they reach the driver.
+class GLStateCache {
+public:
+    static constexpr int MaxTextureUnits = 16;
+
+    struct FrameStats {
+        uint32_t issuedCalls = 0;     // Calls forwarded to GL
+        uint32_t redundantCalls = 0;  // Calls filtered by the cache
+        uint32_t desyncs = 0;         // Validation mismatches against glGet*
+    };
+
+    // The cache mirrors the single GL context owned by the engine
+    static GLStateCache& Get();
+
+    // Forget all cached values so the next call of each kind goes through.
+    // Call after context creation or after code that bypasses the cache.
+    void Reset();
+
+    // Per-frame statistics
+    void BeginFrame();
+    const FrameStats& GetLastFrameStats() const { return m_LastFrame; }
+    uint64_t GetTotalRedundantCalls() const { return m_TotalRedundant; }
+    uint64_t GetTotalDesyncs() const { return m_TotalDesyncs; }
+    uint64_t GetFrameCount() const { return m_FrameCount; }
+    void ResetStats();  // Totals and frame count start over (after warmup)
+
+    // Debug mode: cross-check every cached value against glGet* after it
+    // changes, and the whole cache once per frame. On by default in debug builds.
+    void SetValidationEnabled(bool enabled) { m_ValidationEnabled = enabled; }
+    bool IsValidationEnabled() const { return m_ValidationEnabled; }
+    // Full comparison of the cache against the context; returns false on desync
+    bool Validate();
+
+    // Object bindings
+    void UseProgram(GLuint program);
+    void BindVertexArray(GLuint vao);
+    void BindBuffer(GLenum target, GLuint buffer);
+    void BindTexture(GLuint unit, GLenum target, GLuint texture);
+    void BindFramebuffer(GLenum target, GLuint framebuffer);
+
+    // Cached bindings, for attribution in debug output. Zero when nothing is
+    // bound or the cache has not seen the binding yet.
+    GLuint GetBoundProgram() const { return Known(m_Program); }
+    GLuint GetBoundVertexArray() const { return Known(m_VertexArray); }
+    GLuint GetBoundBuffer(GLenum target) const;
+    GLuint GetBoundTexture(GLenum target) const;  // On the active unit
+    GLuint GetBoundDrawFramebuffer() const { return Known(m_DrawFramebuffer); }
+
+    // Fixed-function state
+    void SetCapability(GLenum cap, bool enabled);
+    void Enable(GLenum cap) { SetCapability(cap, true); }
+    void Disable(GLenum cap) { SetCapability(cap, false); }
+    void BlendFunc(GLenum srcFactor, GLenum dstFactor);
+    void DepthFunc(GLenum func);
+    void DepthMask(bool enabled);
+    void CullFace(GLenum mode);
+    void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+    void ClearColor(float r, float g, float b, float a);
+
+    // Deletion goes through the cache because GL implicitly unbinds deleted objects
+    void DeleteProgram(GLuint program);
+    void DeleteVertexArray(GLuint vao);
+    void DeleteBuffer(GLuint buffer);
+    void DeleteTexture(GLuint texture);
+    void DeleteFramebuffer(GLuint framebuffer);
+
+private:
+    GLStateCache();
+
+    // Marker for state the cache does not know (forces the next call through)
+    static constexpr GLuint Unknown = 0xFFFFFFFFu;
+    static GLuint Known(GLuint name) { return name == Unknown ? 0 : name; }
+
+    enum BufferSlot {
+        ArrayBufferSlot,
+        ElementArrayBufferSlot,
+        PixelPackBufferSlot,
+        PixelUnpackBufferSlot,
+        UniformBufferSlot,
+        CopyReadBufferSlot,
+        CopyWriteBufferSlot,
+        BufferSlotCount
+    };
+
+    enum TextureSlot {
+        Texture2DSlot,
+        Texture2DArraySlot,
+        TextureCubeMapSlot,
+        TextureSlotCount
+    };
+
+    enum CapabilitySlot {
+        DepthTestSlot,
+        BlendSlot,
+        CullFaceSlot,
+        ScissorTestSlot,
+        StencilTestSlot,
+        FramebufferSRGBSlot,
+        CapabilitySlotCount
+    };
+
+    static int BufferSlotFor(GLenum target);
+    static GLenum BufferBindingQuery(int slot);
+    static int TextureSlotFor(GLenum target);
+    static GLenum TextureBindingQuery(int slot);
+    static int CapabilitySlotFor(GLenum cap);
+
+    void CountIssued() { ++m_Frame.issuedCalls; }
+    void CountRedundant() { ++m_Frame.redundantCalls; }
+    void ActivateUnit(GLuint unit);
+    void CheckBinding(const char* what, GLenum query, GLuint expected);
+    void CheckClearColor();
+
+    // Cached state (Unknown means "not yet observed")
+    GLuint m_Program;
+    GLuint m_VertexArray;
+    std::array<GLuint, BufferSlotCount> m_Buffers;
+    GLuint m_ActiveUnit;
+    std::array<std::array<GLuint, TextureSlotCount>, MaxTextureUnits> m_Textures;
+    GLuint m_DrawFramebuffer;
+    GLuint m_ReadFramebuffer;
+    std::array<int8_t, CapabilitySlotCount> m_Capabilities;  // -1 unknown, 0 off, 1 on
+    GLenum m_BlendSrc;
+    GLenum m_BlendDst;
+    GLenum m_DepthFunc;
+    int8_t m_DepthMask;
+    GLenum m_CullFace;
+    std::array<GLint, 4> m_Viewport;
+    std::array<float, 4> m_ClearColor;
+    bool m_ViewportKnown;
+    bool m_ClearColorKnown;
+
+    bool m_ValidationEnabled;
+    FrameStats m_Frame;
+    FrameStats m_LastFrame;
+    uint64_t m_TotalRedundant;
+    uint64_t m_TotalDesyncs;
+    uint64_t m_FrameCount;
+};
+
+} // namespace Rendering
+} // namespace ShadowEngine
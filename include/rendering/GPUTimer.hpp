@@ -0,0 +1,42 @@
+#pragma once
+
+#include <glad/glad.h>
+
+namespace ShadowEngine {
+namespace Rendering {
+
+// Measures GPU time between Begin and End with GL_TIME_ELAPSED queries. Results
+// arrive a few frames late; a small ring of queries keeps the CPU from ever
+// waiting on one. Frames are skipped rather than stalled when the ring is full.
+// The very first result is dropped: some drivers (llvmpipe) report garbage for
+// a query object's first use.
+class GPUTimer {
+public:
+    GPUTimer();
+    ~GPUTimer();
+
+    // Prevent copying
+    GPUTimer(const GPUTimer&) = delete;
+    GPUTimer& operator=(const GPUTimer&) = delete;
+
+    bool Initialize();
+    void Shutdown();
+
+    void Begin();
+    void End();
+
+    // Pop the oldest finished measurement. Returns false when none is ready.
+    bool Poll(double& outMilliseconds);
+
+private:
+    static constexpr int QueryCount = 4;
+
+    GLuint m_Queries[QueryCount];
+    int m_Oldest;   // Oldest query still in flight
+    int m_Pending;  // Queries in flight
+    bool m_Active;  // Between a Begin that issued a query and its End
+    bool m_Primed;  // First result already dropped
+};
+
+} // namespace Rendering
+} // namespace ShadowEngine
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ShadowEngine {
+namespace Rendering {
+
+class Shader;
+class Texture;
+
+// A shader and the textures it samples, bound to units 0..n-1 in order.
+// Described on disk by a .shmat text file (see AssetManager::LoadMaterial).
+class Material {
+public:
+    Material(const std::string& name, std::shared_ptr<Shader> shader,
+             std::vector<std::shared_ptr<Texture>> textures);
+
+    // Use the shader, bind the textures and point the samplers uTexture0,
+    // uTexture1, ... at their units. Textures that are null (no GPU backend)
+    // are skipped.
+    void Bind() const;
+
+    const std::string& GetName() const { return m_Name; }
+    const std::shared_ptr<Shader>& GetShader() const { return m_Shader; }
+    const std::vector<std::shared_ptr<Texture>>& GetTextures() const { return m_Textures; }
+
+private:
+    std::string m_Name;
+    std::shared_ptr<Shader> m_Shader;
+    std::vector<std::shared_ptr<Texture>> m_Textures;
+};
+
+} // namespace Rendering
+} // namespace ShadowEngine
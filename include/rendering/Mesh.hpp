@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <glad/glad.h>
@@ -14,22 +15,46 @@ public:
     Mesh();
     ~Mesh();
 
-    // Initialize mesh with vertex and index data
+    // Initialize mesh with vertex and index data. Without GPU buffers the mesh
+    // only keeps its CPU copy, for backends that never touch GL.
     bool Initialize(const std::vector<float>& vertices, 
-                   const std::vector<unsigned int>& indices);
+                   const std::vector<unsigned int>& indices,
+                   bool createGPUBuffers = true);
     
     // Render the mesh using the specified shader
     void Render(const std::shared_ptr<Shader>& shader);
 
+    // CPU copies of the mesh data, consumed by the software rasterizer
+    const std::vector<float>& GetVertices() const { return m_Vertices; }
+    const std::vector<unsigned int>& GetIndices() const { return m_Indices; }
+    size_t GetIndexCount() const { return m_IndexCount; }
+
+    // Object-space bounding sphere, used for frustum culling
+    const float* GetBoundsCenter() const { return m_BoundsCenter; }
+    float GetBoundsRadius() const { return m_BoundsRadius; }
+
+    // Small per-process identifier, used in draw sort keys
+    uint32_t GetID() const { return m_ID; }
+
+    // Vertex and index buffer sizes (zero without GPU buffers)
+    size_t GetGpuBytes() const { return m_GpuBytes; }
+
 private:
     GLuint m_VAO;  // Vertex Array Object
     GLuint m_VBO;  // Vertex Buffer Object
     GLuint m_EBO;  // Element Buffer Object
+    size_t m_GpuBytes;  // Vertex and index buffer sizes, charged to the assets budget
     
     size_t m_IndexCount;
+    std::vector<float> m_Vertices;
+    std::vector<unsigned int> m_Indices;
+    float m_BoundsCenter[3];
+    float m_BoundsRadius;
+    uint32_t m_ID;
     
     // Helper functions
     void SetupMesh();
+    void ComputeBounds();
     void Cleanup();
 };
 
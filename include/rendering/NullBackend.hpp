@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include "rendering/RenderBackend.hpp"
+
+namespace ShadowEngine {
+namespace Rendering {
+
+// Accepts every draw and issues no GL calls. Meshes and shaders created for it
+// keep only their CPU data, so it runs without a context or driver; frame times
+// measure the engine's own CPU cost.
+class NullBackend : public RenderBackend {
+public:
+    struct FrameStats {
+        size_t draws = 0;
+        size_t triangles = 0;
+    };
+
+    BackendType GetType() const override { return BackendType::Null; }
+    void Execute(const RenderQueue& queue, const RenderTarget& target) override;
+
+    const FrameStats& GetLastFrameStats() const { return m_Stats; }
+
+private:
+    FrameStats m_Stats;
+};
+
+} // namespace Rendering
+} // namespace ShadowEngine
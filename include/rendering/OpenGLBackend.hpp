@@ -0,0 +1,18 @@
+#pragma once
+
+#include "rendering/RenderBackend.hpp"
+
+namespace ShadowEngine {
+namespace Rendering {
+
+// Draws the queue with one glDrawElements per packet. Camera matrices are set
+// once per shader change and the model matrix per draw.
+class OpenGLBackend : public RenderBackend {
+public:
+    BackendType GetType() const override { return BackendType::OpenGL; }
+    void Execute(const RenderQueue& queue, const RenderTarget& target) override;
+    void Finish() override;
+};
+
+} // namespace Rendering
+} // namespace ShadowEngine
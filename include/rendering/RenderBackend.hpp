@@ -0,0 +1,55 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+namespace ShadowEngine {
+
+class JobSystem;
+
+namespace Rendering {
+
+class Framebuffer;
+class RenderQueue;
+
+enum class BackendType {
+    OpenGL,    // Draw on the GPU
+    Software,  // Rasterize on the CPU, present through GL
+    Null       // Prepare everything, draw nothing; needs no GL context
+};
+
+// "gl", "software" or "null"
+const char* GetBackendName(BackendType type);
+bool ParseBackendType(const std::string& name, BackendType& outType);
+
+// Whether the backend needs a current GL context and GPU copies of meshes and shaders
+bool BackendRequiresContext(BackendType type);
+
+// Where a frame goes: an offscreen framebuffer, or the default one when null
+struct RenderTarget {
+    Framebuffer* framebuffer = nullptr;
+    int width = 0;
+    int height = 0;
+};
+
+// Consumes a prepared RenderQueue. Everything up to the queue (scene update,
+// culling, sorting, matrix generation, uniform packing) is shared by all
+// backends, so swapping in the null backend isolates the engine's CPU cost.
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+
+    virtual BackendType GetType() const = 0;
+
+    // Draw every packet in the queue into the target
+    virtual void Execute(const RenderQueue& queue, const RenderTarget& target) = 0;
+
+    // Block until the submitted frame has fully executed
+    virtual void Finish() {}
+
+    // jobs, if given, is shared by backends that do CPU work and must outlive them
+    static std::unique_ptr<RenderBackend> Create(BackendType type, JobSystem* jobs = nullptr);
+};
+
+} // namespace Rendering
+} // namespace ShadowEngine
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "math/Matrix.hpp"
+
+namespace ShadowEngine {
+
+class JobSystem;
+
+namespace Rendering {
+
+class Material;
+class Mesh;
+class Shader;
+
+// Per-draw uniform block, laid out like a std140 block of two mat4s
+struct PerDrawUniforms {
+    float model[16];
+    float modelViewProjection[16];
+};
+
+// One visible draw after preparation. Packets are sorted by key; the uniforms
+// for packet i are GetUniforms()[i].
+struct DrawPacket {
+    Mesh* mesh;
+    Shader* shader;
+    const Material* material;  // Null: the shader alone, no textures
+    uint64_t sortKey;
+};
+
+// Backend-independent CPU side of a frame: collects submitted objects, culls
+// them against the view frustum, sorts the survivors by state (shader, then
+// mesh, then front to back) and packs their matrices into one contiguous array
+// that a backend walks in order.
+class RenderQueue {
+public:
+    struct Stats {
+        size_t submitted = 0;
+        size_t visible = 0;
+        double cullMs = 0.0;
+        double sortMs = 0.0;
+        double packMs = 0.0;
+    };
+
+    RenderQueue() = default;
+
+    // Prevent copying
+    RenderQueue(const RenderQueue&) = delete;
+    RenderQueue& operator=(const RenderQueue&) = delete;
+
+    // Pack large frames in parallel on jobs (null: on the calling thread)
+    void SetJobSystem(JobSystem* jobs) { m_Jobs = jobs; }
+
+    // Queue an object for this frame. Mesh and shader must outlive the frame.
+    void Submit(Mesh& mesh, Shader& shader, const Math::Matrix4& model);
+
+    // Drawn with the material's shader and textures; the material must have a
+    // shader and outlive the frame
+    void Submit(Mesh& mesh, const Material& material, const Math::Matrix4& model);
+
+    // Cull, sort and pack everything submitted since the last Clear
+    void Prepare(const Math::Matrix4& view, const Math::Matrix4& projection);
+
+    // Drop this frame's submissions; capacity is kept for the next frame
+    void Clear();
+
+    const std::vector<DrawPacket>& GetPackets() const { return m_Packets; }
+    const std::vector<PerDrawUniforms>& GetUniforms() const { return m_Uniforms; }
+    const Math::Matrix4& GetView() const { return m_View; }
+    const Math::Matrix4& GetProjection() const { return m_Projection; }
+    const Stats& GetStats() const { return m_Stats; }
+    size_t GetSubmittedCount() const { return m_Items.size(); }
+
+private:
+    struct Item {
+        Mesh* mesh;
+        Shader* shader;
+        const Material* material;
+        Math::Matrix4 model;
+    };
+
+    using SortEntry = std::pair<uint64_t, uint32_t>;  // Key, item index
+
+    void SortEntries();
+    void PackRange(size_t begin, size_t end, const float* viewProjection);
+
+    std::vector<Item> m_Items;
+    std::vector<SortEntry> m_Entries;
+    std::vector<SortEntry> m_SortScratch;
+    std::vector<uint32_t> m_Histogram;
+    std::vector<DrawPacket> m_Packets;
+    std::vector<PerDrawUniforms> m_Uniforms;
+    Math::Matrix4 m_View;
+    Math::Matrix4 m_Projection;
+    Stats m_Stats;
+    JobSystem* m_Jobs = nullptr;
+};
+
+} // namespace Rendering
+} // namespace ShadowEngine
@@ -6,40 +6,161 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include "math/Matrix.hpp"
+#include "rendering/RenderBackend.hpp"
+#include "rendering/DynamicResolution.hpp"
+#include "rendering/FrameCapture.hpp"
 
 namespace ShadowEngine {
 
+class JobSystem;
+
 namespace Rendering {
 
 class Shader;
 class Mesh;
 class Material;
+class Texture;
+class TextureStreamer;
+class Framebuffer;
+class RenderQueue;
+class GPUTimer;
+class AssetManager;
+class ResourceCache;
 
 class RenderSystem {
 public:
     RenderSystem();
     ~RenderSystem();
 
+    // Job system shared by the CPU-side frame preparation and the software
+    // backend. Set before Initialize; it must outlive the render system.
+    void SetJobSystem(JobSystem* jobs);
+    JobSystem* GetJobSystem() const { return m_Jobs; }
+
     // Initialize the rendering system
-    bool Initialize(GLFWwindow* window);
+    bool Initialize(GLFWwindow* window, BackendType backend = BackendType::OpenGL);
+
+    // Initialize against an already-current offscreen context; frames are drawn
+    // into an FBO of the given size instead of a window back buffer. The null
+    // backend needs no context, and loader may then be null.
+    bool InitializeHeadless(GLADloadproc loader, int width, int height,
+                            BackendType backend = BackendType::OpenGL);
     
-    // Main rendering loop
-    void Render();
+    // Main rendering loop: prepares this frame's submissions and hands them to the backend.
+    // Same as PublishFrame followed by RenderPublished.
+    void Render(uint64_t frameIndex);
+
+    // Submissions are double buffered so simulation and rendering can overlap.
+    // PublishFrame seals everything submitted since the last call, together with
+    // the camera and target size, into an immutable snapshot, and opens the other
+    // buffer for the next frame. Call it from the thread that submits (and polls
+    // GLFW), never while RenderPublished is running. frameIndex is the engine's
+    // frame number; captures are named by it.
+    void PublishFrame(uint64_t frameIndex);
+
+    // Draw the last published snapshot. May run on another thread than the
+    // submitting one, provided that thread owns the GL context.
+    void RenderPublished();
 
-    // Shader management
+    // Block until the last rendered frame has fully executed
+    void Finish();
+
+    // Queue an object for the next published frame
+    void Submit(const std::shared_ptr<Mesh>& mesh, const std::shared_ptr<Shader>& shader,
+                const Math::Matrix4& model);
+
+    // Same, drawn with a material's shader and textures
+    void Submit(const std::shared_ptr<Mesh>& mesh, const std::shared_ptr<Material>& material,
+                const Math::Matrix4& model);
+
+    // Shader management. Requests with the same source text share one program.
     std::shared_ptr<Shader> CreateShader(const std::string& vertexPath, const std::string& fragmentPath);
     
-    // Mesh management
+    // Mesh management. Requests with the same data share one set of buffers.
     std::shared_ptr<Mesh> CreateMesh(const std::vector<float>& vertices, 
                                     const std::vector<unsigned int>& indices);
 
+    // Shaders and meshes, shared by content and released once unused and over
+    // budget. Available once initialized.
+    ResourceCache& GetResourceCache() { return *m_ResourceCache; }
+
+    // Texture management. Cooked .shtx containers upload at once; other images
+    // are decoded and their mip levels stream in over the following frames.
+    std::shared_ptr<Texture> CreateTexture(const std::string& imagePath);
+    TextureStreamer& GetTextureStreamer() { return *m_TextureStreamer; }
+
+    // Background loading; uploads are finished at the start of each
+    // RenderPublished. Available once initialized.
+    AssetManager& GetAssetManager() { return *m_AssetManager; }
+
     // Camera/view control
     void SetViewMatrix(const Math::Matrix4& viewMatrix);
 
+    // Render target used in headless mode (null when drawing to a window)
+    Framebuffer* GetOffscreenTarget() { return m_OffscreenTarget.get(); }
+
+    // Backend chosen at initialization, and the CPU-side preparation of the
+    // last published frame
+    RenderBackend& GetBackend() { return *m_Backend; }
+    const RenderQueue& GetRenderQueue() const { return *m_Snapshots[m_SubmitIndex ^ 1].queue; }
+
+    // False for the null backend, which never touches GL
+    bool HasContext() const { return m_HasContext; }
+
+    // Render the scene into a scaled target sized from GPU frame time, then
+    // upscale it onto the window or offscreen target. Needs a GL context.
+    bool EnableDynamicResolution(const DynamicResolution::Settings& settings);
+    void DisableDynamicResolution();
+    const DynamicResolution* GetDynamicResolution() const { return m_DynamicResolution.get(); }
+
+    // Read every finished frame back asynchronously and write it to disk on a
+    // background thread. Needs a GL context.
+    bool EnableCapture(const FrameCapture::Settings& settings);
+    void DisableCapture();
+    const FrameCapture* GetCapture() const { return m_Capture.get(); }
+
+    // While paused, frames are drawn but not captured (headless warmup)
+    void SetCapturePaused(bool paused) { m_CapturePaused = paused; }
+
+    // GL state cache and dynamic resolution statistics start over from the
+    // next rendered frame. Not while a frame is rendering.
+    void ResetStats();
+
 private:
     GLFWwindow* m_Window;
-    std::vector<std::shared_ptr<Shader>> m_Shaders;
-    std::vector<std::shared_ptr<Mesh>> m_Meshes;
+    GLADloadproc m_ProcLoader;
+    bool m_HasContext;
+    int m_Width;   // Target size when there is neither window nor offscreen target
+    int m_Height;
+    std::unique_ptr<Framebuffer> m_OffscreenTarget;
+    std::unique_ptr<RenderBackend> m_Backend;
+    JobSystem* m_Jobs;
+
+    // One frame's scene output: the draw list plus the camera and target size it
+    // is drawn with. The scene fills m_Snapshots[m_SubmitIndex] while the
+    // renderer draws the other one.
+    struct FrameSnapshot {
+        std::unique_ptr<RenderQueue> queue;
+        Math::Matrix4 view;
+        Math::Matrix4 projection;
+        int width = 0;
+        int height = 0;
+        uint64_t frameIndex = 0;
+    };
+    FrameSnapshot m_Snapshots[2];
+    int m_SubmitIndex;
+
+    std::unique_ptr<DynamicResolution> m_DynamicResolution;
+    std::unique_ptr<GPUTimer> m_GPUTimer;
+    std::unique_ptr<Framebuffer> m_ScaledTarget;
+    std::shared_ptr<Shader> m_UpscaleShader;  // Null: upscale with a blit instead
+    GLuint m_UpscaleVertexArray;              // Empty; the triangle comes from gl_VertexID
+    std::unique_ptr<FrameCapture> m_Capture;
+    bool m_CapturePaused;
+    std::vector<std::shared_ptr<Texture>> m_Textures;
+    std::unique_ptr<TextureStreamer> m_TextureStreamer;
+    std::unique_ptr<ResourceCache> m_ResourceCache;
+    std::unique_ptr<AssetManager> m_AssetManager;
 
     // Cached view matrix from the current camera (if provided by a scene)
     Math::Matrix4 m_ViewMatrix;
@@ -48,6 +169,7 @@ private:
     // Internal initialization
     bool InitializeOpenGL();
     void SetupDebugCallback();
+    void RenderScaled(const RenderQueue& queue, const RenderTarget& output);
 };
 
 } // namespace Rendering
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ShadowEngine {
+namespace Rendering {
+
+class Shader;
+class Mesh;
+
+// Shares GPU objects between identical requests. Shaders are keyed by a hash
+// of their source text and meshes by a hash of their vertex and index data, so
+// the same content maps to one program or one set of buffers whatever path or
+// caller it came from. A hit is checked against the stored content before it is
+// returned, so a hash collision costs a duplicate object, never a wrong one.
+//
+// Callers hold shared_ptrs; an entry is in use while anyone besides the cache
+// holds one. Entries nobody uses stay cached so a later request can revive
+// them, and are released least recently used first while the cache is over
+// its memory budget. Release is deferred: an entry must have been unused for
+// a few Collect calls first, so a frame snapshot that still refers to it has
+// been drawn.
+//
+// Use from the thread that owns the GL context.
+class ResourceCache {
+public:
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t collisions = 0;  // Equal hashes, different content
+        uint64_t evictions = 0;
+        size_t entries = 0;
+        size_t unused = 0;        // Entries only the cache holds
+        size_t bytes = 0;         // GPU objects plus the meshes' CPU copies
+        size_t peakBytes = 0;
+    };
+
+    // Without a context shaders are identities and meshes keep only their CPU
+    // data, as with RenderSystem's Create functions
+    explicit ResourceCache(bool hasContext);
+    ~ResourceCache();
+
+    // Prevent copying
+    ResourceCache(const ResourceCache&) = delete;
+    ResourceCache& operator=(const ResourceCache&) = delete;
+
+    // Null when compilation fails; failures are not cached
+    std::shared_ptr<Shader> GetShader(std::string_view vertexCode, std::string_view fragmentCode,
+                                      const std::string& label);
+    std::shared_ptr<Mesh> GetMesh(const std::vector<float>& vertices, const std::vector<unsigned int>& indices);
+
+    // While the cache holds more than this many bytes, unused entries are
+    // released; 0 releases them as soon as the release delay allows
+    void SetBudget(size_t bytes) { m_Budget = bytes; }
+    size_t GetBudget() const { return m_Budget; }
+
+    // Collect calls an entry must go unused before it may be released
+    void SetReleaseDelay(int frames) { m_ReleaseDelay = frames < 0 ? 0 : frames; }
+    int GetReleaseDelay() const { return m_ReleaseDelay; }
+
+    // Note which entries became unused and evict over budget (call once per frame)
+    void Collect();
+
+    // Release every unused entry whatever the budget and delay, e.g. after a
+    // scene change once the old scene's frames have been drawn
+    void ReleaseUnused();
+
+    Stats GetStats() const;
+    void PrintSummary(std::ostream& out) const;
+
+private:
+    enum class Kind : uint8_t { Shader, Mesh };
+
+    struct Entry {
+        Kind kind;
+        uint64_t hash;
+        std::shared_ptr<Shader> shader;
+        std::shared_ptr<Mesh> mesh;
+        std::string vertexCode;    // Shaders: sources, to confirm hits
+        std::string fragmentCode;
+        size_t bytes = 0;
+        uint64_t unusedSince = 0;  // Frame it was first seen unused; 0 while in use
+    };
+    using EntryList = std::list<Entry>;
+
+    bool IsUsed(const Entry& entry) const;
+    EntryList::iterator Lookup(Kind kind, uint64_t hash);
+    void Insert(Entry entry);
+    EntryList::iterator Evict(EntryList::iterator it);
+
+    bool m_HasContext;
+    size_t m_Budget;
+    int m_ReleaseDelay;
+    uint64_t m_Frame;
+
+    // Least recently requested first
+    EntryList m_Entries;
+    std::unordered_map<uint64_t, EntryList::iterator> m_Index;  // Hash of kind and content
+
+    Stats m_Stats;
+};
+
+} // namespace Rendering
+} // namespace ShadowEngine
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <glad/glad.h>
 
@@ -14,6 +16,10 @@ public:
 
     // Load and compile shaders
     bool LoadFromFiles(const std::string& vertexPath, const std::string& fragmentPath);
+
+    // Compile and link sources already in memory; label names the program in
+    // debug output
+    bool LoadFromSource(std::string_view vertexCode, std::string_view fragmentCode, const std::string& label);
     
     // Use the shader program
     void Use() const;
@@ -21,17 +27,27 @@ public:
     // Uniform setters
     void SetUniform(const std::string& name, int value);
     void SetUniform(const std::string& name, float value);
+    void SetUniform(const std::string& name, float x, float y);
     void SetUniform(const std::string& name, const float* matrix);
     
     // Get the program ID
     GLuint GetProgramID() const { return m_ProgramID; }
 
+    // Small per-process identifier, used in draw sort keys. Unlike the program
+    // ID it is also valid for shaders that were never compiled (null backend).
+    uint32_t GetID() const { return m_ID; }
+
+    // Estimated program size (zero until linked)
+    size_t GetGpuBytes() const { return m_GpuBytes; }
+
 private:
     GLuint m_ProgramID;
+    size_t m_GpuBytes;  // Estimated program size, charged to the assets budget
+    uint32_t m_ID;
     std::unordered_map<std::string, GLint> m_UniformLocations;
     
     // Helper functions
-    bool CompileShader(GLuint& shaderID, const std::string& shaderCode, GLenum shaderType);
+    bool CompileShader(GLuint& shaderID, std::string_view shaderCode, GLenum shaderType);
     bool LinkProgram();
     GLint GetUniformLocation(const std::string& name);
 };
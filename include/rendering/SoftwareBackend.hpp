@@ -0,0 +1,35 @@
+#pragma once
+
+#include <memory>
+#include "rendering/RenderBackend.hpp"
+
+namespace ShadowEngine {
+
+class JobSystem;
+
+namespace Rendering {
+
+class SoftwareRasterizer;
+
+// Rasterizes the queue on the CPU and only uses GL to present the result. For
+// GPU-less test machines, reference images and broken drivers. All shaders are
+// assumed to follow basic.vert/basic.frag.
+class SoftwareBackend : public RenderBackend {
+public:
+    // Rasterizes on jobs, or on a private job system when jobs is null
+    explicit SoftwareBackend(JobSystem* jobs = nullptr);
+    ~SoftwareBackend() override;
+
+    BackendType GetType() const override { return BackendType::Software; }
+    void Execute(const RenderQueue& queue, const RenderTarget& target) override;
+    void Finish() override;
+
+    SoftwareRasterizer& GetRasterizer() { return *m_Rasterizer; }
+
+private:
+    std::unique_ptr<SoftwareRasterizer> m_Rasterizer;
+    std::unique_ptr<Framebuffer> m_Present;
+};
+
+} // namespace Rendering
+} // namespace ShadowEngine
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "core/ImageLoader.hpp"
+#include "core/JobSystem.hpp"
+#include "math/Matrix.hpp"
+
+namespace ShadowEngine {
+namespace Rendering {
+
+// CPU rasterizer implementing the basic.vert/basic.frag pipeline: interleaved
+// position (3 floats) + colour (3 floats) vertices, transformed by one MVP matrix,
+// depth-tested with GL_LESS and written as opaque RGBA8.
+//
+// Draws are queued and executed by Flush in three phases run as jobs: vertex
+// transform, clip/setup/binning into 64x64 tiles, then per-tile rasterization
+// with SSE2 edge functions (scalar fallback elsewhere). Colours are interpolated
+// perspective-correctly. Buffers use the GL convention of row 0 at the bottom, so
+// output can be diffed directly against glReadPixels.
+class SoftwareRasterizer {
+public:
+    struct FrameStats {
+        size_t submittedTriangles = 0;
+        size_t rasterizedTriangles = 0;  // After clipping and culling
+        size_t binnedTiles = 0;          // Triangle/tile pairs
+        double frontEndMs = 0.0;         // Transform, clip, setup and binning
+        double backEndMs = 0.0;          // Tile rasterization
+    };
+
+    // Runs on a private job system; threadCount 0 uses every hardware thread
+    // (the caller counts as one)
+    explicit SoftwareRasterizer(unsigned threadCount = 0);
+    // Runs on a shared job system, which must outlive the rasterizer
+    explicit SoftwareRasterizer(JobSystem& jobs);
+    ~SoftwareRasterizer();
+
+    // Prevent copying
+    SoftwareRasterizer(const SoftwareRasterizer&) = delete;
+    SoftwareRasterizer& operator=(const SoftwareRasterizer&) = delete;
+
+    bool Resize(int width, int height);
+    int GetWidth() const { return m_Width; }
+    int GetHeight() const { return m_Height; }
+    unsigned GetThreadCount() const;
+
+    // Clear is applied lazily per tile during the next Flush
+    void Clear(float r, float g, float b, float a, float depth = 1.0f);
+    void SetCullBackFaces(bool enabled) { m_CullBackFaces = enabled; }
+
+    // Queue an indexed triangle list. The arrays are read during Flush and must
+    // stay valid until then.
+    void DrawIndexed(const float* vertices, size_t vertexCount,
+                     const unsigned int* indices, size_t indexCount,
+                     const Math::Matrix4& mvp);
+
+    // Execute every queued draw
+    void Flush();
+
+    const FrameStats& GetLastFrameStats() const { return m_Stats; }
+
+    // Tightly packed RGBA8 copy of the colour buffer, bottom row first
+    void ReadPixels(ImageLoader::ImageData& out) const;
+
+    // Raw buffers: GetPitch() pixels per row, padded to whole tiles
+    const uint32_t* GetColorBuffer() const { return m_Color.data(); }
+    const float* GetDepthBuffer() const { return m_Depth.data(); }
+    int GetPitch() const { return m_Pitch; }
+
+    static constexpr int TileSize = 64;
+
+private:
+    struct ClipVertex {
+        float x, y, z, w;
+        float r, g, b;
+    };
+
+    struct Plane {
+        float a, b, c;  // value(x, y) = a*x + b*y + c at pixel centres
+    };
+
+    struct SetupTriangle {
+        Plane edges[3];
+        bool topLeft[3];
+        Plane depth;
+        Plane invW;
+        Plane color[3];  // Colour divided by w
+        int minX, minY, maxX, maxY;  // Pixel bounds, max exclusive
+    };
+
+    struct DrawCommand {
+        const float* vertices;
+        size_t vertexCount;
+        const unsigned int* indices;
+        size_t triangleCount;
+        Math::Matrix4 mvp;
+        size_t firstVertex;  // Offset into m_ClipVertices
+    };
+
+    struct BinEntry {
+        uint32_t tile;
+        uint32_t triangle;  // Into the owning chunk's triangles
+    };
+
+    struct TileEntry {
+        uint32_t chunk;
+        uint32_t triangle;
+    };
+
+    // Triangles set up by one front-end job, and the tiles each one touches in
+    // submission order
+    struct Chunk {
+        size_t draw = 0;
+        size_t firstTriangle = 0;
+        size_t triangleCount = 0;
+        std::vector<SetupTriangle> triangles;
+        std::vector<BinEntry> bins;
+    };
+
+    void TransformVertices(const DrawCommand& draw, size_t begin, size_t end);
+    void ProcessChunk(Chunk& chunk);
+    void GatherTileLists();
+    void SetupAndBin(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2, Chunk& chunk);
+    void RasterizeTile(int tileIndex);
+    void RasterizeTriangle(const SetupTriangle& tri, int x0, int y0, int x1, int y1);
+
+    int m_Width;
+    int m_Height;
+    int m_Pitch;
+    int m_TilesX;
+    int m_TilesY;
+    std::vector<uint32_t> m_Color;
+    std::vector<float> m_Depth;
+
+    bool m_ClearPending;
+    uint32_t m_ClearColor;
+    float m_ClearDepth;
+    bool m_CullBackFaces;
+
+    std::vector<DrawCommand> m_Draws;
+    std::vector<std::pair<size_t, size_t>> m_VertexJobs;  // (draw, first vertex)
+    std::vector<ClipVertex> m_ClipVertices;
+    std::vector<Chunk> m_Chunks;
+    size_t m_ActiveChunks;
+
+    // Chunk capacity per input triangle, in powers of two, from the largest
+    // ratio seen. Culling moves draws between chunks every frame, so growing
+    // chunks one at a time would keep allocating long after the scene settles.
+    size_t m_SetupPerTriangle;
+    size_t m_BinsPerTriangle;
+
+    // Every chunk's bin entries grouped by tile: tile t owns
+    // m_TileEntries[m_TileOffsets[t], m_TileOffsets[t + 1])
+    std::vector<uint32_t> m_TileOffsets;
+    std::vector<uint32_t> m_TileCursors;
+    std::vector<TileEntry> m_TileEntries;
+
+    FrameStats m_Stats;
+    std::unique_ptr<JobSystem> m_OwnedJobs;
+    JobSystem* m_Jobs;
+};
+
+} // namespace Rendering
+} // namespace ShadowEngine
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include <glad/glad.h>
+#include "core/ImageLoader.hpp"
+#include "core/PixelConversion.hpp"
+
+namespace ShadowEngine {
+
+class CompressedTextureFile;
+
+namespace Rendering {
+
+class TextureStreamer;
+
+// 2D texture. RGBA8 textures have their mip chain streamed in by the
+// TextureStreamer, coarsest level first, and stay drawable throughout: sampling
+// is clamped to the finest level that is resident so far. Cooked block-compressed
+// textures are uploaded whole from a memory-mapped container.
+class Texture {
+public:
+    Texture();
+    ~Texture();
+
+    // Prevent copying
+    Texture(const Texture&) = delete;
+    Texture& operator=(const Texture&) = delete;
+
+    // Load a cooked .shtx container; mip payloads go from the mapping to the driver
+    static std::shared_ptr<Texture> LoadCompressed(const std::string& path);
+
+    // Upload an already opened container, e.g. one read on a loader thread
+    static std::shared_ptr<Texture> CreateCompressed(const std::string& name, const CompressedTextureFile& file);
+
+    // Bind to a texture unit
+    void Bind(GLuint unit) const;
+
+    GLuint GetTextureID() const { return m_TextureID; }
+    int GetWidth() const { return m_Width; }
+    int GetHeight() const { return m_Height; }
+    const std::string& GetName() const { return m_Name; }
+
+    // Streaming state
+    int GetLevelCount() const { return m_LevelCount; }
+    int GetResidentLevelCount() const { return m_LevelCount - m_FinestResidentLevel; }
+    bool IsFullyResident() const { return m_FinestResidentLevel == 0; }
+    size_t GetResidentBytes() const { return m_ResidentBytes; }
+    size_t GetPendingBytes() const;
+
+private:
+    friend class TextureStreamer;
+
+    // Count uploaded bytes and charge them to the assets GPU budget
+    void AddResidentBytes(size_t bytes);
+
+    GLuint m_TextureID;
+    int m_Width;
+    int m_Height;
+    int m_LevelCount;
+    int m_FinestResidentLevel;  // Lowest level index uploaded so far
+    size_t m_ResidentBytes;
+    std::string m_Name;
+
+    // Levels not uploaded yet, finest first; released as they become resident.
+    // Their pixels are in m_PendingFormat.
+    std::vector<ImageLoader::ImageData> m_PendingLevels;
+    PixelConversion::Format m_PendingFormat;
+};
+
+} // namespace Rendering
+} // namespace ShadowEngine
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "core/ImageLoader.hpp"
+
+namespace ShadowEngine {
+namespace Rendering {
+
+// Where a packed image ended up: page plus the transform that
+// maps the image's own [0,1] UVs into the page.
+struct AtlasRegion {
+    int page = 0;
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+    float uvOffset[2] = {0.0f, 0.0f};
+    float uvScale[2] = {1.0f, 1.0f};
+};
+
+// Packed pages and the remap table produced by TextureAtlasBuilder. Pages must
+// keep at most GetMipLevels levels; coarser ones blend neighbouring images.
+class TextureAtlas {
+public:
+    const AtlasRegion* FindRegion(const std::string& name) const;
+    const std::unordered_map<std::string, AtlasRegion>& GetRegions() const { return m_Regions; }
+    const std::vector<ImageLoader::ImageData>& GetPages() const { return m_Pages; }
+    int GetPageSize() const { return m_PageSize; }
+    int GetMipLevels() const { return m_MipLevels; }
+
+private:
+    friend class TextureAtlasBuilder;
+
+    std::vector<ImageLoader::ImageData> m_Pages;
+    std::unordered_map<std::string, AtlasRegion> m_Regions;
+    int m_PageSize = 0;
+    int m_MipLevels = 1;
+};
+
+// Packs many small images into atlas pages with a MaxRects (best short side fit)
+// packer. Every image is surrounded by a gutter filled with its own edge texels
+// and aligned so the first MipLevels levels never blend neighbouring images.
+class TextureAtlasBuilder {
+public:
+    struct Options {
+        int pageSize = 2048;   // Square pages; must be a multiple of the mip alignment
+        int padding = 2;       // Minimum gutter in texels around each image
+        int mipLevels = 4;     // Levels (including the base) that are bleed-free
+        int maxPages = 64;
+    };
+
+    void Add(const std::string& name, ImageLoader::ImageData image);
+    bool AddFromFile(const std::string& path);
+
+    size_t GetImageCount() const { return m_Images.size(); }
+
+    bool Build(const Options& options, TextureAtlas& outAtlas) const;
+
+private:
+    struct Entry {
+        std::string name;
+        ImageLoader::ImageData image;
+    };
+
+    std::vector<Entry> m_Images;
+};
+
+} // namespace Rendering
+} // namespace ShadowEngine
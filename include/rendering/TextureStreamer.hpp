@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+#include <glad/glad.h>
+#include "core/ImageLoader.hpp"
+#include "core/PixelConversion.hpp"
+
+namespace ShadowEngine {
+namespace Rendering {
+
+class Texture;
+
+// Uploads texture mip chains through a ring of pixel-unpack buffers.
+// Levels are streamed coarsest first under a per-frame byte budget; each ring
+// slot is fenced so the CPU never waits on the GPU to reuse a staging buffer.
+class TextureStreamer {
+public:
+    struct FrameStats {
+        size_t uploadedBytes = 0;
+        int uploadedLevels = 0;
+        int stalledSlots = 0;  // Uploads deferred because every staging buffer was in flight
+    };
+
+    TextureStreamer();
+    ~TextureStreamer();
+
+    // Prevent copying
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    bool Initialize(size_t frameBudgetBytes = 4 * 1024 * 1024, int stagingSlots = 4);
+    void Shutdown();
+
+    // Create a texture from an RGBA8 image. Only the coarsest level of the mip
+    // chain is uploaded immediately; the rest is queued for streaming.
+    std::shared_ptr<Texture> CreateTexture(const std::string& name, ImageLoader::ImageData image);
+
+    // Same, from a mip chain built elsewhere (see MipGenerator::Build),
+    // so the CPU work can happen off the GL thread. The levels' pixels are in
+    // format, e.g. converted by PixelConversion::ConvertLevels.
+    std::shared_ptr<Texture> CreateTexture(const std::string& name, std::vector<ImageLoader::ImageData> levels,
+                                           PixelConversion::Format format = PixelConversion::Format::RGBA8);
+
+    // Upload queued mip levels within the frame budget (call once per frame)
+    void Update();
+
+    void SetFrameBudget(size_t bytes) { m_FrameBudget = bytes; }
+    size_t GetFrameBudget() const { return m_FrameBudget; }
+
+    const FrameStats& GetLastFrameStats() const { return m_LastFrame; }
+    size_t GetPendingTextureCount() const { return m_Queue.size(); }
+    size_t GetTotalResidentBytes() const;
+
+private:
+    struct StagingSlot {
+        GLuint buffer = 0;
+        size_t capacity = 0;
+        GLsync fence = nullptr;
+    };
+
+    bool UploadNextLevel(Texture& texture);
+    StagingSlot* AcquireSlot(size_t bytes);
+
+    std::vector<StagingSlot> m_Slots;
+    size_t m_NextSlot;
+    size_t m_FrameBudget;
+
+    // Textures with pending levels, in request order
+    std::deque<std::weak_ptr<Texture>> m_Queue;
+    // Every live texture, for memory reporting
+    std::vector<std::weak_ptr<Texture>> m_Textures;
+
+    FrameStats m_LastFrame;
+    bool m_IsInitialized;
+};
+
+} // namespace Rendering
+} // namespace ShadowEngine
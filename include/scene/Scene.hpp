@@ -1,12 +1,19 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
+#include <vector>
 #include "scene/Camera.hpp"
+#include "math/Matrix.hpp"
+#include "rendering/AssetManager.hpp"
 
 namespace ShadowEngine {
 
 namespace Rendering {
 class RenderSystem;
+class Material;
+class Mesh;
+class Shader;
 }
 
 namespace Input {
@@ -24,11 +31,28 @@ public:
     // Called once when the scene is removed or the engine shuts down.
     virtual void OnDetach() {}
 
-    // Called every frame before rendering.
+    // Called at the engine's fixed simulation rate, zero or more times per
+    // frame and always before Update. Advance anything that integrates motion
+    // here so results do not depend on the frame rate.
+    virtual void FixedUpdate(float /*fixedDeltaTime*/) {}
+
+    // Called every frame before rendering, with the variable frame time.
+    // Submit draws here, blending the last two fixed steps by
+    // GetInterpolationAlpha().
     virtual void Update(float /*deltaTime*/) {}
+
+    // How far the frame is between the last fixed step and the next one, in [0, 1)
+    float GetInterpolationAlpha() const { return m_InterpolationAlpha; }
+
+    // Set by the engine after running the frame's fixed steps
+    void SetInterpolationAlpha(float alpha) { m_InterpolationAlpha = alpha; }
+
+private:
+    float m_InterpolationAlpha = 0.0f;
 };
 
-// A simple test scene that sets up a rotating cube using the RenderSystem.
+// A simple test scene that draws a rotating cube, loaded through the
+// RenderSystem's asset manager.
 class TestScene : public Scene {
 public:
     TestScene(Rendering::RenderSystem& renderSystem, Input::InputManager& inputManager);
@@ -36,15 +60,55 @@ public:
 
     void OnAttach() override;
     void OnDetach() override;
+    void FixedUpdate(float fixedDeltaTime) override;
     void Update(float deltaTime) override;
 
 private:
     Rendering::RenderSystem& m_RenderSystem;
     Input::InputManager& m_InputManager;
     std::unique_ptr<SceneSystem::Camera> m_Camera;
+    Rendering::AssetHandle m_MeshAsset;
+    Rendering::AssetHandle m_MaterialAsset;
+    std::shared_ptr<Rendering::Mesh> m_Mesh;          // Null until the assets are ready
+    std::shared_ptr<Rendering::Material> m_Material;
+    double m_Time = 0.0;
+    Math::Matrix4 m_PreviousModel;  // Cube transform at the last two fixed steps
+    Math::Matrix4 m_Model;
     bool m_IsInitialized = false;
 };
 
+// Stress scene for CPU frame-cost measurements: a grid of spinning cubes with a
+// fresh model matrix per object every frame, seen by an orbiting camera so the
+// culled fraction changes over time. Pair with the null backend to time the
+// engine without a driver.
+class BenchmarkScene : public Scene {
+public:
+    BenchmarkScene(Rendering::RenderSystem& renderSystem, size_t objectCount);
+    ~BenchmarkScene() override = default;
+
+    void OnAttach() override;
+    void FixedUpdate(float fixedDeltaTime) override;
+    void Update(float deltaTime) override;
+
+private:
+    struct Object {
+        float position[3];
+        float axis[3];
+        float phase;
+        float speed;
+        unsigned int variant;  // Mesh index
+    };
+
+    Rendering::RenderSystem& m_RenderSystem;
+    size_t m_ObjectCount;
+    std::vector<Object> m_Objects;
+    std::vector<std::shared_ptr<Rendering::Mesh>> m_Meshes;
+    std::shared_ptr<Rendering::Shader> m_Shader;
+    float m_Extent = 0.0f;
+    double m_PreviousTime = 0.0;  // Simulated time at the last two fixed steps
+    double m_Time = 0.0;
+};
+
 using ScenePtr = std::unique_ptr<Scene>;
 
 } // namespace ShadowEngine
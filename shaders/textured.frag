@@ -0,0 +1,12 @@
+#version 330 core
+
+in vec3 ourColor;
+in vec2 texCoord;
+out vec4 FragColor;
+
+uniform sampler2D uTexture0;
+
+void main()
+{
+    FragColor = vec4(ourColor, 1.0) * texture(uTexture0, texCoord);
+}
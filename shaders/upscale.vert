@@ -0,0 +1,13 @@
+#version 330 core
+
+// Fullscreen triangle from gl_VertexID; no vertex buffer is bound
+out vec2 texCoord;
+
+uniform vec2 uvScale;  // Scaled size over the size of the texture it was drawn into
+
+void main()
+{
+    vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    texCoord = corner * uvScale;
+    gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
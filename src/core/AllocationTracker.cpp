@@ -0,0 +1,182 @@
+#include "core/AllocationTracker.hpp"
+#include "core/MemoryTracker.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+
+namespace ShadowEngine {
+
+namespace {
+
+// Plain atomics rather than members: the replacement operators run before the
+// tracker exists and after it is destroyed
+std::atomic<uint64_t> s_Allocations{0};
+std::atomic<uint64_t> s_Frees{0};
+std::atomic<uint64_t> s_Bytes{0};
+
+} // namespace
+
+AllocationTracker& AllocationTracker::Get() {
+    static AllocationTracker instance;
+    return instance;
+}
+
+AllocationTracker::Counts AllocationTracker::GetTotals() const {
+    Counts counts;
+    counts.allocations = s_Allocations.load(std::memory_order_relaxed);
+    counts.frees = s_Frees.load(std::memory_order_relaxed);
+    counts.bytes = s_Bytes.load(std::memory_order_relaxed);
+    return counts;
+}
+
+void AllocationTracker::BeginFrame() {
+    m_FrameStart = GetTotals();
+}
+
+void AllocationTracker::EndFrame() {
+    const Counts now = GetTotals();
+    m_LastFrame.allocations = now.allocations - m_FrameStart.allocations;
+    m_LastFrame.frees = now.frees - m_FrameStart.frees;
+    m_LastFrame.bytes = now.bytes - m_FrameStart.bytes;
+
+    if (++m_Frames <= static_cast<uint64_t>(m_WarmupFrames)) {
+        return;
+    }
+    ++m_CountedFrames;
+    m_CountedAllocations += m_LastFrame.allocations;
+    m_CountedBytes += m_LastFrame.bytes;
+    m_MaxFrameAllocations = std::max(m_MaxFrameAllocations, m_LastFrame.allocations);
+    if (m_LastFrame.allocations > 0) {
+        ++m_AllocatingFrames;
+    }
+}
+
+void AllocationTracker::PrintSummary(std::ostream& out) const {
+    if (!IsEnabled()) {
+        return;
+    }
+    if (m_CountedFrames == 0) {
+        out << "Heap allocations: no frames past warmup" << std::endl;
+        return;
+    }
+    const double frames = static_cast<double>(m_CountedFrames);
+    out << "Heap allocations per frame: mean " << std::fixed << std::setprecision(2)
+        << m_CountedAllocations / frames << " (" << m_CountedBytes / frames << " bytes), max "
+        << m_MaxFrameAllocations << "; " << m_AllocatingFrames << " of " << m_CountedFrames
+        << " frames allocated" << std::endl;
+    out.unsetf(std::ios::floatfield);
+}
+
+void AllocationTracker::RecordAllocation(size_t size) {
+    s_Allocations.fetch_add(1, std::memory_order_relaxed);
+    s_Bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void AllocationTracker::RecordFree() {
+    s_Frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace ShadowEngine
+
+#ifdef SHADOW_TRACK_ALLOCATIONS
+
+// Replacement global allocation functions. Every other form (arrays, nothrow,
+// sized delete) forwards to these in the standard library, except the aligned
+// ones, which are replaced separately.
+//
+// Each block starts with a header recording its size and memory tag, so delete
+// credits the tag that was charged even when a different scope frees it.
+
+namespace {
+
+struct BlockHeader {
+    std::size_t size;
+    ShadowEngine::MemoryTag tag;
+};
+
+// Rounded up so the user pointer stays aligned for any fundamental type
+constexpr std::size_t HeaderSize =
+    (sizeof(BlockHeader) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+void* Track(void* block, std::size_t offset, std::size_t size) {
+    void* user = static_cast<char*>(block) + offset;
+    BlockHeader* header = reinterpret_cast<BlockHeader*>(static_cast<char*>(user) - sizeof(BlockHeader));
+    header->size = size;
+    header->tag = ShadowEngine::MemoryScope::GetCurrent();
+    ShadowEngine::AllocationTracker::RecordAllocation(size);
+    ShadowEngine::MemoryTracker::Add(header->tag, ShadowEngine::MemoryDomain::Heap, size);
+    return user;
+}
+
+void* Untrack(void* user, std::size_t offset) {
+    const BlockHeader* header = reinterpret_cast<const BlockHeader*>(static_cast<char*>(user) - sizeof(BlockHeader));
+    ShadowEngine::AllocationTracker::RecordFree();
+    ShadowEngine::MemoryTracker::Remove(header->tag, ShadowEngine::MemoryDomain::Heap, header->size);
+    return static_cast<char*>(user) - offset;
+}
+
+void* TrackedAllocate(std::size_t size) {
+    if (void* block = std::malloc(HeaderSize + size)) {
+        return Track(block, HeaderSize, size);
+    }
+    throw std::bad_alloc();
+}
+
+// The header sits in the alignment-sized gap before the user pointer
+std::size_t AlignedOffset(std::align_val_t alignment) {
+    return std::max(static_cast<std::size_t>(alignment), HeaderSize);
+}
+
+void* TrackedAllocateAligned(std::size_t size, std::align_val_t alignment) {
+    const std::size_t offset = AlignedOffset(alignment);
+    const std::size_t align = std::max(static_cast<std::size_t>(alignment), sizeof(void*));
+#if defined(_WIN32)
+    if (void* block = _aligned_malloc(offset + size, align)) {
+        return Track(block, offset, size);
+    }
+#else
+    void* block = nullptr;
+    if (posix_memalign(&block, align, offset + size) == 0) {
+        return Track(block, offset, size);
+    }
+#endif
+    throw std::bad_alloc();
+}
+
+void TrackedFree(void* memory) {
+    if (memory) {
+        std::free(Untrack(memory, HeaderSize));
+    }
+}
+
+void TrackedFreeAligned(void* memory, std::align_val_t alignment) {
+    if (memory) {
+        void* block = Untrack(memory, AlignedOffset(alignment));
+#if defined(_WIN32)
+        _aligned_free(block);
+#else
+        std::free(block);
+#endif
+    }
+}
+
+} // namespace
+
+void* operator new(std::size_t size) { return TrackedAllocate(size); }
+void* operator new[](std::size_t size) { return TrackedAllocate(size); }
+void operator delete(void* memory) noexcept { TrackedFree(memory); }
+void operator delete[](void* memory) noexcept { TrackedFree(memory); }
+void operator delete(void* memory, std::size_t) noexcept { TrackedFree(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { TrackedFree(memory); }
+
+void* operator new(std::size_t size, std::align_val_t alignment) { return TrackedAllocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return TrackedAllocateAligned(size, alignment); }
+void operator delete(void* memory, std::align_val_t alignment) noexcept { TrackedFreeAligned(memory, alignment); }
+void operator delete[](void* memory, std::align_val_t alignment) noexcept { TrackedFreeAligned(memory, alignment); }
+void operator delete(void* memory, std::size_t, std::align_val_t alignment) noexcept { TrackedFreeAligned(memory, alignment); }
+void operator delete[](void* memory, std::size_t, std::align_val_t alignment) noexcept { TrackedFreeAligned(memory, alignment); }
+
+#endif // SHADOW_TRACK_ALLOCATIONS
@@ -0,0 +1,456 @@
+#include "core/BlockCompression.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace ShadowEngine {
+namespace BlockCompression {
+
+namespace {
+
+// Principal axis of a point cloud by power iteration on its covariance matrix
+template <int C>
+void ComputePrincipalAxis(const float (&points)[16][C], float (&mean)[C], float (&axis)[C]) {
+    for (int c = 0; c < C; ++c) {
+        mean[c] = 0.0f;
+        for (int i = 0; i < 16; ++i) {
+            mean[c] += points[i][c];
+        }
+        mean[c] /= 16.0f;
+    }
+
+    float covariance[C][C] = {};
+    for (int i = 0; i < 16; ++i) {
+        for (int a = 0; a < C; ++a) {
+            for (int b = 0; b < C; ++b) {
+                covariance[a][b] += (points[i][a] - mean[a]) * (points[i][b] - mean[b]);
+            }
+        }
+    }
+
+    // Start from the bounding box diagonal; it is usually close to the answer
+    for (int c = 0; c < C; ++c) {
+        float lo = points[0][c];
+        float hi = points[0][c];
+        for (int i = 1; i < 16; ++i) {
+            lo = std::min(lo, points[i][c]);
+            hi = std::max(hi, points[i][c]);
+        }
+        axis[c] = hi - lo;
+    }
+
+    for (int iteration = 0; iteration < 8; ++iteration) {
+        float next[C] = {};
+        for (int a = 0; a < C; ++a) {
+            for (int b = 0; b < C; ++b) {
+                next[a] += covariance[a][b] * axis[b];
+            }
+        }
+        float length = 0.0f;
+        for (int c = 0; c < C; ++c) {
+            length += next[c] * next[c];
+        }
+        length = std::sqrt(length);
+        if (length < 1e-6f) {
+            break;
+        }
+        for (int c = 0; c < C; ++c) {
+            axis[c] = next[c] / length;
+        }
+    }
+
+    float length = 0.0f;
+    for (int c = 0; c < C; ++c) {
+        length += axis[c] * axis[c];
+    }
+    length = std::sqrt(length);
+    for (int c = 0; c < C; ++c) {
+        axis[c] = length > 1e-6f ? axis[c] / length : 0.0f;
+    }
+}
+
+// Endpoints at the extremes of the points projected onto the principal axis
+template <int C>
+void ComputeAxisEndpoints(const float (&points)[16][C], float (&e0)[C], float (&e1)[C]) {
+    float mean[C];
+    float axis[C];
+    ComputePrincipalAxis(points, mean, axis);
+
+    float minT = 0.0f;
+    float maxT = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        float t = 0.0f;
+        for (int c = 0; c < C; ++c) {
+            t += (points[i][c] - mean[c]) * axis[c];
+        }
+        minT = std::min(minT, t);
+        maxT = std::max(maxT, t);
+    }
+
+    for (int c = 0; c < C; ++c) {
+        e0[c] = std::min(255.0f, std::max(0.0f, mean[c] + axis[c] * maxT));
+        e1[c] = std::min(255.0f, std::max(0.0f, mean[c] + axis[c] * minT));
+    }
+}
+
+uint16_t PackRGB565(const float (&color)[3]) {
+    int r = static_cast<int>(std::lround(color[0] * 31.0f / 255.0f));
+    int g = static_cast<int>(std::lround(color[1] * 63.0f / 255.0f));
+    int b = static_cast<int>(std::lround(color[2] * 31.0f / 255.0f));
+    return static_cast<uint16_t>((std::min(r, 31) << 11) | (std::min(g, 63) << 5) | std::min(b, 31));
+}
+
+void UnpackRGB565(uint16_t packed, int (&color)[3]) {
+    int r = (packed >> 11) & 31;
+    int g = (packed >> 5) & 63;
+    int b = packed & 31;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+// Chooses the closest palette entry for every pixel; returns the squared error
+int FitColorIndices(const float (&points)[16][3], uint16_t c0, uint16_t c1, uint32_t& indices) {
+    int palette[4][3];
+    UnpackRGB565(c0, palette[0]);
+    UnpackRGB565(c1, palette[1]);
+    for (int c = 0; c < 3; ++c) {
+        palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+        palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+
+    indices = 0;
+    int totalError = 0;
+    for (int i = 0; i < 16; ++i) {
+        int best = 0;
+        int bestError = 1 << 30;
+        for (int p = 0; p < 4; ++p) {
+            int error = 0;
+            for (int c = 0; c < 3; ++c) {
+                int d = static_cast<int>(points[i][c]) - palette[p][c];
+                error += d * d;
+            }
+            if (error < bestError) {
+                bestError = error;
+                best = p;
+            }
+        }
+        indices |= static_cast<uint32_t>(best) << (2 * i);
+        totalError += bestError;
+    }
+    return totalError;
+}
+
+// Least-squares endpoint refit for a fixed set of indices
+bool RefitColorEndpoints(const float (&points)[16][3], uint32_t indices, float (&e0)[3], float (&e1)[3]) {
+    static const float weights[4] = {1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+
+    float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+    float ap[3] = {}, bp[3] = {};
+    for (int i = 0; i < 16; ++i) {
+        float a = weights[(indices >> (2 * i)) & 3];
+        float b = 1.0f - a;
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+        for (int c = 0; c < 3; ++c) {
+            ap[c] += a * points[i][c];
+            bp[c] += b * points[i][c];
+        }
+    }
+
+    float det = aa * bb - ab * ab;
+    if (std::fabs(det) < 1e-6f) {
+        return false;
+    }
+    for (int c = 0; c < 3; ++c) {
+        e0[c] = std::min(255.0f, std::max(0.0f, (ap[c] * bb - bp[c] * ab) / det));
+        e1[c] = std::min(255.0f, std::max(0.0f, (bp[c] * aa - ap[c] * ab) / det));
+    }
+    return true;
+}
+
+// Swaps endpoint order so c0 > c1 (four-colour mode) and remaps the indices
+void OrderColorEndpoints(uint16_t& c0, uint16_t& c1, uint32_t& indices) {
+    if (c0 < c1) {
+        std::swap(c0, c1);
+        // 0 <-> 1 and 2 <-> 3 is a flip of the low bit of every index
+        indices ^= 0x55555555u;
+    }
+}
+
+void EncodeColorBlock(const uint8_t* block, uint8_t* out) {
+    float points[16][3];
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            points[i][c] = block[i * 4 + c];
+        }
+    }
+
+    float e0[3];
+    float e1[3];
+    ComputeAxisEndpoints(points, e0, e1);
+
+    uint16_t c0 = PackRGB565(e0);
+    uint16_t c1 = PackRGB565(e1);
+    uint32_t indices = 0;
+
+    if (c0 == c1) {
+        // Solid block: every index selects c0
+        indices = 0;
+    } else {
+        int error = FitColorIndices(points, c0, c1, indices);
+
+        float r0[3];
+        float r1[3];
+        if (RefitColorEndpoints(points, indices, r0, r1)) {
+            uint16_t rc0 = PackRGB565(r0);
+            uint16_t rc1 = PackRGB565(r1);
+            uint32_t refitIndices = 0;
+            if (rc0 != rc1 && FitColorIndices(points, rc0, rc1, refitIndices) < error) {
+                c0 = rc0;
+                c1 = rc1;
+                indices = refitIndices;
+            }
+        }
+        OrderColorEndpoints(c0, c1, indices);
+        if (c0 == c1) {
+            indices = 0;
+        }
+    }
+
+    out[0] = static_cast<uint8_t>(c0 & 0xFF);
+    out[1] = static_cast<uint8_t>(c0 >> 8);
+    out[2] = static_cast<uint8_t>(c1 & 0xFF);
+    out[3] = static_cast<uint8_t>(c1 >> 8);
+    for (int i = 0; i < 4; ++i) {
+        out[4 + i] = static_cast<uint8_t>((indices >> (8 * i)) & 0xFF);
+    }
+}
+
+// Little-endian bit packer for BC7 blocks
+class BitWriter {
+public:
+    explicit BitWriter(uint8_t* out) : m_Out(out), m_Position(0) { std::memset(out, 0, 16); }
+
+    void Write(uint32_t value, int bits) {
+        for (int i = 0; i < bits; ++i, ++m_Position) {
+            if (value & (1u << i)) {
+                m_Out[m_Position >> 3] |= static_cast<uint8_t>(1u << (m_Position & 7));
+            }
+        }
+    }
+
+private:
+    uint8_t* m_Out;
+    int m_Position;
+};
+
+} // namespace
+
+size_t GetBlockSize(Format format) {
+    switch (format) {
+        case Format::BC1:
+        case Format::BC4:
+            return 8;
+        case Format::BC3:
+        case Format::BC5:
+        case Format::BC7:
+            return 16;
+    }
+    return 0;
+}
+
+size_t GetCompressedSize(Format format, int width, int height) {
+    size_t blocksX = static_cast<size_t>((std::max(width, 1) + 3) / 4);
+    size_t blocksY = static_cast<size_t>((std::max(height, 1) + 3) / 4);
+    return blocksX * blocksY * GetBlockSize(format);
+}
+
+const char* GetFormatName(Format format) {
+    switch (format) {
+        case Format::BC1: return "BC1";
+        case Format::BC3: return "BC3";
+        case Format::BC4: return "BC4";
+        case Format::BC5: return "BC5";
+        case Format::BC7: return "BC7";
+    }
+    return "Unknown";
+}
+
+void EncodeBC1Block(const uint8_t* block, uint8_t* out) {
+    EncodeColorBlock(block, out);
+}
+
+void EncodeBC4Block(const uint8_t* block, int channel, uint8_t* out) {
+    int values[16];
+    int lo = 255;
+    int hi = 0;
+    for (int i = 0; i < 16; ++i) {
+        values[i] = block[i * 4 + channel];
+        lo = std::min(lo, values[i]);
+        hi = std::max(hi, values[i]);
+    }
+
+    out[0] = static_cast<uint8_t>(hi);
+    out[1] = static_cast<uint8_t>(lo);
+
+    uint64_t indices = 0;
+    if (hi > lo) {
+        // red0 > red1 selects the eight-value palette
+        int palette[8];
+        palette[0] = hi;
+        palette[1] = lo;
+        for (int i = 2; i < 8; ++i) {
+            palette[i] = ((8 - i) * hi + (i - 1) * lo + 3) / 7;
+        }
+
+        for (int i = 0; i < 16; ++i) {
+            int best = 0;
+            int bestError = 1 << 30;
+            for (int p = 0; p < 8; ++p) {
+                int error = std::abs(values[i] - palette[p]);
+                if (error < bestError) {
+                    bestError = error;
+                    best = p;
+                }
+            }
+            indices |= static_cast<uint64_t>(best) << (3 * i);
+        }
+    }
+
+    for (int i = 0; i < 6; ++i) {
+        out[2 + i] = static_cast<uint8_t>((indices >> (8 * i)) & 0xFF);
+    }
+}
+
+void EncodeBC3Block(const uint8_t* block, uint8_t* out) {
+    EncodeBC4Block(block, 3, out);
+    EncodeColorBlock(block, out + 8);
+}
+
+void EncodeBC5Block(const uint8_t* block, uint8_t* out) {
+    EncodeBC4Block(block, 0, out);
+    EncodeBC4Block(block, 1, out + 8);
+}
+
+void EncodeBC7Block(const uint8_t* block, uint8_t* out) {
+    // Mode 6: one subset, RGBA endpoints at 7 bits plus a per-endpoint p-bit,
+    // 4-bit indices. Handles colour and alpha together with good quality.
+    static const int weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+    float points[16][4];
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 4; ++c) {
+            points[i][c] = block[i * 4 + c];
+        }
+    }
+
+    float ends[2][4];
+    ComputeAxisEndpoints(points, ends[0], ends[1]);
+
+    // Quantize each endpoint, picking the p-bit that minimizes its own error
+    int quantized[2][4];
+    int pbits[2];
+    int expanded[2][4];
+    for (int e = 0; e < 2; ++e) {
+        float bestError = 1e30f;
+        for (int p = 0; p < 2; ++p) {
+            int q[4];
+            float error = 0.0f;
+            for (int c = 0; c < 4; ++c) {
+                q[c] = static_cast<int>(std::lround((ends[e][c] - p) / 2.0f));
+                q[c] = std::min(127, std::max(0, q[c]));
+                float d = static_cast<float>((q[c] << 1) | p) - ends[e][c];
+                error += d * d;
+            }
+            if (error < bestError) {
+                bestError = error;
+                pbits[e] = p;
+                std::memcpy(quantized[e], q, sizeof(q));
+            }
+        }
+        for (int c = 0; c < 4; ++c) {
+            expanded[e][c] = (quantized[e][c] << 1) | pbits[e];
+        }
+    }
+
+    int palette[16][4];
+    for (int w = 0; w < 16; ++w) {
+        for (int c = 0; c < 4; ++c) {
+            palette[w][c] = ((64 - weights[w]) * expanded[0][c] + weights[w] * expanded[1][c] + 32) >> 6;
+        }
+    }
+
+    int indices[16];
+    for (int i = 0; i < 16; ++i) {
+        int best = 0;
+        int bestError = 1 << 30;
+        for (int w = 0; w < 16; ++w) {
+            int error = 0;
+            for (int c = 0; c < 4; ++c) {
+                int d = block[i * 4 + c] - palette[w][c];
+                error += d * d;
+            }
+            if (error < bestError) {
+                bestError = error;
+                best = w;
+            }
+        }
+        indices[i] = best;
+    }
+
+    // The anchor (first) index is stored with its top bit implied zero
+    if (indices[0] & 8) {
+        std::swap(quantized[0], quantized[1]);
+        std::swap(pbits[0], pbits[1]);
+        for (int i = 0; i < 16; ++i) {
+            indices[i] = 15 - indices[i];
+        }
+    }
+
+    BitWriter writer(out);
+    writer.Write(1u << 6, 7);  // Mode 6
+    for (int c = 0; c < 4; ++c) {
+        writer.Write(static_cast<uint32_t>(quantized[0][c]), 7);
+        writer.Write(static_cast<uint32_t>(quantized[1][c]), 7);
+    }
+    writer.Write(static_cast<uint32_t>(pbits[0]), 1);
+    writer.Write(static_cast<uint32_t>(pbits[1]), 1);
+    writer.Write(static_cast<uint32_t>(indices[0]), 3);
+    for (int i = 1; i < 16; ++i) {
+        writer.Write(static_cast<uint32_t>(indices[i]), 4);
+    }
+}
+
+void CompressImage(Format format, const uint8_t* rgba, int width, int height, std::vector<uint8_t>& out) {
+    const size_t blockSize = GetBlockSize(format);
+    out.resize(GetCompressedSize(format, width, height));
+
+    uint8_t block[16 * 4];
+    uint8_t* dst = out.data();
+    for (int by = 0; by < height; by += 4) {
+        for (int bx = 0; bx < width; bx += 4) {
+            // Gather the block, clamping reads past the image edge
+            for (int y = 0; y < 4; ++y) {
+                int sy = std::min(by + y, height - 1);
+                for (int x = 0; x < 4; ++x) {
+                    int sx = std::min(bx + x, width - 1);
+                    std::memcpy(&block[(y * 4 + x) * 4], &rgba[(static_cast<size_t>(sy) * width + sx) * 4], 4);
+                }
+            }
+
+            switch (format) {
+                case Format::BC1: EncodeBC1Block(block, dst); break;
+                case Format::BC3: EncodeBC3Block(block, dst); break;
+                case Format::BC4: EncodeBC4Block(block, 0, dst); break;
+                case Format::BC5: EncodeBC5Block(block, dst); break;
+                case Format::BC7: EncodeBC7Block(block, dst); break;
+            }
+            dst += blockSize;
+        }
+    }
+}
+
+} // namespace BlockCompression
+} // namespace ShadowEngine
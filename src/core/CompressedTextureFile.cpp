@@ -0,0 +1,211 @@
+#include "core/CompressedTextureFile.hpp"
+#include "core/Log.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace ShadowEngine {
+
+static_assert(sizeof(CompressedTextureFile::FileHeader) == 32, "FileHeader layout is part of the file format");
+static_assert(sizeof(CompressedTextureFile::MipEntry) == 24, "MipEntry layout is part of the file format");
+
+namespace {
+
+constexpr size_t PayloadAlignment = 16;
+
+// Larger than any texture a driver accepts; keeps level sizes far from overflow
+constexpr uint32_t MaxDimension = 1u << 16;
+
+size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+bool IsKnownFormat(uint32_t format) {
+    switch (static_cast<BlockCompression::Format>(format)) {
+        case BlockCompression::Format::BC1:
+        case BlockCompression::Format::BC3:
+        case BlockCompression::Format::BC4:
+        case BlockCompression::Format::BC5:
+        case BlockCompression::Format::BC7:
+            return true;
+    }
+    return false;
+}
+
+} // namespace
+
+bool CompressedTextureFile::Open(const std::string& path) {
+    Close();
+
+    if (!VirtualFileSystem::Get().Read(path, m_File)) {
+        SHADOW_LOG_ERROR(Assets, "Failed to open texture container: {}", path);
+        return false;
+    }
+
+    const uint8_t* data = m_File.GetData();
+    const size_t size = m_File.GetSize();
+
+    FileHeader header;
+    if (size < sizeof(header)) {
+        SHADOW_LOG_ERROR(Assets, "Texture container too small: {}", path);
+        Close();
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+
+    if (header.magic != Magic) {
+        SHADOW_LOG_ERROR(Assets, "Not a texture container: {}", path);
+        Close();
+        return false;
+    }
+    if (header.version != Version) {
+        SHADOW_LOG_ERROR(Assets, "Unsupported texture container version {}: {}", header.version, path);
+        Close();
+        return false;
+    }
+    if (!IsKnownFormat(header.format) || header.width == 0 || header.height == 0 || header.mipCount == 0 ||
+        header.width > MaxDimension || header.height > MaxDimension) {
+        SHADOW_LOG_ERROR(Assets, "Corrupt texture container header: {}", path);
+        Close();
+        return false;
+    }
+
+    // A full chain ends at 1x1; Write never stores more levels than that
+    uint32_t maxMipCount = 1;
+    for (uint32_t extent = std::max(header.width, header.height); extent > 1; extent /= 2) {
+        ++maxMipCount;
+    }
+    if (header.mipCount > maxMipCount) {
+        SHADOW_LOG_ERROR(Assets, "Texture container has {} mips, more than {}x{} allows: {}",
+                         header.mipCount, header.width, header.height, path);
+        Close();
+        return false;
+    }
+
+    const size_t tableEnd = sizeof(FileHeader) + static_cast<size_t>(header.mipCount) * sizeof(MipEntry);
+    if (tableEnd > size) {
+        SHADOW_LOG_ERROR(Assets, "Truncated mip table: {}", path);
+        Close();
+        return false;
+    }
+
+    m_Format = static_cast<BlockCompression::Format>(header.format);
+    m_Width = static_cast<int>(header.width);
+    m_Height = static_cast<int>(header.height);
+    m_Flags = header.flags;
+    m_Mips.resize(header.mipCount);
+
+    // Each level halves the one above it (rounding down, never below 1) and
+    // holds exactly its block count times the block size, as Write lays it out
+    uint32_t mipWidth = header.width;
+    uint32_t mipHeight = header.height;
+    for (uint32_t level = 0; level < header.mipCount; ++level) {
+        MipEntry entry;
+        std::memcpy(&entry, data + sizeof(FileHeader) + level * sizeof(MipEntry), sizeof(entry));
+
+        if (entry.width != mipWidth || entry.height != mipHeight) {
+            SHADOW_LOG_ERROR(Assets, "Mip {} is {}x{}, expected {}x{}, in texture container: {}",
+                             level, entry.width, entry.height, mipWidth, mipHeight, path);
+            Close();
+            return false;
+        }
+
+        const uint64_t blocks = static_cast<uint64_t>((mipWidth + 3) / 4) * ((mipHeight + 3) / 4);
+        const uint64_t expected = blocks * BlockCompression::GetBlockSize(m_Format);
+        if (entry.size != expected || entry.offset < tableEnd ||
+            entry.offset > size || entry.size > size - entry.offset) {
+            SHADOW_LOG_ERROR(Assets, "Corrupt mip {} in texture container: {}", level, path);
+            Close();
+            return false;
+        }
+        mipWidth = std::max(1u, mipWidth / 2);
+        mipHeight = std::max(1u, mipHeight / 2);
+
+        Mip& mip = m_Mips[level];
+        mip.width = static_cast<int>(entry.width);
+        mip.height = static_cast<int>(entry.height);
+        mip.data = data + entry.offset;
+        mip.size = static_cast<size_t>(entry.size);
+    }
+
+    return true;
+}
+
+void CompressedTextureFile::Close() {
+    m_Mips.clear();
+    m_File = VirtualFileSystem::File();
+    m_Width = 0;
+    m_Height = 0;
+    m_Flags = 0;
+}
+
+size_t CompressedTextureFile::GetTotalPayloadSize() const {
+    size_t total = 0;
+    for (const Mip& mip : m_Mips) {
+        total += mip.size;
+    }
+    return total;
+}
+
+bool CompressedTextureFile::Write(const std::string& path, BlockCompression::Format format,
+                                  int width, int height, uint32_t flags,
+                                  const std::vector<std::vector<uint8_t>>& mips) {
+    if (mips.empty() || width <= 0 || height <= 0) {
+        SHADOW_LOG_ERROR(Assets, "Nothing to write to texture container: {}", path);
+        return false;
+    }
+
+    FileHeader header = {};
+    header.magic = Magic;
+    header.version = Version;
+    header.format = static_cast<uint32_t>(format);
+    header.width = static_cast<uint32_t>(width);
+    header.height = static_cast<uint32_t>(height);
+    header.mipCount = static_cast<uint32_t>(mips.size());
+    header.flags = flags;
+
+    std::vector<MipEntry> table(mips.size());
+    size_t offset = AlignUp(sizeof(FileHeader) + table.size() * sizeof(MipEntry), PayloadAlignment);
+    int mipWidth = width;
+    int mipHeight = height;
+    for (size_t level = 0; level < mips.size(); ++level) {
+        if (mips[level].size() != BlockCompression::GetCompressedSize(format, mipWidth, mipHeight)) {
+            SHADOW_LOG_ERROR(Assets, "Mip {} has the wrong size for {}x{} {}",
+                             level, mipWidth, mipHeight, BlockCompression::GetFormatName(format));
+            return false;
+        }
+        table[level].width = static_cast<uint32_t>(mipWidth);
+        table[level].height = static_cast<uint32_t>(mipHeight);
+        table[level].offset = offset;
+        table[level].size = mips[level].size();
+        offset = AlignUp(offset + mips[level].size(), PayloadAlignment);
+
+        mipWidth = std::max(1, mipWidth / 2);
+        mipHeight = std::max(1, mipHeight / 2);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        SHADOW_LOG_ERROR(Assets, "Failed to open texture container for writing: {}", path);
+        return false;
+    }
+
+    static const char padding[PayloadAlignment] = {};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(MipEntry)));
+
+    size_t written = sizeof(header) + table.size() * sizeof(MipEntry);
+    for (size_t level = 0; level < mips.size(); ++level) {
+        file.write(padding, static_cast<std::streamsize>(table[level].offset - written));
+        file.write(reinterpret_cast<const char*>(mips[level].data()), static_cast<std::streamsize>(mips[level].size()));
+        written = table[level].offset + mips[level].size();
+    }
+
+    if (!file.good()) {
+        SHADOW_LOG_ERROR(Assets, "Failed to write texture container: {}", path);
+        return false;
+    }
+    return true;
+}
+
+} // namespace ShadowEngine
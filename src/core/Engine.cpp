@@ -1,18 +1,35 @@
 #include "Engine.hpp"
 #include "scene/Scene.hpp"
-#include <iostream>
-#include <filesystem>
+#include "core/AllocationTracker.hpp"
+#include "core/FrameStatistics.hpp"
+#include "core/Log.hpp"
+#include "core/MemoryTracker.hpp"
+#include "core/Profiler.hpp"
+#include "core/VirtualFileSystem.hpp"
+#include "rendering/AssetManager.hpp"
+#include "rendering/RenderQueue.hpp"
+#include "rendering/FrameFences.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 
 namespace ShadowEngine {
 
 Engine::Engine()
     : m_IsInitialized(false)
     , m_IsRunning(false)
+    , m_IsHeadless(false)
+    , m_Backend(Rendering::BackendType::OpenGL)
 {
+    // Construct the profiler and the logger first so they outlive the engine,
+    // which may write the profile and report from its destructor
+    Profiler::Get();
+    Log::Get();
 }
 
 Engine::~Engine() {
     Shutdown();
+    WriteProfile();
 }
 
 Engine& Engine::GetInstance() {
@@ -20,26 +37,28 @@ Engine& Engine::GetInstance() {
     return instance;
 }
 
-bool Engine::Initialize(const std::string& windowTitle, int windowWidth, int windowHeight) {
+bool Engine::Initialize(const std::string& windowTitle, int windowWidth, int windowHeight,
+                        Rendering::BackendType backend) {
     if (m_IsInitialized) {
-        std::cerr << "Engine already initialized!" << std::endl;
+        SHADOW_LOG_ERROR(Core, "Engine already initialized!");
         return false;
     }
 
     // Store window parameters
+    m_Backend = backend;
     m_WindowTitle = windowTitle;
     m_WindowWidth = windowWidth;
     m_WindowHeight = windowHeight;
 
     // Create and initialize window
     if (!InitializeWindow()) {
-        std::cerr << "Failed to initialize window!" << std::endl;
+        SHADOW_LOG_ERROR(Core, "Failed to initialize window!");
         return false;
     }
 
     // Initialize other engine systems
     if (!InitializeSystems()) {
-        std::cerr << "Failed to initialize engine systems!" << std::endl;
+        SHADOW_LOG_ERROR(Core, "Failed to initialize engine systems!");
         Shutdown();
         return false;
     }
@@ -47,7 +66,45 @@ bool Engine::Initialize(const std::string& windowTitle, int windowWidth, int win
     m_IsInitialized = true;
     return true;
 }
+
+bool Engine::InitializeHeadless(const HeadlessOptions& options) {
+    if (m_IsInitialized) {
+        SHADOW_LOG_ERROR(Core, "Engine already initialized!");
+        return false;
+    }
+
+    m_IsHeadless = true;
+    m_HeadlessOptions = options;
+    m_Backend = options.Backend;
+    m_WindowTitle = "Shadow Engine (headless)";
+    m_WindowWidth = options.Width;
+    m_WindowHeight = options.Height;
+
+    // The null backend never touches GL, so it needs no context or driver at all
+    if (Rendering::BackendRequiresContext(m_Backend)) {
+        m_HeadlessContext = std::make_unique<HeadlessContext>();
+        if (!m_HeadlessContext->Initialize()) {
+            SHADOW_LOG_ERROR(Core, "Failed to create headless context!");
+            m_HeadlessContext.reset();
+            m_IsHeadless = false;
+            return false;
+        }
+    }
+
+    if (!InitializeSystems()) {
+        SHADOW_LOG_ERROR(Core, "Failed to initialize engine systems!");
+        ShutdownSystems();
+        m_HeadlessContext.reset();
+        m_IsHeadless = false;
+        return false;
+    }
+
+    m_IsInitialized = true;
+    return true;
+}
+
 void Engine::SetScene(ScenePtr scene) {
+    MemoryScope memoryScope(MemoryTag::Scene);
     if (m_Scene) {
         m_Scene->OnDetach();
     }
@@ -58,56 +115,558 @@ void Engine::SetScene(ScenePtr scene) {
 }
 
 
+void Engine::SetFramePacing(const FramePacer::Settings& settings) {
+    m_PacingSettings = settings;
+    if (m_IsInitialized) {
+        ConfigurePacing();
+    }
+}
+
+bool Engine::SetProfileOutput(const std::string& path) {
+    if (!Profiler::IsCompiledIn()) {
+        SHADOW_LOG_ERROR(Core, "Profiling is compiled out of this build; configure with -DSHADOW_ENABLE_PROFILER=ON");
+        return false;
+    }
+    m_ProfileOutput = path;
+    SHADOW_PROFILE_THREAD("Main");
+    Profiler::Get().Start();
+    return true;
+}
+
+void Engine::WriteProfile() {
+    if (m_ProfileOutput.empty()) {
+        return;
+    }
+    Profiler& profiler = Profiler::Get();
+    profiler.Stop();
+    const Profiler::Stats stats = profiler.GetStats();
+    if (profiler.WriteChromeTrace(m_ProfileOutput)) {
+        if (stats.overwritten > 0) {
+            SHADOW_LOG_INFO(Core, "Profile: {} zones from {} threads written to {} ({} oldest overwritten)",
+                            stats.recorded, stats.threads, m_ProfileOutput, stats.overwritten);
+        } else {
+            SHADOW_LOG_INFO(Core, "Profile: {} zones from {} threads written to {}", stats.recorded, stats.threads,
+                            m_ProfileOutput);
+        }
+    }
+    m_ProfileOutput.clear();
+}
+
+bool Engine::SetMemoryOptions(const MemoryOptions& options) {
+    m_MemoryOptions = options;
+    m_MemoryOptions.LogInterval = std::max(1, options.LogInterval);
+    m_MemoryLog.close();
+    if (options.LogPath.empty()) {
+        return true;
+    }
+
+    m_MemoryLog.open(options.LogPath);
+    if (!m_MemoryLog) {
+        SHADOW_LOG_ERROR(Core, "Failed to open memory log: {}", options.LogPath);
+        return false;
+    }
+    MemoryTracker::WriteCsvHeader(m_MemoryLog);
+    return true;
+}
+
+void Engine::WriteMemorySnapshot() {
+    if (m_MemoryLog.is_open()) {
+        MemoryTracker::WriteCsvRows(m_MemoryLog, MemoryTracker::Get().TakeSnapshot(m_FrameIndex));
+    }
+}
+
+void Engine::SetTimestep(const TimestepOptions& options) {
+    m_Timestep = options;
+    if (m_Timestep.FixedDeltaTime <= 0.0) {
+        SHADOW_LOG_WARNING(Core, "Invalid fixed timestep, using 1/60 s");
+        m_Timestep.FixedDeltaTime = 1.0 / 60.0;
+    }
+    m_Timestep.MaxStepsPerFrame = std::max(1, m_Timestep.MaxStepsPerFrame);
+}
+
+void Engine::RegisterEngineSystems() {
+    if (m_Scheduler.HasSystem("Input")) {
+        return;  // Initialized before
+    }
+
+    // All three stay on the main thread: GLFW must be polled there, scenes use
+    // the frame allocator and the context is current there unless pipelined
+    SystemDesc input;
+    input.name = "Input";
+    input.mainThread = true;
+    input.writes = {"Input", "Events"};
+    input.run = [this]() {
+        MemoryScope memoryScope(MemoryTag::Input);
+        if (m_Window) {
+            // Begin new input frame (copies previous state, resets deltas),
+            // then process input events (mouse move, keys, etc.)
+            m_InputManager->Update();
+            m_Window->PollEvents();
+        }
+        // Deliver those with whatever other threads posted since the last frame
+        m_EventBus.Dispatch();
+    };
+
+    SystemDesc simulation;
+    simulation.name = "Simulation";
+    simulation.mainThread = true;
+    simulation.reads = {"Input"};
+    simulation.writes = {"Scene", "RenderQueue"};
+    simulation.after = {"Input"};
+    simulation.run = [this]() {
+        // Run the fixed steps this frame owes, then the per-frame update
+        MemoryScope memoryScope(MemoryTag::Scene);
+        AdvanceSimulation(m_FrameSeconds);
+        if (m_Scene) {
+            SHADOW_PROFILE_ZONE("Scene::Update");
+            m_Scene->Update(static_cast<float>(m_FrameSeconds));
+        }
+    };
+
+    SystemDesc render;
+    render.name = "Render";
+    render.mainThread = true;
+    render.writes = {"RenderQueue", "Gpu"};
+    render.after = {"Simulation"};
+    render.run = [this]() {
+        if (m_RenderFrame) {
+            m_RenderFrame();
+        }
+    };
+
+    m_Scheduler.Register(std::move(input));
+    m_Scheduler.Register(std::move(simulation));
+    m_Scheduler.Register(std::move(render));
+}
+
+void Engine::AdvanceSimulation(double frameSeconds) {
+    const double step = m_Timestep.FixedDeltaTime;
+    m_Accumulator += frameSeconds;
+
+    int steps = 0;
+    while (m_Accumulator >= step) {
+        if (steps == m_Timestep.MaxStepsPerFrame) {
+            // Spiral-of-death guard: drop whole steps but keep the fraction so
+            // the interpolation alpha stays continuous
+            const double dropped = m_Accumulator - std::fmod(m_Accumulator, step);
+            m_Accumulator -= dropped;
+            m_DroppedSeconds += dropped;
+            ++m_CappedFrames;
+            break;
+        }
+        if (m_Scene) {
+            SHADOW_PROFILE_ZONE("Scene::FixedUpdate");
+            m_Scene->FixedUpdate(static_cast<float>(step));
+        }
+        m_Accumulator -= step;
+        ++steps;
+    }
+    m_FixedSteps += steps;
+
+    if (m_Scene) {
+        m_Scene->SetInterpolationAlpha(static_cast<float>(m_Accumulator / step));
+    }
+}
+
+void Engine::PrintSimulationSummary() const {
+    SHADOW_LOG_INFO(Core, "Simulation: {} fixed steps at {:.3} Hz; {} frames hit the {}-step cap, {:.3} s dropped",
+                    m_FixedSteps, 1.0 / m_Timestep.FixedDeltaTime, m_CappedFrames, m_Timestep.MaxStepsPerFrame,
+                    m_DroppedSeconds);
+}
+
+void Engine::ResetStats() {
+    m_FixedSteps = 0;
+    m_CappedFrames = 0;
+    m_DroppedSeconds = 0.0;
+    m_Scheduler.ResetStats();
+    m_FrameAllocator.ResetStats();
+    MemoryTracker::Get().ResetPeaks();
+    m_FrameIndex = 0;
+}
+
+void Engine::BeginFrameMemory() {
+    m_FrameAllocator.Reset();
+    AllocationTracker::Get().BeginFrame();
+}
+
+void Engine::EndFrameMemory() {
+    AllocationTracker::Get().EndFrame();
+
+    // Warnings and snapshots are taken here, outside operator new
+    ++m_FrameIndex;
+    MemoryTracker::Get().CheckBudgets();
+    if (m_FrameIndex % static_cast<uint64_t>(m_MemoryOptions.LogInterval) == 0) {
+        WriteMemorySnapshot();
+    }
+}
+
+void Engine::PrintMemorySummary() {
+    const FrameAllocator::Stats arena = m_FrameAllocator.GetStats();
+    if (arena.highWater > 0) {
+        SHADOW_LOG_INFO(Core, "Frame allocator: {} KB peak of {} KB, {} overflow blocks", arena.highWater / 1024,
+                        arena.capacity / 1024, arena.overflowBlocks);
+    }
+    SHADOW_LOG_REPORT(Info, Core, [](std::ostream& out) { AllocationTracker::Get().PrintSummary(out); });
+    SHADOW_LOG_REPORT(Info, Core, [this](std::ostream& out) {
+        MemoryTracker::PrintReport(out, MemoryTracker::Get().TakeSnapshot(m_FrameIndex));
+    });
+}
+
+void Engine::StartRenderThread(std::function<void()> frame) {
+    // Hand the context over; GL calls on this thread are invalid until it returns
+    if (m_Window) {
+        m_Window->ReleaseContext();
+    } else if (m_HeadlessContext) {
+        m_HeadlessContext->ReleaseContext();
+    }
+
+    m_RenderThread = std::make_unique<RenderThread>();
+    m_RenderThread->Start(
+        [this]() {
+            if (m_Window) {
+                m_Window->MakeContextCurrent();
+            } else if (m_HeadlessContext) {
+                m_HeadlessContext->MakeContextCurrent();
+            }
+        },
+        std::move(frame),
+        [this]() {
+            if (m_Window) {
+                m_Window->ReleaseContext();
+            } else if (m_HeadlessContext) {
+                m_HeadlessContext->ReleaseContext();
+            }
+        });
+}
+
+void Engine::StopRenderThread() {
+    if (!m_RenderThread) {
+        return;
+    }
+    m_RenderThread->Stop();
+
+    // Take the context back for shutdown
+    if (m_Window) {
+        m_Window->MakeContextCurrent();
+    } else if (m_HeadlessContext) {
+        m_HeadlessContext->MakeContextCurrent();
+    }
+
+    const uint64_t frames = m_RenderThread->GetFrameCount();
+    if (frames > 0) {
+        SHADOW_LOG_INFO(Core,
+                        "Pipeline: render thread busy {:.3} ms per frame, simulation waited {:.3} ms per frame for it",
+                        m_RenderThread->GetBusyMs() / frames, m_RenderThread->GetWaitMs() / frames);
+    }
+    m_RenderThread.reset();
+}
+
+void Engine::ConfigurePacing() {
+    // Headless frames have no blocking swap to synchronise with
+    FramePacer::Settings settings = m_PacingSettings;
+    settings.vsync = settings.vsync && m_Window;
+
+    double refreshRate = 0.0;
+    if (m_Window) {
+        m_Window->SetVSync(settings.vsync);
+        if (const GLFWvidmode* mode = glfwGetVideoMode(glfwGetPrimaryMonitor())) {
+            refreshRate = mode->refreshRate;
+        }
+    }
+    m_FramePacer.Configure(settings, refreshRate);
+
+    if (m_RenderSystem && m_RenderSystem->HasContext()) {
+        if (!m_FrameFences) {
+            m_FrameFences = std::make_unique<Rendering::FrameFences>();
+        }
+        m_FrameFences->SetMaxQueuedFrames(m_PacingSettings.maxQueuedFrames);
+    }
+}
+
 void Engine::Shutdown() {
     if (!m_IsInitialized) {
         return;
     }
 
     ShutdownSystems();
+    m_HeadlessContext.reset();
     m_IsInitialized = false;
     m_IsRunning = false;
+
+    // Every GPU object has been released by now, so anything left is a leak
+    MemoryTracker& memory = MemoryTracker::Get();
+    for (size_t tag = 0; tag < static_cast<size_t>(MemoryTag::Count); ++tag) {
+        const MemoryTracker::Usage usage = memory.GetUsage(static_cast<MemoryTag>(tag), MemoryDomain::Gpu);
+        if (usage.current != 0) {
+            SHADOW_LOG_WARNING(Core, "Warning: {} bytes of {} GPU memory still allocated at shutdown", usage.current,
+                               MemoryTracker::GetTagName(static_cast<MemoryTag>(tag)));
+        }
+    }
+    WriteMemorySnapshot();
+    m_MemoryLog.close();
+
+    // Every thread that records zones has been joined by now
+    WriteProfile();
+    Log::Get().Flush();
 }
 
 void Engine::Run() {
     if (!m_IsInitialized) {
-        std::cerr << "Engine not initialized!" << std::endl;
+        SHADOW_LOG_ERROR(Core, "Engine not initialized!");
         return;
     }
 
     m_IsRunning = true;
-    std::cout << "Engine started running..." << std::endl;
+    SHADOW_LOG_INFO(Core, "Engine started running...");
+
+    {
+        SHADOW_PROFILE_ZONE("Engine::Run");
+        if (m_IsHeadless) {
+            RunHeadless();
+        } else {
+            RunWindowed();
+        }
+    }
+    Shutdown();
+}
 
+void Engine::RunWindowed() {
+    using Clock = std::chrono::steady_clock;
+    FrameStatistics frameTimes;
+    FrameStatistics latency;
+    frameTimes.Reserve(1 << 16);  // About 18 minutes at 60 Hz before the first regrowth
+    latency.Reserve(1 << 16);
+    AllocationTracker::Get().SetWarmupFrames(10);
+    Clock::time_point lastFrameStart = Clock::now();
     double lastTime = glfwGetTime();
 
+    // Present the rendered frame and track the latency of the input it used
+    auto present = [&](Clock::time_point inputTime) {
+        {
+            SHADOW_PROFILE_ZONE("Present");
+            m_Window->SwapBuffers();
+        }
+        if (m_FrameFences) {
+            m_FrameFences->Insert(inputTime);
+        } else {
+            latency.AddSample(std::chrono::duration<double, std::milli>(Clock::now() - inputTime).count());
+        }
+    };
+
+    // Pipelined, the render thread draws the published frame and owns the fences
+    Clock::time_point inputTime;
+    Clock::time_point publishedInputTime;
+    if (m_Pipelined) {
+        StartRenderThread([&]() {
+            if (m_FrameFences) {
+                m_FrameFences->WaitForSlot(&latency);
+            }
+            m_RenderSystem->RenderPublished();
+            present(publishedInputTime);
+        });
+    }
+
+    m_RenderFrame = [&]() {
+        if (m_Pipelined) {
+            // The previous frame must be done with its snapshot before this one
+            // is published over it; the render thread then draws while the
+            // next iteration simulates
+            m_RenderThread->Wait();
+            m_RenderSystem->PublishFrame(m_FrameIndex);
+            publishedInputTime = inputTime;
+            m_RenderThread->Kick();
+        } else {
+            m_RenderSystem->Render(m_FrameIndex);
+            present(inputTime);
+        }
+    };
+
     // Main game loop
     while (m_IsRunning && !m_Window->ShouldClose()) {
+        SHADOW_PROFILE_ZONE("Frame");
+        // Keep the GPU queue short, then wait for this frame's slot (late latch)
+        if (m_FrameFences && !m_Pipelined) {
+            m_FrameFences->WaitForSlot(&latency);
+        }
+        m_FramePacer.BeginFrame();
+        BeginFrameMemory();
+
+        // Everything from here to the swap is latency for this frame's input
+        inputTime = Clock::now();
+        frameTimes.AddSample(std::chrono::duration<double, std::milli>(inputTime - lastFrameStart).count());
+        lastFrameStart = inputTime;
+
         double currentTime = glfwGetTime();
-        float deltaTime = static_cast<float>(currentTime - lastTime);
+        m_FrameSeconds = currentTime - lastTime;
         lastTime = currentTime;
 
-        // Begin new input frame (copies previous state, resets deltas)
-        if (m_InputManager) {
-            m_InputManager->Update();
+        // Input, simulation, render and whatever the game registered
+        m_Scheduler.Run(m_JobSystem.get());
+
+        EndFrameMemory();
+        m_FramePacer.EndFrame();
+    }
+    StopRenderThread();
+    m_RenderFrame = nullptr;
+
+    const std::string pacing = std::string(FramePacer::GetModeName(m_PacingSettings.mode)) +
+                               ", VSync " + (m_PacingSettings.vsync ? "on" : "off");
+    SHADOW_LOG_REPORT(Info, Core, [&](std::ostream& out) { frameTimes.Print(out, "Frame times (" + pacing + ")"); });
+    if (latency.GetCount() > 0) {
+        SHADOW_LOG_REPORT(Info, Core, [&](std::ostream& out) {
+            latency.PrintDurations(out, "Input-to-present latency");
+        });
+    }
+    PrintSimulationSummary();
+    SHADOW_LOG_REPORT(Info, Core, [&](std::ostream& out) { m_Scheduler.Print(out); });
+    PrintMemorySummary();
+}
+
+void Engine::RunHeadless() {
+    using Clock = std::chrono::steady_clock;
+
+    // Frames advance a fixed 1/60 s of game time regardless of how long they
+    // take, so every run simulates and draws the same frames and captures from
+    // different builds are comparable
+    const double frameSeconds = 1.0 / 60.0;
+    const HeadlessOptions& options = m_HeadlessOptions;
+    const bool timed = options.DurationSeconds > 0.0;
+
+    FrameStatistics stats;
+    FrameStatistics latency;
+    stats.Reserve(timed ? 1 << 16 : static_cast<size_t>(options.FrameCount));
+    latency.Reserve(timed ? 1 << 16 : static_cast<size_t>(options.FrameCount));
+    AllocationTracker::Get().SetWarmupFrames(options.WarmupFrames);
+
+    // Mean CPU preparation cost per measured frame
+    Rendering::RenderQueue::Stats queueTotals;
+    auto addQueueStats = [&]() {
+        const Rendering::RenderQueue::Stats& queue = m_RenderSystem->GetRenderQueue().GetStats();
+        queueTotals.submitted += queue.submitted;
+        queueTotals.visible += queue.visible;
+        queueTotals.cullMs += queue.cullMs;
+        queueTotals.sortMs += queue.sortMs;
+        queueTotals.packMs += queue.packMs;
+    };
+
+    // Pipelined, the render thread draws the published frame, waiting for the
+    // GPU as the serial loop does
+    Clock::time_point frameStart;
+    int measuredFrame = 0;
+    Clock::time_point publishedFrameStart;
+    int publishedMeasuredFrame = 0;
+    if (m_Pipelined) {
+        StartRenderThread([&]() {
+            if (m_FrameFences) {
+                m_FrameFences->WaitForSlot(publishedMeasuredFrame > 0 ? &latency : nullptr);
+            }
+            m_RenderSystem->RenderPublished();
+            m_RenderSystem->Finish();
+            if (m_FrameFences) {
+                m_FrameFences->Insert(publishedFrameStart);
+            }
+            if (publishedMeasuredFrame >= 0) {
+                addQueueStats();
+            }
+        });
+    }
+
+    // Warmup frames are drawn but not captured. Once the last of them has
+    // finished drawing, the renderer's statistics start over with the rest.
+    m_RenderSystem->SetCapturePaused(options.WarmupFrames > 0);
+    auto startMeasuring = [&]() {
+        if (measuredFrame == 0) {
+            m_RenderSystem->ResetStats();
+            m_RenderSystem->SetCapturePaused(false);
         }
+    };
 
-        // Process input events (mouse move, keys, etc.)
-        m_Window->PollEvents();
+    m_RenderFrame = [&]() {
+        if (m_Pipelined) {
+            // Samples then cover simulating this frame plus waiting for the
+            // previous one to finish drawing, i.e. the pipeline's frame interval
+            m_RenderThread->Wait();
+            startMeasuring();
+            m_RenderSystem->PublishFrame(m_FrameIndex);
+            publishedFrameStart = frameStart;
+            publishedMeasuredFrame = measuredFrame;
+            m_RenderThread->Kick();
+        } else {
+            startMeasuring();
+            m_RenderSystem->Render(m_FrameIndex);
 
-        // Update active scene (game state)
-        if (m_Scene) {
-            m_Scene->Update(deltaTime);
+            // There is no swap to pace the loop; wait for the GPU so every sample
+            // covers the whole frame rather than just command submission
+            m_RenderSystem->Finish();
+            if (m_FrameFences) {
+                m_FrameFences->Insert(frameStart);
+            }
+            if (measuredFrame >= 0) {
+                addQueueStats();
+            }
+        }
+    };
+
+    m_FrameSeconds = frameSeconds;
+    Clock::time_point measureStart = Clock::now();
+    for (int frame = 0; m_IsRunning; ++frame) {
+        measuredFrame = frame - options.WarmupFrames;
+        if (measuredFrame == 0) {
+            measureStart = Clock::now();
+        }
+        if (measuredFrame >= 0) {
+            if (timed) {
+                std::chrono::duration<double> elapsed = Clock::now() - measureStart;
+                if (elapsed.count() >= options.DurationSeconds) break;
+            } else if (measuredFrame >= options.FrameCount) {
+                break;
+            }
         }
 
-        // Render frame
-        if (m_RenderSystem) {
-            m_RenderSystem->Render();
+        SHADOW_PROFILE_ZONE("Frame");
+        if (m_FrameFences && !m_Pipelined) {
+            m_FrameFences->WaitForSlot(measuredFrame > 0 ? &latency : nullptr);
+        }
+        m_FramePacer.BeginFrame();
+        BeginFrameMemory();
+        if (measuredFrame == 0) {
+            // Every report covers the measured frames only
+            ResetStats();
+        }
+        frameStart = Clock::now();
+        m_Scheduler.Run(m_JobSystem.get());
+
+        if (measuredFrame >= 0) {
+            stats.AddSample(std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count());
         }
 
-        // Swap buffers
-        m_Window->SwapBuffers();
+        EndFrameMemory();
+        m_FramePacer.EndFrame();
     }
+    StopRenderThread();
+    m_RenderFrame = nullptr;
 
-    Shutdown();
+    SHADOW_LOG_REPORT(Info, Core, [&](std::ostream& out) {
+        stats.Print(out, "Headless run " + std::to_string(options.Width) + "x" + std::to_string(options.Height) +
+                         ", " + Rendering::GetBackendName(m_Backend) + " backend" +
+                         (m_Pipelined ? ", pipelined" : ""));
+    });
+
+    const size_t frames = stats.GetCount();
+    if (frames > 0) {
+        SHADOW_LOG_INFO(Rendering,
+                        "Render queue per frame: {} submitted, {} visible; cull {:.3} ms, sort {:.3} ms, pack {:.3} ms",
+                        queueTotals.submitted / frames, queueTotals.visible / frames, queueTotals.cullMs / frames,
+                        queueTotals.sortMs / frames, queueTotals.packMs / frames);
+    }
+    if (latency.GetCount() > 0) {
+        SHADOW_LOG_REPORT(Info, Core, [&](std::ostream& out) {
+            latency.PrintDurations(out, "Update-to-completion latency");
+        });
+    }
+    PrintSimulationSummary();
+    SHADOW_LOG_REPORT(Info, Core, [&](std::ostream& out) { m_Scheduler.Print(out); });
+    PrintMemorySummary();
 }
 
 bool Engine::InitializeWindow() {
@@ -115,52 +674,78 @@ bool Engine::InitializeWindow() {
     props.Title = m_WindowTitle;
     props.Width = m_WindowWidth;
     props.Height = m_WindowHeight;
-    props.VSync = true;
+    props.VSync = m_PacingSettings.vsync;
     props.Fullscreen = false;
     
-    // Try to find the icon in different possible locations
-    std::string iconPath = "C:/ShadowEngine/assets/icons/B.png";
-    if (!std::filesystem::exists(iconPath)) {
-        // Try the build directory
-        iconPath = "build/windows/x64/Debug/bin/assets/icons/tree.png";
-        if (!std::filesystem::exists(iconPath)) {
-            // If icon not found, just continue without it
-            std::cerr << "Warning: Icon file not found. Window will use default icon." << std::endl;
-            iconPath.clear();
-        }
+    // Resolved through the VFS, so the icon may come from a pack or a loose file
+    const std::string iconPath = "assets/icons/B.png";
+    if (VirtualFileSystem::Get().Exists(iconPath)) {
+        props.IconPath = iconPath;
+    } else {
+        // If icon not found, just continue without it
+        SHADOW_LOG_WARNING(Core, "Warning: Icon file not found. Window will use default icon.");
     }
-    props.IconPath = iconPath;
 
     m_Window = std::make_unique<Window>(props);
+    m_Window->SetEventBus(&m_EventBus);
     return m_Window->Initialize();
 }
 
 bool Engine::InitializeSystems() {
+    // Workers first: every other system may schedule jobs from the start
+    m_JobSystem = std::make_unique<JobSystem>(m_JobSettings);
+    SHADOW_LOG_INFO(Core, "Job system: {} workers{}", m_JobSystem->GetWorkerCount(),
+                    m_JobSettings.pinWorkers ? ", pinned" : "");
+
     // Initialize render system
-    m_RenderSystem = std::make_unique<Rendering::RenderSystem>();
-    if (!m_RenderSystem->Initialize(m_Window->GetNativeWindow())) {
-        std::cerr << "Failed to initialize render system!" << std::endl;
-        return false;
+    {
+        MemoryScope memoryScope(MemoryTag::Rendering);
+        m_RenderSystem = std::make_unique<Rendering::RenderSystem>();
+        m_RenderSystem->SetJobSystem(m_JobSystem.get());
+        bool renderReady = m_IsHeadless
+            ? m_RenderSystem->InitializeHeadless(m_HeadlessContext ? HeadlessContext::GetProcLoader() : nullptr,
+                                                 m_WindowWidth, m_WindowHeight, m_Backend)
+            : m_RenderSystem->Initialize(m_Window->GetNativeWindow(), m_Backend);
+        if (!renderReady) {
+            SHADOW_LOG_ERROR(Rendering, "Failed to initialize render system!");
+            return false;
+        }
+        m_RenderSystem->GetAssetManager().SetEventBus(&m_EventBus);
+        m_RenderSystem->GetAssetManager().SetOpaqueTextureFormat(m_OpaqueTextureFormat);
     }
     
-    // Initialize input system
-    m_InputManager = std::make_unique<Input::InputManager>();
-    if (!m_InputManager->Initialize(m_Window->GetNativeWindow())) {
-        std::cerr << "Failed to initialize input system!" << std::endl;
-        return false;
+    // Initialize input system. Headless runs keep an idle manager so scenes can
+    // still query it; it never receives events.
+    {
+        MemoryScope memoryScope(MemoryTag::Input);
+        m_InputManager = std::make_unique<Input::InputManager>();
+        m_InputManager->SetEventBus(&m_EventBus);
+        if (!m_IsHeadless && !m_InputManager->Initialize(m_Window->GetNativeWindow())) {
+            SHADOW_LOG_ERROR(Input, "Failed to initialize input system!");
+            return false;
+        }
     }
 
     // Create a default test scene so that something is visible by default.
-    m_Scene = std::make_unique<TestScene>(*m_RenderSystem, *m_InputManager);
-    if (m_Scene) {
-        m_Scene->OnAttach();
+    {
+        MemoryScope memoryScope(MemoryTag::Scene);
+        m_Scene = std::make_unique<TestScene>(*m_RenderSystem, *m_InputManager);
+        if (m_Scene) {
+            m_Scene->OnAttach();
+        }
     }
 
-    std::cout << "Initializing engine systems..." << std::endl;
+    RegisterEngineSystems();
+    ConfigurePacing();
+
+    SHADOW_LOG_INFO(Core, "Initializing engine systems...");
     return true;
 }
 
 void Engine::ShutdownSystems() {
+    // Fences belong to the context the render system is about to release
+    m_FrameFences.reset();
+
     // Shutdown input system
     if (m_InputManager) {
         m_InputManager.reset();
@@ -176,8 +761,31 @@ void Engine::ShutdownSystems() {
     if (m_RenderSystem) {
         m_RenderSystem.reset();
     }
+
+    // Shutdown job system last; the systems above may still have queued work
+    if (m_JobSystem) {
+        const JobSystem::Stats stats = m_JobSystem->GetStats();
+        SHADOW_LOG_INFO(Core, "Job system ran {} jobs ({} stolen)", stats.executed, stats.stolen);
+        m_JobSystem.reset();
+    }
+
+    // Every producer is gone; drop what they left and the subscriptions
+    const EventBus::Stats events = m_EventBus.GetStats();
+    if (events.posted > 0) {
+        SHADOW_LOG_INFO(Core, "Event bus: {} posted, {} dispatched in {} batches, peak depth {} of {}, {} dropped",
+                        events.posted, events.dispatched, events.batches, events.peakDepth, events.capacity,
+                        events.dropped);
+    }
+    m_EventBus.Clear();
+
+    const VirtualFileSystem& vfs = VirtualFileSystem::Get();
+    if (vfs.GetMountCount() > 0) {
+        const VirtualFileSystem::Stats stats = vfs.GetStats();
+        SHADOW_LOG_INFO(Assets, "Files: {} read from {} packs ({} KB decompressed), {} loose", stats.packReads,
+                        vfs.GetMountCount(), stats.decompressedBytes / 1024, stats.looseReads);
+    }
     
-    std::cout << "Shutting down engine systems..." << std::endl;
+    SHADOW_LOG_INFO(Core, "Shutting down engine systems...");
 }
 
 } // namespace ShadowEngine 
\ No newline at end of file
@@ -0,0 +1,250 @@
+#include "core/EventBus.hpp"
+#include "core/Log.hpp"
+#include "core/Profiler.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace ShadowEngine {
+
+namespace EventBusDetail {
+
+uint32_t NextTypeId() {
+    static std::atomic<uint32_t> s_NextTypeId{0};
+    return s_NextTypeId.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace EventBusDetail
+
+// A slot holds position p when its sequence is p (free for the producer that
+// claims p), p + 1 once that event is published, and p + capacity after the
+// owning thread has copied it out, which frees it for the next lap.
+struct alignas(64) EventBus::Slot {
+    std::atomic<uint64_t> sequence{0};
+    uint32_t type = 0;
+    uint32_t size = 0;
+    alignas(16) unsigned char data[PayloadBytes];
+};
+
+EventBus::EventBus(size_t capacity)
+    : m_Head(0)
+    , m_Dropped(0)
+    , m_Tail(0)
+    , m_NextSubscription(1)
+    , m_Dispatching(false)
+    , m_HasRemovals(false)
+    , m_ReportedDrops(0)
+    , m_Dispatched(0)
+    , m_Batches(0)
+    , m_LastDepth(0)
+    , m_PeakDepth(0) {
+    size_t rounded = 1;
+    while (rounded < std::max<size_t>(capacity, 2)) {
+        rounded <<= 1;
+    }
+    m_Slots = std::make_unique<Slot[]>(rounded);
+    m_Mask = rounded - 1;
+    for (size_t i = 0; i < rounded; ++i) {
+        m_Slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+EventBus::~EventBus() = default;
+
+bool EventBus::PostRaw(uint32_t type, const void* events, size_t size, size_t count) {
+    if (count > m_Mask + 1) {
+        m_Dropped.fetch_add(count, std::memory_order_relaxed);
+        return false;
+    }
+
+    // The owning thread frees slots in order, so when the last slot of the
+    // range is free, all of them are
+    uint64_t position = m_Head.load(std::memory_order_relaxed);
+    while (true) {
+        const uint64_t last = position + count - 1;
+        const uint64_t sequence = m_Slots[last & m_Mask].sequence.load(std::memory_order_acquire);
+        const int64_t lag = static_cast<int64_t>(sequence - last);
+        if (lag == 0) {
+            if (m_Head.compare_exchange_weak(position, position + count, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (lag < 0) {
+            m_Dropped.fetch_add(count, std::memory_order_relaxed);
+            return false;
+        } else {
+            position = m_Head.load(std::memory_order_relaxed);
+        }
+    }
+
+    const unsigned char* bytes = static_cast<const unsigned char*>(events);
+    for (size_t i = 0; i < count; ++i) {
+        Slot& slot = m_Slots[(position + i) & m_Mask];
+        slot.type = type;
+        slot.size = static_cast<uint32_t>(size);
+        std::memcpy(slot.data, bytes + i * size, size);
+        slot.sequence.store(position + i + 1, std::memory_order_release);
+    }
+    return true;
+}
+
+EventBus::SubscriptionId EventBus::SubscribeRaw(uint32_t type, std::function<void(const void*)> handler) {
+    const SubscriptionId id = m_NextSubscription++;
+    if (m_Dispatching) {
+        // Adding now could move the list a handler is running from
+        m_PendingSubscribers.push_back({type, Subscriber{id, std::move(handler)}});
+        return id;
+    }
+    if (type >= m_Subscribers.size()) {
+        m_Subscribers.resize(type + 1);
+    }
+    m_Subscribers[type].push_back({id, std::move(handler)});
+    return id;
+}
+
+void EventBus::Unsubscribe(SubscriptionId id) {
+    if (id == 0) {
+        return;
+    }
+    for (auto& pending : m_PendingSubscribers) {
+        if (pending.second.id == id) {
+            pending.second.id = 0;
+            m_HasRemovals = true;
+            return;
+        }
+    }
+    for (std::vector<Subscriber>& list : m_Subscribers) {
+        for (auto it = list.begin(); it != list.end(); ++it) {
+            if (it->id != id) {
+                continue;
+            }
+            if (m_Dispatching) {
+                // The handler may be the one running; drop it afterwards
+                it->id = 0;
+                m_HasRemovals = true;
+            } else {
+                list.erase(it);
+            }
+            return;
+        }
+    }
+}
+
+void EventBus::Deliver(uint32_t type, const void* event) {
+    if (type >= m_Subscribers.size()) {
+        return;
+    }
+    for (const Subscriber& subscriber : m_Subscribers[type]) {
+        if (subscriber.id != 0) {
+            subscriber.handler(event);
+        }
+    }
+}
+
+size_t EventBus::Dispatch() {
+    if (m_Dispatching) {
+        return 0;  // Called from a handler
+    }
+    SHADOW_PROFILE_ZONE("EventBus::Dispatch");
+
+    const uint64_t dropped = m_Dropped.load(std::memory_order_relaxed);
+    if (dropped != m_ReportedDrops) {
+        SHADOW_LOG_WARNING(Core, "EventBus: {} events dropped (queue full)", dropped - m_ReportedDrops);
+        m_ReportedDrops = dropped;
+    }
+
+    // Only what was claimed before now; handlers that post feed the next call
+    uint64_t tail = m_Tail.load(std::memory_order_relaxed);
+    const uint64_t end = m_Head.load(std::memory_order_acquire);
+    m_LastDepth = static_cast<size_t>(end - tail);
+    m_PeakDepth = std::max(m_PeakDepth, m_LastDepth);
+    if (tail == end) {
+        return 0;
+    }
+
+    // Copy a batch out and free its slots before running any handler, so
+    // producers are never held up by slow subscribers
+    struct Pending {
+        uint32_t type;
+        alignas(16) unsigned char data[PayloadBytes];
+    };
+    Pending batch[BatchSize];
+
+    m_Dispatching = true;
+    size_t delivered = 0;
+    while (tail < end) {
+        size_t count = 0;
+        while (count < BatchSize && tail < end) {
+            Slot& slot = m_Slots[tail & m_Mask];
+            if (slot.sequence.load(std::memory_order_acquire) != tail + 1) {
+                break;  // Claimed but still being written
+            }
+            batch[count].type = slot.type;
+            std::memcpy(batch[count].data, slot.data, slot.size);
+            slot.sequence.store(tail + m_Mask + 1, std::memory_order_release);
+            ++tail;
+            ++count;
+        }
+        m_Tail.store(tail, std::memory_order_relaxed);
+        if (count == 0) {
+            break;  // The rest waits for the next call rather than spinning on a producer
+        }
+
+        ++m_Batches;
+        for (size_t i = 0; i < count; ++i) {
+            Deliver(batch[i].type, batch[i].data);
+        }
+        delivered += count;
+    }
+    m_Dispatching = false;
+    m_Dispatched += delivered;
+
+    if (m_HasRemovals) {
+        for (std::vector<Subscriber>& list : m_Subscribers) {
+            list.erase(std::remove_if(list.begin(), list.end(), [](const Subscriber& s) { return s.id == 0; }),
+                       list.end());
+        }
+        m_HasRemovals = false;
+    }
+    for (auto& pending : m_PendingSubscribers) {
+        if (pending.second.id == 0) {
+            continue;
+        }
+        if (pending.first >= m_Subscribers.size()) {
+            m_Subscribers.resize(pending.first + 1);
+        }
+        m_Subscribers[pending.first].push_back(std::move(pending.second));
+    }
+    m_PendingSubscribers.clear();
+    return delivered;
+}
+
+void EventBus::Clear() {
+    // Producers are expected to have stopped; a slot still being written is left
+    uint64_t tail = m_Tail.load(std::memory_order_relaxed);
+    const uint64_t end = m_Head.load(std::memory_order_acquire);
+    while (tail < end && m_Slots[tail & m_Mask].sequence.load(std::memory_order_acquire) == tail + 1) {
+        m_Slots[tail & m_Mask].sequence.store(tail + m_Mask + 1, std::memory_order_release);
+        ++tail;
+    }
+    m_Tail.store(tail, std::memory_order_relaxed);
+    m_Subscribers.clear();
+    m_PendingSubscribers.clear();
+    m_HasRemovals = false;
+}
+
+size_t EventBus::GetDepth() const {
+    return static_cast<size_t>(m_Head.load(std::memory_order_relaxed) - m_Tail.load(std::memory_order_relaxed));
+}
+
+EventBus::Stats EventBus::GetStats() const {
+    Stats stats;
+    stats.posted = m_Head.load(std::memory_order_relaxed);
+    stats.dispatched = m_Dispatched;
+    stats.dropped = m_Dropped.load(std::memory_order_relaxed);
+    stats.batches = m_Batches;
+    stats.lastDepth = m_LastDepth;
+    stats.peakDepth = m_PeakDepth;
+    stats.capacity = m_Mask + 1;
+    return stats;
+}
+
+} // namespace ShadowEngine
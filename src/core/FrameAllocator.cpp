@@ -0,0 +1,108 @@
+#include "core/FrameAllocator.hpp"
+#include <algorithm>
+
+namespace ShadowEngine {
+
+namespace {
+
+uintptr_t AlignUp(uintptr_t value, size_t alignment) {
+    return (value + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+}
+
+// Offset of the first aligned byte at or after base + offset
+size_t AlignedOffset(const unsigned char* base, size_t offset, size_t alignment) {
+    const uintptr_t address = reinterpret_cast<uintptr_t>(base) + offset;
+    return offset + static_cast<size_t>(AlignUp(address, alignment) - address);
+}
+
+} // namespace
+
+FrameAllocator::FrameAllocator(size_t capacity)
+    : m_Offset(0)
+    , m_OverflowOffset(0)
+    , m_OverflowUsed(0)
+    , m_HighWater(0)
+    , m_OverflowBlocks(0)
+{
+    m_Block.size = std::max<size_t>(capacity, 4096);
+    m_Block.memory = std::make_unique<unsigned char[]>(m_Block.size);
+}
+
+FrameAllocator::~FrameAllocator() = default;
+
+void* FrameAllocator::Allocate(size_t size, size_t alignment) {
+    const size_t offset = AlignedOffset(m_Block.memory.get(), m_Offset, alignment);
+    if (m_Overflow.empty() && offset + size <= m_Block.size) {
+        m_Offset = offset + size;
+        return m_Block.memory.get() + offset;
+    }
+    return AllocateOverflow(size, alignment);
+}
+
+void* FrameAllocator::AllocateOverflow(size_t size, size_t alignment) {
+    if (!m_Overflow.empty()) {
+        Block& block = m_Overflow.back();
+        const size_t offset = AlignedOffset(block.memory.get(), m_OverflowOffset, alignment);
+        if (offset + size <= block.size) {
+            m_OverflowOffset = offset + size;
+            return block.memory.get() + offset;
+        }
+        m_OverflowUsed += m_OverflowOffset;
+    }
+
+    // Each overflow block is at least as large as all the blocks before it,
+    // so the total at least doubles and a frame needs few
+    size_t total = m_Block.size;
+    for (const Block& previous : m_Overflow) {
+        total += previous.size;
+    }
+    Block block;
+    block.size = std::max(size + alignment, total);
+    block.memory = std::make_unique<unsigned char[]>(block.size);
+    m_Overflow.push_back(std::move(block));
+    ++m_OverflowBlocks;
+
+    Block& added = m_Overflow.back();
+    const size_t offset = AlignedOffset(added.memory.get(), 0, alignment);
+    m_OverflowOffset = offset + size;
+    return added.memory.get() + offset;
+}
+
+void FrameAllocator::Reset() {
+    const size_t used = m_Offset + m_OverflowUsed + m_OverflowOffset;
+    m_HighWater = std::max(m_HighWater, used);
+
+    if (!m_Overflow.empty()) {
+        // Grow so that a frame like this one fits in the main block next time
+        m_Overflow.clear();
+        m_Block.size = std::max(m_Block.size * 2, m_HighWater + m_HighWater / 4);
+        m_Block.memory = std::make_unique<unsigned char[]>(m_Block.size);
+    }
+    m_Offset = 0;
+    m_OverflowOffset = 0;
+    m_OverflowUsed = 0;
+}
+
+FrameAllocator::Stats FrameAllocator::GetStats() const {
+    Stats stats;
+    stats.capacity = m_Block.size;
+    stats.used = m_Offset + m_OverflowUsed + m_OverflowOffset;
+    stats.highWater = std::max(m_HighWater, stats.used);
+    stats.overflowBlocks = m_OverflowBlocks;
+    return stats;
+}
+
+void FrameAllocator::ResetStats() {
+    m_HighWater = 0;
+    m_OverflowBlocks = 0;
+}
+
+void* FrameAllocator::do_allocate(size_t bytes, size_t alignment) {
+    return Allocate(bytes, alignment);
+}
+
+bool FrameAllocator::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+} // namespace ShadowEngine
@@ -0,0 +1,123 @@
+#include "core/FramePacer.hpp"
+#include <cmath>
+#include <thread>
+
+namespace ShadowEngine {
+
+namespace {
+
+double ToMilliseconds(FramePacer::Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+} // namespace
+
+const char* FramePacer::GetModeName(Mode mode) {
+    switch (mode) {
+        case Mode::Uncapped:  return "uncapped";
+        case Mode::Limited:   return "limit";
+        case Mode::LateLatch: return "late-latch";
+    }
+    return "unknown";
+}
+
+bool FramePacer::ParseMode(const std::string& name, Mode& outMode) {
+    for (Mode mode : {Mode::Uncapped, Mode::Limited, Mode::LateLatch}) {
+        if (name == GetModeName(mode)) {
+            outMode = mode;
+            return true;
+        }
+    }
+    return false;
+}
+
+FramePacer::FramePacer()
+    : FramePacer(Settings())
+{
+}
+
+FramePacer::FramePacer(const Settings& settings)
+    : m_Period(Clock::duration::zero())
+    , m_HasDeadline(false)
+    , m_PredictedWorkMs(0.0)
+    , m_SleepMeanMs(1.0)
+    , m_SleepVariance(0.25)
+{
+    Configure(settings, 0.0);
+}
+
+void FramePacer::Configure(const Settings& settings, double refreshRate) {
+    m_Settings = settings;
+    double fps = settings.targetFps > 0.0 ? settings.targetFps : (refreshRate > 0.0 ? refreshRate : 60.0);
+    m_Period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / fps));
+    m_HasDeadline = false;
+}
+
+void FramePacer::BeginFrame() {
+    if (m_Settings.mode == Mode::LateLatch && m_HasDeadline) {
+        // Leave just enough time for the frame's work before its slot
+        auto lead = std::chrono::duration<double, std::milli>(m_PredictedWorkMs + m_Settings.lateLatchMarginMs);
+        WaitUntil(m_NextDeadline - std::chrono::duration_cast<Clock::duration>(lead));
+    }
+    m_WorkStart = Clock::now();
+}
+
+void FramePacer::EndFrame() {
+    Clock::time_point now = Clock::now();
+
+    // Grow the prediction at once, shrink it slowly: a miss costs a whole frame
+    double workMs = ToMilliseconds(now - m_WorkStart);
+    m_PredictedWorkMs = workMs > m_PredictedWorkMs
+        ? workMs
+        : m_PredictedWorkMs + 0.05 * (workMs - m_PredictedWorkMs);
+
+    if (m_Settings.mode == Mode::Uncapped) {
+        return;
+    }
+
+    if (!m_HasDeadline) {
+        m_NextDeadline = now;
+        m_HasDeadline = true;
+    }
+
+    if (m_Settings.mode == Mode::Limited) {
+        WaitUntil(m_NextDeadline);
+        now = Clock::now();
+    } else if (m_Settings.vsync) {
+        // A blocking swap just returned at the vertical blank; re-anchor on it
+        m_NextDeadline = now;
+    }
+
+    m_NextDeadline += m_Period;
+    if (m_NextDeadline < now) {
+        // Missed by more than a frame: restart the cadence rather than bursting to catch up
+        m_NextDeadline = now + m_Period;
+    }
+}
+
+void FramePacer::WaitUntil(Clock::time_point deadline) {
+    // Sleep in 1 ms steps while the remaining time comfortably covers a
+    // (pessimistic) sleep, learning the real sleep length as we go
+    for (;;) {
+        double remainingMs = ToMilliseconds(deadline - Clock::now());
+        if (remainingMs <= m_SleepMeanMs + 2.0 * std::sqrt(m_SleepVariance)) {
+            break;
+        }
+
+        Clock::time_point start = Clock::now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        double sleptMs = ToMilliseconds(Clock::now() - start);
+
+        // Exponentially weighted, so the estimate follows timer resolution changes
+        const double weight = 0.05;
+        double delta = sleptMs - m_SleepMeanMs;
+        m_SleepMeanMs += weight * delta;
+        m_SleepVariance = (1.0 - weight) * (m_SleepVariance + weight * delta * delta);
+    }
+
+    while (Clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+} // namespace ShadowEngine
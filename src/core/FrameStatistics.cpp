@@ -0,0 +1,83 @@
+#include "core/FrameStatistics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+namespace ShadowEngine {
+
+double FrameStatistics::GetTotal() const {
+    double total = 0.0;
+    for (double sample : m_Samples) {
+        total += sample;
+    }
+    return total;
+}
+
+double FrameStatistics::GetMean() const {
+    return m_Samples.empty() ? 0.0 : GetTotal() / static_cast<double>(m_Samples.size());
+}
+
+double FrameStatistics::GetMin() const {
+    return m_Samples.empty() ? 0.0 : *std::min_element(m_Samples.begin(), m_Samples.end());
+}
+
+double FrameStatistics::GetMax() const {
+    return m_Samples.empty() ? 0.0 : *std::max_element(m_Samples.begin(), m_Samples.end());
+}
+
+double FrameStatistics::GetStandardDeviation() const {
+    if (m_Samples.size() < 2) {
+        return 0.0;
+    }
+    const double mean = GetMean();
+    double sumSquares = 0.0;
+    for (double sample : m_Samples) {
+        sumSquares += (sample - mean) * (sample - mean);
+    }
+    return std::sqrt(sumSquares / static_cast<double>(m_Samples.size() - 1));
+}
+
+double FrameStatistics::GetPercentile(double p) const {
+    if (m_Samples.empty()) {
+        return 0.0;
+    }
+    std::vector<double> sorted = m_Samples;
+    size_t rank = static_cast<size_t>(std::ceil(std::clamp(p, 0.0, 100.0) / 100.0 * sorted.size()));
+    size_t index = rank > 0 ? rank - 1 : 0;
+    std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(index), sorted.end());
+    return sorted[index];
+}
+
+void FrameStatistics::Print(std::ostream& out, const std::string& label) const {
+    const std::ios::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+
+    const double mean = GetMean();
+    out << std::fixed << std::setprecision(3)
+        << label << ": " << GetCount() << " frames in " << GetTotal() / 1000.0 << " s" << std::endl
+        << "  mean " << mean << " ms (" << (mean > 0.0 ? 1000.0 / mean : 0.0) << " fps)"
+        << ", stddev " << GetStandardDeviation() << " ms" << std::endl
+        << "  min " << GetMin() << " ms, p50 " << GetPercentile(50.0)
+        << " ms, p95 " << GetPercentile(95.0) << " ms, p99 " << GetPercentile(99.0)
+        << " ms, max " << GetMax() << " ms" << std::endl;
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void FrameStatistics::PrintDurations(std::ostream& out, const std::string& label) const {
+    const std::ios::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+
+    out << std::fixed << std::setprecision(3)
+        << label << ": " << GetCount() << " samples, mean " << GetMean()
+        << " ms, stddev " << GetStandardDeviation() << " ms" << std::endl
+        << "  min " << GetMin() << " ms, p50 " << GetPercentile(50.0)
+        << " ms, p95 " << GetPercentile(95.0) << " ms, p99 " << GetPercentile(99.0)
+        << " ms, max " << GetMax() << " ms" << std::endl;
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+} // namespace ShadowEngine
@@ -0,0 +1,102 @@
+#include "core/Hash.hpp"
+#include <cstring>
+
+namespace ShadowEngine {
+namespace Hash {
+
+namespace {
+
+// Constants from the XXH64 specification
+constexpr uint64_t Prime1 = 11400714785074694791ull;
+constexpr uint64_t Prime2 = 14029467366897019727ull;
+constexpr uint64_t Prime3 = 1609587929392839161ull;
+constexpr uint64_t Prime4 = 9650029242287828579ull;
+constexpr uint64_t Prime5 = 2870177450012600261ull;
+
+uint64_t Read64(const uint8_t* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint32_t Read32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint64_t RotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+uint64_t Round(uint64_t accumulator, uint64_t input) {
+    accumulator += input * Prime2;
+    accumulator = RotateLeft(accumulator, 31);
+    return accumulator * Prime1;
+}
+
+uint64_t MergeRound(uint64_t hash, uint64_t lane) {
+    hash ^= Round(0, lane);
+    return hash * Prime1 + Prime4;
+}
+
+} // namespace
+
+uint64_t Compute(const void* data, size_t size, uint64_t seed) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    const uint8_t* const end = p + size;
+    uint64_t hash;
+
+    if (size >= 32) {
+        // Four independent lanes over 32-byte stripes
+        uint64_t v1 = seed + Prime1 + Prime2;
+        uint64_t v2 = seed + Prime2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - Prime1;
+        const uint8_t* const limit = end - 32;
+        do {
+            v1 = Round(v1, Read64(p));
+            v2 = Round(v2, Read64(p + 8));
+            v3 = Round(v3, Read64(p + 16));
+            v4 = Round(v4, Read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+
+        hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+        hash = MergeRound(hash, v1);
+        hash = MergeRound(hash, v2);
+        hash = MergeRound(hash, v3);
+        hash = MergeRound(hash, v4);
+    } else {
+        hash = seed + Prime5;
+    }
+    hash += static_cast<uint64_t>(size);
+
+    // Remaining bytes, eight, four and one at a time
+    while (end - p >= 8) {
+        hash ^= Round(0, Read64(p));
+        hash = RotateLeft(hash, 27) * Prime1 + Prime4;
+        p += 8;
+    }
+    if (end - p >= 4) {
+        hash ^= static_cast<uint64_t>(Read32(p)) * Prime1;
+        hash = RotateLeft(hash, 23) * Prime2 + Prime3;
+        p += 4;
+    }
+    while (p < end) {
+        hash ^= (*p) * Prime5;
+        hash = RotateLeft(hash, 11) * Prime1;
+        ++p;
+    }
+
+    // Avalanche
+    hash ^= hash >> 33;
+    hash *= Prime2;
+    hash ^= hash >> 29;
+    hash *= Prime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+} // namespace Hash
+} // namespace ShadowEngine
@@ -0,0 +1,198 @@
+#include "HeadlessContext.hpp"
+#include "core/Log.hpp"
+#include <cstring>
+
+#ifndef _WIN32
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+namespace ShadowEngine {
+
+#ifndef _WIN32
+
+namespace {
+
+bool HasToken(const char* list, const char* token) {
+    if (!list) return false;
+    const size_t length = std::strlen(token);
+    for (const char* at = std::strstr(list, token); at; at = std::strstr(at + 1, token)) {
+        bool startOk = at == list || at[-1] == ' ';
+        bool endOk = at[length] == '\0' || at[length] == ' ';
+        if (startOk && endOk) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void* LoadProc(const char* name) {
+    return reinterpret_cast<void*>(eglGetProcAddress(name));
+}
+
+EGLDisplay OpenDisplay() {
+    // Client extensions are queried without a display; a null result just means
+    // the implementation predates EGL_EXT_client_extensions
+    const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (HasToken(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+        auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (getPlatformDisplay) {
+            EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (display != EGL_NO_DISPLAY) {
+                return display;
+            }
+        }
+    }
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+} // namespace
+
+HeadlessContext::HeadlessContext()
+    : m_Display(EGL_NO_DISPLAY)
+    , m_Context(EGL_NO_CONTEXT)
+    , m_Surface(EGL_NO_SURFACE)
+{
+}
+
+HeadlessContext::~HeadlessContext() {
+    Shutdown();
+}
+
+bool HeadlessContext::Initialize() {
+    EGLDisplay display = OpenDisplay();
+    EGLint major = 0, minor = 0;
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor)) {
+        SHADOW_LOG_ERROR(Rendering, "Failed to initialize EGL display");
+        return false;
+    }
+    m_Display = display;
+
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        SHADOW_LOG_ERROR(Rendering, "EGL implementation does not support desktop OpenGL");
+        Shutdown();
+        return false;
+    }
+
+    const char* displayExtensions = eglQueryString(display, EGL_EXTENSIONS);
+    const bool surfaceless = HasToken(displayExtensions, "EGL_KHR_surfaceless_context");
+
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE, surfaceless ? 0 : EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_NONE
+    };
+    EGLConfig config = nullptr;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(display, configAttribs, &config, 1, &configCount) || configCount == 0) {
+        SHADOW_LOG_ERROR(Rendering, "No EGL config supports offscreen OpenGL rendering");
+        Shutdown();
+        return false;
+    }
+
+    // Same version and profile the windowed path asks GLFW for
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION_KHR, 3,
+        EGL_CONTEXT_MINOR_VERSION_KHR, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR,
+#ifndef NDEBUG
+        EGL_CONTEXT_FLAGS_KHR, EGL_CONTEXT_OPENGL_DEBUG_BIT_KHR,
+#endif
+        EGL_NONE
+    };
+    m_Context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+    if (m_Context == EGL_NO_CONTEXT) {
+        SHADOW_LOG_ERROR(Rendering, "Failed to create EGL OpenGL 3.3 core context (error 0x{:x})", eglGetError());
+        m_Context = nullptr;
+        Shutdown();
+        return false;
+    }
+
+    if (!surfaceless) {
+        // Everything is drawn into an FBO; the pbuffer only exists to make the
+        // context current on implementations that require a surface
+        const EGLint pbufferAttribs[] = {EGL_WIDTH, 16, EGL_HEIGHT, 16, EGL_NONE};
+        m_Surface = eglCreatePbufferSurface(display, config, pbufferAttribs);
+        if (m_Surface == EGL_NO_SURFACE) {
+            SHADOW_LOG_ERROR(Rendering, "Failed to create EGL pbuffer surface");
+            Shutdown();
+            return false;
+        }
+    }
+
+    if (!eglMakeCurrent(display, m_Surface, m_Surface, m_Context)) {
+        SHADOW_LOG_ERROR(Rendering, "Failed to make EGL context current");
+        Shutdown();
+        return false;
+    }
+
+    SHADOW_LOG_INFO(Rendering, "Headless EGL {}.{} context created ({})", major, minor,
+                    surfaceless ? "surfaceless" : "pbuffer");
+    return true;
+}
+
+void HeadlessContext::Shutdown() {
+    if (m_Display == EGL_NO_DISPLAY) {
+        return;
+    }
+    eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (m_Surface != EGL_NO_SURFACE) {
+        eglDestroySurface(m_Display, m_Surface);
+        m_Surface = EGL_NO_SURFACE;
+    }
+    if (m_Context) {
+        eglDestroyContext(m_Display, m_Context);
+        m_Context = nullptr;
+    }
+    eglTerminate(m_Display);
+    m_Display = EGL_NO_DISPLAY;
+}
+
+void HeadlessContext::MakeContextCurrent() {
+    if (m_Context) {
+        eglMakeCurrent(m_Display, m_Surface, m_Surface, m_Context);
+    }
+}
+
+void HeadlessContext::ReleaseContext() {
+    if (m_Context) {
+        eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    }
+}
+
+GLADloadproc HeadlessContext::GetProcLoader() {
+    return LoadProc;
+}
+
+#else
+
+// EGL is not generally available on Windows; CI captures run on Linux
+HeadlessContext::HeadlessContext()
+    : m_Display(nullptr)
+    , m_Context(nullptr)
+    , m_Surface(nullptr)
+{
+}
+
+HeadlessContext::~HeadlessContext() = default;
+
+bool HeadlessContext::Initialize() {
+    SHADOW_LOG_ERROR(Rendering, "Headless mode requires EGL and is not supported on this platform");
+    return false;
+}
+
+void HeadlessContext::Shutdown() {}
+void HeadlessContext::MakeContextCurrent() {}
+void HeadlessContext::ReleaseContext() {}
+
+GLADloadproc HeadlessContext::GetProcLoader() {
+    return nullptr;
+}
+
+#endif
+
+} // namespace ShadowEngine
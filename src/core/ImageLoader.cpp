@@ -1,63 +1,328 @@
 #include "../include/core/ImageLoader.hpp"
+#include "core/FrameAllocator.hpp"
+#include "core/JobSystem.hpp"
+#include "core/Log.hpp"
+#include "core/Profiler.hpp"
+#include "core/VirtualFileSystem.hpp"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+// Set while decoding into an arena. stb_image allocates through the hooks
+// below, so its working buffers and result come from the arena, and frees are
+// left to the arena's reset.
+thread_local ShadowEngine::FrameAllocator* t_DecodeArena = nullptr;
+
+// Without an arena, memory comes from operator new so a decoded buffer can be
+// handed to a PixelBuffer as it is, and heap tracking sees the decoder.
+// stb_image sizes its PNG output up front, so growing by copy is rare.
+void* DecodeMalloc(size_t size)
+{
+    return t_DecodeArena ? t_DecodeArena->Allocate(size, 16) : ::operator new(size, std::nothrow);
+}
+
+void* DecodeRealloc(void* pointer, size_t oldSize, size_t newSize)
+{
+    void* grown = t_DecodeArena ? t_DecodeArena->Allocate(newSize, 16) : ::operator new(newSize, std::nothrow);
+    if (grown && pointer) {
+        std::memcpy(grown, pointer, std::min(oldSize, newSize));
+        if (!t_DecodeArena) {
+            ::operator delete(pointer);
+        }
+    }
+    return grown;
+}
+
+void DecodeFree(void* pointer)
+{
+    if (!t_DecodeArena) {
+        ::operator delete(pointer);
+    }
+}
+
+} // namespace
+
+#define STBI_MALLOC(size) DecodeMalloc(size)
+#define STBI_REALLOC_SIZED(pointer, oldSize, newSize) DecodeRealloc(pointer, oldSize, newSize)
+#define STBI_FREE(pointer) DecodeFree(pointer)
 #define STB_IMAGE_IMPLEMENTATION
 #include "../../third_party/stb/stb_image.h"
-#include <iostream>
-#include <fstream>
-#include <stdexcept>
 
 namespace ShadowEngine {
 
+ImageLoader::PixelBuffer::~PixelBuffer()
+{
+    ::operator delete(m_Data);
+}
+
+ImageLoader::PixelBuffer::PixelBuffer(const PixelBuffer& other)
+{
+    assign(other.begin(), other.end());
+}
+
+ImageLoader::PixelBuffer& ImageLoader::PixelBuffer::operator=(const PixelBuffer& other)
+{
+    if (this != &other) {
+        assign(other.begin(), other.end());
+    }
+    return *this;
+}
+
+ImageLoader::PixelBuffer::PixelBuffer(PixelBuffer&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+ImageLoader::PixelBuffer& ImageLoader::PixelBuffer::operator=(PixelBuffer&& other) noexcept
+{
+    if (this != &other) {
+        ::operator delete(m_Data);
+        m_Data = std::exchange(other.m_Data, nullptr);
+        m_Size = std::exchange(other.m_Size, 0);
+        m_Capacity = std::exchange(other.m_Capacity, 0);
+    }
+    return *this;
+}
+
+void ImageLoader::PixelBuffer::resize(size_t size)
+{
+    if (size > m_Capacity) {
+        unsigned char* grown = static_cast<unsigned char*>(::operator new(size));
+        if (m_Size > 0) {
+            std::memcpy(grown, m_Data, m_Size);
+        }
+        ::operator delete(m_Data);
+        m_Data = grown;
+        m_Capacity = size;
+    }
+    if (size > m_Size) {
+        std::memset(m_Data + m_Size, 0, size - m_Size);
+    }
+    m_Size = size;
+}
+
+void ImageLoader::PixelBuffer::assign(size_t size, unsigned char value)
+{
+    clear();
+    resize(size);
+    if (value != 0) {
+        std::memset(m_Data, value, size);
+    }
+}
+
+void ImageLoader::PixelBuffer::assign(const unsigned char* first, const unsigned char* last)
+{
+    const size_t size = static_cast<size_t>(last - first);
+    if (size > m_Capacity) {
+        unsigned char* grown = static_cast<unsigned char*>(::operator new(size));
+        ::operator delete(m_Data);
+        m_Data = grown;
+        m_Capacity = size;
+    }
+    if (size > 0) {
+        std::memcpy(m_Data, first, size);
+    }
+    m_Size = size;
+}
+
+void ImageLoader::PixelBuffer::Adopt(unsigned char* data, size_t size)
+{
+    ::operator delete(m_Data);
+    m_Data = data;
+    m_Size = size;
+    m_Capacity = size;
+}
+
+ImageLoader::DecodedImage::~DecodedImage()
+{
+    Reset();
+}
+
+ImageLoader::DecodedImage::DecodedImage(DecodedImage&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+ImageLoader::DecodedImage& ImageLoader::DecodedImage::operator=(DecodedImage&& other) noexcept
+{
+    if (this != &other) {
+        Reset();
+        m_Pixels = std::exchange(other.m_Pixels, nullptr);
+        m_Width = std::exchange(other.m_Width, 0);
+        m_Height = std::exchange(other.m_Height, 0);
+        m_OwnsPixels = std::exchange(other.m_OwnsPixels, false);
+    }
+    return *this;
+}
+
+void ImageLoader::DecodedImage::Reset()
+{
+    // Heap buffers came from operator new through the decode hooks; free
+    // them directly, since this thread may be decoding into an arena right now
+    if (m_OwnsPixels) {
+        ::operator delete(m_Pixels);
+    }
+    m_Pixels = nullptr;
+    m_Width = 0;
+    m_Height = 0;
+    m_OwnsPixels = false;
+}
+
+ImageLoader::ImageData ImageLoader::DecodedImage::ToImageData() const
+{
+    ImageData image;
+    image.width = m_Width;
+    image.height = m_Height;
+    image.channels = 4;
+    image.data.assign(m_Pixels, m_Pixels + GetSize());
+    return image;
+}
+
+ImageLoader::ImageData ImageLoader::DecodedImage::TakeImageData()
+{
+    if (!m_OwnsPixels) {
+        ImageData image = ToImageData();
+        Reset();
+        return image;
+    }
+    ImageData image;
+    image.width = m_Width;
+    image.height = m_Height;
+    image.channels = 4;
+    image.data.Adopt(m_Pixels, GetSize());
+    m_OwnsPixels = false;
+    Reset();
+    return image;
+}
+
 bool ImageLoader::LoadImage(const std::string& path, ImageData& outImage)
 {
-    // Check if file exists using fstream
-    std::ifstream file(path);
-    if (!file.good()) {
-        std::cerr << "Image file does not exist or cannot be accessed: " << path << std::endl;
+    SHADOW_PROFILE_ZONE("ImageLoader::LoadImage");
+    // Decoded straight from the pack mapping or loose-file mapping
+    VirtualFileSystem::File file;
+    if (!VirtualFileSystem::Get().Read(path, file)) {
+        SHADOW_LOG_ERROR(Assets, "Image file does not exist or cannot be accessed: {}", path);
+        return false;
+    }
+    if (!DecodeImage(file.GetData(), file.GetSize(), outImage)) {
+        SHADOW_LOG_ERROR(Assets, "Failed to load image: {}", path);
+        return false;
+    }
+    return true;
+}
+
+bool ImageLoader::LoadImage(const std::string& path, DecodedImage& outImage)
+{
+    SHADOW_PROFILE_ZONE("ImageLoader::LoadImage");
+    VirtualFileSystem::File file;
+    if (!VirtualFileSystem::Get().Read(path, file)) {
+        SHADOW_LOG_ERROR(Assets, "Image file does not exist or cannot be accessed: {}", path);
+        return false;
+    }
+    if (!DecodeImage(file.GetData(), file.GetSize(), outImage)) {
+        SHADOW_LOG_ERROR(Assets, "Failed to load image: {}", path);
         return false;
     }
-    file.close();
+    return true;
+}
 
+bool ImageLoader::DecodeImage(const uint8_t* encoded, size_t size, ImageData& outImage)
+{
     // Clear output image data
     outImage.width = 0;
     outImage.height = 0;
     outImage.channels = 0;
     outImage.data.clear();
 
+    DecodedImage decoded;
+    if (!DecodeImage(encoded, size, decoded)) {
+        return false;
+    }
+
+    try
+    {
+        outImage = decoded.TakeImageData();
+    }
+    catch (const std::exception& e)
+    {
+        SHADOW_LOG_ERROR(Assets, "Failed to allocate memory for image data: {}", e.what());
+        return false;
+    }
+    return true;
+}
+
+bool ImageLoader::DecodeImage(const uint8_t* encoded, size_t size, DecodedImage& outImage)
+{
+    SHADOW_PROFILE_ZONE("ImageLoader::DecodeImage");
+    outImage.Reset();
+
     int width, height, channels;
 
+    if (size > static_cast<size_t>(INT_MAX))
+    {
+        SHADOW_LOG_ERROR(Assets, "Image too large to decode: {} bytes", size);
+        return false;
+    }
+
     // Force load as RGBA (4 channels)
-    unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+    unsigned char* data = stbi_load_from_memory(encoded, static_cast<int>(size), &width, &height, &channels,
+                                                STBI_rgb_alpha);
     
     if (!data)
     {
-        std::cerr << "Failed to load image: " << stbi_failure_reason() << std::endl;
+        SHADOW_LOG_ERROR(Assets, "Failed to decode image: {}", stbi_failure_reason());
         return false;
     }
 
+    // The buffer is adopted as it is; it came from malloc unless an arena is set
+    outImage.m_Pixels = data;
+    outImage.m_OwnsPixels = t_DecodeArena == nullptr;
+
     // Validate image dimensions
     if (width <= 0 || height <= 0)
     {
-        std::cerr << "Invalid image dimensions: " << width << "x" << height << std::endl;
-        stbi_image_free(data);
+        SHADOW_LOG_ERROR(Assets, "Invalid image dimensions: {}x{}", width, height);
+        outImage.Reset();
         return false;
     }
 
-    try
-    {
-        outImage.width = width;
-        outImage.height = height;
-        outImage.channels = 4;  // Always 4 channels (RGBA)
-        outImage.data.assign(data, data + width * height * 4);
-    }
-    catch (const std::exception& e)
-    {
-        std::cerr << "Failed to allocate memory for image data: " << e.what() << std::endl;
-        stbi_image_free(data);
-        return false;
-    }
-    
-    stbi_image_free(data);
+    outImage.m_Width = width;
+    outImage.m_Height = height;
     return true;
 }
 
+bool ImageLoader::DecodeImage(const uint8_t* encoded, size_t size, FrameAllocator& arena, DecodedImage& outImage)
+{
+    FrameAllocator* previous = std::exchange(t_DecodeArena, &arena);
+    const bool decoded = DecodeImage(encoded, size, outImage);
+    t_DecodeArena = previous;
+    return decoded;
+}
+
+size_t ImageLoader::DecodeBatch(JobSystem& jobs, const std::vector<EncodedImage>& inputs,
+                                std::vector<DecodedImage>& outImages)
+{
+    SHADOW_PROFILE_ZONE("ImageLoader::DecodeBatch");
+    outImages.clear();
+    outImages.resize(inputs.size());
+
+    // One image per job: decode times vary too much for larger chunks to balance
+    std::atomic<size_t> decoded{0};
+    jobs.ParallelFor(inputs.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (DecodeImage(inputs[i].data, inputs[i].size, outImages[i])) {
+                decoded.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+    return decoded.load(std::memory_order_relaxed);
+}
+
 } // namespace ShadowEngine 
\ No newline at end of file
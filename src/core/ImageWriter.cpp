@@ -0,0 +1,172 @@
+#include "core/ImageWriter.hpp"
+#include "core/Log.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+namespace ShadowEngine {
+
+namespace {
+
+// Largest payload of a stored deflate block
+constexpr size_t MaxStoredBlock = 65535;
+
+struct Crc32Table {
+    uint32_t entries[256];
+
+    Crc32Table() {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            entries[i] = c;
+        }
+    }
+};
+
+uint32_t UpdateCrc32(uint32_t crc, const unsigned char* data, size_t size) {
+    static const Crc32Table table;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table.entries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+// Adler-32 as zlib requires; 5552 is the longest run before the sums can overflow
+struct Adler32 {
+    uint32_t a = 1;
+    uint32_t b = 0;
+
+    void Update(const unsigned char* data, size_t size) {
+        while (size > 0) {
+            size_t run = std::min<size_t>(size, 5552);
+            for (size_t i = 0; i < run; ++i) {
+                a += data[i];
+                b += a;
+            }
+            a %= 65521;
+            b %= 65521;
+            data += run;
+            size -= run;
+        }
+    }
+
+    uint32_t Value() const { return (b << 16) | a; }
+};
+
+void PutBigEndian(std::vector<unsigned char>& out, uint32_t value) {
+    out.push_back(static_cast<unsigned char>(value >> 24));
+    out.push_back(static_cast<unsigned char>(value >> 16));
+    out.push_back(static_cast<unsigned char>(value >> 8));
+    out.push_back(static_cast<unsigned char>(value));
+}
+
+// Chunk data must already be in out after a 4-byte length and the type
+void FinishChunk(std::vector<unsigned char>& out, size_t chunkStart) {
+    const uint32_t length = static_cast<uint32_t>(out.size() - chunkStart - 8);
+    out[chunkStart + 0] = static_cast<unsigned char>(length >> 24);
+    out[chunkStart + 1] = static_cast<unsigned char>(length >> 16);
+    out[chunkStart + 2] = static_cast<unsigned char>(length >> 8);
+    out[chunkStart + 3] = static_cast<unsigned char>(length);
+    const uint32_t crc = UpdateCrc32(0xFFFFFFFFu, out.data() + chunkStart + 4, length + 4) ^ 0xFFFFFFFFu;
+    PutBigEndian(out, crc);
+}
+
+size_t BeginChunk(std::vector<unsigned char>& out, const char type[4]) {
+    const size_t start = out.size();
+    out.insert(out.end(), 4, 0);
+    out.insert(out.end(), type, type + 4);
+    return start;
+}
+
+} // namespace
+
+bool ImageWriter::EncodePNG(const unsigned char* pixels, int width, int height, int channels,
+                            bool bottomUp, std::vector<unsigned char>& out) {
+    if (!pixels || width <= 0 || height <= 0 || (channels != 3 && channels != 4)) {
+        SHADOW_LOG_ERROR(Assets, "ImageWriter: unsupported image {}x{}x{}", width, height, channels);
+        return false;
+    }
+
+    const size_t rowBytes = static_cast<size_t>(width) * channels;
+    const size_t filteredBytes = (rowBytes + 1) * height;  // Every row starts with filter type 0
+    const size_t blockCount = (filteredBytes + MaxStoredBlock - 1) / MaxStoredBlock;
+
+    out.clear();
+    out.reserve(8 + 25 + 12 + 2 + filteredBytes + blockCount * 5 + 4 + 12);
+
+    static const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    out.insert(out.end(), signature, signature + 8);
+
+    size_t chunk = BeginChunk(out, "IHDR");
+    PutBigEndian(out, static_cast<uint32_t>(width));
+    PutBigEndian(out, static_cast<uint32_t>(height));
+    out.push_back(8);                          // Bit depth
+    out.push_back(channels == 4 ? 6 : 2);      // RGBA or RGB
+    out.push_back(0);                          // Deflate
+    out.push_back(0);                          // Adaptive filtering
+    out.push_back(0);                          // No interlace
+    FinishChunk(out, chunk);
+
+    // zlib stream of stored blocks. Rows are fed through in order; a block
+    // boundary may fall anywhere, including inside a row.
+    chunk = BeginChunk(out, "IDAT");
+    out.push_back(0x78);
+    out.push_back(0x01);
+
+    Adler32 adler;
+    size_t blockRemaining = 0;
+    size_t written = 0;
+    auto emit = [&](const unsigned char* data, size_t size) {
+        while (size > 0) {
+            if (blockRemaining == 0) {
+                const size_t blockSize = std::min(MaxStoredBlock, filteredBytes - written);
+                const bool final = written + blockSize == filteredBytes;
+                out.push_back(final ? 1 : 0);
+                out.push_back(static_cast<unsigned char>(blockSize));
+                out.push_back(static_cast<unsigned char>(blockSize >> 8));
+                out.push_back(static_cast<unsigned char>(~blockSize));
+                out.push_back(static_cast<unsigned char>(~blockSize >> 8));
+                blockRemaining = blockSize;
+            }
+            const size_t run = std::min(size, blockRemaining);
+            out.insert(out.end(), data, data + run);
+            adler.Update(data, run);
+            blockRemaining -= run;
+            written += run;
+            data += run;
+            size -= run;
+        }
+    };
+
+    const unsigned char filter = 0;
+    for (int y = 0; y < height; ++y) {
+        const int sourceRow = bottomUp ? height - 1 - y : y;
+        emit(&filter, 1);
+        emit(pixels + static_cast<size_t>(sourceRow) * rowBytes, rowBytes);
+    }
+    PutBigEndian(out, adler.Value());
+    FinishChunk(out, chunk);
+
+    chunk = BeginChunk(out, "IEND");
+    FinishChunk(out, chunk);
+    return true;
+}
+
+bool ImageWriter::WritePNG(const std::string& path, const ImageLoader::ImageData& image) {
+    std::vector<unsigned char> encoded;
+    if (!EncodePNG(image.data.data(), image.width, image.height, image.channels, false, encoded)) {
+        return false;
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()))) {
+        SHADOW_LOG_ERROR(Assets, "Failed to write image: {}", path);
+        return false;
+    }
+    return true;
+}
+
+} // namespace ShadowEngine
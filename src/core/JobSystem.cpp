@@ -0,0 +1,425 @@
+#include "core/JobSystem.hpp"
+#include "core/Log.hpp"
+#include "core/MemoryTracker.hpp"
+#include "core/Profiler.hpp"
+#include <algorithm>
+#include <new>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace ShadowEngine {
+
+namespace {
+
+// Worker threads belong to exactly one system; other threads have no queue
+thread_local const JobSystem* t_WorkerSystem = nullptr;
+thread_local int t_WorkerQueue = -1;
+
+// Busy-poll rounds before an idle worker goes to sleep
+constexpr int IdleSpins = 64;
+
+uint32_t NextRandom(uint32_t& state) {
+    // xorshift32; only used to pick steal victims
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+} // namespace
+
+// Either a function, or one chunk of a ParallelFor body. The chunk form keeps
+// the body by pointer, so splitting a loop never allocates a std::function.
+struct JobSystem::Job {
+    std::function<void()> function;
+    const std::function<void(size_t, size_t)>* range = nullptr;
+    size_t begin = 0;
+    size_t end = 0;
+    JobCounter* counter = nullptr;
+    MemoryTag memoryTag = MemoryTag::Core;  // Heap charges while it runs, inherited from the submitter
+};
+
+// Chase-Lev deque (Le et al., "Correct and Efficient Work-Stealing for Weak
+// Memory Models") over a fixed ring. The owner pushes and pops at the bottom;
+// thieves take from the top, and only the last element is ever contended.
+class JobSystem::WorkQueue {
+public:
+    explicit WorkQueue(size_t capacity)
+        : m_Top(0)
+        , m_Bottom(0)
+        , m_Mask(0)
+    {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        m_Mask = size - 1;
+        m_Buffer = std::make_unique<std::atomic<Job*>[]>(size);
+    }
+
+    // Owner only; false when full
+    bool Push(Job* job) {
+        const int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+        const int64_t top = m_Top.load(std::memory_order_acquire);
+        if (bottom - top > static_cast<int64_t>(m_Mask)) {
+            return false;
+        }
+        m_Buffer[bottom & m_Mask].store(job, std::memory_order_relaxed);
+        m_Bottom.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Owner only
+    Job* Pop() {
+        const int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+        m_Bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = m_Top.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;  // Empty
+        }
+        Job* job = m_Buffer[bottom & m_Mask].load(std::memory_order_relaxed);
+        if (top == bottom) {
+            // Last element: race thieves for it
+            if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                               std::memory_order_relaxed)) {
+                job = nullptr;
+            }
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    // Any thread
+    Job* Steal() {
+        int64_t top = m_Top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+        if (top >= bottom) {
+            return nullptr;
+        }
+        Job* job = m_Buffer[top & m_Mask].load(std::memory_order_relaxed);
+        if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                           std::memory_order_relaxed)) {
+            return nullptr;  // Lost to the owner or another thief
+        }
+        return job;
+    }
+
+private:
+    alignas(64) std::atomic<int64_t> m_Top;
+    alignas(64) std::atomic<int64_t> m_Bottom;
+    size_t m_Mask;
+    std::unique_ptr<std::atomic<Job*>[]> m_Buffer;
+};
+
+JobSystem::JobSystem()
+    : JobSystem(Settings())
+{
+}
+
+JobSystem::JobSystem(const Settings& settings)
+    : m_Settings(settings)
+    , m_OwnerThread(std::this_thread::get_id())
+    , m_JobPool(sizeof(Job), 1024)
+    , m_QueuedJobs(0)
+    , m_Sleeping(0)
+    , m_Quit(false)
+    , m_Executed(0)
+    , m_Stolen(0)
+{
+    unsigned workerCount = std::max(1u, std::thread::hardware_concurrency()) - 1;
+    if (settings.workerCount >= 0) {
+        workerCount = static_cast<unsigned>(settings.workerCount);
+    }
+
+    // Create every queue before any worker starts stealing from them
+    for (unsigned i = 0; i <= workerCount; ++i) {
+        m_Queues.push_back(std::make_unique<WorkQueue>(std::max<size_t>(settings.queueCapacity, 2)));
+    }
+    for (unsigned i = 1; i <= workerCount; ++i) {
+        m_Workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+        if (settings.pinWorkers) {
+            PinWorker(m_Workers.back(), i);
+        }
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_SleepMutex);
+        m_Quit.store(true);
+    }
+    m_Wake.notify_all();
+    for (std::thread& worker : m_Workers) {
+        worker.join();
+    }
+
+    // Nothing should be left, but never leak a job that was never waited for
+    Job* job = nullptr;
+    while ((job = FindJob(0)) != nullptr) {
+        Execute(job);
+    }
+}
+
+void JobSystem::Run(std::function<void()> function, JobCounter* counter, JobCounter* dependency) {
+    Job* job = CreateJob(counter);
+    job->function = std::move(function);
+    Submit(job, dependency);
+}
+
+JobSystem::Job* JobSystem::CreateJob(JobCounter* counter) {
+    void* memory = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_JobPoolMutex);
+        memory = m_JobPool.Allocate();
+    }
+    Job* job = new (memory) Job();
+    job->counter = counter;
+    job->memoryTag = MemoryScope::GetCurrent();
+    if (counter) {
+        counter->m_Value.fetch_add(1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+void JobSystem::DestroyJob(Job* job) {
+    job->~Job();
+    std::lock_guard<std::mutex> lock(m_JobPoolMutex);
+    m_JobPool.Free(job);
+}
+
+void JobSystem::Submit(Job* job, JobCounter* dependency) {
+    // Checked under the lock Complete takes, so the job is either released by
+    // the dependency's last job or queued here, never both. The lock is only
+    // held while jobs remain, so a finished dependency is never locked.
+    int value = dependency ? dependency->m_Value.load(std::memory_order_acquire) : 0;
+    while (value != 0) {
+        if (value & JobCounter::LockBit) {
+            std::this_thread::yield();
+            value = dependency->m_Value.load(std::memory_order_acquire);
+        } else if (dependency->m_Value.compare_exchange_weak(value, value | JobCounter::LockBit,
+                                                             std::memory_order_acquire)) {
+            dependency->m_Dependents.push_back(job);
+            dependency->m_Value.fetch_and(~JobCounter::LockBit, std::memory_order_release);
+            return;
+        }
+    }
+    Push(job);
+}
+
+void JobSystem::Wait(const JobCounter& counter) {
+    const int queueIndex = CurrentQueueIndex();
+    while (!counter.IsDone()) {
+        if (Job* job = FindJob(queueIndex)) {
+            Execute(job);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool JobSystem::TryRunJob() {
+    if (Job* job = FindJob(CurrentQueueIndex())) {
+        Execute(job);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+    if (grainSize == 0) {
+        grainSize = std::max<size_t>(1, count / (static_cast<size_t>(GetThreadCount()) * 4));
+    }
+    if (count <= grainSize || m_Workers.empty()) {
+        body(0, count);
+        return;
+    }
+
+    // The caller keeps the first chunk and helps with the rest while waiting
+    JobCounter counter;
+    for (size_t begin = grainSize; begin < count; begin += grainSize) {
+        Job* job = CreateJob(&counter);
+        job->range = &body;
+        job->begin = begin;
+        job->end = std::min(count, begin + grainSize);
+        Push(job);
+    }
+    body(0, grainSize);
+    Wait(counter);
+}
+
+JobSystem::Stats JobSystem::GetStats() const {
+    Stats stats;
+    stats.executed = m_Executed.load(std::memory_order_relaxed);
+    stats.stolen = m_Stolen.load(std::memory_order_relaxed);
+    return stats;
+}
+
+int JobSystem::CurrentQueueIndex() const {
+    if (t_WorkerSystem == this) {
+        return t_WorkerQueue;
+    }
+    return std::this_thread::get_id() == m_OwnerThread ? 0 : -1;
+}
+
+void JobSystem::Push(Job* job) {
+    const int queueIndex = CurrentQueueIndex();
+    if (queueIndex < 0 || !m_Queues[queueIndex]->Push(job)) {
+        std::lock_guard<std::mutex> lock(m_SharedMutex);
+        m_Shared.push_back(job);
+    }
+
+    // Paired with the sleep check in WorkerLoop: either the worker sees the
+    // job count or this sees the sleeper and wakes it
+    m_QueuedJobs.fetch_add(1, std::memory_order_seq_cst);
+    if (m_Sleeping.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lock(m_SleepMutex);
+        m_Wake.notify_one();
+    }
+}
+
+JobSystem::Job* JobSystem::FindJob(int queueIndex) {
+    Job* job = nullptr;
+    if (queueIndex >= 0) {
+        job = m_Queues[queueIndex]->Pop();
+    }
+
+    if (!job && m_QueuedJobs.load(std::memory_order_relaxed) > 0) {
+        {
+            std::lock_guard<std::mutex> lock(m_SharedMutex);
+            if (!m_Shared.empty()) {
+                job = m_Shared.front();
+                m_Shared.pop_front();
+            }
+        }
+
+        // Steal from a random victim, then sweep the rest
+        if (!job) {
+            thread_local uint32_t seed = 0x9E3779B9u ^ static_cast<uint32_t>(
+                std::hash<std::thread::id>()(std::this_thread::get_id()));
+            const size_t queueCount = m_Queues.size();
+            const size_t start = NextRandom(seed) % queueCount;
+            for (size_t i = 0; i < queueCount && !job; ++i) {
+                const size_t victim = (start + i) % queueCount;
+                if (static_cast<int>(victim) != queueIndex) {
+                    job = m_Queues[victim]->Steal();
+                }
+            }
+            if (job) {
+                m_Stolen.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    if (job) {
+        m_QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+void JobSystem::Execute(Job* job) {
+    MemoryScope scope(job->memoryTag);
+    if (job->range) {
+        (*job->range)(job->begin, job->end);
+    } else {
+        job->function();
+    }
+    JobCounter* counter = job->counter;
+    DestroyJob(job);
+    m_Executed.fetch_add(1, std::memory_order_relaxed);
+    if (counter) {
+        Complete(counter);
+    }
+}
+
+void JobSystem::Complete(JobCounter* counter) {
+    int value = counter->m_Value.load(std::memory_order_relaxed);
+    for (;;) {
+        const int remaining = value & ~JobCounter::LockBit;
+        if (remaining > 1) {
+            // Not the last job; the lock bit, if set, is carried through
+            if (counter->m_Value.compare_exchange_weak(value, value - 1, std::memory_order_acq_rel)) {
+                return;
+            }
+        } else if (value & JobCounter::LockBit) {
+            std::this_thread::yield();  // Run is adding a dependent
+            value = counter->m_Value.load(std::memory_order_relaxed);
+        } else if (counter->m_Value.compare_exchange_weak(value, 1 | JobCounter::LockBit,
+                                                          std::memory_order_acquire)) {
+            break;
+        }
+    }
+
+    // Last job: take the dependents, then unlock and reach zero in one store
+    std::vector<void*> dependents;
+    dependents.swap(counter->m_Dependents);
+    counter->m_Value.store(0, std::memory_order_release);
+
+    for (void* dependent : dependents) {
+        Push(static_cast<Job*>(dependent));
+    }
+}
+
+void JobSystem::WorkerLoop(unsigned queueIndex) {
+    SHADOW_PROFILE_THREAD("Job worker");
+    t_WorkerSystem = this;
+    t_WorkerQueue = static_cast<int>(queueIndex);
+
+    int idle = 0;
+    while (!m_Quit.load(std::memory_order_acquire)) {
+        if (Job* job = FindJob(t_WorkerQueue)) {
+            Execute(job);
+            idle = 0;
+            continue;
+        }
+        if (++idle < IdleSpins) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_SleepMutex);
+        m_Sleeping.fetch_add(1, std::memory_order_seq_cst);
+        m_Wake.wait(lock, [this] {
+            return m_Quit.load(std::memory_order_acquire) ||
+                   m_QueuedJobs.load(std::memory_order_seq_cst) > 0;
+        });
+        m_Sleeping.fetch_sub(1, std::memory_order_seq_cst);
+        idle = 0;
+    }
+}
+
+void JobSystem::PinWorker(std::thread& thread, unsigned core) {
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    core %= cores;
+#if defined(_WIN32)
+    if (core < 64 && !SetThreadAffinityMask(thread.native_handle(), DWORD_PTR(1) << core)) {
+        SHADOW_LOG_WARNING(Core, "JobSystem: failed to pin worker to core {}", core);
+    }
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    if (pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) != 0) {
+        SHADOW_LOG_WARNING(Core, "JobSystem: failed to pin worker to core {}", core);
+    }
+#else
+    (void)thread;
+    SHADOW_LOG_WARNING(Core, "JobSystem: thread affinity is not supported on this platform");
+#endif
+}
+
+} // namespace ShadowEngine
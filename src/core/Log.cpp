@@ -0,0 +1,400 @@
+#include "core/Log.hpp"
+#include "core/Profiler.hpp"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+
+namespace ShadowEngine {
+
+namespace {
+
+static_assert(Log::QueueBytes % 8 == 0, "QueueBytes must be a multiple of the record alignment");
+
+constexpr auto PollInterval = std::chrono::milliseconds(2);
+
+// Records written while the writer thread is stopped are formatted at once
+thread_local std::vector<uint8_t> t_DirectRecord;
+thread_local bool t_Direct = false;
+
+size_t AlignRecord(size_t size) {
+    return (size + 7) & ~size_t(7);
+}
+
+template <typename T>
+T Get(const uint8_t*& in) {
+    T value;
+    std::memcpy(&value, in, sizeof(value));
+    in += sizeof(value);
+    return value;
+}
+
+// Parsed from {:.N} and {:x}
+struct FormatSpec {
+    int precision = -1;
+    bool hex = false;
+};
+
+void AppendArg(const uint8_t*& in, const FormatSpec& spec, std::string& out) {
+    char text[64];
+    switch (static_cast<LogDetail::ArgType>(*in++)) {
+        case LogDetail::ArgType::Int:
+            std::snprintf(text, sizeof(text), spec.hex ? "%" PRIx64 : "%" PRId64, Get<int64_t>(in));
+            out += text;
+            break;
+        case LogDetail::ArgType::UInt:
+            std::snprintf(text, sizeof(text), spec.hex ? "%" PRIx64 : "%" PRIu64, Get<uint64_t>(in));
+            out += text;
+            break;
+        case LogDetail::ArgType::Double:
+            // Default matches an ostream's: six significant digits
+            if (spec.precision >= 0) {
+                std::snprintf(text, sizeof(text), "%.*f", std::min(spec.precision, 20), Get<double>(in));
+            } else {
+                std::snprintf(text, sizeof(text), "%g", Get<double>(in));
+            }
+            out += text;
+            break;
+        case LogDetail::ArgType::Bool:
+            out += *in++ != 0 ? "true" : "false";
+            break;
+        case LogDetail::ArgType::Char:
+            out += static_cast<char>(*in++);
+            break;
+        case LogDetail::ArgType::String: {
+            const uint32_t length = Get<uint32_t>(in);
+            out.append(reinterpret_cast<const char*>(in), length);
+            in += length;
+            break;
+        }
+        case LogDetail::ArgType::Pointer:
+            std::snprintf(text, sizeof(text), "0x%" PRIx64, Get<uint64_t>(in));
+            out += text;
+            break;
+    }
+}
+
+void Format(const char* format, size_t argCount, const uint8_t* args, std::string& out) {
+    const char* c = format;
+    while (*c != '\0') {
+        if ((c[0] == '{' && c[1] == '{') || (c[0] == '}' && c[1] == '}')) {
+            out += c[0];
+            c += 2;
+            continue;
+        }
+        if (c[0] != '{') {
+            out += *c++;
+            continue;
+        }
+
+        const char* close = std::strchr(c, '}');
+        if (close == nullptr) {
+            out += c;
+            break;
+        }
+        if (argCount == 0) {
+            out.append(c, close + 1);  // More placeholders than arguments: leave them visible
+        } else {
+            FormatSpec spec;
+            if (c[1] == ':' && c[2] == '.') {
+                spec.precision = std::atoi(c + 3);
+            } else if (c[1] == ':' && c[2] == 'x') {
+                spec.hex = true;
+            }
+            AppendArg(args, spec, out);
+            --argCount;
+        }
+        c = close + 1;
+    }
+}
+
+FILE* GetStream(LogLevel level) {
+    return level >= LogLevel::Warning ? stderr : stdout;
+}
+
+// Messages carry their own trailing newline or none; print exactly one.
+// Empty messages (a report with nothing to say) print nothing.
+void WriteLine(FILE* stream, std::string& text) {
+    if (text.empty()) {
+        return;
+    }
+    if (text.back() != '\n') {
+        text += '\n';
+    }
+    std::fwrite(text.data(), 1, text.size(), stream);
+}
+
+} // namespace
+
+struct Log::RecordHeader {
+    uint32_t size;        // Whole record, rounded up to 8 bytes; 0 marks the unused end of the ring
+    LogLevel level;
+    LogCategory category;
+    uint16_t argCount;
+    const char* format;
+    uint64_t time;        // Nanoseconds since the logger was created
+};
+
+// Single-producer, single-consumer byte ring. The owning thread reserves space
+// and publishes a record by advancing head with release; the writer reads up
+// to head and hands the space back by advancing tail. Records never straddle
+// the end: a zero size marks the rest as skipped.
+struct Log::ThreadQueue {
+    std::unique_ptr<uint8_t[]> buffer;
+    std::atomic<uint64_t> head{0};
+    std::atomic<uint64_t> tail{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<bool> inUse{true};  // Cleared when the thread exits, so a new thread can take the ring over
+    uint64_t pendingHead = 0;       // Owner only: head once the record being written is published
+    uint64_t reported = 0;          // Writer only: drops already reported
+    uint32_t id = 0;
+};
+
+struct Log::Line {
+    uint64_t time;
+    LogLevel level;
+    std::string text;
+};
+
+Log& Log::Get() {
+    static Log instance;
+    return instance;
+}
+
+const char* Log::GetLevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace: return "trace";
+        case LogLevel::Debug: return "debug";
+        case LogLevel::Info: return "info";
+        case LogLevel::Warning: return "warning";
+        case LogLevel::Error: return "error";
+    }
+    return "unknown";
+}
+
+const char* Log::GetCategoryName(LogCategory category) {
+    switch (category) {
+        case LogCategory::Core: return "core";
+        case LogCategory::Rendering: return "rendering";
+        case LogCategory::Input: return "input";
+        case LogCategory::Scene: return "scene";
+        case LogCategory::Assets: return "assets";
+        case LogCategory::Count: break;
+    }
+    return "unknown";
+}
+
+Log::Log()
+    : m_Epoch(std::chrono::steady_clock::now())
+    , m_Running(true)
+    , m_FlushRequested(0)
+    , m_FlushCompleted(0)
+    , m_Quit(false)
+    , m_Stopped(false)
+    , m_Written(0) {
+    m_Writer = std::thread(&Log::WriterLoop, this);
+}
+
+Log::~Log() {
+    Shutdown();
+}
+
+uint64_t Log::Now() const {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - m_Epoch).count());
+}
+
+Log::ThreadQueue& Log::GetThreadQueue() {
+    struct Lease {
+        ThreadQueue* queue = nullptr;
+
+        ~Lease() {
+            if (queue != nullptr) {
+                queue->inUse.store(false, std::memory_order_release);
+            }
+        }
+    };
+    thread_local Lease lease;
+
+    if (lease.queue == nullptr) {
+        std::lock_guard<std::mutex> lock(m_QueuesMutex);
+        for (const auto& queue : m_Queues) {
+            if (!queue->inUse.load(std::memory_order_acquire)) {
+                queue->inUse.store(true, std::memory_order_relaxed);
+                lease.queue = queue.get();
+                break;
+            }
+        }
+        if (lease.queue == nullptr) {
+            auto created = std::make_unique<ThreadQueue>();
+            created->buffer = std::make_unique<uint8_t[]>(QueueBytes);
+            created->id = static_cast<uint32_t>(m_Queues.size() + 1);
+            lease.queue = created.get();
+            m_Queues.push_back(std::move(created));
+        }
+    }
+    return *lease.queue;
+}
+
+uint8_t* Log::BeginRecord(LogLevel level, LogCategory category, const char* format, size_t argCount,
+                          size_t payload) {
+    const size_t size = AlignRecord(sizeof(RecordHeader) + payload);
+    const RecordHeader header{static_cast<uint32_t>(size), level, category, static_cast<uint16_t>(argCount),
+                              format, Now()};
+
+    if (!m_Running.load(std::memory_order_acquire)) {
+        t_DirectRecord.resize(size);
+        std::memcpy(t_DirectRecord.data(), &header, sizeof(header));
+        t_Direct = true;
+        return t_DirectRecord.data() + sizeof(header);
+    }
+
+    ThreadQueue& queue = GetThreadQueue();
+    const uint64_t head = queue.head.load(std::memory_order_relaxed);
+    const uint64_t tail = queue.tail.load(std::memory_order_acquire);
+    const size_t offset = static_cast<size_t>(head % QueueBytes);
+    const size_t contiguous = QueueBytes - offset;
+    const size_t needed = size <= contiguous ? size : contiguous + size;
+    if (head + needed - tail > QueueBytes) {
+        queue.dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    uint64_t start = head;
+    if (size > contiguous) {
+        const uint32_t skip = 0;
+        std::memcpy(queue.buffer.get() + offset, &skip, sizeof(skip));
+        start += contiguous;
+    }
+    uint8_t* record = queue.buffer.get() + start % QueueBytes;
+    std::memcpy(record, &header, sizeof(header));
+    queue.pendingHead = start + size;
+    t_Direct = false;
+    return record + sizeof(header);
+}
+
+void Log::EndRecord() {
+    if (t_Direct) {
+        RecordHeader header;
+        std::memcpy(&header, t_DirectRecord.data(), sizeof(header));
+        std::string text;
+        Format(header.format, header.argCount, t_DirectRecord.data() + sizeof(header), text);
+        FILE* stream = GetStream(header.level);
+        WriteLine(stream, text);
+        std::fflush(stream);
+        t_Direct = false;
+        return;
+    }
+    ThreadQueue& queue = GetThreadQueue();
+    queue.head.store(queue.pendingHead, std::memory_order_release);
+}
+
+void Log::Drain(std::vector<Line>& lines) {
+    std::lock_guard<std::mutex> lock(m_QueuesMutex);
+    for (const auto& queue : m_Queues) {
+        uint64_t tail = queue->tail.load(std::memory_order_relaxed);
+        const uint64_t head = queue->head.load(std::memory_order_acquire);
+        while (tail < head) {
+            const size_t offset = static_cast<size_t>(tail % QueueBytes);
+            const uint8_t* record = queue->buffer.get() + offset;
+            RecordHeader header;
+            std::memcpy(&header.size, record, sizeof(header.size));
+            if (header.size == 0) {
+                tail += QueueBytes - offset;
+                continue;
+            }
+            std::memcpy(&header, record, sizeof(header));
+            Line line{header.time, header.level, std::string()};
+            Format(header.format, header.argCount, record + sizeof(header), line.text);
+            lines.push_back(std::move(line));
+            tail += header.size;
+        }
+        queue->tail.store(tail, std::memory_order_release);
+
+        const uint64_t dropped = queue->dropped.load(std::memory_order_relaxed);
+        if (dropped != queue->reported) {
+            lines.push_back({Now(), LogLevel::Warning,
+                             "Log: " + std::to_string(dropped - queue->reported) + " messages dropped on thread " +
+                             std::to_string(queue->id) + " (queue full)"});
+            queue->reported = dropped;
+        }
+    }
+}
+
+void Log::Output(std::vector<Line>& lines) {
+    if (lines.empty()) {
+        return;
+    }
+
+    // Each ring is in order; interleave the threads by time
+    std::stable_sort(lines.begin(), lines.end(), [](const Line& a, const Line& b) { return a.time < b.time; });
+    for (Line& line : lines) {
+        WriteLine(GetStream(line.level), line.text);
+    }
+    std::fflush(stdout);
+    std::fflush(stderr);
+    m_Written.fetch_add(lines.size(), std::memory_order_relaxed);
+    lines.clear();
+}
+
+void Log::WriterLoop() {
+    SHADOW_PROFILE_THREAD("Log");
+    std::vector<Line> lines;
+    std::unique_lock<std::mutex> lock(m_WakeMutex);
+    while (true) {
+        // Read before draining: whatever was logged before these requests is
+        // in the rings by now
+        const uint64_t flushTarget = m_FlushRequested;
+        const bool quit = m_Quit;
+        lock.unlock();
+        Drain(lines);
+        Output(lines);
+        lock.lock();
+
+        m_FlushCompleted = flushTarget;
+        m_Flushed.notify_all();
+        if (quit) {
+            break;
+        }
+        if (m_FlushRequested == m_FlushCompleted && !m_Quit) {
+            m_Wake.wait_for(lock, PollInterval);
+        }
+    }
+    m_Stopped = true;
+    m_Flushed.notify_all();
+}
+
+void Log::Flush() {
+    std::unique_lock<std::mutex> lock(m_WakeMutex);
+    if (m_Stopped) {
+        return;  // Messages are written synchronously by now
+    }
+    const uint64_t target = ++m_FlushRequested;
+    m_Wake.notify_one();
+    m_Flushed.wait(lock, [this, target] { return m_FlushCompleted >= target || m_Stopped; });
+}
+
+void Log::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_WakeMutex);
+        m_Quit = true;
+    }
+    m_Running.store(false, std::memory_order_release);
+    m_Wake.notify_one();
+    if (m_Writer.joinable()) {
+        m_Writer.join();
+    }
+}
+
+Log::Stats Log::GetStats() const {
+    Stats stats;
+    stats.written = m_Written.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(m_QueuesMutex);
+    for (const auto& queue : m_Queues) {
+        stats.dropped += queue->dropped.load(std::memory_order_relaxed);
+    }
+    stats.threads = static_cast<unsigned>(m_Queues.size());
+    return stats;
+}
+
+} // namespace ShadowEngine
@@ -0,0 +1,201 @@
+#include "core/Lz4.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace ShadowEngine {
+namespace Lz4 {
+
+namespace {
+
+// Format constants from the LZ4 block specification
+constexpr size_t MinMatch = 4;
+constexpr size_t LastLiterals = 5;       // The last five bytes are always literals
+constexpr size_t MatchSearchLimit = 12;  // No match starts within 12 bytes of the end
+constexpr size_t MaxOffset = 65535;
+
+constexpr int HashBits = 12;
+
+uint32_t Read32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint32_t Hash(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - HashBits);
+}
+
+// Lengths of 15 and over continue in bytes of 255 and a final remainder
+uint8_t* WriteLength(uint8_t* out, size_t length) {
+    while (length >= 255) {
+        *out++ = 255;
+        length -= 255;
+    }
+    *out++ = static_cast<uint8_t>(length);
+    return out;
+}
+
+bool ReadLength(const uint8_t*& in, const uint8_t* end, size_t& length) {
+    uint8_t byte;
+    do {
+        if (in == end) {
+            return false;
+        }
+        byte = *in++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+// One token: literals, then a back-reference unless this is the last sequence
+uint8_t* WriteSequence(uint8_t* out, const uint8_t* literals, size_t literalLength,
+                       size_t offset, size_t matchLength) {
+    uint8_t* token = out++;
+    const size_t literalNibble = std::min<size_t>(literalLength, 15);
+    if (literalLength >= 15) {
+        out = WriteLength(out, literalLength - 15);
+    }
+    if (literalLength > 0) {
+        std::memcpy(out, literals, literalLength);
+        out += literalLength;
+    }
+
+    if (matchLength == 0) {
+        *token = static_cast<uint8_t>(literalNibble << 4);
+        return out;
+    }
+
+    *out++ = static_cast<uint8_t>(offset & 0xFF);
+    *out++ = static_cast<uint8_t>(offset >> 8);
+    const size_t extra = matchLength - MinMatch;
+    if (extra >= 15) {
+        out = WriteLength(out, extra - 15);
+    }
+    *token = static_cast<uint8_t>((literalNibble << 4) | std::min<size_t>(extra, 15));
+    return out;
+}
+
+} // namespace
+
+size_t GetMaxCompressedSize(size_t size) {
+    return size + size / 255 + 16;
+}
+
+size_t GetMaxDecompressedSize(size_t size) {
+    return size * 255 + 16;
+}
+
+size_t Compress(const uint8_t* data, size_t size, uint8_t* out) {
+    uint8_t* op = out;
+    const uint8_t* anchor = data;
+
+    if (size > MatchSearchLimit) {
+        // Last position each 4-byte sequence was seen at; stale or colliding
+        // entries are rejected by comparing the bytes
+        uint32_t table[1 << HashBits] = {};
+        const uint8_t* const searchEnd = data + size - MatchSearchLimit;
+        const uint8_t* const matchEnd = data + size - LastLiterals;
+
+        const uint8_t* ip = data;
+        while (ip <= searchEnd) {
+            const uint32_t sequence = Read32(ip);
+            const uint32_t hash = Hash(sequence);
+            const uint8_t* candidate = data + table[hash];
+            table[hash] = static_cast<uint32_t>(ip - data);
+
+            if (candidate >= ip || static_cast<size_t>(ip - candidate) > MaxOffset || Read32(candidate) != sequence) {
+                // Step further the longer nothing matched, so incompressible
+                // data is skipped quickly
+                ip += 1 + (static_cast<size_t>(ip - anchor) >> 6);
+                continue;
+            }
+
+            // Extend backwards into the pending literals, then forwards
+            while (ip > anchor && candidate > data && ip[-1] == candidate[-1]) {
+                --ip;
+                --candidate;
+            }
+            const uint8_t* end = ip + MinMatch;
+            const uint8_t* reference = candidate + MinMatch;
+            while (end < matchEnd && *end == *reference) {
+                ++end;
+                ++reference;
+            }
+
+            op = WriteSequence(op, anchor, static_cast<size_t>(ip - anchor),
+                               static_cast<size_t>(ip - candidate), static_cast<size_t>(end - ip));
+            ip = end;
+            anchor = ip;
+
+            if (ip <= searchEnd) {
+                table[Hash(Read32(ip - 2))] = static_cast<uint32_t>(ip - 2 - data);
+            }
+        }
+    }
+
+    op = WriteSequence(op, anchor, static_cast<size_t>(data + size - anchor), 0, 0);
+    return static_cast<size_t>(op - out);
+}
+
+bool Decompress(const uint8_t* data, size_t size, uint8_t* out, size_t outSize) {
+    const uint8_t* ip = data;
+    const uint8_t* const inEnd = data + size;
+    uint8_t* op = out;
+    uint8_t* const outEnd = out + outSize;
+
+    while (ip < inEnd) {
+        const uint8_t token = *ip++;
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !ReadLength(ip, inEnd, literalLength)) {
+            return false;
+        }
+        if (literalLength > static_cast<size_t>(inEnd - ip) || literalLength > static_cast<size_t>(outEnd - op)) {
+            return false;
+        }
+        if (literalLength > 0) {
+            std::memcpy(op, ip, literalLength);
+            ip += literalLength;
+            op += literalLength;
+        }
+
+        // The last sequence ends after its literals
+        if (ip == inEnd) {
+            break;
+        }
+
+        if (inEnd - ip < 2) {
+            return false;
+        }
+        const size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - out)) {
+            return false;
+        }
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !ReadLength(ip, inEnd, matchLength)) {
+            return false;
+        }
+        matchLength += MinMatch;
+        if (matchLength > static_cast<size_t>(outEnd - op)) {
+            return false;
+        }
+
+        // Overlapping matches repeat the last offset bytes, so copy forwards
+        const uint8_t* match = op - offset;
+        if (offset >= matchLength) {
+            std::memcpy(op, match, matchLength);
+            op += matchLength;
+        } else {
+            for (size_t i = 0; i < matchLength; ++i) {
+                *op++ = *match++;
+            }
+        }
+    }
+
+    return op == outEnd;
+}
+
+} // namespace Lz4
+} // namespace ShadowEngine
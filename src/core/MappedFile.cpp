@@ -0,0 +1,153 @@
+#include "core/MappedFile.hpp"
+#include "core/Log.hpp"
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ShadowEngine {
+
+MappedFile::MappedFile()
+    : m_Data(nullptr)
+    , m_Size(0)
+#ifdef _WIN32
+    , m_FileHandle(nullptr)
+    , m_MappingHandle(nullptr)
+#else
+    , m_FileDescriptor(-1)
+#endif
+{
+}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : MappedFile()
+{
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        std::swap(m_Data, other.m_Data);
+        std::swap(m_Size, other.m_Size);
+        std::swap(m_Path, other.m_Path);
+#ifdef _WIN32
+        std::swap(m_FileHandle, other.m_FileHandle);
+        std::swap(m_MappingHandle, other.m_MappingHandle);
+#else
+        std::swap(m_FileDescriptor, other.m_FileDescriptor);
+#endif
+    }
+    return *this;
+}
+
+bool MappedFile::Open(const std::string& path) {
+    Close();
+    m_Path = path;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        SHADOW_LOG_ERROR(Assets, "Failed to open file for mapping: {}", path);
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        SHADOW_LOG_ERROR(Assets, "Cannot map empty file: {}", path);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        SHADOW_LOG_ERROR(Assets, "Failed to create file mapping: {}", path);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        SHADOW_LOG_ERROR(Assets, "Failed to map view of file: {}", path);
+        return false;
+    }
+
+    m_FileHandle = file;
+    m_MappingHandle = mapping;
+    m_Data = static_cast<const uint8_t*>(view);
+    m_Size = static_cast<size_t>(size.QuadPart);
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        SHADOW_LOG_ERROR(Assets, "Failed to open file for mapping: {}", path);
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        SHADOW_LOG_ERROR(Assets, "Cannot map empty file: {}", path);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (view == MAP_FAILED) {
+        close(fd);
+        SHADOW_LOG_ERROR(Assets, "Failed to map file: {}", path);
+        return false;
+    }
+
+    m_FileDescriptor = fd;
+    m_Data = static_cast<const uint8_t*>(view);
+    m_Size = static_cast<size_t>(info.st_size);
+#endif
+
+    return true;
+}
+
+void MappedFile::Close() {
+#ifdef _WIN32
+    if (m_Data) {
+        UnmapViewOfFile(m_Data);
+    }
+    if (m_MappingHandle) {
+        CloseHandle(m_MappingHandle);
+        m_MappingHandle = nullptr;
+    }
+    if (m_FileHandle) {
+        CloseHandle(m_FileHandle);
+        m_FileHandle = nullptr;
+    }
+#else
+    if (m_Data) {
+        munmap(const_cast<uint8_t*>(m_Data), m_Size);
+    }
+    if (m_FileDescriptor >= 0) {
+        close(m_FileDescriptor);
+        m_FileDescriptor = -1;
+    }
+#endif
+    m_Data = nullptr;
+    m_Size = 0;
+}
+
+} // namespace ShadowEngine
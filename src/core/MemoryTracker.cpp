@@ -0,0 +1,238 @@
+#include "core/MemoryTracker.hpp"
+#include "core/AllocationTracker.hpp"
+#include "core/Log.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+namespace ShadowEngine {
+
+namespace {
+
+constexpr size_t TagCount = static_cast<size_t>(MemoryTag::Count);
+constexpr size_t DomainCount = static_cast<size_t>(MemoryDomain::Count);
+
+// Plain atomics rather than members: heap charges arrive from the replacement
+// operator new before the tracker exists and after it is destroyed
+struct Counter {
+    std::atomic<int64_t> current{0};
+    std::atomic<int64_t> peak{0};
+    std::atomic<int64_t> intervalPeak{0};  // Highest since the last budget check
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> budget{0};
+};
+
+Counter s_Counters[TagCount][DomainCount];
+bool s_OverBudget[TagCount][DomainCount];  // Only touched by CheckBudgets
+
+thread_local MemoryTag t_CurrentTag = MemoryTag::Core;
+
+const char* const TagNames[TagCount] = {"core", "rendering", "input", "scene", "assets"};
+const char* const DomainNames[DomainCount] = {"heap", "gpu"};
+
+Counter& GetCounter(MemoryTag tag, MemoryDomain domain) {
+    return s_Counters[static_cast<size_t>(tag)][static_cast<size_t>(domain)];
+}
+
+void RaiseTo(std::atomic<int64_t>& value, int64_t candidate) {
+    int64_t seen = value.load(std::memory_order_relaxed);
+    while (seen < candidate && !value.compare_exchange_weak(seen, candidate, std::memory_order_relaxed)) {
+    }
+}
+
+void PrintBytes(std::ostream& out, int64_t bytes) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%10.2f MB", static_cast<double>(bytes) / (1024.0 * 1024.0));
+    out << text;
+}
+
+} // namespace
+
+MemoryTracker& MemoryTracker::Get() {
+    static MemoryTracker instance;
+    return instance;
+}
+
+bool MemoryTracker::IsHeapTracked() {
+    return AllocationTracker::IsEnabled();
+}
+
+const char* MemoryTracker::GetTagName(MemoryTag tag) {
+    return static_cast<size_t>(tag) < TagCount ? TagNames[static_cast<size_t>(tag)] : "unknown";
+}
+
+const char* MemoryTracker::GetDomainName(MemoryDomain domain) {
+    return static_cast<size_t>(domain) < DomainCount ? DomainNames[static_cast<size_t>(domain)] : "unknown";
+}
+
+bool MemoryTracker::ParseTag(const std::string& text, MemoryTag& out) {
+    for (size_t i = 0; i < TagCount; ++i) {
+        if (text == TagNames[i]) {
+            out = static_cast<MemoryTag>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MemoryTracker::ParseDomain(const std::string& text, MemoryDomain& out) {
+    for (size_t i = 0; i < DomainCount; ++i) {
+        if (text == DomainNames[i]) {
+            out = static_cast<MemoryDomain>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MemoryTracker::ParseBudget(const std::string& text, MemoryTag& tag, MemoryDomain& domain, size_t& bytes) {
+    const size_t dot = text.find('.');
+    const size_t equals = text.find('=', dot == std::string::npos ? 0 : dot);
+    if (dot == std::string::npos || equals == std::string::npos ||
+        !ParseTag(text.substr(0, dot), tag) || !ParseDomain(text.substr(dot + 1, equals - dot - 1), domain)) {
+        return false;
+    }
+
+    char* end = nullptr;
+    const double megabytes = std::strtod(text.c_str() + equals + 1, &end);
+    if (end == text.c_str() + equals + 1 || *end != '\0' || megabytes < 0.0) {
+        return false;
+    }
+    bytes = static_cast<size_t>(megabytes * 1024.0 * 1024.0);
+    return true;
+}
+
+void MemoryTracker::Add(MemoryTag tag, MemoryDomain domain, size_t bytes) {
+    Counter& counter = GetCounter(tag, domain);
+    const int64_t current = counter.current.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed) +
+                            static_cast<int64_t>(bytes);
+    counter.allocations.fetch_add(1, std::memory_order_relaxed);
+    RaiseTo(counter.peak, current);
+    RaiseTo(counter.intervalPeak, current);
+}
+
+void MemoryTracker::Remove(MemoryTag tag, MemoryDomain domain, size_t bytes) {
+    GetCounter(tag, domain).current.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+}
+
+void MemoryTracker::ResetPeaks() {
+    for (auto& domains : s_Counters) {
+        for (Counter& counter : domains) {
+            counter.peak.store(counter.current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    }
+}
+
+MemoryTracker::Usage MemoryTracker::GetUsage(MemoryTag tag, MemoryDomain domain) const {
+    const Counter& counter = GetCounter(tag, domain);
+    Usage usage;
+    usage.current = counter.current.load(std::memory_order_relaxed);
+    usage.peak = counter.peak.load(std::memory_order_relaxed);
+    usage.allocations = counter.allocations.load(std::memory_order_relaxed);
+    return usage;
+}
+
+int64_t MemoryTracker::GetTotal(MemoryDomain domain) const {
+    int64_t total = 0;
+    for (size_t tag = 0; tag < TagCount; ++tag) {
+        total += GetUsage(static_cast<MemoryTag>(tag), domain).current;
+    }
+    return total;
+}
+
+void MemoryTracker::SetBudget(MemoryTag tag, MemoryDomain domain, size_t bytes) {
+    GetCounter(tag, domain).budget.store(bytes, std::memory_order_relaxed);
+}
+
+size_t MemoryTracker::GetBudget(MemoryTag tag, MemoryDomain domain) const {
+    return static_cast<size_t>(GetCounter(tag, domain).budget.load(std::memory_order_relaxed));
+}
+
+void MemoryTracker::CheckBudgets() {
+    for (size_t tag = 0; tag < TagCount; ++tag) {
+        for (size_t domain = 0; domain < DomainCount; ++domain) {
+            Counter& counter = s_Counters[tag][domain];
+            const int64_t budget = static_cast<int64_t>(counter.budget.load(std::memory_order_relaxed));
+            if (budget == 0) {
+                continue;
+            }
+
+            // The highest use since the last check, so short spikes still warn
+            const int64_t current = counter.current.load(std::memory_order_relaxed);
+            const int64_t highest = std::max(current, counter.intervalPeak.exchange(current, std::memory_order_relaxed));
+            if (highest > budget && !s_OverBudget[tag][domain]) {
+                s_OverBudget[tag][domain] = true;
+                SHADOW_LOG_WARNING(Core, "Memory budget exceeded: {} {} reached {} KB of {} KB", TagNames[tag],
+                                   DomainNames[domain], highest / 1024, budget / 1024);
+            } else if (current <= budget && s_OverBudget[tag][domain]) {
+                s_OverBudget[tag][domain] = false;
+            }
+        }
+    }
+}
+
+MemoryTracker::Snapshot MemoryTracker::TakeSnapshot(uint64_t frame) const {
+    Snapshot snapshot;
+    snapshot.frame = frame;
+    for (size_t tag = 0; tag < TagCount; ++tag) {
+        for (size_t domain = 0; domain < DomainCount; ++domain) {
+            snapshot.usage[tag][domain] = GetUsage(static_cast<MemoryTag>(tag), static_cast<MemoryDomain>(domain));
+        }
+    }
+    return snapshot;
+}
+
+void MemoryTracker::PrintReport(std::ostream& out, const Snapshot& snapshot) {
+    out << "Memory at frame " << snapshot.frame << (IsHeapTracked() ? "" : " (heap not tracked)") << ":" << std::endl;
+    for (size_t domain = 0; domain < DomainCount; ++domain) {
+        if (domain == static_cast<size_t>(MemoryDomain::Heap) && !IsHeapTracked()) {
+            continue;
+        }
+        for (size_t tag = 0; tag < TagCount; ++tag) {
+            const Usage& usage = snapshot.usage[tag][domain];
+            const uint64_t budget = s_Counters[tag][domain].budget.load(std::memory_order_relaxed);
+            char label[32];
+            std::snprintf(label, sizeof(label), "  %-4s %-10s", DomainNames[domain], TagNames[tag]);
+            out << label;
+            PrintBytes(out, usage.current);
+            out << ", peak";
+            PrintBytes(out, usage.peak);
+            if (budget > 0) {
+                out << ", budget";
+                PrintBytes(out, static_cast<int64_t>(budget));
+            }
+            out << std::endl;
+        }
+    }
+}
+
+void MemoryTracker::WriteCsvHeader(std::ostream& out) {
+    out << "frame,domain,tag,current_bytes,peak_bytes,allocations,budget_bytes\n";
+}
+
+void MemoryTracker::WriteCsvRows(std::ostream& out, const Snapshot& snapshot) {
+    for (size_t domain = 0; domain < DomainCount; ++domain) {
+        for (size_t tag = 0; tag < TagCount; ++tag) {
+            const Usage& usage = snapshot.usage[tag][domain];
+            out << snapshot.frame << ',' << DomainNames[domain] << ',' << TagNames[tag] << ','
+                << usage.current << ',' << usage.peak << ',' << usage.allocations << ','
+                << s_Counters[tag][domain].budget.load(std::memory_order_relaxed) << '\n';
+        }
+    }
+}
+
+MemoryScope::MemoryScope(MemoryTag tag)
+    : m_Previous(t_CurrentTag) {
+    t_CurrentTag = tag;
+}
+
+MemoryScope::~MemoryScope() {
+    t_CurrentTag = m_Previous;
+}
+
+MemoryTag MemoryScope::GetCurrent() {
+    return t_CurrentTag;
+}
+
+} // namespace ShadowEngine
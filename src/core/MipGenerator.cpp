@@ -0,0 +1,423 @@
+#include "core/MipGenerator.hpp"
+#include "core/JobSystem.hpp"
+#include "core/Profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SHADOW_MIP_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace ShadowEngine {
+namespace MipGenerator {
+
+namespace {
+
+constexpr double KernelRadius = 3.0;  // Kaiser and Lanczos support, in destination texels
+constexpr double KaiserAlpha = 4.0;
+constexpr int RowsPerJob = 16;
+constexpr int EncodeTableSize = 4096;  // Indexed by sqrt(linear), which spaces entries evenly in sRGB
+
+using ImageData = ImageLoader::ImageData;
+
+double Sinc(double x) {
+    if (std::abs(x) < 1e-8) {
+        return 1.0;
+    }
+    const double px = 3.14159265358979323846 * x;
+    return std::sin(px) / px;
+}
+
+// Modified Bessel function of the first kind, order 0 (power series)
+double BesselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    const double quarterSquare = x * x / 4.0;
+    for (int k = 1; k < 32 && term > sum * 1e-12; ++k) {
+        term *= quarterSquare / (static_cast<double>(k) * k);
+        sum += term;
+    }
+    return sum;
+}
+
+double EvaluateKernel(Filter filter, double x) {
+    x = std::abs(x);
+    if (x >= KernelRadius) {
+        return 0.0;
+    }
+    if (filter == Filter::Lanczos) {
+        return Sinc(x) * Sinc(x / KernelRadius);
+    }
+    const double t = x / KernelRadius;
+    return Sinc(x) * BesselI0(KaiserAlpha * std::sqrt(1.0 - t * t)) / BesselI0(KaiserAlpha);
+}
+
+// Source texels and weights for every destination texel along one axis. Each
+// texel has the same number of taps; short ones are padded with zero weights
+// on their last index so the indices never decrease.
+struct Axis {
+    int taps = 0;
+    std::vector<int> indices;
+    std::vector<float> weights;
+};
+
+Axis BuildAxis(Filter filter, int srcSize, int dstSize) {
+    const double scale = static_cast<double>(srcSize) / dstSize;
+    std::vector<std::vector<std::pair<int, double>>> texels(static_cast<size_t>(dstSize));
+
+    for (int i = 0; i < dstSize; ++i) {
+        std::vector<std::pair<int, double>>& taps = texels[static_cast<size_t>(i)];
+        if (filter == Filter::Box) {
+            // Overlap of each source texel with the destination texel's footprint
+            const double lo = i * scale;
+            const double hi = (i + 1) * scale;
+            for (int j = static_cast<int>(std::floor(lo)); j < static_cast<int>(std::ceil(hi)); ++j) {
+                const double overlap = std::min(hi, j + 1.0) - std::max(lo, static_cast<double>(j));
+                if (overlap > 0.0) {
+                    taps.emplace_back(j, overlap);
+                }
+            }
+        } else {
+            // Kernel stretched by the ratio, sampled at source texel centres
+            const double center = (i + 0.5) * scale;
+            const double support = KernelRadius * scale;
+            const int first = static_cast<int>(std::ceil(center - support - 0.5));
+            const int last = static_cast<int>(std::floor(center + support - 0.5));
+            for (int j = first; j <= last; ++j) {
+                const double weight = EvaluateKernel(filter, (j + 0.5 - center) / scale);
+                if (weight != 0.0) {
+                    taps.emplace_back(j, weight);
+                }
+            }
+        }
+
+        double total = 0.0;
+        for (const auto& tap : taps) {
+            total += tap.second;
+        }
+        for (auto& tap : taps) {
+            tap.first = std::clamp(tap.first, 0, srcSize - 1);  // Edges repeat
+            tap.second /= total;
+        }
+    }
+
+    Axis axis;
+    for (const auto& taps : texels) {
+        axis.taps = std::max(axis.taps, static_cast<int>(taps.size()));
+    }
+    axis.indices.resize(static_cast<size_t>(dstSize) * axis.taps);
+    axis.weights.resize(static_cast<size_t>(dstSize) * axis.taps, 0.0f);
+    for (size_t i = 0; i < texels.size(); ++i) {
+        for (int k = 0; k < axis.taps; ++k) {
+            const size_t tap = std::min(static_cast<size_t>(k), texels[i].size() - 1);
+            axis.indices[i * axis.taps + k] = texels[i][tap].first;
+            if (static_cast<size_t>(k) < texels[i].size()) {
+                axis.weights[i * axis.taps + k] = static_cast<float>(texels[i][k].second);
+            }
+        }
+    }
+    return axis;
+}
+
+double SrgbToLinear(double value) {
+    return value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+}
+
+double LinearToSrgb(double value) {
+    return value <= 0.0031308 ? value * 12.92 : 1.055 * std::pow(value, 1.0 / 2.4) - 0.055;
+}
+
+unsigned char Quantize(double value) {
+    return static_cast<unsigned char>(std::floor(std::clamp(value, 0.0, 1.0) * 255.0 + 0.5));
+}
+
+struct Tables {
+    float unorm[256];
+    float srgbToLinear[256];
+    unsigned char linearToSrgb[EncodeTableSize];
+
+    Tables() {
+        for (int i = 0; i < 256; ++i) {
+            unorm[i] = static_cast<float>(i / 255.0);
+            srgbToLinear[i] = static_cast<float>(SrgbToLinear(i / 255.0));
+        }
+        for (int i = 0; i < EncodeTableSize; ++i) {
+            const double root = static_cast<double>(i) / (EncodeTableSize - 1);
+            linearToSrgb[i] = Quantize(LinearToSrgb(root * root));
+        }
+    }
+};
+
+const Tables& GetTables() {
+    static const Tables tables;
+    return tables;
+}
+
+// One RGBA pixel in a register where SSE2 is available
+#ifdef SHADOW_MIP_SSE2
+using Vec4 = __m128;
+inline Vec4 Zero() { return _mm_setzero_ps(); }
+inline Vec4 Load(const float* p) { return _mm_loadu_ps(p); }
+inline void Store(float* p, Vec4 v) { _mm_storeu_ps(p, v); }
+inline Vec4 MulAdd(Vec4 acc, Vec4 v, float w) { return _mm_add_ps(acc, _mm_mul_ps(v, _mm_set1_ps(w))); }
+#else
+struct Vec4 { float c[4]; };
+inline Vec4 Zero() { return Vec4{{0.0f, 0.0f, 0.0f, 0.0f}}; }
+inline Vec4 Load(const float* p) { return Vec4{{p[0], p[1], p[2], p[3]}}; }
+inline void Store(float* p, Vec4 v) { std::copy(v.c, v.c + 4, p); }
+inline Vec4 MulAdd(Vec4 acc, Vec4 v, float w) {
+    for (int c = 0; c < 4; ++c) {
+        acc.c[c] += v.c[c] * w;
+    }
+    return acc;
+}
+#endif
+
+void Encode(Vec4 value, bool srgb, const Tables& tables, unsigned char* out) {
+#ifdef SHADOW_MIP_SSE2
+    const Vec4 clamped = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    const __m128i unorm = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f)));
+    if (!srgb) {
+        const __m128i words = _mm_packs_epi32(unorm, unorm);
+        const int pixel = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+        std::memcpy(out, &pixel, 4);
+        return;
+    }
+    const __m128i index = _mm_cvttps_epi32(_mm_add_ps(
+        _mm_mul_ps(_mm_sqrt_ps(clamped), _mm_set1_ps(static_cast<float>(EncodeTableSize - 1))), _mm_set1_ps(0.5f)));
+    alignas(16) int indices[4];
+    alignas(16) int alpha[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(indices), index);
+    _mm_store_si128(reinterpret_cast<__m128i*>(alpha), unorm);
+    out[0] = tables.linearToSrgb[indices[0]];
+    out[1] = tables.linearToSrgb[indices[1]];
+    out[2] = tables.linearToSrgb[indices[2]];
+    out[3] = static_cast<unsigned char>(alpha[3]);
+#else
+    for (int c = 0; c < 4; ++c) {
+        const float v = std::min(std::max(value.c[c], 0.0f), 1.0f);
+        if (srgb && c < 3) {
+            out[c] = tables.linearToSrgb[static_cast<int>(std::sqrt(v) * (EncodeTableSize - 1) + 0.5f)];
+        } else {
+            out[c] = static_cast<unsigned char>(v * 255.0f + 0.5f);
+        }
+    }
+#endif
+}
+
+// Filter destination rows [rowBegin, rowEnd): decode the source rows they
+// cover, filter those horizontally into a band, then filter the band
+// vertically. Bands overlap by the filter support, so each runs on its own.
+void ResampleRows(const ImageData& src, ImageData& dst, const Axis& xAxis, const Axis& yAxis, bool srgb,
+                  int rowBegin, int rowEnd) {
+    const Tables& tables = GetTables();
+    const float* colourTable = srgb ? tables.srgbToLinear : tables.unorm;
+    const int firstRow = yAxis.indices[static_cast<size_t>(rowBegin) * yAxis.taps];
+    const int lastRow = yAxis.indices[static_cast<size_t>(rowEnd) * yAxis.taps - 1];
+    const size_t bandStride = static_cast<size_t>(dst.width) * 4;
+
+    std::vector<float> row(static_cast<size_t>(src.width) * 4);
+    std::vector<float> band(static_cast<size_t>(lastRow - firstRow + 1) * bandStride);
+
+    for (int sy = firstRow; sy <= lastRow; ++sy) {
+        const unsigned char* in = &src.data[static_cast<size_t>(sy) * src.width * 4];
+        for (int x = 0; x < src.width * 4; x += 4) {
+            row[x + 0] = colourTable[in[x + 0]];
+            row[x + 1] = colourTable[in[x + 1]];
+            row[x + 2] = colourTable[in[x + 2]];
+            row[x + 3] = tables.unorm[in[x + 3]];
+        }
+
+        float* out = &band[static_cast<size_t>(sy - firstRow) * bandStride];
+        for (int x = 0; x < dst.width; ++x) {
+            const int* indices = &xAxis.indices[static_cast<size_t>(x) * xAxis.taps];
+            const float* weights = &xAxis.weights[static_cast<size_t>(x) * xAxis.taps];
+            Vec4 acc = Zero();
+            for (int k = 0; k < xAxis.taps; ++k) {
+                acc = MulAdd(acc, Load(&row[static_cast<size_t>(indices[k]) * 4]), weights[k]);
+            }
+            Store(out + static_cast<size_t>(x) * 4, acc);
+        }
+    }
+
+    for (int y = rowBegin; y < rowEnd; ++y) {
+        const int* indices = &yAxis.indices[static_cast<size_t>(y) * yAxis.taps];
+        const float* weights = &yAxis.weights[static_cast<size_t>(y) * yAxis.taps];
+        unsigned char* out = &dst.data[static_cast<size_t>(y) * dst.width * 4];
+        for (int x = 0; x < dst.width; ++x) {
+            Vec4 acc = Zero();
+            for (int k = 0; k < yAxis.taps; ++k) {
+                acc = MulAdd(acc, Load(&band[static_cast<size_t>(indices[k] - firstRow) * bandStride + x * 4]),
+                             weights[k]);
+            }
+            Encode(acc, srgb, tables, out + static_cast<size_t>(x) * 4);
+        }
+    }
+}
+
+void ResampleReference(const ImageData& src, ImageData& dst, const Axis& xAxis, const Axis& yAxis, bool srgb) {
+    std::vector<double> linear(src.data.size());
+    for (size_t i = 0; i < src.data.size(); ++i) {
+        const double value = src.data[i] / 255.0;
+        linear[i] = srgb && i % 4 != 3 ? SrgbToLinear(value) : value;
+    }
+
+    std::vector<double> horizontal(static_cast<size_t>(src.height) * dst.width * 4, 0.0);
+    for (int y = 0; y < src.height; ++y) {
+        for (int x = 0; x < dst.width; ++x) {
+            for (int k = 0; k < xAxis.taps; ++k) {
+                const size_t tap = static_cast<size_t>(x) * xAxis.taps + k;
+                const size_t from = (static_cast<size_t>(y) * src.width + xAxis.indices[tap]) * 4;
+                for (int c = 0; c < 4; ++c) {
+                    horizontal[(static_cast<size_t>(y) * dst.width + x) * 4 + c] += linear[from + c] * xAxis.weights[tap];
+                }
+            }
+        }
+    }
+
+    for (int y = 0; y < dst.height; ++y) {
+        for (int x = 0; x < dst.width; ++x) {
+            double sum[4] = {};
+            for (int k = 0; k < yAxis.taps; ++k) {
+                const size_t tap = static_cast<size_t>(y) * yAxis.taps + k;
+                const size_t from = (static_cast<size_t>(yAxis.indices[tap]) * dst.width + x) * 4;
+                for (int c = 0; c < 4; ++c) {
+                    sum[c] += horizontal[from + c] * yAxis.weights[tap];
+                }
+            }
+            unsigned char* out = &dst.data[(static_cast<size_t>(y) * dst.width + x) * 4];
+            for (int c = 0; c < 4; ++c) {
+                out[c] = Quantize(srgb && c < 3 ? LinearToSrgb(std::clamp(sum[c], 0.0, 1.0)) : sum[c]);
+            }
+        }
+    }
+}
+
+// Alpha test threshold as a byte value: alpha >= threshold passes
+int GetAlphaThreshold(float cutoff) {
+    return std::clamp(static_cast<int>(std::ceil(cutoff * 255.0f)), 1, 255);
+}
+
+double ComputeCoverage(const ImageData& image, int threshold) {
+    size_t passing = 0;
+    for (size_t i = 3; i < image.data.size(); i += 4) {
+        passing += image.data[i] >= threshold ? 1 : 0;
+    }
+    return static_cast<double>(passing) / (image.data.size() / 4);
+}
+
+// Find the alpha value that, used as the threshold, gives this level the
+// target coverage, then scale alpha so that value lands on the real threshold.
+// The integer scale keeps every texel on the same side it was of the found value.
+void PreserveCoverage(ImageData& level, int threshold, double coverage) {
+    size_t histogram[256] = {};
+    for (size_t i = 3; i < level.data.size(); i += 4) {
+        ++histogram[level.data[i]];
+    }
+
+    const double target = coverage * (level.data.size() / 4);
+    size_t above[257] = {};  // Texels with alpha >= index
+    for (int a = 255; a >= 0; --a) {
+        above[a] = above[a + 1] + histogram[a];
+    }
+    int best = threshold;
+    for (int a = 1; a < 256; ++a) {
+        if (std::abs(above[a] - target) < std::abs(above[best] - target)) {
+            best = a;
+        }
+    }
+    if (best == threshold) {
+        return;
+    }
+
+    for (size_t i = 3; i < level.data.size(); i += 4) {
+        level.data[i] = static_cast<unsigned char>(std::min(255, level.data[i] * threshold / best));
+    }
+}
+
+template <typename Resample>
+std::vector<ImageData> BuildChain(ImageData base, const Settings& settings, Resample resample) {
+    std::vector<ImageData> levels;
+    if (base.width <= 0 || base.height <= 0 || base.channels != 4 ||
+        base.data.size() != static_cast<size_t>(base.width) * base.height * 4) {
+        levels.push_back(std::move(base));
+        return levels;
+    }
+
+    size_t levelCount = static_cast<size_t>(GetLevelCount(base.width, base.height));
+    if (settings.maxLevels > 0) {
+        levelCount = std::min(levelCount, static_cast<size_t>(settings.maxLevels));
+    }
+    levels.reserve(levelCount);
+    levels.push_back(std::move(base));
+
+    const int threshold = GetAlphaThreshold(settings.alphaCutoff);
+    const double coverage = settings.alphaCutoff > 0.0f ? ComputeCoverage(levels[0], threshold) : 0.0;
+
+    while (levels.size() < levelCount) {
+        const ImageData& src = levels.back();
+        ImageData dst;
+        dst.width = std::max(1, src.width / 2);
+        dst.height = std::max(1, src.height / 2);
+        dst.channels = 4;
+        dst.data.resize(static_cast<size_t>(dst.width) * dst.height * 4);
+
+        const Axis xAxis = BuildAxis(settings.filter, src.width, dst.width);
+        const Axis yAxis = BuildAxis(settings.filter, src.height, dst.height);
+        resample(src, dst, xAxis, yAxis);
+
+        if (settings.alphaCutoff > 0.0f) {
+            PreserveCoverage(dst, threshold, coverage);
+        }
+        levels.push_back(std::move(dst));
+    }
+    return levels;
+}
+
+} // namespace
+
+const char* GetFilterName(Filter filter) {
+    switch (filter) {
+        case Filter::Box: return "box";
+        case Filter::Kaiser: return "kaiser";
+        case Filter::Lanczos: return "lanczos";
+    }
+    return "unknown";
+}
+
+int GetLevelCount(int width, int height) {
+    int count = 1;
+    while (width > 1 || height > 1) {
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+        ++count;
+    }
+    return count;
+}
+
+std::vector<ImageData> Build(ImageData base, const Settings& settings, JobSystem* jobs) {
+    SHADOW_PROFILE_ZONE("MipGenerator::Build");
+    return BuildChain(std::move(base), settings,
+                      [&settings, jobs](const ImageData& src, ImageData& dst, const Axis& xAxis, const Axis& yAxis) {
+        if (jobs == nullptr) {
+            ResampleRows(src, dst, xAxis, yAxis, settings.srgb, 0, dst.height);
+            return;
+        }
+        jobs->ParallelFor(static_cast<size_t>(dst.height), RowsPerJob, [&](size_t begin, size_t end) {
+            ResampleRows(src, dst, xAxis, yAxis, settings.srgb, static_cast<int>(begin), static_cast<int>(end));
+        });
+    });
+}
+
+std::vector<ImageData> BuildReference(ImageData base, const Settings& settings) {
+    return BuildChain(std::move(base), settings,
+                      [&settings](const ImageData& src, ImageData& dst, const Axis& xAxis, const Axis& yAxis) {
+        ResampleReference(src, dst, xAxis, yAxis, settings.srgb);
+    });
+}
+
+} // namespace MipGenerator
+} // namespace ShadowEngine
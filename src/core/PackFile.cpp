@@ -0,0 +1,231 @@
+#include "core/PackFile.hpp"
+#include "core/Log.hpp"
+#include "core/Lz4.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace ShadowEngine {
+
+static_assert(sizeof(PackFile::FileHeader) == 32, "FileHeader layout is part of the file format");
+static_assert(sizeof(PackFile::IndexEntry) == 40, "IndexEntry layout is part of the file format");
+
+namespace {
+
+constexpr size_t PayloadAlignment = 16;
+
+size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+PackFile::IndexEntry ReadIndexEntry(const uint8_t* index, size_t i) {
+    PackFile::IndexEntry entry;
+    std::memcpy(&entry, index + i * sizeof(PackFile::IndexEntry), sizeof(entry));
+    return entry;
+}
+
+} // namespace
+
+uint64_t PackFile::HashPath(std::string_view path) {
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : path) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool PackFile::Open(const std::string& path) {
+    Close();
+
+    if (!m_File.Open(path)) {
+        return false;
+    }
+
+    const uint8_t* data = m_File.GetData();
+    const size_t size = m_File.GetSize();
+
+    FileHeader header;
+    if (size < sizeof(header)) {
+        SHADOW_LOG_ERROR(Assets, "Pack too small: {}", path);
+        Close();
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+
+    if (header.magic != Magic) {
+        SHADOW_LOG_ERROR(Assets, "Not a pack: {}", path);
+        Close();
+        return false;
+    }
+    if (header.version != Version) {
+        SHADOW_LOG_ERROR(Assets, "Unsupported pack version {}: {}", header.version, path);
+        Close();
+        return false;
+    }
+
+    const size_t indexEnd = sizeof(FileHeader) + static_cast<size_t>(header.entryCount) * sizeof(IndexEntry);
+    if (indexEnd > size || header.stringsOffset < indexEnd || header.stringsOffset > size ||
+        header.stringsSize > size - header.stringsOffset) {
+        SHADOW_LOG_ERROR(Assets, "Truncated pack index: {}", path);
+        Close();
+        return false;
+    }
+
+    // Validate every entry once so lookups can trust the index. A compressed
+    // entry cannot claim more bytes than its payload could expand to, so a
+    // corrupt size never turns into a huge decompression buffer.
+    const uint8_t* index = data + sizeof(FileHeader);
+    uint64_t previousHash = 0;
+    for (size_t i = 0; i < header.entryCount; ++i) {
+        const IndexEntry entry = ReadIndexEntry(index, i);
+        const bool compressed = (entry.flags & FlagLz4) != 0;
+        if ((i > 0 && entry.hash < previousHash) || (entry.flags & ~FlagLz4) != 0 ||
+            entry.pathOffset > header.stringsSize || entry.pathLength > header.stringsSize - entry.pathOffset ||
+            entry.offset > size || entry.storedSize > size - entry.offset ||
+            (!compressed && entry.storedSize != entry.size) ||
+            (compressed && entry.size > Lz4::GetMaxDecompressedSize(static_cast<size_t>(entry.storedSize)))) {
+            SHADOW_LOG_ERROR(Assets, "Corrupt entry {} in pack: {}", i, path);
+            Close();
+            return false;
+        }
+        previousHash = entry.hash;
+    }
+
+    m_Index = index;
+    m_Strings = reinterpret_cast<const char*>(data + header.stringsOffset);
+    m_EntryCount = header.entryCount;
+    return true;
+}
+
+void PackFile::Close() {
+    m_File.Close();
+    m_Index = nullptr;
+    m_Strings = nullptr;
+    m_EntryCount = 0;
+}
+
+PackFile::Entry PackFile::GetEntry(size_t index) const {
+    const IndexEntry entry = ReadIndexEntry(m_Index, index);
+    Entry out;
+    out.path = std::string_view(m_Strings + entry.pathOffset, entry.pathLength);
+    out.data = m_File.GetData() + entry.offset;
+    out.storedSize = static_cast<size_t>(entry.storedSize);
+    out.size = static_cast<size_t>(entry.size);
+    out.compressed = (entry.flags & FlagLz4) != 0;
+    return out;
+}
+
+bool PackFile::Find(std::string_view path, Entry& out) const {
+    const uint64_t hash = HashPath(path);
+
+    // First entry with this hash, then every entry sharing it
+    size_t low = 0;
+    size_t high = m_EntryCount;
+    while (low < high) {
+        const size_t middle = low + (high - low) / 2;
+        if (ReadIndexEntry(m_Index, middle).hash < hash) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    for (size_t i = low; i < m_EntryCount && ReadIndexEntry(m_Index, i).hash == hash; ++i) {
+        Entry entry = GetEntry(i);
+        if (entry.path == path) {
+            out = entry;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PackFile::Write(const std::string& path, const std::vector<Source>& files, bool compress) {
+    // Sort by hash (then path, so equal hashes are deterministic) for the index
+    std::vector<size_t> order(files.size());
+    std::vector<uint64_t> hashes(files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        order[i] = i;
+        hashes[i] = HashPath(files[i].path);
+        if (files[i].path.size() > UINT16_MAX) {
+            SHADOW_LOG_ERROR(Assets, "Path too long for a pack: {}", files[i].path);
+            return false;
+        }
+    }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return hashes[a] != hashes[b] ? hashes[a] < hashes[b] : files[a].path < files[b].path;
+    });
+    for (size_t i = 1; i < order.size(); ++i) {
+        if (files[order[i]].path == files[order[i - 1]].path) {
+            SHADOW_LOG_ERROR(Assets, "Duplicate path in pack: {}", files[order[i]].path);
+            return false;
+        }
+    }
+
+    std::vector<IndexEntry> index(files.size());
+    std::string strings;
+    for (size_t i = 0; i < order.size(); ++i) {
+        const Source& source = files[order[i]];
+        index[i].hash = hashes[order[i]];
+        index[i].pathOffset = static_cast<uint32_t>(strings.size());
+        index[i].pathLength = static_cast<uint16_t>(source.path.size());
+        strings += source.path;
+    }
+
+    FileHeader header = {};
+    header.magic = Magic;
+    header.version = Version;
+    header.entryCount = static_cast<uint32_t>(files.size());
+    header.stringsOffset = sizeof(FileHeader) + index.size() * sizeof(IndexEntry);
+    header.stringsSize = strings.size();
+
+    // Compress up front so the index can be written before the payloads
+    std::vector<std::vector<uint8_t>> compressed(files.size());
+    size_t offset = AlignUp(static_cast<size_t>(header.stringsOffset + header.stringsSize), PayloadAlignment);
+    for (size_t i = 0; i < order.size(); ++i) {
+        const std::vector<uint8_t>& data = files[order[i]].data;
+        if (compress && !data.empty()) {
+            std::vector<uint8_t>& block = compressed[i];
+            block.resize(Lz4::GetMaxCompressedSize(data.size()));
+            block.resize(Lz4::Compress(data.data(), data.size(), block.data()));
+            if (block.size() > data.size() - data.size() / 8) {
+                block.clear();
+                block.shrink_to_fit();
+            }
+        }
+
+        const bool stored = compressed[i].empty();
+        index[i].offset = offset;
+        index[i].storedSize = stored ? data.size() : compressed[i].size();
+        index[i].size = data.size();
+        index[i].flags = stored ? 0 : FlagLz4;
+        offset = AlignUp(offset + static_cast<size_t>(index[i].storedSize), PayloadAlignment);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        SHADOW_LOG_ERROR(Assets, "Failed to open pack for writing: {}", path);
+        return false;
+    }
+
+    static const char padding[PayloadAlignment] = {};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(index.size() * sizeof(IndexEntry)));
+    file.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+
+    size_t written = static_cast<size_t>(header.stringsOffset + header.stringsSize);
+    for (size_t i = 0; i < order.size(); ++i) {
+        const std::vector<uint8_t>& payload = compressed[i].empty() ? files[order[i]].data : compressed[i];
+        file.write(padding, static_cast<std::streamsize>(index[i].offset - written));
+        file.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+        written = static_cast<size_t>(index[i].offset) + payload.size();
+    }
+
+    if (!file.good()) {
+        SHADOW_LOG_ERROR(Assets, "Failed to write pack: {}", path);
+        return false;
+    }
+    return true;
+}
+
+} // namespace ShadowEngine
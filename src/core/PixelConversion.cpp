@@ -0,0 +1,307 @@
+#include "core/PixelConversion.hpp"
+#include "core/JobSystem.hpp"
+#include "core/Profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SHADOW_PIXEL_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace ShadowEngine {
+namespace PixelConversion {
+
+namespace {
+
+constexpr size_t PixelsPerChunk = 16384;
+
+// Round to nearest, ties to even, as the GPU does
+uint16_t FloatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+    bits &= 0x7FFFFFFFu;
+
+    if (bits >= 0x7F800000u) {
+        return sign | (bits > 0x7F800000u ? 0x7E00u : 0x7C00u);  // NaN stays NaN
+    }
+    if (bits >= 0x477FF000u) {
+        return sign | 0x7C00u;  // Rounds past the largest half
+    }
+    if (bits < 0x38800000u) {
+        // Denormal half: the value in units of 2^-24
+        if (bits < 0x33000000u) {
+            return sign;
+        }
+        const uint32_t mantissa = (bits & 0x7FFFFFu) | 0x800000u;
+        const uint32_t shift = 126u - (bits >> 23);
+        uint32_t result = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1u);
+        const uint32_t halfway = 1u << (shift - 1u);
+        if (remainder > halfway || (remainder == halfway && (result & 1u) != 0)) {
+            ++result;
+        }
+        return static_cast<uint16_t>(sign | result);
+    }
+
+    // Rebias the exponent from 127 to 15 and drop 13 mantissa bits
+    uint32_t result = (bits - 0x38000000u) >> 13;
+    const uint32_t remainder = bits & 0x1FFFu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (result & 1u) != 0)) {
+        ++result;
+    }
+    return static_cast<uint16_t>(sign | result);
+}
+
+float HalfToFloat(uint16_t half) {
+    const uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1Fu;
+    const uint32_t mantissa = half & 0x3FFu;
+    if (exponent == 0) {
+        const float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign != 0 ? -magnitude : magnitude;
+    }
+    const uint32_t bits = exponent == 31 ? sign | 0x7F800000u | (mantissa << 13)
+                                         : sign | ((exponent + 112u) << 23) | (mantissa << 13);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Every unorm byte as a half; the fast path is a lookup per channel
+struct HalfTable {
+    uint16_t values[256];
+
+    HalfTable() {
+        for (int i = 0; i < 256; ++i) {
+            values[i] = FloatToHalf(static_cast<float>(i) / 255.0f);
+        }
+    }
+};
+
+const HalfTable& GetHalfTable() {
+    static const HalfTable table;
+    return table;
+}
+
+uint8_t UnormToByte(float value) {
+    value = value > 0.0f ? value : 0.0f;  // Also catches NaN
+    value = value < 1.0f ? value : 1.0f;
+    return static_cast<uint8_t>(value * 255.0f + 0.5f);
+}
+
+uint16_t PackRgb565(const uint8_t* pixel) {
+    // Nearest step, halves rounding up
+    const uint32_t r = (pixel[0] * 31u * 2u + 255u) / 510u;
+    const uint32_t g = (pixel[1] * 63u * 2u + 255u) / 510u;
+    const uint32_t b = (pixel[2] * 31u * 2u + 255u) / 510u;
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+void UnpackRgb565(uint16_t value, uint8_t* pixel) {
+    const uint32_t r = value >> 11;
+    const uint32_t g = (value >> 5) & 0x3Fu;
+    const uint32_t b = value & 0x1Fu;
+    pixel[0] = static_cast<uint8_t>((r * 255u * 2u + 31u) / 62u);
+    pixel[1] = static_cast<uint8_t>((g * 255u * 2u + 63u) / 126u);
+    pixel[2] = static_cast<uint8_t>((b * 255u * 2u + 31u) / 62u);
+    pixel[3] = 255;
+}
+
+#ifdef SHADOW_PIXEL_SSE2
+// x / 255 rounded, for x up to 255 * 255 in each 32-bit lane
+inline __m128i DivideBy255(__m128i x) {
+    x = _mm_add_epi32(x, _mm_set1_epi32(128));
+    return _mm_srli_epi32(_mm_add_epi32(x, _mm_srli_epi32(x, 8)), 8);
+}
+
+// Four RGBA8 pixels to four RGB565 values, one per 32-bit lane. The products
+// fit in 16 bits, so the 16-bit multiply is exact.
+inline __m128i PackRgb565x4(__m128i pixels) {
+    const __m128i byteMask = _mm_set1_epi32(0xFF);
+    const __m128i r = _mm_and_si128(pixels, byteMask);
+    const __m128i g = _mm_and_si128(_mm_srli_epi32(pixels, 8), byteMask);
+    const __m128i b = _mm_and_si128(_mm_srli_epi32(pixels, 16), byteMask);
+    const __m128i r5 = DivideBy255(_mm_mullo_epi16(r, _mm_set1_epi32(31)));
+    const __m128i g6 = DivideBy255(_mm_mullo_epi16(g, _mm_set1_epi32(63)));
+    const __m128i b5 = DivideBy255(_mm_mullo_epi16(b, _mm_set1_epi32(31)));
+    const __m128i packed = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(r5, 11), _mm_slli_epi32(g6, 5)), b5);
+    // Sign-extend the low halves so the saturating pack keeps their bits
+    return _mm_srai_epi32(_mm_slli_epi32(packed, 16), 16);
+}
+
+// Four halves, one per 32-bit lane, to floats (denormals included)
+inline __m128 HalfToFloatx4(__m128i half) {
+    const __m128i expMantissa = _mm_and_si128(half, _mm_set1_epi32(0x7FFF));
+    const __m128i sign = _mm_slli_epi32(_mm_xor_si128(half, expMantissa), 16);
+    // Shift into float position, then rescale the exponent bias from 15 to 127
+    const __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(expMantissa, 13)),
+                                     _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23)));
+    const __m128i infNan = _mm_cmpgt_epi32(expMantissa, _mm_set1_epi32(0x7BFF));
+    const __m128 infNanExponent = _mm_and_ps(_mm_castsi128_ps(infNan), _mm_castsi128_ps(_mm_set1_epi32(255 << 23)));
+    return _mm_or_ps(scaled, _mm_or_ps(_mm_castsi128_ps(sign), infNanExponent));
+}
+
+inline __m128i UnormToIntx4(__m128 value) {
+    value = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(value, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f)));
+}
+#endif
+
+void Convert(Format format, const uint8_t* src, uint8_t* dst, size_t pixelCount) {
+    switch (format) {
+        case Format::RGBA8:
+            std::memcpy(dst, src, pixelCount * 4);
+            break;
+        case Format::RGBA16F:
+            Rgba8ToRgba16F(src, reinterpret_cast<uint16_t*>(dst), pixelCount);
+            break;
+        case Format::RGB565:
+            Rgba8ToRgb565(src, reinterpret_cast<uint16_t*>(dst), pixelCount);
+            break;
+    }
+}
+
+} // namespace
+
+size_t GetBytesPerPixel(Format format) {
+    switch (format) {
+        case Format::RGBA8: return 4;
+        case Format::RGBA16F: return 8;
+        case Format::RGB565: return 2;
+    }
+    return 0;
+}
+
+const char* GetFormatName(Format format) {
+    switch (format) {
+        case Format::RGBA8: return "RGBA8";
+        case Format::RGBA16F: return "RGBA16F";
+        case Format::RGB565: return "RGB565";
+    }
+    return "unknown";
+}
+
+void Rgba8ToRgba16F(const uint8_t* src, uint16_t* dst, size_t pixelCount) {
+    // 256 possible inputs: a table beats converting in registers
+    const uint16_t* table = GetHalfTable().values;
+    const size_t count = pixelCount * 4;
+    for (size_t i = 0; i < count; i += 4) {
+        dst[i + 0] = table[src[i + 0]];
+        dst[i + 1] = table[src[i + 1]];
+        dst[i + 2] = table[src[i + 2]];
+        dst[i + 3] = table[src[i + 3]];
+    }
+}
+
+void Rgba16FToRgba8(const uint16_t* src, uint8_t* dst, size_t pixelCount) {
+    size_t i = 0;
+#ifdef SHADOW_PIXEL_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 2 <= pixelCount; i += 2) {
+        const __m128i halves = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        const __m128i first = UnormToIntx4(HalfToFloatx4(_mm_unpacklo_epi16(halves, zero)));
+        const __m128i second = UnormToIntx4(HalfToFloatx4(_mm_unpackhi_epi16(halves, zero)));
+        const __m128i words = _mm_packs_epi32(first, second);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i * 4), _mm_packus_epi16(words, words));
+    }
+#endif
+    Rgba16FToRgba8Reference(src + i * 4, dst + i * 4, pixelCount - i);
+}
+
+void Rgba8ToRgb565(const uint8_t* src, uint16_t* dst, size_t pixelCount) {
+    size_t i = 0;
+#ifdef SHADOW_PIXEL_SSE2
+    for (; i + 8 <= pixelCount; i += 8) {
+        const __m128i first = PackRgb565x4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4)));
+        const __m128i second = PackRgb565x4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4 + 16)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(first, second));
+    }
+#endif
+    Rgba8ToRgb565Reference(src + i * 4, dst + i, pixelCount - i);
+}
+
+void Rgb565ToRgba8(const uint16_t* src, uint8_t* dst, size_t pixelCount) {
+    size_t i = 0;
+#ifdef SHADOW_PIXEL_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    for (; i + 4 <= pixelCount; i += 4) {
+        const __m128i values = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i)), zero);
+        const __m128i r5 = _mm_srli_epi32(values, 11);
+        const __m128i g6 = _mm_and_si128(_mm_srli_epi32(values, 5), _mm_set1_epi32(0x3F));
+        const __m128i b5 = _mm_and_si128(values, _mm_set1_epi32(0x1F));
+        // Multiply-shift forms of the reference's rounded divisions
+        const __m128i r = _mm_srli_epi32(_mm_add_epi32(_mm_mullo_epi16(r5, _mm_set1_epi32(527)), _mm_set1_epi32(23)), 6);
+        const __m128i g = _mm_srli_epi32(_mm_add_epi32(_mm_mullo_epi16(g6, _mm_set1_epi32(259)), _mm_set1_epi32(33)), 6);
+        const __m128i b = _mm_srli_epi32(_mm_add_epi32(_mm_mullo_epi16(b5, _mm_set1_epi32(527)), _mm_set1_epi32(23)), 6);
+        const __m128i pixels = _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 8)),
+                                            _mm_or_si128(_mm_slli_epi32(b, 16), alpha));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), pixels);
+    }
+#endif
+    Rgb565ToRgba8Reference(src + i, dst + i * 4, pixelCount - i);
+}
+
+void Rgba8ToRgba16FReference(const uint8_t* src, uint16_t* dst, size_t pixelCount) {
+    for (size_t i = 0; i < pixelCount * 4; ++i) {
+        dst[i] = FloatToHalf(static_cast<float>(src[i]) / 255.0f);
+    }
+}
+
+void Rgba16FToRgba8Reference(const uint16_t* src, uint8_t* dst, size_t pixelCount) {
+    for (size_t i = 0; i < pixelCount * 4; ++i) {
+        dst[i] = UnormToByte(HalfToFloat(src[i]));
+    }
+}
+
+void Rgba8ToRgb565Reference(const uint8_t* src, uint16_t* dst, size_t pixelCount) {
+    for (size_t i = 0; i < pixelCount; ++i) {
+        dst[i] = PackRgb565(src + i * 4);
+    }
+}
+
+void Rgb565ToRgba8Reference(const uint16_t* src, uint8_t* dst, size_t pixelCount) {
+    for (size_t i = 0; i < pixelCount; ++i) {
+        UnpackRgb565(src[i], dst + i * 4);
+    }
+}
+
+void ConvertLevels(const std::vector<ImageLoader::ImageData>& levels, Format format,
+                   std::vector<ImageLoader::PixelBuffer>& out, JobSystem* jobs) {
+    SHADOW_PROFILE_ZONE("PixelConversion::ConvertLevels");
+    struct Chunk {
+        size_t level;
+        size_t begin;
+        size_t end;
+    };
+
+    const size_t bytesPerPixel = GetBytesPerPixel(format);
+    std::vector<Chunk> chunks;
+    out.resize(levels.size());
+    for (size_t level = 0; level < levels.size(); ++level) {
+        const size_t pixelCount = levels[level].data.size() / 4;
+        out[level].resize(pixelCount * bytesPerPixel);
+        for (size_t begin = 0; begin < pixelCount; begin += PixelsPerChunk) {
+            chunks.push_back({level, begin, std::min(pixelCount, begin + PixelsPerChunk)});
+        }
+    }
+
+    auto convert = [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            const Chunk& chunk = chunks[i];
+            Convert(format, levels[chunk.level].data.data() + chunk.begin * 4,
+                    out[chunk.level].data() + chunk.begin * bytesPerPixel, chunk.end - chunk.begin);
+        }
+    };
+    if (jobs != nullptr) {
+        jobs->ParallelFor(chunks.size(), 1, convert);
+    } else {
+        convert(0, chunks.size());
+    }
+}
+
+} // namespace PixelConversion
+} // namespace ShadowEngine
@@ -0,0 +1,89 @@
+#include "core/PoolAllocator.hpp"
+#include <algorithm>
+
+namespace ShadowEngine {
+
+PoolAllocator::PoolAllocator(size_t blockSize, size_t blocksPerChunk, std::pmr::memory_resource* upstream)
+    : m_BlockSize(0)
+    , m_BlocksPerChunk(std::max<size_t>(blocksPerChunk, 1))
+    , m_Upstream(upstream ? upstream : std::pmr::new_delete_resource())
+    , m_FreeList(nullptr)
+    , m_InUse(0)
+    , m_PeakInUse(0)
+{
+    // Every block must hold the free-list link and keep its successor aligned
+    const size_t alignment = alignof(std::max_align_t);
+    m_BlockSize = (std::max(blockSize, sizeof(FreeBlock)) + alignment - 1) / alignment * alignment;
+}
+
+PoolAllocator::~PoolAllocator() = default;
+
+void* PoolAllocator::Allocate() {
+    if (!m_FreeList) {
+        AddChunk();
+    }
+    FreeBlock* block = m_FreeList;
+    m_FreeList = block->next;
+    m_PeakInUse = std::max(m_PeakInUse, ++m_InUse);
+    return block;
+}
+
+void PoolAllocator::Free(void* block) {
+    if (!block) {
+        return;
+    }
+    FreeBlock* freed = static_cast<FreeBlock*>(block);
+    freed->next = m_FreeList;
+    m_FreeList = freed;
+    --m_InUse;
+}
+
+void PoolAllocator::Reserve(size_t blockCount) {
+    while (m_Chunks.size() * m_BlocksPerChunk < blockCount) {
+        AddChunk();
+    }
+}
+
+PoolAllocator::Stats PoolAllocator::GetStats() const {
+    Stats stats;
+    stats.blockSize = m_BlockSize;
+    stats.capacity = m_Chunks.size() * m_BlocksPerChunk;
+    stats.inUse = m_InUse;
+    stats.peakInUse = m_PeakInUse;
+    stats.chunks = m_Chunks.size();
+    return stats;
+}
+
+void PoolAllocator::AddChunk() {
+    // operator new[] of unsigned char is aligned for max_align_t
+    m_Chunks.push_back(std::make_unique<unsigned char[]>(m_BlockSize * m_BlocksPerChunk));
+    unsigned char* chunk = m_Chunks.back().get();
+
+    // Thread the new blocks onto the free list in address order
+    for (size_t i = m_BlocksPerChunk; i-- > 0;) {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + i * m_BlockSize);
+        block->next = m_FreeList;
+        m_FreeList = block;
+    }
+}
+
+void* PoolAllocator::do_allocate(size_t bytes, size_t alignment) {
+    if (bytes <= m_BlockSize && alignment <= GetBlockAlignment()) {
+        return Allocate();
+    }
+    return m_Upstream->allocate(bytes, alignment);
+}
+
+void PoolAllocator::do_deallocate(void* memory, size_t bytes, size_t alignment) {
+    if (bytes <= m_BlockSize && alignment <= GetBlockAlignment()) {
+        Free(memory);
+    } else {
+        m_Upstream->deallocate(memory, bytes, alignment);
+    }
+}
+
+bool PoolAllocator::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+} // namespace ShadowEngine
@@ -0,0 +1,201 @@
+#include "core/Profiler.hpp"
+#include "core/Log.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace ShadowEngine {
+
+namespace {
+
+static_assert((Profiler::EventsPerThread & (Profiler::EventsPerThread - 1)) == 0,
+              "EventsPerThread must be a power of two");
+
+// Zone names are identifiers and literals in practice, but keep the JSON valid
+void WriteJsonString(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        switch (*c) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(*c));
+                    out << escaped;
+                } else {
+                    out << *c;
+                }
+        }
+    }
+    out << '"';
+}
+
+// Chrome traces take microseconds; keep nanosecond precision as a fraction
+void WriteMicroseconds(std::ostream& out, uint64_t nanoseconds) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%llu.%03u",
+                  static_cast<unsigned long long>(nanoseconds / 1000),
+                  static_cast<unsigned>(nanoseconds % 1000));
+    out << text;
+}
+
+} // namespace
+
+Profiler& Profiler::Get() {
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler()
+    : m_Epoch(Clock::now())
+    , m_Capturing(false)
+    , m_Generation(0) {
+}
+
+void Profiler::Start() {
+    m_Generation.fetch_add(1, std::memory_order_relaxed);
+    m_Capturing.store(true, std::memory_order_release);
+}
+
+void Profiler::Stop() {
+    m_Capturing.store(false, std::memory_order_release);
+}
+
+Profiler::ThreadBufferOwner::~ThreadBufferOwner() {
+    // Kept, not freed: the zones of an exited worker still export
+    if (buffer) {
+        Profiler& profiler = Profiler::Get();
+        std::lock_guard<std::mutex> lock(profiler.m_ThreadsMutex);
+        buffer->retired = true;
+    }
+}
+
+Profiler::ThreadBuffer& Profiler::GetThreadBuffer() {
+    // Buffers belong to the profiler, not the thread, so the zones of worker
+    // threads that have already exited still export
+    thread_local ThreadBufferOwner owner;
+    if (!owner.buffer) {
+        owner.buffer = &AcquireThreadBuffer();
+    }
+    return *owner.buffer;
+}
+
+Profiler::ThreadBuffer& Profiler::AcquireThreadBuffer() {
+    const uint64_t generation = m_Generation.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(m_ThreadsMutex);
+
+    // Reuse an exited thread's buffer, and its ring, unless it still holds
+    // zones of the current capture
+    for (const auto& buffer : m_Threads) {
+        if (buffer->retired && (buffer->generation.load(std::memory_order_relaxed) != generation ||
+                                buffer->head.load(std::memory_order_relaxed) == 0)) {
+            buffer->retired = false;
+            buffer->name = nullptr;
+            buffer->head.store(0, std::memory_order_relaxed);
+            buffer->generation.store(0, std::memory_order_relaxed);
+            return *buffer;
+        }
+    }
+
+    auto created = std::make_unique<ThreadBuffer>();
+    created->id = static_cast<uint32_t>(m_Threads.size() + 1);
+    m_Threads.push_back(std::move(created));
+    return *m_Threads.back();
+}
+
+void Profiler::SetThreadName(const char* name) {
+    GetThreadBuffer().name = name;
+}
+
+void Profiler::Record(const char* name, uint64_t begin, uint64_t end) {
+    ThreadBuffer& buffer = GetThreadBuffer();
+
+    // The first zone of a new capture restarts this thread's ring, allocating
+    // it if the thread never recorded before
+    const uint64_t generation = m_Generation.load(std::memory_order_relaxed);
+    uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    if (buffer.generation.load(std::memory_order_relaxed) != generation || buffer.events.empty()) {
+        if (buffer.events.empty()) {
+            buffer.events.resize(EventsPerThread);
+        }
+        buffer.generation.store(generation, std::memory_order_relaxed);
+        head = 0;
+    }
+
+    buffer.events[head & (EventsPerThread - 1)] = Event{name, begin, end};
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+Profiler::Stats Profiler::GetStats() const {
+    Stats stats;
+    const uint64_t generation = m_Generation.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(m_ThreadsMutex);
+    for (const auto& buffer : m_Threads) {
+        const uint64_t head = buffer->head.load(std::memory_order_acquire);
+        if (buffer->generation.load(std::memory_order_relaxed) != generation || head == 0) {
+            continue;
+        }
+        stats.recorded += std::min<uint64_t>(head, EventsPerThread);
+        stats.overwritten += head > EventsPerThread ? head - EventsPerThread : 0;
+        ++stats.threads;
+    }
+    return stats;
+}
+
+bool Profiler::WriteChromeTrace(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        SHADOW_LOG_ERROR(Core, "Failed to open profile output: {}", path);
+        return false;
+    }
+
+    const uint64_t generation = m_Generation.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(m_ThreadsMutex);
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto separator = [&]() {
+        file << (first ? "\n" : ",\n");
+        first = false;
+    };
+
+    for (const auto& buffer : m_Threads) {
+        const uint64_t head = buffer->head.load(std::memory_order_acquire);
+        if (buffer->generation.load(std::memory_order_relaxed) != generation || head == 0) {
+            continue;
+        }
+
+        if (buffer->name) {
+            separator();
+            file << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->id
+                 << ",\"args\":{\"name\":";
+            WriteJsonString(file, buffer->name);
+            file << "}}";
+        }
+
+        const uint64_t oldest = head > EventsPerThread ? head - EventsPerThread : 0;
+        for (uint64_t i = oldest; i < head; ++i) {
+            const Event& event = buffer->events[i & (EventsPerThread - 1)];
+            separator();
+            file << "{\"ph\":\"X\",\"name\":";
+            WriteJsonString(file, event.name);
+            file << ",\"pid\":1,\"tid\":" << buffer->id << ",\"ts\":";
+            WriteMicroseconds(file, event.begin);
+            file << ",\"dur\":";
+            WriteMicroseconds(file, event.end - event.begin);
+            file << '}';
+        }
+    }
+    file << "\n]}\n";
+
+    if (!file) {
+        SHADOW_LOG_ERROR(Core, "Failed to write profile output: {}", path);
+        return false;
+    }
+    return true;
+}
+
+} // namespace ShadowEngine
@@ -0,0 +1,103 @@
+#include "core/RenderThread.hpp"
+#include "core/Profiler.hpp"
+
+namespace ShadowEngine {
+
+namespace {
+
+double MillisecondsSince(RenderThread::Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(RenderThread::Clock::now() - start).count();
+}
+
+} // namespace
+
+RenderThread::RenderThread()
+    : m_Pending(false)
+    , m_Quit(false)
+    , m_FrameCount(0)
+    , m_BusyMs(0.0)
+    , m_WaitMs(0.0)
+{
+}
+
+RenderThread::~RenderThread() {
+    Stop();
+}
+
+void RenderThread::Start(std::function<void()> onStart, std::function<void()> frame,
+                         std::function<void()> onStop) {
+    Stop();
+    m_Frame = std::move(frame);
+    m_Pending = false;
+    m_Quit = false;
+    m_FrameCount = 0;
+    m_BusyMs = 0.0;
+    m_WaitMs = 0.0;
+    m_Thread = std::thread(&RenderThread::ThreadLoop, this, std::move(onStart), std::move(onStop));
+}
+
+void RenderThread::Stop() {
+    if (!m_Thread.joinable()) {
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Done.wait(lock, [this] { return !m_Pending; });
+        m_Quit = true;
+    }
+    m_Wake.notify_one();
+    m_Thread.join();
+}
+
+void RenderThread::Kick() {
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Done.wait(lock, [this] { return !m_Pending; });
+        m_Pending = true;
+    }
+    m_Wake.notify_one();
+}
+
+void RenderThread::Wait() {
+    SHADOW_PROFILE_ZONE("RenderThread::Wait");
+    Clock::time_point start = Clock::now();
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Done.wait(lock, [this] { return !m_Pending; });
+    m_WaitMs += MillisecondsSince(start);
+}
+
+void RenderThread::ThreadLoop(std::function<void()> onStart, std::function<void()> onStop) {
+    SHADOW_PROFILE_THREAD("Render");
+    if (onStart) {
+        onStart();
+    }
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    for (;;) {
+        m_Wake.wait(lock, [this] { return m_Pending || m_Quit; });
+        if (m_Quit) {
+            break;
+        }
+
+        lock.unlock();
+        Clock::time_point start = Clock::now();
+        {
+            SHADOW_PROFILE_ZONE("Render frame");
+            m_Frame();
+        }
+        const double busy = MillisecondsSince(start);
+        lock.lock();
+
+        ++m_FrameCount;
+        m_BusyMs += busy;
+        m_Pending = false;
+        m_Done.notify_all();
+    }
+    lock.unlock();
+
+    if (onStop) {
+        onStop();
+    }
+}
+
+} // namespace ShadowEngine
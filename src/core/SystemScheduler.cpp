@@ -0,0 +1,387 @@
+#include "core/SystemScheduler.hpp"
+#include "core/JobSystem.hpp"
+#include "core/Log.hpp"
+#include "core/Profiler.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <thread>
+
+namespace ShadowEngine {
+
+using Clock = std::chrono::steady_clock;
+
+struct SystemScheduler::System {
+    std::string name;
+    std::function<void()> run;
+    std::vector<uint32_t> reads;   // Resource ids, sorted; a resource in writes is not repeated here
+    std::vector<uint32_t> writes;
+    std::vector<uint32_t> predecessors;
+    std::vector<uint32_t> successors;
+    bool mainThread = false;
+
+    std::atomic<int> pending{0};  // Predecessors still running this frame
+
+    // This frame, in ms since Run began
+    double beginMs = 0.0;
+    double endMs = 0.0;
+    double pathMs = 0.0;     // Longest chain ending with this system
+    int criticalPrevious = -1;
+
+    double totalMs = 0.0;
+    uint64_t criticalFrames = 0;
+};
+
+namespace {
+
+double ToMilliseconds(Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+bool Intersects(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b, uint32_t& shared) {
+    auto first = a.begin();
+    auto second = b.begin();
+    while (first != a.end() && second != b.end()) {
+        if (*first < *second) {
+            ++first;
+        } else if (*second < *first) {
+            ++second;
+        } else {
+            shared = *first;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+SystemScheduler::SystemScheduler()
+    : m_Sorted(true)
+    , m_Jobs(nullptr)
+    , m_Remaining(0)
+    , m_Frames(0)
+    , m_TotalWallMs(0.0)
+    , m_TotalWorkMs(0.0) {
+    m_CriticalPath.Reserve(1 << 16);  // About 18 minutes at 60 Hz before the first regrowth
+}
+
+SystemScheduler::~SystemScheduler() = default;
+
+int SystemScheduler::FindSystem(const std::string& name) const {
+    for (size_t i = 0; i < m_Systems.size(); ++i) {
+        if (m_Systems[i]->name == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+uint32_t SystemScheduler::GetResource(const std::string& name) {
+    auto it = std::find(m_Resources.begin(), m_Resources.end(), name);
+    if (it != m_Resources.end()) {
+        return static_cast<uint32_t>(it - m_Resources.begin());
+    }
+    m_Resources.push_back(name);
+    return static_cast<uint32_t>(m_Resources.size() - 1);
+}
+
+bool SystemScheduler::Reaches(uint32_t from, uint32_t to) const {
+    std::vector<bool> visited(m_Systems.size(), false);
+    std::vector<uint32_t> stack{from};
+    while (!stack.empty()) {
+        const uint32_t index = stack.back();
+        stack.pop_back();
+        if (index == to) {
+            return true;
+        }
+        if (visited[index]) {
+            continue;
+        }
+        visited[index] = true;
+        for (uint32_t next : m_Systems[index]->successors) {
+            stack.push_back(next);
+        }
+    }
+    return false;
+}
+
+int SystemScheduler::FindConflict(const System& a, const System& b) const {
+    uint32_t shared = 0;
+    if (Intersects(a.writes, b.writes, shared) || Intersects(a.writes, b.reads, shared) ||
+        Intersects(a.reads, b.writes, shared)) {
+        return static_cast<int>(shared);
+    }
+    return -1;
+}
+
+bool SystemScheduler::Register(SystemDesc desc) {
+    if (desc.name.empty() || !desc.run) {
+        SHADOW_LOG_ERROR(Core, "Systems need a name and a function");
+        return false;
+    }
+    if (FindSystem(desc.name) >= 0) {
+        SHADOW_LOG_ERROR(Core, "System '{}' is already registered", desc.name);
+        return false;
+    }
+
+    std::vector<uint32_t> after;
+    std::vector<uint32_t> before;
+    for (auto* constraint : {&desc.after, &desc.before}) {
+        for (const std::string& name : *constraint) {
+            const int index = FindSystem(name);
+            if (index < 0) {
+                SHADOW_LOG_ERROR(Core, "System '{}' is ordered against '{}', which is not registered", desc.name,
+                                 name);
+                return false;
+            }
+            (constraint == &desc.after ? after : before).push_back(static_cast<uint32_t>(index));
+        }
+    }
+
+    // Running after a and before b needs b to precede this system, which it
+    // cannot if b already leads to a
+    for (uint32_t b : before) {
+        for (uint32_t a : after) {
+            if (Reaches(b, a)) {
+                SHADOW_LOG_ERROR(Core, "System '{}' cannot run after '{}' and before '{}': '{}' already runs first",
+                                 desc.name, m_Systems[a]->name, m_Systems[b]->name, m_Systems[b]->name);
+                return false;
+            }
+        }
+    }
+
+    auto system = std::make_unique<System>();
+    system->name = std::move(desc.name);
+    system->run = std::move(desc.run);
+    system->mainThread = desc.mainThread;
+    for (const std::string& name : desc.writes) {
+        system->writes.push_back(GetResource(name));
+    }
+    for (const std::string& name : desc.reads) {
+        system->reads.push_back(GetResource(name));
+    }
+    for (std::vector<uint32_t>* ids : {&system->writes, &system->reads}) {
+        std::sort(ids->begin(), ids->end());
+        ids->erase(std::unique(ids->begin(), ids->end()), ids->end());
+    }
+    system->reads.erase(std::remove_if(system->reads.begin(), system->reads.end(),
+                                       [&](uint32_t id) {
+                                           return std::binary_search(system->writes.begin(),
+                                                                     system->writes.end(), id);
+                                       }),
+                        system->reads.end());
+
+    // Any system sharing data must already be on one side of this one
+    for (size_t i = 0; i < m_Systems.size(); ++i) {
+        const int shared = FindConflict(*system, *m_Systems[i]);
+        if (shared < 0) {
+            continue;
+        }
+        const uint32_t other = static_cast<uint32_t>(i);
+        const bool runsFirst = std::any_of(after.begin(), after.end(), [&](uint32_t a) { return Reaches(other, a); });
+        const bool runsLater = std::any_of(before.begin(), before.end(), [&](uint32_t b) { return Reaches(b, other); });
+        if (!runsFirst && !runsLater) {
+            SHADOW_LOG_ERROR(Core, "System '{}' conflicts with '{}' over '{}'; order one after the other",
+                             system->name, m_Systems[i]->name, m_Resources[shared]);
+            return false;
+        }
+    }
+
+    const uint32_t index = static_cast<uint32_t>(m_Systems.size());
+    for (uint32_t a : after) {
+        m_Systems[a]->successors.push_back(index);
+        system->predecessors.push_back(a);
+    }
+    for (uint32_t b : before) {
+        system->successors.push_back(b);
+        m_Systems[b]->predecessors.push_back(index);
+    }
+    m_Systems.push_back(std::move(system));
+    m_MainReady.reserve(m_Systems.size());
+    m_Sorted = false;
+    return true;
+}
+
+void SystemScheduler::Sort() {
+    // Kahn's algorithm, taking ready systems in registration order
+    std::vector<size_t> incoming(m_Systems.size());
+    for (size_t i = 0; i < m_Systems.size(); ++i) {
+        incoming[i] = m_Systems[i]->predecessors.size();
+    }
+    m_Order.clear();
+    for (size_t i = 0; i < m_Systems.size(); ++i) {
+        if (incoming[i] == 0) {
+            m_Order.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    for (size_t next = 0; next < m_Order.size(); ++next) {
+        for (uint32_t successor : m_Systems[m_Order[next]]->successors) {
+            if (--incoming[successor] == 0) {
+                m_Order.push_back(successor);
+            }
+        }
+    }
+    m_Sorted = true;
+}
+
+void SystemScheduler::Run(JobSystem* jobs) {
+    if (m_Systems.empty()) {
+        return;
+    }
+    SHADOW_PROFILE_ZONE("SystemScheduler::Run");
+    if (!m_Sorted) {
+        Sort();
+    }
+
+    m_FrameStart = Clock::now();
+    if (jobs == nullptr || jobs->GetWorkerCount() == 0) {
+        m_Jobs = nullptr;
+        for (uint32_t index : m_Order) {
+            Execute(index);
+        }
+    } else {
+        m_Jobs = jobs;
+        for (const std::unique_ptr<System>& system : m_Systems) {
+            system->pending.store(static_cast<int>(system->predecessors.size()), std::memory_order_relaxed);
+        }
+        m_Remaining.store(m_Systems.size(), std::memory_order_relaxed);
+        for (uint32_t index : m_Order) {
+            if (m_Systems[index]->predecessors.empty()) {
+                Dispatch(index);
+            }
+        }
+
+        // Run main-thread systems as they become ready and help with the
+        // others in between
+        while (m_Remaining.load(std::memory_order_acquire) > 0) {
+            int ready = -1;
+            {
+                std::lock_guard<std::mutex> lock(m_MainMutex);
+                if (!m_MainReady.empty()) {
+                    ready = static_cast<int>(m_MainReady.back());
+                    m_MainReady.pop_back();
+                }
+            }
+            if (ready >= 0) {
+                Execute(static_cast<uint32_t>(ready));
+            } else if (!jobs->TryRunJob()) {
+                std::this_thread::yield();
+            }
+        }
+        m_Jobs = nullptr;
+    }
+    RecordFrame(ToMilliseconds(Clock::now() - m_FrameStart));
+}
+
+void SystemScheduler::Dispatch(uint32_t index) {
+    if (m_Systems[index]->mainThread) {
+        std::lock_guard<std::mutex> lock(m_MainMutex);
+        m_MainReady.push_back(index);
+    } else {
+        // Small enough a capture for std::function to store inline
+        m_Jobs->Run([this, index]() { Execute(index); });
+    }
+}
+
+void SystemScheduler::Execute(uint32_t index) {
+    System& system = *m_Systems[index];
+    const Clock::time_point begin = Clock::now();
+    {
+        SHADOW_PROFILE_ZONE(system.name.c_str());
+        system.run();
+    }
+    system.beginMs = ToMilliseconds(begin - m_FrameStart);
+    system.endMs = ToMilliseconds(Clock::now() - m_FrameStart);
+
+    if (m_Jobs) {
+        for (uint32_t successor : system.successors) {
+            if (m_Systems[successor]->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                Dispatch(successor);
+            }
+        }
+        // Last: once the count reaches zero, Run may return
+        m_Remaining.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void SystemScheduler::RecordFrame(double wallMs) {
+    double workMs = 0.0;
+    double criticalMs = 0.0;
+    int last = -1;
+    for (uint32_t index : m_Order) {
+        System& system = *m_Systems[index];
+        const double durationMs = system.endMs - system.beginMs;
+        system.totalMs += durationMs;
+        workMs += durationMs;
+
+        system.pathMs = durationMs;
+        system.criticalPrevious = -1;
+        for (uint32_t predecessor : system.predecessors) {
+            const double pathMs = m_Systems[predecessor]->pathMs + durationMs;
+            if (pathMs > system.pathMs) {
+                system.pathMs = pathMs;
+                system.criticalPrevious = static_cast<int>(predecessor);
+            }
+        }
+        if (last < 0 || system.pathMs > criticalMs) {
+            criticalMs = system.pathMs;
+            last = static_cast<int>(index);
+        }
+    }
+    for (int index = last; index >= 0; index = m_Systems[index]->criticalPrevious) {
+        ++m_Systems[index]->criticalFrames;
+    }
+
+    m_LastFrame.wallMs = wallMs;
+    m_LastFrame.workMs = workMs;
+    m_LastFrame.criticalPathMs = criticalMs;
+    m_CriticalPath.AddSample(criticalMs);
+    m_TotalWallMs += wallMs;
+    m_TotalWorkMs += workMs;
+    ++m_Frames;
+}
+
+void SystemScheduler::ResetStats() {
+    for (const std::unique_ptr<System>& system : m_Systems) {
+        system->totalMs = 0.0;
+        system->criticalFrames = 0;
+    }
+    m_LastFrame = FrameStats();
+    m_CriticalPath.Clear();
+    m_Frames = 0;
+    m_TotalWallMs = 0.0;
+    m_TotalWorkMs = 0.0;
+}
+
+void SystemScheduler::Print(std::ostream& out) const {
+    if (m_Frames == 0) {
+        return;
+    }
+    const std::ios::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+
+    const double frames = static_cast<double>(m_Frames);
+    const double criticalMs = m_CriticalPath.GetMean();
+    m_CriticalPath.PrintDurations(out, "Critical path");
+    out << std::fixed << std::setprecision(3)
+        << "  " << m_Systems.size() << " systems, mean work " << m_TotalWorkMs / frames
+        << " ms, wall " << m_TotalWallMs / frames << " ms, parallelism "
+        << (criticalMs > 0.0 ? m_TotalWorkMs / frames / criticalMs : 1.0) << std::endl;
+
+    size_t width = 0;
+    for (const std::unique_ptr<System>& system : m_Systems) {
+        width = std::max(width, system->name.size());
+    }
+    for (uint32_t index : m_Order) {
+        const System& system = *m_Systems[index];
+        out << "  " << std::left << std::setw(static_cast<int>(width)) << system.name << std::right
+            << (system.mainThread ? "  main  " : "  jobs  ") << std::setprecision(3)
+            << system.totalMs / frames << " ms, critical in " << std::setprecision(1)
+            << 100.0 * static_cast<double>(system.criticalFrames) / frames << "% of frames" << std::endl;
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+} // namespace ShadowEngine
@@ -0,0 +1,146 @@
+#include "core/VirtualFileSystem.hpp"
+#include "core/Log.hpp"
+#include "core/Lz4.hpp"
+#include "core/PackFile.hpp"
+#include <filesystem>
+#include <utility>
+
+namespace ShadowEngine {
+
+VirtualFileSystem::File::File(File&& other) noexcept {
+    *this = std::move(other);
+}
+
+VirtualFileSystem::File& VirtualFileSystem::File::operator=(File&& other) noexcept {
+    if (this != &other) {
+        m_Data = std::exchange(other.m_Data, nullptr);
+        m_Size = std::exchange(other.m_Size, 0);
+        m_Buffer = std::move(other.m_Buffer);
+        m_Mapping = std::move(other.m_Mapping);
+    }
+    return *this;
+}
+
+VirtualFileSystem& VirtualFileSystem::Get() {
+    static VirtualFileSystem instance;
+    return instance;
+}
+
+VirtualFileSystem::VirtualFileSystem()
+#ifdef NDEBUG
+    : m_LooseOverrides(false)
+#else
+    : m_LooseOverrides(true)
+#endif
+    , m_PackReads(0)
+    , m_LooseReads(0)
+    , m_DecompressedBytes(0) {
+}
+
+VirtualFileSystem::~VirtualFileSystem() = default;
+
+bool VirtualFileSystem::Mount(const std::string& packPath) {
+    auto pack = std::make_unique<PackFile>();
+    if (!pack->Open(packPath)) {
+        SHADOW_LOG_ERROR(Assets, "Failed to mount pack: {}", packPath);
+        return false;
+    }
+    m_Packs.push_back(std::move(pack));
+    return true;
+}
+
+void VirtualFileSystem::UnmountAll() {
+    m_Packs.clear();
+}
+
+std::string VirtualFileSystem::NormalizePath(const std::string& path) {
+    std::string normalized = path;
+    for (char& c : normalized) {
+        if (c == '\\') {
+            c = '/';
+        }
+    }
+    while (normalized.compare(0, 2, "./") == 0) {
+        normalized.erase(0, 2);
+    }
+    return normalized;
+}
+
+bool VirtualFileSystem::IsLooseFile(const std::string& path) {
+    std::error_code error;
+    return std::filesystem::is_regular_file(path, error);
+}
+
+bool VirtualFileSystem::Exists(const std::string& path) const {
+    const std::string normalized = NormalizePath(path);
+    for (auto it = m_Packs.rbegin(); it != m_Packs.rend(); ++it) {
+        PackFile::Entry entry;
+        if ((*it)->Find(normalized, entry)) {
+            return true;
+        }
+    }
+    return IsLooseFile(path);
+}
+
+bool VirtualFileSystem::Read(const std::string& path, File& out) const {
+    out = File();
+    if (m_LooseOverrides && IsLooseFile(path)) {
+        return ReadLoose(path, out);
+    }
+    if (ReadFromPacks(NormalizePath(path), out)) {
+        return true;
+    }
+    return !m_LooseOverrides && IsLooseFile(path) && ReadLoose(path, out);
+}
+
+bool VirtualFileSystem::ReadFromPacks(const std::string& path, File& out) const {
+    for (auto it = m_Packs.rbegin(); it != m_Packs.rend(); ++it) {
+        PackFile::Entry entry;
+        if (!(*it)->Find(path, entry)) {
+            continue;
+        }
+
+        if (entry.compressed) {
+            out.m_Buffer.resize(entry.size);
+            if (!Lz4::Decompress(entry.data, entry.storedSize, out.m_Buffer.data(), entry.size)) {
+                SHADOW_LOG_ERROR(Assets, "Corrupt compressed entry {} in pack: {}", path, (*it)->GetPath());
+                out = File();
+                return false;
+            }
+            out.m_Data = out.m_Buffer.data();
+            m_DecompressedBytes.fetch_add(entry.size, std::memory_order_relaxed);
+        } else {
+            out.m_Data = entry.data;
+        }
+        out.m_Size = entry.size;
+        m_PackReads.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+bool VirtualFileSystem::ReadLoose(const std::string& path, File& out) const {
+    // Empty files cannot be mapped, and need not be
+    std::error_code error;
+    if (std::filesystem::file_size(path, error) == 0 && !error) {
+        m_LooseReads.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    if (!out.m_Mapping.Open(path)) {
+        return false;
+    }
+    out.m_Data = out.m_Mapping.GetData();
+    out.m_Size = out.m_Mapping.GetSize();
+    m_LooseReads.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+VirtualFileSystem::Stats VirtualFileSystem::GetStats() const {
+    Stats stats;
+    stats.packReads = m_PackReads.load(std::memory_order_relaxed);
+    stats.looseReads = m_LooseReads.load(std::memory_order_relaxed);
+    stats.decompressedBytes = m_DecompressedBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace ShadowEngine
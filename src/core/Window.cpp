@@ -1,7 +1,9 @@
 #include "../include/Window.hpp"
+#include "../include/core/EventBus.hpp"
 #include "../include/core/ImageLoader.hpp"
+#include "../include/core/Log.hpp"
+#include "../include/core/Profiler.hpp"
 #include <GLFW/glfw3.h>
-#include <iostream>
 #include <stdexcept>
 
 namespace ShadowEngine {
@@ -36,6 +38,12 @@ bool Window::Initialize() {
     // Set up the unique_ptr with the custom deleter
     m_Window = std::unique_ptr<GLFWwindow, GLFWWindowDeleter>(window);
 
+    // Window events go to the bus, if one is set
+    glfwSetWindowUserPointer(m_Window.get(), this);
+    glfwSetWindowSizeCallback(m_Window.get(), SizeCallback);
+    glfwSetWindowCloseCallback(m_Window.get(), CloseCallback);
+    glfwSetWindowFocusCallback(m_Window.get(), FocusCallback);
+
     // Set context
     glfwMakeContextCurrent(m_Window.get());
     SetVSync(m_Data.VSync);
@@ -59,6 +67,15 @@ void Window::PollEvents() {
     glfwPollEvents();
 }
 
+void Window::MakeContextCurrent() {
+    if (!m_Window) return;
+    glfwMakeContextCurrent(m_Window.get());
+}
+
+void Window::ReleaseContext() {
+    glfwMakeContextCurrent(nullptr);
+}
+
 void Window::SwapBuffers() {
     if (!m_Window) return;
     glfwSwapBuffers(m_Window.get());
@@ -102,7 +119,7 @@ bool Window::SetIcon(const std::string& iconPath) {
 
 bool Window::InitializeGLFW() {
     if (!glfwInit()) {
-        std::cerr << "Failed to initialize GLFW" << std::endl;
+        SHADOW_LOG_ERROR(Core, "Failed to initialize GLFW");
         return false;
     }
 
@@ -110,6 +127,10 @@ bool Window::InitializeGLFW() {
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
     glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
+#ifndef NDEBUG
+    // Debug contexts report performance warnings that release contexts may drop
+    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+#endif
 
     return true;
 }
@@ -118,24 +139,57 @@ void Window::ShutdownGLFW() {
     glfwTerminate();
 }
 
+void Window::PostEvent(const WindowEvent& event) {
+    if (m_Data.Events) {
+        m_Data.Events->Post(event);
+    }
+}
+
+void Window::SizeCallback(GLFWwindow* window, int width, int height) {
+    Window* self = static_cast<Window*>(glfwGetWindowUserPointer(window));
+    if (!self) return;
+
+    self->m_Data.Width = width;
+    self->m_Data.Height = height;
+    WindowEvent event;
+    event.type = WindowEventType::Resized;
+    event.width = width;
+    event.height = height;
+    self->PostEvent(event);
+}
+
+void Window::CloseCallback(GLFWwindow* window) {
+    Window* self = static_cast<Window*>(glfwGetWindowUserPointer(window));
+    if (!self) return;
+
+    WindowEvent event;
+    event.type = WindowEventType::CloseRequested;
+    self->PostEvent(event);
+}
+
+void Window::FocusCallback(GLFWwindow* window, int focused) {
+    Window* self = static_cast<Window*>(glfwGetWindowUserPointer(window));
+    if (!self) return;
+
+    WindowEvent event;
+    event.type = focused == GLFW_TRUE ? WindowEventType::FocusGained : WindowEventType::FocusLost;
+    self->PostEvent(event);
+}
+
 bool Window::LoadIcon(const std::string& iconPath) {
+    SHADOW_PROFILE_ZONE("Window::LoadIcon");
     if (!m_Window) return false;
 
-    ImageLoader::ImageData imageData;
-    if (!ImageLoader::LoadImage(iconPath, imageData)) {
-        return false;
-    }
-
-    // Ensure we have RGBA data
-    if (imageData.channels != 4) {
-        std::cerr << "Icon must be in RGBA format" << std::endl;
+    // GLFW copies the pixels, so the decoder's buffer is handed over as it is
+    ImageLoader::DecodedImage image;
+    if (!ImageLoader::LoadImage(iconPath, image)) {
         return false;
     }
 
     GLFWimage icon;
-    icon.width = imageData.width;
-    icon.height = imageData.height;
-    icon.pixels = imageData.data.data();
+    icon.width = image.GetWidth();
+    icon.height = image.GetHeight();
+    icon.pixels = const_cast<unsigned char*>(image.GetPixels());
 
     glfwSetWindowIcon(m_Window.get(), 1, &icon);
     return true;
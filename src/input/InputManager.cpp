@@ -1,5 +1,8 @@
 #include "input/InputManager.hpp"
-#include <iostream>
+#include "core/EventBus.hpp"
+#include "core/Log.hpp"
+#include "core/MemoryTracker.hpp"
+#include "core/Profiler.hpp"
 #include <algorithm>
 
 namespace ShadowEngine {
@@ -9,24 +12,33 @@ namespace Input {
 static InputManager* s_InputManagerInstance = nullptr;
 
 // InputState methods
+// Codes outside the table (GLFW_KEY_UNKNOWN) read as released
+template <typename T, size_t N>
+static T GetState(const std::array<T, N>& states, int code) {
+    return code >= 0 && static_cast<size_t>(code) < N ? states[static_cast<size_t>(code)] : T();
+}
+
+template <typename T, size_t N>
+static void SetState(std::array<T, N>& states, int code, T value) {
+    if (code >= 0 && static_cast<size_t>(code) < N) {
+        states[static_cast<size_t>(code)] = value;
+    }
+}
+
 bool InputState::IsKeyPressed(KeyCode key) const {
-    auto it = keyStates.find(static_cast<int>(key));
-    return it != keyStates.end() && it->second;
+    return GetState(keyStates, static_cast<int>(key));
 }
 
 bool InputState::IsMouseButtonPressed(MouseButton button) const {
-    auto it = mouseButtonStates.find(static_cast<int>(button));
-    return it != mouseButtonStates.end() && it->second;
+    return GetState(mouseButtonStates, static_cast<int>(button));
 }
 
 bool InputState::IsGamepadButtonPressed(GamepadButton button) const {
-    auto it = gamepadButtonStates.find(static_cast<int>(button));
-    return it != gamepadButtonStates.end() && it->second;
+    return GetState(gamepadButtonStates, static_cast<int>(button));
 }
 
 float InputState::GetGamepadAxis(GamepadAxis axis) const {
-    auto it = gamepadAxisStates.find(static_cast<int>(axis));
-    return it != gamepadAxisStates.end() ? it->second : 0.0f;
+    return GetState(gamepadAxisStates, static_cast<int>(axis));
 }
 
 // InputMapping methods
@@ -64,11 +76,16 @@ bool InputMapping::IsTriggered(const InputState& state) const {
 }
 
 // InputManager implementation
-InputManager::InputManager() : m_Window(nullptr) {
+InputManager::InputManager()
+    : m_Window(nullptr)
+    , m_EventBus(nullptr)
+    , m_EventSubscription(0)
+    , m_NextCallbackId(1) {
     s_InputManagerInstance = this;
 }
 
 InputManager::~InputManager() {
+    SetEventBus(nullptr);
     if (s_InputManagerInstance == this) {
         s_InputManagerInstance = nullptr;
     }
@@ -78,7 +95,7 @@ bool InputManager::Initialize(GLFWwindow* window) {
     m_Window = window;
     
     if (!m_Window) {
-        std::cerr << "InputManager: Invalid window pointer!" << std::endl;
+        SHADOW_LOG_ERROR(Input, "InputManager: Invalid window pointer!");
         return false;
     }
     
@@ -92,11 +109,13 @@ bool InputManager::Initialize(GLFWwindow* window) {
     // Initialize gamepad states
     UpdateGamepadStates();
     
-    std::cout << "Input system initialized successfully!" << std::endl;
+    SHADOW_LOG_INFO(Input, "Input system initialized successfully!");
     return true;
 }
 
 void InputManager::Update() {
+    SHADOW_PROFILE_ZONE("InputManager::Update");
+    MemoryScope memoryScope(MemoryTag::Input);
     // Store previous state
     m_PreviousState = m_CurrentState;
     
@@ -110,20 +129,36 @@ void InputManager::Update() {
     UpdateGamepadStates();
 }
 
-void InputManager::AddEventCallback(EventType type, InputEventCallback callback) {
+void InputManager::SetEventBus(EventBus* events) {
+    if (m_EventBus) {
+        m_EventBus->Unsubscribe(m_EventSubscription);
+        m_EventSubscription = 0;
+    }
+    m_EventBus = events;
+    if (m_EventBus) {
+        m_EventSubscription =
+            m_EventBus->Subscribe<InputEvent>([this](const InputEvent& event) { ProcessEvent(event); });
+    }
+}
+
+InputCallbackId InputManager::AddEventCallback(EventType type, InputEventCallback callback) {
     int index = static_cast<int>(type);
     if (index >= 0 && index < static_cast<int>(EventType::GamepadAxisMoved) + 1) {
-        m_EventCallbacks[index].push_back(callback);
+        const InputCallbackId id = m_NextCallbackId++;
+        m_EventCallbacks[index].emplace_back(id, std::move(callback));
+        return id;
     }
+    return 0;
 }
 
-void InputManager::RemoveEventCallback(EventType type, InputEventCallback callback) {
-    // Note: std::function doesn't support equality comparison
-    // This method is provided for interface completeness but doesn't work as expected
-    // In a real implementation, you would need to store additional information to identify callbacks
-    // For now, we'll just log that this method was called
-    std::cout << "Warning: RemoveEventCallback called but std::function equality is not supported" << std::endl;
-    std::cout << "Consider using a different approach for callback management" << std::endl;
+void InputManager::RemoveEventCallback(EventType type, InputCallbackId id) {
+    int index = static_cast<int>(type);
+    if (index >= 0 && index < static_cast<int>(EventType::GamepadAxisMoved) + 1) {
+        auto& callbacks = m_EventCallbacks[index];
+        callbacks.erase(std::remove_if(callbacks.begin(), callbacks.end(),
+                                       [id](const auto& entry) { return entry.first == id; }),
+                        callbacks.end());
+    }
 }
 
 bool InputManager::IsKeyPressed(KeyCode key) const {
@@ -231,18 +266,18 @@ void InputManager::KeyCallback(GLFWwindow* window, int key, int scancode, int ac
     switch (action) {
         case GLFW_PRESS:
             event.type = EventType::KeyPressed;
-            s_InputManagerInstance->m_CurrentState.keyStates[key] = true;
+            SetState(s_InputManagerInstance->m_CurrentState.keyStates, key, true);
             break;
         case GLFW_RELEASE:
             event.type = EventType::KeyReleased;
-            s_InputManagerInstance->m_CurrentState.keyStates[key] = false;
+            SetState(s_InputManagerInstance->m_CurrentState.keyStates, key, false);
             break;
         case GLFW_REPEAT:
             event.type = EventType::KeyRepeated;
             break;
     }
     
-    s_InputManagerInstance->ProcessEvent(event);
+    s_InputManagerInstance->PostEvent(event);
 }
 
 void InputManager::MouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
@@ -254,15 +289,15 @@ void InputManager::MouseButtonCallback(GLFWwindow* window, int button, int actio
     switch (action) {
         case GLFW_PRESS:
             event.type = EventType::MouseButtonPressed;
-            s_InputManagerInstance->m_CurrentState.mouseButtonStates[button] = true;
+            SetState(s_InputManagerInstance->m_CurrentState.mouseButtonStates, button, true);
             break;
         case GLFW_RELEASE:
             event.type = EventType::MouseButtonReleased;
-            s_InputManagerInstance->m_CurrentState.mouseButtonStates[button] = false;
+            SetState(s_InputManagerInstance->m_CurrentState.mouseButtonStates, button, false);
             break;
     }
     
-    s_InputManagerInstance->ProcessEvent(event);
+    s_InputManagerInstance->PostEvent(event);
 }
 
 void InputManager::MousePositionCallback(GLFWwindow* window, double xpos, double ypos) {
@@ -282,7 +317,7 @@ void InputManager::MousePositionCallback(GLFWwindow* window, double xpos, double
     s_InputManagerInstance->m_CurrentState.mouseDeltaX = event.deltaX;
     s_InputManagerInstance->m_CurrentState.mouseDeltaY = event.deltaY;
     
-    s_InputManagerInstance->ProcessEvent(event);
+    s_InputManagerInstance->PostEvent(event);
 }
 
 void InputManager::MouseScrollCallback(GLFWwindow* window, double xoffset, double yoffset) {
@@ -296,7 +331,7 @@ void InputManager::MouseScrollCallback(GLFWwindow* window, double xoffset, doubl
     s_InputManagerInstance->m_CurrentState.scrollDeltaX = xoffset;
     s_InputManagerInstance->m_CurrentState.scrollDeltaY = yoffset;
     
-    s_InputManagerInstance->ProcessEvent(event);
+    s_InputManagerInstance->PostEvent(event);
 }
 
 void InputManager::GamepadCallback(int gamepadId, int event) {
@@ -307,20 +342,29 @@ void InputManager::GamepadCallback(int gamepadId, int event) {
     
     if (event == GLFW_CONNECTED) {
         inputEvent.type = EventType::GamepadConnected;
-        std::cout << "Gamepad " << gamepadId << " connected!" << std::endl;
+        SHADOW_LOG_INFO(Input, "Gamepad {} connected!", gamepadId);
     } else if (event == GLFW_DISCONNECTED) {
         inputEvent.type = EventType::GamepadDisconnected;
-        std::cout << "Gamepad " << gamepadId << " disconnected!" << std::endl;
+        SHADOW_LOG_INFO(Input, "Gamepad {} disconnected!", gamepadId);
     }
     
-    s_InputManagerInstance->ProcessEvent(inputEvent);
+    s_InputManagerInstance->PostEvent(inputEvent);
+}
+
+void InputManager::PostEvent(const InputEvent& event) {
+    // A full bus drops the event; the state above is already up to date
+    if (m_EventBus) {
+        m_EventBus->Post(event);
+    } else {
+        ProcessEvent(event);
+    }
 }
 
 void InputManager::ProcessEvent(const InputEvent& event) {
     int index = static_cast<int>(event.type);
     if (index >= 0 && index < static_cast<int>(EventType::GamepadAxisMoved) + 1) {
-        for (const auto& callback : m_EventCallbacks[index]) {
-            callback(event);
+        for (const auto& entry : m_EventCallbacks[index]) {
+            entry.second(event);
         }
     }
 }
@@ -1,18 +1,208 @@
 // Entry point for ShadowEngine-based applications.
 // This is intentionally kept minimal as a clean starting point.
+//
+// Headless runs for benchmarks and CI:
+//   ShadowEngine --headless [--frames N | --duration SECONDS] [--size WIDTHxHEIGHT]
+//
+// --backend gl|software|null picks the render backend (windowed or headless):
+// software rasterizes on the CPU and uses GL only to present, null prepares
+// every draw but issues no GL calls and needs no context.
+// --objects N replaces the test scene with N spinning cubes for CPU frame-cost runs.
+// --dynamic-resolution MS scales the scene resolution to keep GPU time near MS.
+//
+// Frame pacing: --pacing uncapped|limit|late-latch [--fps N] [--vsync on|off]
+// [--max-queued N]. Frame times and input-to-present latency print on exit.
+//
+// Simulation: --sim-rate HZ sets the fixed step (default 60), --max-sim-steps N
+// caps the catch-up steps after a hitch (default 8).
+// Capture: --capture DIR [--capture-format png|raw] [--capture-every N] reads
+// frames back asynchronously and writes them on a background thread.
+// --pipelined simulates the next frame while a render thread draws the current one.
+// Jobs: --workers N sets the job system's worker threads (default: one per core
+// besides the main thread), --pin-workers binds each worker to its own core.
+// --profile FILE records profiler zones for the whole run and writes them as
+// Chrome trace JSON on exit (debug builds, or -DSHADOW_ENABLE_PROFILER=ON).
+// Memory: --memory-log FILE appends a CSV snapshot of use per subsystem every
+// --memory-interval N frames (default 60); --memory-budget tag.domain=MB warns
+// when a subsystem goes over, e.g. assets.gpu=256 (repeatable). Heap figures
+// need -DSHADOW_TRACK_ALLOCATIONS=ON.
+// Assets: --pack FILE mounts a pack built with PackTool (repeatable, later packs
+// win); --loose on|off lets loose files override pack entries (default: on in
+// debug builds); --opaque-textures rgba8|rgb565 picks the format textures
+// without transparency are streamed in (default rgba8).
+// --validate-gl-state on|off checks the GL state cache against glGet* after
+// every change and once per frame (default: on in debug builds).
 
 #include "Engine.hpp"
+#include "scene/Scene.hpp"
+#include "core/MemoryTracker.hpp"
+#include "core/VirtualFileSystem.hpp"
+#include "rendering/GLStateCache.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
 
-int main(int /*argc*/, char* /*argv*/[]) {
+int main(int argc, char* argv[]) {
     auto& engine = ShadowEngine::Engine::GetInstance();
 
-    // TODO: Customize window title, size, and other initialization parameters as needed.
-    if (!engine.Initialize("Shadow Engine", 1280, 720)) {
+    bool headless = false;
+    bool pipelined = false;
+    long objectCount = 0;
+    double dynamicResolutionTarget = 0.0;
+    bool capture = false;
+    ShadowEngine::Rendering::FrameCapture::Settings captureSettings;
+    ShadowEngine::FramePacer::Settings pacing;
+    ShadowEngine::Engine::TimestepOptions timestep;
+    ShadowEngine::JobSystem::Settings jobSettings;
+    ShadowEngine::Rendering::BackendType backend = ShadowEngine::Rendering::BackendType::OpenGL;
+    ShadowEngine::Engine::HeadlessOptions headlessOptions;
+    const char* profileOutput = nullptr;
+    ShadowEngine::Engine::MemoryOptions memoryOptions;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (std::strcmp(argv[i], "--pipelined") == 0) {
+            pipelined = true;
+        } else if (std::strcmp(argv[i], "--backend") == 0 && i + 1 < argc) {
+            if (!ShadowEngine::Rendering::ParseBackendType(argv[++i], backend)) {
+                std::cerr << "Unknown backend, expected gl, software or null: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--dynamic-resolution") == 0 && i + 1 < argc) {
+            dynamicResolutionTarget = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--capture") == 0 && i + 1 < argc) {
+            capture = true;
+            captureSettings.directory = argv[++i];
+        } else if (std::strcmp(argv[i], "--capture-format") == 0 && i + 1 < argc) {
+            if (!ShadowEngine::Rendering::FrameCapture::ParseFormat(argv[++i], captureSettings.format)) {
+                std::cerr << "Unknown capture format, expected png or raw: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--capture-every") == 0 && i + 1 < argc) {
+            captureSettings.frameInterval = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--pacing") == 0 && i + 1 < argc) {
+            if (!ShadowEngine::FramePacer::ParseMode(argv[++i], pacing.mode)) {
+                std::cerr << "Unknown pacing mode, expected uncapped, limit or late-latch: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            pacing.targetFps = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--vsync") == 0 && i + 1 < argc) {
+            pacing.vsync = std::strcmp(argv[++i], "off") != 0;
+        } else if (std::strcmp(argv[i], "--max-queued") == 0 && i + 1 < argc) {
+            pacing.maxQueuedFrames = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--sim-rate") == 0 && i + 1 < argc) {
+            double rate = std::atof(argv[++i]);
+            if (rate <= 0.0) {
+                std::cerr << "Invalid simulation rate: " << argv[i] << std::endl;
+                return 1;
+            }
+            timestep.FixedDeltaTime = 1.0 / rate;
+        } else if (std::strcmp(argv[i], "--max-sim-steps") == 0 && i + 1 < argc) {
+            timestep.MaxStepsPerFrame = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            jobSettings.workerCount = std::atoi(argv[++i]);
+            if (jobSettings.workerCount < 0) {
+                std::cerr << "Invalid worker count: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--pin-workers") == 0) {
+            jobSettings.pinWorkers = true;
+        } else if (std::strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            profileOutput = argv[++i];
+        } else if (std::strcmp(argv[i], "--pack") == 0 && i + 1 < argc) {
+            if (!ShadowEngine::VirtualFileSystem::Get().Mount(argv[++i])) {
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--loose") == 0 && i + 1 < argc) {
+            ShadowEngine::VirtualFileSystem::Get().SetLooseOverrides(std::strcmp(argv[++i], "off") != 0);
+        } else if (std::strcmp(argv[i], "--opaque-textures") == 0 && i + 1 < argc) {
+            const char* name = argv[++i];
+            if (std::strcmp(name, "rgba8") == 0) {
+                engine.SetOpaqueTextureFormat(ShadowEngine::PixelConversion::Format::RGBA8);
+            } else if (std::strcmp(name, "rgb565") == 0) {
+                engine.SetOpaqueTextureFormat(ShadowEngine::PixelConversion::Format::RGB565);
+            } else {
+                std::cerr << "Unknown texture format, expected rgba8 or rgb565: " << name << std::endl;
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--validate-gl-state") == 0 && i + 1 < argc) {
+            ShadowEngine::Rendering::GLStateCache::Get().SetValidationEnabled(std::strcmp(argv[++i], "off") != 0);
+        } else if (std::strcmp(argv[i], "--memory-log") == 0 && i + 1 < argc) {
+            memoryOptions.LogPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--memory-interval") == 0 && i + 1 < argc) {
+            memoryOptions.LogInterval = std::atoi(argv[++i]);
+            if (memoryOptions.LogInterval < 1) {
+                std::cerr << "Invalid memory interval: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--memory-budget") == 0 && i + 1 < argc) {
+            ShadowEngine::MemoryTag tag;
+            ShadowEngine::MemoryDomain domain;
+            size_t bytes = 0;
+            if (!ShadowEngine::MemoryTracker::ParseBudget(argv[++i], tag, domain, bytes)) {
+                std::cerr << "Invalid memory budget, expected tag.domain=MB: " << argv[i] << std::endl;
+                return 1;
+            }
+            ShadowEngine::MemoryTracker::Get().SetBudget(tag, domain, bytes);
+        } else if (std::strcmp(argv[i], "--objects") == 0 && i + 1 < argc) {
+            objectCount = std::atol(argv[++i]);
+        } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            headlessOptions.FrameCount = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--duration") == 0 && i + 1 < argc) {
+            headlessOptions.DurationSeconds = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            if (std::sscanf(argv[++i], "%dx%d", &headlessOptions.Width, &headlessOptions.Height) != 2) {
+                std::cerr << "Invalid size, expected WIDTHxHEIGHT: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else {
+            std::cerr << "Unknown option: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    engine.SetFramePacing(pacing);
+    engine.SetTimestep(timestep);
+    engine.SetJobSystemSettings(jobSettings);
+    if (profileOutput && !engine.SetProfileOutput(profileOutput)) {
+        return 1;
+    }
+    if (!engine.SetMemoryOptions(memoryOptions)) {
+        return 1;
+    }
+    if (headless) {
+        headlessOptions.Backend = backend;
+        if (!engine.InitializeHeadless(headlessOptions)) {
+            return 1;
+        }
+    } else {
+        // TODO: Customize window title, size, and other initialization parameters as needed.
+        if (!engine.Initialize("Shadow Engine", 1280, 720, backend)) {
+            return 1;
+        }
+    }
+
+    if (dynamicResolutionTarget > 0.0) {
+        ShadowEngine::Rendering::DynamicResolution::Settings settings;
+        settings.targetFrameMs = dynamicResolutionTarget;
+        if (!engine.GetRenderSystem().EnableDynamicResolution(settings)) {
+            return 1;
+        }
+    }
+
+    if (capture && !engine.GetRenderSystem().EnableCapture(captureSettings)) {
         return 1;
     }
 
     // TODO: Set up your game/application state here (scenes, systems, etc.).
+    if (objectCount > 0) {
+        engine.SetScene(std::make_unique<ShadowEngine::BenchmarkScene>(
+            engine.GetRenderSystem(), static_cast<size_t>(objectCount)));
+    }
 
+    engine.SetPipelined(pipelined);
     engine.Run();
     return 0;
-}
\ No newline at end of file
+}
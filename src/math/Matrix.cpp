@@ -137,5 +137,112 @@ Matrix4 CreateScale(float x, float y, float z) {
     return result;
 }
 
+namespace {
+
+struct Quaternion {
+    float w, x, y, z;
+};
+
+struct Decomposed {
+    float translation[3];
+    float scale[3];
+    Quaternion rotation;
+};
+
+Decomposed Decompose(const Matrix4& m) {
+    Decomposed result;
+    const float* d = m.GetData();
+    result.translation[0] = d[12];
+    result.translation[1] = d[13];
+    result.translation[2] = d[14];
+
+    // Column c holds the rotated, scaled basis axis c; r(row, col) is the pure rotation
+    for (int c = 0; c < 3; ++c) {
+        result.scale[c] = std::sqrt(d[c * 4] * d[c * 4] + d[c * 4 + 1] * d[c * 4 + 1] + d[c * 4 + 2] * d[c * 4 + 2]);
+    }
+    auto r = [&](int row, int col) {
+        return result.scale[col] > 0.0f ? d[col * 4 + row] / result.scale[col] : (row == col ? 1.0f : 0.0f);
+    };
+
+    // Branch on the largest diagonal term to keep the square root well conditioned
+    Quaternion& q = result.rotation;
+    const float trace = r(0, 0) + r(1, 1) + r(2, 2);
+    if (trace > 0.0f) {
+        float s = std::sqrt(trace + 1.0f) * 2.0f;
+        q = {0.25f * s, (r(2, 1) - r(1, 2)) / s, (r(0, 2) - r(2, 0)) / s, (r(1, 0) - r(0, 1)) / s};
+    } else if (r(0, 0) > r(1, 1) && r(0, 0) > r(2, 2)) {
+        float s = std::sqrt(1.0f + r(0, 0) - r(1, 1) - r(2, 2)) * 2.0f;
+        q = {(r(2, 1) - r(1, 2)) / s, 0.25f * s, (r(0, 1) + r(1, 0)) / s, (r(0, 2) + r(2, 0)) / s};
+    } else if (r(1, 1) > r(2, 2)) {
+        float s = std::sqrt(1.0f + r(1, 1) - r(0, 0) - r(2, 2)) * 2.0f;
+        q = {(r(0, 2) - r(2, 0)) / s, (r(0, 1) + r(1, 0)) / s, 0.25f * s, (r(1, 2) + r(2, 1)) / s};
+    } else {
+        float s = std::sqrt(1.0f + r(2, 2) - r(0, 0) - r(1, 1)) * 2.0f;
+        q = {(r(1, 0) - r(0, 1)) / s, (r(0, 2) + r(2, 0)) / s, (r(1, 2) + r(2, 1)) / s, 0.25f * s};
+    }
+    return result;
+}
+
+Quaternion Slerp(Quaternion a, Quaternion b, float t) {
+    float cosine = a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z;
+    if (cosine < 0.0f) {
+        // Take the short way round
+        b = {-b.w, -b.x, -b.y, -b.z};
+        cosine = -cosine;
+    }
+
+    float wa = 1.0f - t;
+    float wb = t;
+    if (cosine < 0.9995f) {
+        float angle = std::acos(cosine);
+        float sine = std::sin(angle);
+        wa = std::sin((1.0f - t) * angle) / sine;
+        wb = std::sin(t * angle) / sine;
+    }
+
+    // Nearly parallel inputs fall back to a normalised lerp
+    Quaternion q = {wa * a.w + wb * b.w, wa * a.x + wb * b.x, wa * a.y + wb * b.y, wa * a.z + wb * b.z};
+    float length = std::sqrt(q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z);
+    if (length > 0.0f) {
+        q = {q.w / length, q.x / length, q.y / length, q.z / length};
+    }
+    return q;
+}
+
+} // namespace
+
+Matrix4 InterpolateTransforms(const Matrix4& from, const Matrix4& to, float alpha) {
+    const Decomposed a = Decompose(from);
+    const Decomposed b = Decompose(to);
+    const Quaternion q = Slerp(a.rotation, b.rotation, alpha);
+
+    float scale[3];
+    for (int i = 0; i < 3; ++i) {
+        scale[i] = a.scale[i] + (b.scale[i] - a.scale[i]) * alpha;
+    }
+
+    const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+    Matrix4 result;
+    result.data[0] = (1.0f - 2.0f * (yy + zz)) * scale[0];
+    result.data[1] = 2.0f * (xy + wz) * scale[0];
+    result.data[2] = 2.0f * (xz - wy) * scale[0];
+
+    result.data[4] = 2.0f * (xy - wz) * scale[1];
+    result.data[5] = (1.0f - 2.0f * (xx + zz)) * scale[1];
+    result.data[6] = 2.0f * (yz + wx) * scale[1];
+
+    result.data[8] = 2.0f * (xz + wy) * scale[2];
+    result.data[9] = 2.0f * (yz - wx) * scale[2];
+    result.data[10] = (1.0f - 2.0f * (xx + yy)) * scale[2];
+
+    for (int i = 0; i < 3; ++i) {
+        result.data[12 + i] = a.translation[i] + (b.translation[i] - a.translation[i]) * alpha;
+    }
+    return result;
+}
+
 } // namespace Math
 } // namespace ShadowEngine 
\ No newline at end of file
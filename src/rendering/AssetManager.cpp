@@ -0,0 +1,790 @@
+#include "rendering/AssetManager.hpp"
+#include "rendering/Material.hpp"
+#include "rendering/Mesh.hpp"
+#include "rendering/ResourceCache.hpp"
+#include "rendering/Shader.hpp"
+#include "rendering/Texture.hpp"
+#include "rendering/TextureStreamer.hpp"
+#include "core/CompressedTextureFile.hpp"
+#include "core/EventBus.hpp"
+#include "core/ImageLoader.hpp"
+#include "core/Log.hpp"
+#include "core/MemoryTracker.hpp"
+#include "core/MipGenerator.hpp"
+#include "core/Profiler.hpp"
+#include "core/VirtualFileSystem.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string_view>
+#include <utility>
+
+namespace ShadowEngine {
+namespace Rendering {
+
+namespace {
+
+enum class AssetType : uint8_t {
+    Texture,
+    Shader,
+    Mesh,
+    Material
+};
+
+bool EndsWith(const std::string& text, std::string_view suffix) {
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+bool IsTerminal(AssetState state) {
+    return state == AssetState::Ready || state == AssetState::Failed || state == AssetState::Cancelled ||
+           state == AssetState::Released;
+}
+
+// Whether every pixel of an RGBA8 image has full alpha
+bool IsOpaque(const ImageLoader::ImageData& image) {
+    for (size_t i = 3; i < image.data.size(); i += 4) {
+        if (image.data[i] != 255) {
+            return false;
+        }
+    }
+    return true;
+}
+
+double MillisecondsSince(AssetManager::Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(AssetManager::Clock::now() - start).count();
+}
+
+// Next whitespace-separated token of line, advancing it
+std::string_view NextToken(std::string_view& line) {
+    size_t begin = 0;
+    while (begin < line.size() && (line[begin] == ' ' || line[begin] == '\t' || line[begin] == '\r')) {
+        ++begin;
+    }
+    size_t end = begin;
+    while (end < line.size() && line[end] != ' ' && line[end] != '\t' && line[end] != '\r') {
+        ++end;
+    }
+    std::string_view token = line.substr(begin, end - begin);
+    line.remove_prefix(end);
+    return token;
+}
+
+bool ParseFloat(std::string_view token, float& out) {
+    // Tokens are short; copy so strtof sees a terminated string
+    char buffer[64];
+    if (token.empty() || token.size() >= sizeof(buffer)) {
+        return false;
+    }
+    std::copy(token.begin(), token.end(), buffer);
+    buffer[token.size()] = '\0';
+    char* end = nullptr;
+    out = std::strtof(buffer, &end);
+    return end == buffer + token.size();
+}
+
+// Position index of an OBJ face corner ("7", "7/2", "7//3", "-1/..."), made
+// zero-based against vertexCount
+bool ParseFaceIndex(std::string_view token, size_t vertexCount, unsigned int& out) {
+    const size_t slash = token.find('/');
+    if (slash != std::string_view::npos) {
+        token = token.substr(0, slash);
+    }
+    char buffer[32];
+    if (token.empty() || token.size() >= sizeof(buffer)) {
+        return false;
+    }
+    std::copy(token.begin(), token.end(), buffer);
+    buffer[token.size()] = '\0';
+    char* end = nullptr;
+    const long index = std::strtol(buffer, &end, 10);
+    if (end != buffer + token.size() || index == 0) {
+        return false;
+    }
+    const long resolved = index > 0 ? index - 1 : static_cast<long>(vertexCount) + index;
+    if (resolved < 0 || static_cast<size_t>(resolved) >= vertexCount) {
+        return false;
+    }
+    out = static_cast<unsigned int>(resolved);
+    return true;
+}
+
+// Interleaved position and colour, the layout Mesh expects
+bool ParseObj(std::string_view text, std::vector<float>& vertices, std::vector<unsigned int>& indices,
+              std::string& error) {
+    std::vector<unsigned int> face;
+    size_t lineNumber = 0;
+    while (!text.empty()) {
+        const size_t newline = text.find('\n');
+        std::string_view line = text.substr(0, newline);
+        text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1);
+        ++lineNumber;
+
+        const std::string_view keyword = NextToken(line);
+        if (keyword == "v") {
+            // Position, then an optional colour; white without one
+            float values[6] = {0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f};
+            int count = 0;
+            for (std::string_view token = NextToken(line); !token.empty() && count < 6; token = NextToken(line)) {
+                if (!ParseFloat(token, values[count++])) {
+                    count = -1;
+                    break;
+                }
+            }
+            if (count != 3 && count != 4 && count != 6) {
+                error = "bad vertex on line " + std::to_string(lineNumber);
+                return false;
+            }
+            if (count == 4) {
+                values[3] = 1.0f;  // Homogeneous w, not a colour
+            }
+            vertices.insert(vertices.end(), values, values + 6);
+        } else if (keyword == "f") {
+            face.clear();
+            const size_t vertexCount = vertices.size() / 6;
+            for (std::string_view token = NextToken(line); !token.empty(); token = NextToken(line)) {
+                unsigned int index = 0;
+                if (!ParseFaceIndex(token, vertexCount, index)) {
+                    error = "bad face index on line " + std::to_string(lineNumber);
+                    return false;
+                }
+                face.push_back(index);
+            }
+            if (face.size() < 3) {
+                error = "face with fewer than three corners on line " + std::to_string(lineNumber);
+                return false;
+            }
+            for (size_t i = 1; i + 1 < face.size(); ++i) {
+                indices.push_back(face[0]);
+                indices.push_back(face[i]);
+                indices.push_back(face[i + 1]);
+            }
+        }
+        // Normals, texture coordinates, groups and materials are not used
+    }
+
+    if (indices.empty()) {
+        error = "no faces";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+struct AssetManager::Record {
+    AssetHandle handle;
+    AssetHandle parent;                    // Material this is a dependency of
+    AssetType type = AssetType::Texture;
+    AssetPriority priority = AssetPriority::Normal;
+    AssetState state = AssetState::Queued;
+    uint64_t sequence = 0;
+    Clock::time_point requested;
+    std::string path;
+    std::string fragmentPath;              // Shaders only
+    std::vector<AssetHandle> children;     // Materials: the shader, then the textures in unit order
+    size_t pendingChildren = 0;
+    bool released = false;                 // Retired once terminal and no stage holds it
+    bool working = false;                  // A stage is using it outside the lock
+
+    // Read and decode output, released once the GPU objects exist
+    VirtualFileSystem::File file;
+    VirtualFileSystem::File fragmentFile;
+    std::unique_ptr<CompressedTextureFile> cooked;
+    std::vector<ImageLoader::ImageData> levels;
+    PixelConversion::Format format = PixelConversion::Format::RGBA8;  // Of levels' pixels
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+    std::vector<std::string> dependencyPaths;  // Materials: vertex, fragment, then textures
+
+    // Results
+    std::shared_ptr<Texture> texture;
+    std::shared_ptr<Shader> shader;
+    std::shared_ptr<Mesh> mesh;
+    std::shared_ptr<Material> material;
+
+    std::string GetName() const { return type == AssetType::Shader ? path + " + " + fragmentPath : path; }
+
+    void ReleasePayload() {
+        file = VirtualFileSystem::File();
+        fragmentFile = VirtualFileSystem::File();
+        cooked.reset();
+        std::vector<ImageLoader::ImageData>().swap(levels);
+        std::vector<float>().swap(vertices);
+        std::vector<unsigned int>().swap(indices);
+        std::vector<std::string>().swap(dependencyPaths);
+    }
+};
+
+AssetManager::AssetManager(JobSystem* jobs, TextureStreamer* streamer, ResourceCache* cache, bool hasContext)
+    : m_Jobs(jobs)
+    , m_Streamer(streamer)
+    , m_Cache(cache)
+    , m_HasContext(hasContext)
+    , m_Events(nullptr)
+    , m_UploadBudgetMilliseconds(2.0)
+    , m_OpaqueTextureFormat(PixelConversion::Format::RGBA8)
+    , m_Requested(0)
+    , m_NextSequence(0)
+    , m_StateCounts()
+    , m_LastFrameUploads(0)
+    , m_LastFrameUploadMilliseconds(0.0)
+    , m_Quit(false) {
+    m_IoThread = std::thread(&AssetManager::IoLoop, this);
+}
+
+AssetManager::~AssetManager() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Quit = true;
+    }
+    m_ReadAvailable.notify_all();
+    m_IoThread.join();
+
+    // Decode jobs hold records; let them finish before the records go
+    if (m_Jobs) {
+        m_Jobs->Wait(m_DecodeJobs);
+    }
+}
+
+AssetHandle AssetManager::LoadTexture(const std::string& path, AssetPriority priority) {
+    auto record = std::make_unique<Record>();
+    record->type = AssetType::Texture;
+    record->priority = priority;
+    record->path = path;
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return Enqueue(std::move(record));
+}
+
+AssetHandle AssetManager::LoadShader(const std::string& vertexPath, const std::string& fragmentPath,
+                                     AssetPriority priority) {
+    auto record = std::make_unique<Record>();
+    record->type = AssetType::Shader;
+    record->priority = priority;
+    record->path = vertexPath;
+    record->fragmentPath = fragmentPath;
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return Enqueue(std::move(record));
+}
+
+AssetHandle AssetManager::LoadMesh(const std::string& path, AssetPriority priority) {
+    auto record = std::make_unique<Record>();
+    record->type = AssetType::Mesh;
+    record->priority = priority;
+    record->path = path;
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return Enqueue(std::move(record));
+}
+
+AssetHandle AssetManager::LoadMaterial(const std::string& path, AssetPriority priority) {
+    auto record = std::make_unique<Record>();
+    record->type = AssetType::Material;
+    record->priority = priority;
+    record->path = path;
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return Enqueue(std::move(record));
+}
+
+AssetHandle AssetManager::Enqueue(std::unique_ptr<Record> record) {
+    // Reuse a retired id when there is one, so the table stays as large as the
+    // most requests ever alive at once
+    AssetHandle handle;
+    if (!m_FreeIds.empty()) {
+        handle.id = m_FreeIds.back();
+        handle.generation = ++m_Generations[handle.id - 1];
+        m_FreeIds.pop_back();
+    } else {
+        m_Records.emplace_back();
+        m_Generations.push_back(0);
+        handle.id = static_cast<uint32_t>(m_Records.size());
+    }
+
+    record->handle = handle;
+    record->sequence = m_NextSequence++;
+    record->requested = Clock::now();
+    record->state = AssetState::Queued;
+    ++m_StateCounts[static_cast<size_t>(AssetState::Queued)];
+    ++m_Requested;
+    m_ReadQueue.push({record->priority, record->sequence, handle});
+    m_Records[handle.id - 1] = std::move(record);
+    m_ReadAvailable.notify_one();
+    return handle;
+}
+
+AssetManager::Record* AssetManager::Find(AssetHandle handle) const {
+    if (handle.id == 0 || handle.id > m_Records.size()) {
+        return nullptr;
+    }
+    Record* record = m_Records[handle.id - 1].get();
+    return record && record->handle.generation == handle.generation ? record : nullptr;
+}
+
+void AssetManager::SetEventBus(EventBus* events) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Events = events;
+}
+
+void AssetManager::SetState(Record& record, AssetState state) {
+    --m_StateCounts[static_cast<size_t>(record.state)];
+    ++m_StateCounts[static_cast<size_t>(state)];
+    record.state = state;
+
+    if (m_Events && IsTerminal(state) && state != AssetState::Released) {
+        AssetEvent event;
+        event.handle = record.handle;
+        event.state = state;
+        m_Events->Post(event);
+    }
+}
+
+void AssetManager::Fail(Record& record, const std::string& reason) {
+    if (IsTerminal(record.state)) {
+        return;
+    }
+    SHADOW_LOG_ERROR(Assets, "Failed to load {}: {}", record.GetName(), reason);
+    SetState(record, AssetState::Failed);
+
+    // Siblings still loading are of no use now, and neither is the material
+    for (AssetHandle child : record.children) {
+        CancelRecord(*Find(child));
+    }
+    if (Record* parent = Find(record.parent)) {
+        Fail(*parent, "dependency " + record.GetName() + " failed");
+    }
+}
+
+void AssetManager::CancelRecord(Record& record) {
+    if (IsTerminal(record.state)) {
+        return;
+    }
+    SetState(record, AssetState::Cancelled);
+    for (AssetHandle child : record.children) {
+        CancelRecord(*Find(child));
+    }
+
+    // A material cannot complete without this dependency
+    if (Record* parent = Find(record.parent)) {
+        CancelRecord(*parent);
+    }
+}
+
+void AssetManager::Complete(Record& record) {
+    SetState(record, AssetState::Ready);
+    m_Latency.AddSample(MillisecondsSince(record.requested));
+
+    Record* parent = Find(record.parent);
+    if (parent && parent->state == AssetState::Waiting && --parent->pendingChildren == 0) {
+        SetState(*parent, AssetState::Uploading);
+        m_UploadQueue.push({parent->priority, parent->sequence, parent->handle});
+    }
+}
+
+void AssetManager::Cancel(AssetHandle handle) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (Record* record = Find(handle)) {
+        CancelRecord(*record);
+    }
+}
+
+void AssetManager::ReleaseRecord(Record& record) {
+    record.released = true;
+    if (record.state == AssetState::Ready) {
+        SetState(record, AssetState::Released);
+        record.texture.reset();
+        record.shader.reset();
+        record.mesh.reset();
+        record.material.reset();
+    } else {
+        CancelRecord(record);
+    }
+    for (AssetHandle child : record.children) {
+        ReleaseRecord(*Find(child));
+    }
+}
+
+void AssetManager::Retire(Record& record) {
+    // A stage still working on it, or a material still referring to it, keeps
+    // the record until they let go; each of them retires it then
+    if (!record.released || record.working || !IsTerminal(record.state) || Find(record.parent)) {
+        return;
+    }
+    const std::vector<AssetHandle> children = std::move(record.children);
+    const uint32_t id = record.handle.id;
+    m_Records[id - 1].reset();
+    m_FreeIds.push_back(id);
+    for (AssetHandle child : children) {
+        if (Record* dependency = Find(child)) {
+            Retire(*dependency);
+        }
+    }
+}
+
+void AssetManager::Release(AssetHandle handle) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (Record* record = Find(handle)) {
+        ReleaseRecord(*record);
+        Retire(*record);
+    }
+}
+
+AssetState AssetManager::GetState(AssetHandle handle) const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (const Record* record = Find(handle)) {
+        return record->state;
+    }
+    const bool issued = handle.id > 0 && handle.id <= m_Generations.size() &&
+                        handle.generation <= m_Generations[handle.id - 1];
+    return issued ? AssetState::Released : AssetState::Failed;
+}
+
+std::shared_ptr<Texture> AssetManager::GetTexture(AssetHandle handle) const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    const Record* record = Find(handle);
+    return record && record->state == AssetState::Ready ? record->texture : nullptr;
+}
+
+std::shared_ptr<Shader> AssetManager::GetShader(AssetHandle handle) const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    const Record* record = Find(handle);
+    return record && record->state == AssetState::Ready ? record->shader : nullptr;
+}
+
+std::shared_ptr<Mesh> AssetManager::GetMesh(AssetHandle handle) const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    const Record* record = Find(handle);
+    return record && record->state == AssetState::Ready ? record->mesh : nullptr;
+}
+
+std::shared_ptr<Material> AssetManager::GetMaterial(AssetHandle handle) const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    const Record* record = Find(handle);
+    return record && record->state == AssetState::Ready ? record->material : nullptr;
+}
+
+void AssetManager::IoLoop() {
+    SHADOW_PROFILE_THREAD("Asset I/O");
+    MemoryScope memoryScope(MemoryTag::Assets);
+    const bool useWorkers = m_Jobs && m_Jobs->GetWorkerCount() > 0;
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    while (true) {
+        m_ReadAvailable.wait(lock, [this] { return m_Quit || !m_ReadQueue.empty(); });
+        if (m_Quit) {
+            break;
+        }
+
+        Record* queued = Find(m_ReadQueue.top().handle);
+        m_ReadQueue.pop();
+        if (!queued || queued->state != AssetState::Queued) {
+            continue;  // Cancelled while queued
+        }
+        Record& record = *queued;
+        SetState(record, AssetState::Reading);
+        record.working = true;
+        lock.unlock();
+
+        std::string error;
+        const bool read = Read(record, error);
+
+        lock.lock();
+        record.working = false;
+        if (record.state == AssetState::Cancelled) {
+            record.ReleasePayload();
+            Retire(record);
+            continue;
+        }
+        if (!read) {
+            record.ReleasePayload();
+            Fail(record, error);
+            continue;
+        }
+        SetState(record, AssetState::Decoding);
+        record.working = true;
+        lock.unlock();
+
+        // Without workers a job would only run when the owning thread waits,
+        // so decode here instead
+        if (useWorkers) {
+            Record* decoding = &record;
+            m_Jobs->Run([this, decoding] { Decode(*decoding); }, &m_DecodeJobs);
+        } else {
+            Decode(record);
+        }
+        lock.lock();
+    }
+}
+
+bool AssetManager::Read(Record& record, std::string& error) {
+    SHADOW_PROFILE_ZONE("AssetManager::Read");
+    const VirtualFileSystem& vfs = VirtualFileSystem::Get();
+
+    if (record.type == AssetType::Texture && EndsWith(record.path, ".shtx")) {
+        // Containers are validated as they are opened, and uploaded as stored
+        record.cooked = std::make_unique<CompressedTextureFile>();
+        if (!record.cooked->Open(record.path)) {
+            error = "invalid texture container";
+            return false;
+        }
+        return true;
+    }
+
+    if (!vfs.Read(record.path, record.file)) {
+        error = "cannot open " + record.path;
+        return false;
+    }
+    if (record.type == AssetType::Shader && !vfs.Read(record.fragmentPath, record.fragmentFile)) {
+        error = "cannot open " + record.fragmentPath;
+        return false;
+    }
+    return true;
+}
+
+void AssetManager::Decode(Record& record) {
+    SHADOW_PROFILE_ZONE("AssetManager::Decode");
+    MemoryScope memoryScope(MemoryTag::Assets);
+    std::string error;
+    const bool decoded = DecodeRecord(record, error);
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    record.working = false;
+    if (record.state == AssetState::Cancelled) {
+        record.ReleasePayload();
+        Retire(record);
+        return;
+    }
+    if (!decoded) {
+        record.ReleasePayload();
+        Fail(record, error);
+        return;
+    }
+    if (record.type != AssetType::Material) {
+        SetState(record, AssetState::Uploading);
+        m_UploadQueue.push({record.priority, record.sequence, record.handle});
+        return;
+    }
+
+    // Dependencies load at the material's priority; it waits for all of them
+    SetState(record, AssetState::Waiting);
+    for (size_t i = 1; i < record.dependencyPaths.size(); ++i) {
+        auto child = std::make_unique<Record>();
+        child->parent = record.handle;
+        child->priority = record.priority;
+        if (i == 1) {
+            child->type = AssetType::Shader;
+            child->path = record.dependencyPaths[0];
+            child->fragmentPath = record.dependencyPaths[1];
+        } else {
+            child->type = AssetType::Texture;
+            child->path = record.dependencyPaths[i];
+        }
+        record.children.push_back(Enqueue(std::move(child)));
+    }
+    record.pendingChildren = record.children.size();
+    record.ReleasePayload();
+}
+
+bool AssetManager::DecodeRecord(Record& record, std::string& error) {
+    switch (record.type) {
+    case AssetType::Texture: {
+        // Nothing samples textures without a GPU backend; containers need no decoding
+        if (!m_HasContext || record.cooked) {
+            return true;
+        }
+        ImageLoader::ImageData image;
+        if (!ImageLoader::DecodeImage(record.file.GetData(), record.file.GetSize(), image)) {
+            error = "cannot decode image";
+            return false;
+        }
+        record.file = VirtualFileSystem::File();
+        record.levels = MipGenerator::Build(std::move(image), MipGenerator::Settings(), m_Jobs);
+
+        // Downsampling can't introduce alpha, so checking the base level is enough
+        const PixelConversion::Format format = GetOpaqueTextureFormat();
+        if (format != PixelConversion::Format::RGBA8 && IsOpaque(record.levels[0])) {
+            std::vector<ImageLoader::PixelBuffer> converted;
+            PixelConversion::ConvertLevels(record.levels, format, converted, m_Jobs);
+            for (size_t i = 0; i < record.levels.size(); ++i) {
+                record.levels[i].data = std::move(converted[i]);
+                record.levels[i].channels = format == PixelConversion::Format::RGB565 ? 3 : 4;
+            }
+            record.format = format;
+        }
+        return true;
+    }
+    case AssetType::Shader:
+        return true;  // Compiled on the GL thread
+    case AssetType::Mesh: {
+        const bool parsed = ParseObj(record.file.GetText(), record.vertices, record.indices, error);
+        record.file = VirtualFileSystem::File();
+        return parsed;
+    }
+    case AssetType::Material: {
+        std::istringstream text{std::string(record.file.GetText())};
+        std::string line;
+        std::vector<std::string> textures;
+        size_t lineNumber = 0;
+        while (std::getline(text, line)) {
+            ++lineNumber;
+            std::istringstream tokens(line.substr(0, line.find('#')));
+            std::string keyword;
+            if (!(tokens >> keyword)) {
+                continue;
+            }
+            std::string first;
+            std::string second;
+            if (keyword == "shader" && tokens >> first >> second && record.dependencyPaths.empty()) {
+                record.dependencyPaths = {first, second};
+            } else if (keyword == "texture" && tokens >> first) {
+                textures.push_back(first);
+            } else {
+                error = "bad directive on line " + std::to_string(lineNumber);
+                return false;
+            }
+        }
+        if (record.dependencyPaths.empty()) {
+            error = "no shader";
+            return false;
+        }
+        record.dependencyPaths.insert(record.dependencyPaths.end(), textures.begin(), textures.end());
+        return true;
+    }
+    }
+    return false;
+}
+
+void AssetManager::ProcessUploads() {
+    SHADOW_PROFILE_ZONE("AssetManager::ProcessUploads");
+    MemoryScope memoryScope(MemoryTag::Assets);
+    const Clock::time_point start = Clock::now();
+    const double budget = GetUploadBudget();
+    int uploads = 0;
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    while (!m_UploadQueue.empty() && (uploads == 0 || MillisecondsSince(start) < budget)) {
+        Record* queued = Find(m_UploadQueue.top().handle);
+        m_UploadQueue.pop();
+        if (!queued) {
+            continue;  // Released while queued
+        }
+        Record& record = *queued;
+        if (record.state != AssetState::Uploading) {
+            record.ReleasePayload();  // Cancelled while queued
+            continue;
+        }
+
+        // Materials only gather their dependencies, which needs the lock
+        bool uploaded;
+        if (record.type == AssetType::Material) {
+            uploaded = AssembleMaterial(record);
+        } else {
+            record.working = true;
+            lock.unlock();
+            uploaded = Upload(record);
+            lock.lock();
+            record.working = false;
+        }
+        record.ReleasePayload();
+        ++uploads;
+
+        if (record.state == AssetState::Cancelled) {
+            record.texture.reset();
+            record.shader.reset();
+            record.mesh.reset();
+            record.material.reset();
+            Retire(record);
+        } else if (!uploaded) {
+            Fail(record, "GPU upload failed");
+        } else {
+            Complete(record);
+        }
+    }
+
+    m_LastFrameUploads = uploads;
+    m_LastFrameUploadMilliseconds = MillisecondsSince(start);
+}
+
+bool AssetManager::Upload(Record& record) {
+    SHADOW_PROFILE_ZONE("AssetManager::Upload");
+    switch (record.type) {
+    case AssetType::Texture:
+        if (!m_HasContext) {
+            return true;  // Ready, but nothing to sample
+        }
+        record.texture = record.cooked ? Texture::CreateCompressed(record.path, *record.cooked)
+                                       : m_Streamer->CreateTexture(record.path, std::move(record.levels), record.format);
+        return record.texture != nullptr;
+    case AssetType::Shader:
+        record.shader = m_Cache->GetShader(record.file.GetText(), record.fragmentFile.GetText(), record.GetName());
+        return record.shader != nullptr;
+    case AssetType::Mesh:
+        record.mesh = m_Cache->GetMesh(record.vertices, record.indices);
+        return record.mesh != nullptr;
+    case AssetType::Material:
+        break;
+    }
+    return false;
+}
+
+bool AssetManager::AssembleMaterial(Record& record) {
+    std::shared_ptr<Shader> shader;
+    std::vector<std::shared_ptr<Texture>> textures;
+    for (size_t i = 0; i < record.children.size(); ++i) {
+        const Record& child = *Find(record.children[i]);
+        if (i == 0) {
+            shader = child.shader;
+        } else {
+            textures.push_back(child.texture);
+        }
+    }
+    record.material = std::make_shared<Material>(record.path, std::move(shader), std::move(textures));
+    return true;
+}
+
+bool AssetManager::IsIdle() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (size_t state = 0; state < StateCount; ++state) {
+        if (!IsTerminal(static_cast<AssetState>(state)) && m_StateCounts[state] > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+AssetManager::Stats AssetManager::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto count = [this](AssetState state) { return m_StateCounts[static_cast<size_t>(state)]; };
+    Stats stats;
+    stats.queuedReads = count(AssetState::Queued) + count(AssetState::Reading);
+    stats.decoding = count(AssetState::Decoding);
+    stats.waiting = count(AssetState::Waiting);
+    stats.queuedUploads = count(AssetState::Uploading);
+    stats.ready = count(AssetState::Ready);
+    stats.failed = count(AssetState::Failed);
+    stats.cancelled = count(AssetState::Cancelled);
+    stats.released = count(AssetState::Released);
+    stats.lastFrameUploads = m_LastFrameUploads;
+    stats.lastFrameUploadMilliseconds = m_LastFrameUploadMilliseconds;
+    return stats;
+}
+
+void AssetManager::PrintSummary(std::ostream& out) const {
+    const Stats stats = GetStats();
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_Requested == 0) {
+        return;
+    }
+    const uint64_t loaded = stats.ready + stats.released;
+    out << "Assets: " << m_Requested << " requested, " << loaded << " loaded, " << stats.failed
+        << " failed, " << stats.cancelled << " cancelled";
+    const uint64_t pending = m_Requested - loaded - stats.failed - stats.cancelled;
+    if (pending > 0) {
+        out << ", " << pending << " unfinished";
+    }
+    out << std::endl;
+    if (m_Latency.GetCount() > 0) {
+        m_Latency.PrintDurations(out, "Asset load latency");
+    }
+}
+
+} // namespace Rendering
+} // namespace ShadowEngine
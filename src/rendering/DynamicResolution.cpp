@@ -0,0 +1,120 @@
+#include "rendering/DynamicResolution.hpp"
+#include "core/Log.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+namespace ShadowEngine {
+namespace Rendering {
+
+DynamicResolution::DynamicResolution()
+    : DynamicResolution(Settings())
+{
+}
+
+DynamicResolution::DynamicResolution(const Settings& settings)
+    : m_Settings(settings)
+    , m_Scale(settings.maxScale)
+    , m_SmoothedMs(0.0)
+    , m_CheapFrames(0)
+    , m_SettleFrames(0)
+    , m_Frame(0)
+    , m_StatsStartFrame(0)
+    , m_ChangeCount(0)
+    , m_ScaleSum(0.0)
+    , m_LowestScale(settings.maxScale)
+    , m_History(settings.historyLength)
+    , m_HistoryStart(0)
+    , m_HistorySize(0)
+{
+    m_Settings.minScale = std::max(0.05f, std::min(m_Settings.minScale, m_Settings.maxScale));
+}
+
+bool DynamicResolution::Update(double gpuMilliseconds) {
+    const float previousScale = m_Scale;
+    m_SmoothedMs = m_Frame == 0
+        ? gpuMilliseconds
+        : m_SmoothedMs + m_Settings.smoothing * (gpuMilliseconds - m_SmoothedMs);
+    ++m_Frame;
+    m_ScaleSum += m_Scale;
+
+    if (m_SettleFrames > 0) {
+        // Results still in flight were rendered at the old scale; restart the
+        // average from the first frame at the new one
+        if (--m_SettleFrames == 0) {
+            m_SmoothedMs = gpuMilliseconds;
+        }
+    } else {
+        const double target = m_Settings.targetFrameMs;
+        const double load = m_SmoothedMs / target;
+        if (load > m_Settings.overBudget && m_Scale > m_Settings.minScale) {
+            // Aim just inside the band so the next reading does not bounce back
+            SetScale(m_Scale * static_cast<float>(std::sqrt(0.95 / load)), gpuMilliseconds);
+        } else if (load < m_Settings.underBudget && m_Scale < m_Settings.maxScale) {
+            if (++m_CheapFrames >= m_Settings.growDelayFrames) {
+                // Grow towards the budget, capped so one misjudged step stays small
+                float predicted = m_Scale * static_cast<float>(std::sqrt(0.9 / std::max(load, 0.01)));
+                SetScale(std::min(predicted, m_Scale + m_Settings.maxGrowStep), gpuMilliseconds);
+            }
+        } else {
+            m_CheapFrames = 0;
+        }
+    }
+
+    if (!m_History.empty()) {
+        const Sample sample{m_Frame, static_cast<float>(gpuMilliseconds), static_cast<float>(m_SmoothedMs), m_Scale};
+        if (m_HistorySize < m_History.size()) {
+            m_History[(m_HistoryStart + m_HistorySize) % m_History.size()] = sample;
+            ++m_HistorySize;
+        } else {
+            // Full: overwrite the oldest
+            m_History[m_HistoryStart] = sample;
+            m_HistoryStart = (m_HistoryStart + 1) % m_History.size();
+        }
+    }
+    return m_Scale != previousScale;
+}
+
+void DynamicResolution::SetScale(float scale, double gpuMilliseconds) {
+    scale = std::max(m_Settings.minScale, std::min(m_Settings.maxScale, scale));
+    m_CheapFrames = 0;
+    if (scale == m_Scale) {
+        return;
+    }
+
+    SHADOW_LOG_INFO(Rendering,
+                    "Dynamic resolution: scale {:.2} -> {:.2} at frame {} (GPU {:.2} ms, smoothed {:.2} ms, target {:.2} ms)",
+                    m_Scale, scale, m_Frame, gpuMilliseconds, m_SmoothedMs, m_Settings.targetFrameMs);
+
+    m_Scale = scale;
+    m_LowestScale = std::min(m_LowestScale, scale);
+    m_SettleFrames = m_Settings.settleFrames;
+    ++m_ChangeCount;
+}
+
+void DynamicResolution::ResetStats() {
+    m_StatsStartFrame = m_Frame;
+    m_ChangeCount = 0;
+    m_ScaleSum = 0.0;
+    m_LowestScale = m_Scale;
+}
+
+void DynamicResolution::PrintSummary(std::ostream& out) const {
+    const uint64_t frames = m_Frame - m_StatsStartFrame;
+    if (frames == 0) {
+        return;
+    }
+
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(2)
+        << "Dynamic resolution: " << m_ChangeCount << " scale changes over " << frames
+        << " frames, scale min " << m_LowestScale << ", mean " << m_ScaleSum / frames
+        << ", final " << m_Scale << std::endl;
+    out.flags(flags);
+    out.precision(precision);
+}
+
+} // namespace Rendering
+} // namespace ShadowEngine
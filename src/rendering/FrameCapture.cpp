@@ -0,0 +1,335 @@
+#include "rendering/FrameCapture.hpp"
+#include "rendering/RenderBackend.hpp"
+#include "rendering/Framebuffer.hpp"
+#include "rendering/GLStateCache.hpp"
+#include "rendering/GLDebugOutput.hpp"
+#include "core/ImageWriter.hpp"
+#include "core/Log.hpp"
+#include "core/MemoryTracker.hpp"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+
+namespace ShadowEngine {
+namespace Rendering {
+
+namespace {
+
+double SecondsSince(FrameCapture::Clock::time_point start) {
+    return std::chrono::duration<double>(FrameCapture::Clock::now() - start).count();
+}
+
+} // namespace
+
+const char* FrameCapture::GetFormatName(Format format) {
+    switch (format) {
+        case Format::PNG: return "png";
+        case Format::Raw: return "raw";
+    }
+    return "unknown";
+}
+
+bool FrameCapture::ParseFormat(const std::string& name, Format& outFormat) {
+    for (Format format : {Format::PNG, Format::Raw}) {
+        if (name == GetFormatName(format)) {
+            outFormat = format;
+            return true;
+        }
+    }
+    return false;
+}
+
+FrameCapture::FrameCapture()
+    : m_NextSlot(0)
+    , m_IsInitialized(false)
+    , m_Quit(false)
+    , m_RawWidth(0)
+    , m_RawHeight(0)
+{
+}
+
+FrameCapture::~FrameCapture() {
+    Shutdown();
+}
+
+bool FrameCapture::Initialize(const Settings& settings) {
+    if (m_IsInitialized) {
+        return true;
+    }
+    if (settings.readbackSlots <= 0 || settings.maxQueuedFrames <= 0 || settings.frameInterval <= 0) {
+        SHADOW_LOG_ERROR(Rendering, "FrameCapture: slot count, queue length and frame interval must be positive");
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(settings.directory, error);
+    if (error) {
+        SHADOW_LOG_ERROR(Rendering, "FrameCapture: cannot create {}: {}", settings.directory, error.message());
+        return false;
+    }
+
+    m_Settings = settings;
+    m_Slots.resize(static_cast<size_t>(settings.readbackSlots));
+    for (size_t i = 0; i < m_Slots.size(); ++i) {
+        glGenBuffers(1, &m_Slots[i].buffer);
+        // Buffers are sized on first use; binding once creates the object for labeling
+        GLStateCache::Get().BindBuffer(GL_PIXEL_PACK_BUFFER, m_Slots[i].buffer);
+        GLDebugOutput::Get().LabelObject(GL_BUFFER, m_Slots[i].buffer, "Capture readback " + std::to_string(i));
+    }
+    GLStateCache::Get().BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    m_NextSlot = 0;
+    m_Stats = Stats();
+    m_Quit = false;
+    m_Writer = std::thread(&FrameCapture::WriterLoop, this);
+    m_IsInitialized = true;
+
+    if (settings.frameInterval > 1) {
+        SHADOW_LOG_INFO(Rendering, "Capturing {} frames to {} every {} frames", GetFormatName(settings.format),
+                        settings.directory, settings.frameInterval);
+    } else {
+        SHADOW_LOG_INFO(Rendering, "Capturing {} frames to {}", GetFormatName(settings.format), settings.directory);
+    }
+    return true;
+}
+
+void FrameCapture::Shutdown() {
+    if (!m_IsInitialized) {
+        return;
+    }
+
+    // Collect every readback still in flight, then let the writer drain
+    Retire(true);
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Quit = true;
+    }
+    m_WorkAvailable.notify_one();
+    m_Writer.join();
+
+    for (Slot& slot : m_Slots) {
+        if (slot.fence) {
+            glDeleteSync(slot.fence);
+        }
+        GLStateCache::Get().DeleteBuffer(slot.buffer);
+        MemoryTracker::Remove(MemoryTag::Rendering, MemoryDomain::Gpu, slot.capacity);
+    }
+    m_Slots.clear();
+    m_FreeBuffers.clear();
+    m_RawFile.close();
+    m_RawWidth = 0;
+    m_RawHeight = 0;
+    m_IsInitialized = false;
+}
+
+void FrameCapture::Capture(const RenderTarget& source, uint64_t frame) {
+    if (!m_IsInitialized) {
+        return;
+    }
+
+    Retire(false);
+
+    if (frame % static_cast<uint64_t>(m_Settings.frameInterval) != 0) {
+        return;
+    }
+
+    // The slot to issue into is always the oldest; if its copy has not
+    // finished, every slot is busy and waiting would stall the frame
+    Slot& slot = m_Slots[m_NextSlot];
+    if (slot.fence) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        ++m_Stats.droppedReadback;
+        return;
+    }
+
+    const size_t bytes = static_cast<size_t>(source.width) * source.height * 4;
+    GLStateCache& state = GLStateCache::Get();
+    state.BindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    if (slot.capacity < bytes) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_READ);
+        MemoryTracker::Remove(MemoryTag::Rendering, MemoryDomain::Gpu, slot.capacity);
+        MemoryTracker::Add(MemoryTag::Rendering, MemoryDomain::Gpu, bytes);
+        slot.capacity = bytes;
+    }
+    state.BindFramebuffer(GL_READ_FRAMEBUFFER, source.framebuffer ? source.framebuffer->GetID() : 0);
+
+    // With a pack buffer bound this only queues the copy; the pointer is an offset
+    glReadPixels(0, 0, source.width, source.height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    state.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.frame = frame;
+    slot.width = source.width;
+    slot.height = source.height;
+    m_NextSlot = (m_NextSlot + 1) % m_Slots.size();
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_Stats.captured == 0) {
+        m_FirstCapture = Clock::now();
+    }
+    ++m_Stats.captured;
+    m_Stats.bytesRead += bytes;
+}
+
+void FrameCapture::Retire(bool wait) {
+    // Slots in flight follow m_NextSlot in issue order
+    for (size_t i = 0; i < m_Slots.size(); ++i) {
+        Slot& slot = m_Slots[(m_NextSlot + i) % m_Slots.size()];
+        if (!slot.fence) {
+            continue;
+        }
+
+        GLenum status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                         wait ? GL_TIMEOUT_IGNORED : 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+            if (status == GL_WAIT_FAILED) {
+                // Treat a lost fence as done; the data is likely garbage but the slot is usable
+                SHADOW_LOG_ERROR(Rendering, "FrameCapture: fence wait failed");
+            } else {
+                break;  // Later slots were issued later still
+            }
+        }
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+
+        const size_t bytes = static_cast<size_t>(slot.width) * slot.height * 4;
+        Job job;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (static_cast<int>(m_Jobs.size()) >= m_Settings.maxQueuedFrames) {
+                ++m_Stats.droppedWriter;
+                continue;
+            }
+            if (!m_FreeBuffers.empty()) {
+                job.pixels = std::move(m_FreeBuffers.back());
+                m_FreeBuffers.pop_back();
+            }
+        }
+
+        GLStateCache::Get().BindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+        const void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(bytes), GL_MAP_READ_BIT);
+        if (mapped) {
+            job.pixels.resize(bytes);
+            std::memcpy(job.pixels.data(), mapped, bytes);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        GLStateCache::Get().BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        if (!mapped) {
+            SHADOW_LOG_ERROR(Rendering, "FrameCapture: failed to map readback buffer");
+            continue;
+        }
+
+        job.frame = slot.frame;
+        job.width = slot.width;
+        job.height = slot.height;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Jobs.push_back(std::move(job));
+        }
+        m_WorkAvailable.notify_one();
+    }
+}
+
+void FrameCapture::WriterLoop() {
+    std::vector<unsigned char> encoded;
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    for (;;) {
+        m_WorkAvailable.wait(lock, [this] { return m_Quit || !m_Jobs.empty(); });
+        if (m_Jobs.empty()) {
+            break;  // Quit, and everything queued has been written
+        }
+
+        Job job = std::move(m_Jobs.front());
+        m_Jobs.pop_front();
+        lock.unlock();
+
+        Clock::time_point start = Clock::now();
+        const bool written = WriteJob(job, encoded);
+        const double seconds = SecondsSince(start);
+
+        lock.lock();
+        if (written) {
+            ++m_Stats.written;
+            m_Stats.bytesWritten += job.pixels.size();
+        }
+        m_Stats.writeSeconds += seconds;
+        m_FreeBuffers.push_back(std::move(job.pixels));
+    }
+}
+
+bool FrameCapture::WriteJob(Job& job, std::vector<unsigned char>& encoded) {
+    const std::filesystem::path directory(m_Settings.directory);
+
+    if (m_Settings.format == Format::PNG) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "frame_%06llu.png", static_cast<unsigned long long>(job.frame));
+        if (!ImageWriter::EncodePNG(job.pixels.data(), job.width, job.height, 4, true, encoded)) {
+            return false;
+        }
+        std::ofstream file(directory / name, std::ios::binary | std::ios::trunc);
+        if (!file.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()))) {
+            SHADOW_LOG_ERROR(Rendering, "FrameCapture: failed to write {}", (directory / name).string());
+            return false;
+        }
+        return true;
+    }
+
+    // Raw: one file per frame size, so every file is a uniform rawvideo stream
+    if (!m_RawFile.is_open() || job.width != m_RawWidth || job.height != m_RawHeight) {
+        m_RawFile.close();
+        char name[48];
+        std::snprintf(name, sizeof(name), "frames_%06llu_%dx%d.rgba",
+                      static_cast<unsigned long long>(job.frame), job.width, job.height);
+        m_RawFile.open(directory / name, std::ios::binary | std::ios::trunc);
+        if (!m_RawFile) {
+            SHADOW_LOG_ERROR(Rendering, "FrameCapture: failed to open {}", (directory / name).string());
+            return false;
+        }
+        m_RawWidth = job.width;
+        m_RawHeight = job.height;
+    }
+
+    const size_t rowBytes = static_cast<size_t>(job.width) * 4;
+    for (int y = job.height - 1; y >= 0; --y) {
+        m_RawFile.write(reinterpret_cast<const char*>(job.pixels.data() + y * rowBytes),
+                        static_cast<std::streamsize>(rowBytes));
+    }
+    return static_cast<bool>(m_RawFile);
+}
+
+FrameCapture::Stats FrameCapture::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    Stats stats = m_Stats;
+    if (stats.captured > 0) {
+        stats.elapsedSeconds = SecondsSince(m_FirstCapture);
+    }
+    return stats;
+}
+
+void FrameCapture::PrintSummary(std::ostream& out) const {
+    const Stats stats = GetStats();
+    const double megabyte = 1024.0 * 1024.0;
+
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(1);
+    out << "Frame capture (" << GetFormatName(m_Settings.format) << " to " << m_Settings.directory << "): "
+        << stats.written << " of " << stats.captured << " frames written, "
+        << stats.bytesWritten / megabyte << " MB";
+    if (stats.elapsedSeconds > 0.0) {
+        out << "; readback " << stats.bytesRead / megabyte / stats.elapsedSeconds << " MB/s";
+    }
+    if (stats.writeSeconds > 0.0) {
+        out << ", writer " << stats.bytesWritten / megabyte / stats.writeSeconds << " MB/s";
+    }
+    out << "; dropped " << stats.droppedReadback + stats.droppedWriter << " ("
+        << stats.droppedReadback << " waiting on the GPU, " << stats.droppedWriter << " writer behind)"
+        << std::endl;
+    out.flags(flags);
+    out.precision(precision);
+}
+
+} // namespace Rendering
+} // namespace ShadowEngine
@@ -0,0 +1,89 @@
+#include "rendering/FrameFences.hpp"
+#include "core/FrameStatistics.hpp"
+#include "core/Profiler.hpp"
+
+namespace ShadowEngine {
+namespace Rendering {
+
+FrameFences::FrameFences(int maxQueuedFrames)
+    : m_MaxQueuedFrames(maxQueuedFrames)
+{
+}
+
+FrameFences::~FrameFences() {
+    for (Pending& pending : m_Pending) {
+        glDeleteSync(pending.fence);
+        m_FreeQueries.push_back(pending.timestampQuery);
+    }
+    if (!m_FreeQueries.empty()) {
+        glDeleteQueries(static_cast<GLsizei>(m_FreeQueries.size()), m_FreeQueries.data());
+    }
+}
+
+void FrameFences::Insert(Clock::time_point inputTime) {
+    GLuint query = 0;
+    if (m_FreeQueries.empty()) {
+        glGenQueries(1, &query);
+    } else {
+        query = m_FreeQueries.back();
+        m_FreeQueries.pop_back();
+    }
+
+    glQueryCounter(query, GL_TIMESTAMP);
+    GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    if (!fence) {
+        m_FreeQueries.push_back(query);
+        return;
+    }
+    m_Pending.push_back(Pending{fence, query, inputTime});
+}
+
+void FrameFences::WaitForSlot(FrameStatistics* latencyOut) {
+    SHADOW_PROFILE_ZONE("FrameFences::WaitForSlot");
+    // Drop whatever has already finished without blocking
+    while (!m_Pending.empty()) {
+        GLenum status = glClientWaitSync(m_Pending.front().fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+            break;
+        }
+        Retire(latencyOut);
+    }
+
+    if (m_MaxQueuedFrames <= 0) {
+        return;
+    }
+
+    // Then block on the oldest frames until this one fits in the queue
+    while (static_cast<int>(m_Pending.size()) >= m_MaxQueuedFrames) {
+        GLenum status = glClientWaitSync(m_Pending.front().fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                         GL_TIMEOUT_IGNORED);
+        if (status == GL_WAIT_FAILED) {
+            break;
+        }
+        Retire(latencyOut);
+    }
+}
+
+void FrameFences::Retire(FrameStatistics* latencyOut) {
+    Pending& oldest = m_Pending.front();
+    if (latencyOut) {
+        // The fence has passed, so the timestamp is ready. Map GPU time onto the
+        // CPU clock by reading both clocks now; recalibrating on every retire
+        // keeps drift out of the measurement.
+        GLuint64 finishedNs = 0;
+        glGetQueryObjectui64v(oldest.timestampQuery, GL_QUERY_RESULT, &finishedNs);
+        GLint64 gpuNowNs = 0;
+        glGetInteger64v(GL_TIMESTAMP, &gpuNowNs);
+        Clock::time_point cpuNow = Clock::now();
+
+        auto sinceFinished = std::chrono::nanoseconds(gpuNowNs - static_cast<GLint64>(finishedNs));
+        Clock::time_point finished = cpuNow - std::chrono::duration_cast<Clock::duration>(sinceFinished);
+        latencyOut->AddSample(std::chrono::duration<double, std::milli>(finished - oldest.inputTime).count());
+    }
+    glDeleteSync(oldest.fence);
+    m_FreeQueries.push_back(oldest.timestampQuery);
+    m_Pending.erase(m_Pending.begin());
+}
+
+} // namespace Rendering
+} // namespace ShadowEngine
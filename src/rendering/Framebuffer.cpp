@@ -0,0 +1,92 @@
+#include "rendering/Framebuffer.hpp"
+#include "rendering/GLStateCache.hpp"
+#include "rendering/GLDebugOutput.hpp"
+#include "core/Log.hpp"
+#include "core/MemoryTracker.hpp"
+
+namespace ShadowEngine {
+namespace Rendering {
+
+Framebuffer::Framebuffer()
+    : m_FramebufferID(0)
+    , m_ColorTexture(0)
+    , m_DepthRenderbuffer(0)
+    , m_Width(0)
+    , m_Height(0)
+{
+}
+
+Framebuffer::~Framebuffer() {
+    Destroy();
+}
+
+bool Framebuffer::Create(int width, int height, const std::string& label) {
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+    Destroy();
+
+    GLStateCache& state = GLStateCache::Get();
+
+    glGenTextures(1, &m_ColorTexture);
+    state.BindTexture(0, GL_TEXTURE_2D, m_ColorTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+
+    glGenRenderbuffers(1, &m_DepthRenderbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_DepthRenderbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+
+    glGenFramebuffers(1, &m_FramebufferID);
+    state.BindFramebuffer(GL_FRAMEBUFFER, m_FramebufferID);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_ColorTexture, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_DepthRenderbuffer);
+
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        SHADOW_LOG_ERROR(Rendering, "Framebuffer incomplete (0x{:x})", status);
+        Destroy();
+        return false;
+    }
+
+    m_Width = width;
+    m_Height = height;
+    MemoryTracker::Add(MemoryTag::Rendering, MemoryDomain::Gpu, GetGpuBytes());
+
+    GLDebugOutput& debug = GLDebugOutput::Get();
+    debug.LabelObject(GL_FRAMEBUFFER, m_FramebufferID, label + " target");
+    debug.LabelObject(GL_TEXTURE, m_ColorTexture, label + " colour");
+    debug.LabelObject(GL_RENDERBUFFER, m_DepthRenderbuffer, label + " depth");
+    return true;
+}
+
+void Framebuffer::Destroy() {
+    MemoryTracker::Remove(MemoryTag::Rendering, MemoryDomain::Gpu, GetGpuBytes());
+    GLStateCache& state = GLStateCache::Get();
+    if (m_FramebufferID != 0) {
+        state.DeleteFramebuffer(m_FramebufferID);
+        m_FramebufferID = 0;
+    }
+    if (m_ColorTexture != 0) {
+        state.DeleteTexture(m_ColorTexture);
+        m_ColorTexture = 0;
+    }
+    if (m_DepthRenderbuffer != 0) {
+        GLDebugOutput::Get().ForgetObject(GL_RENDERBUFFER, m_DepthRenderbuffer);
+        glDeleteRenderbuffers(1, &m_DepthRenderbuffer);
+        m_DepthRenderbuffer = 0;
+    }
+    m_Width = 0;
+    m_Height = 0;
+}
+
+void Framebuffer::Bind() const {
+    GLStateCache::Get().BindFramebuffer(GL_FRAMEBUFFER, m_FramebufferID);
+}
+
+} // namespace Rendering
+} // namespace ShadowEngine
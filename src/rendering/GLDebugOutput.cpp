@@ -0,0 +1,328 @@
+#include "rendering/GLDebugOutput.hpp"
+#include "rendering/GLStateCache.hpp"
+#include "core/Log.hpp"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <sstream>
+#include <utility>
+
+namespace ShadowEngine {
+namespace Rendering {
+
+namespace {
+
+const char* SourceName(GLenum source) {
+    switch (source) {
+        case GL_DEBUG_SOURCE_API:             return "API";
+        case GL_DEBUG_SOURCE_WINDOW_SYSTEM:   return "Window";
+        case GL_DEBUG_SOURCE_SHADER_COMPILER: return "ShaderCompiler";
+        case GL_DEBUG_SOURCE_THIRD_PARTY:     return "ThirdParty";
+        case GL_DEBUG_SOURCE_APPLICATION:     return "Application";
+        default:                              return "Other";
+    }
+}
+
+const char* TypeName(GLenum type) {
+    switch (type) {
+        case GL_DEBUG_TYPE_ERROR:               return "Error";
+        case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return "Deprecated";
+        case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR:  return "Undefined";
+        case GL_DEBUG_TYPE_PORTABILITY:         return "Portability";
+        case GL_DEBUG_TYPE_PERFORMANCE:         return "Performance";
+        case GL_DEBUG_TYPE_MARKER:              return "Marker";
+        case GL_DEBUG_TYPE_PUSH_GROUP:          return "PushGroup";
+        case GL_DEBUG_TYPE_POP_GROUP:           return "PopGroup";
+        default:                                return "Other";
+    }
+}
+
+const char* SeverityName(GLenum severity) {
+    switch (severity) {
+        case GL_DEBUG_SEVERITY_HIGH:         return "high";
+        case GL_DEBUG_SEVERITY_MEDIUM:       return "medium";
+        case GL_DEBUG_SEVERITY_LOW:          return "low";
+        case GL_DEBUG_SEVERITY_NOTIFICATION: return "notification";
+        default:                             return "unknown";
+    }
+}
+
+} // namespace
+
+GLDebugOutput& GLDebugOutput::Get() {
+    static GLDebugOutput instance;
+    return instance;
+}
+
+bool GLDebugOutput::LoadExtensionEntryPoints(GLADloadproc loader) {
+    // glad was generated without extensions, so on pre-4.3 contexts the KHR_debug
+    // entry points have to be fetched by hand when the driver advertises them.
+    GLint extensionCount = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+
+    bool hasExtension = false;
+    for (GLint i = 0; i < extensionCount && !hasExtension; ++i) {
+        const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+        hasExtension = name && std::strcmp(name, "GL_KHR_debug") == 0;
+    }
+    if (!hasExtension || !loader) {
+        return false;
+    }
+
+    glad_glDebugMessageCallback = reinterpret_cast<PFNGLDEBUGMESSAGECALLBACKPROC>(loader("glDebugMessageCallback"));
+    glad_glDebugMessageControl = reinterpret_cast<PFNGLDEBUGMESSAGECONTROLPROC>(loader("glDebugMessageControl"));
+    glad_glObjectLabel = reinterpret_cast<PFNGLOBJECTLABELPROC>(loader("glObjectLabel"));
+    glad_glPushDebugGroup = reinterpret_cast<PFNGLPUSHDEBUGGROUPPROC>(loader("glPushDebugGroup"));
+    glad_glPopDebugGroup = reinterpret_cast<PFNGLPOPDEBUGGROUPPROC>(loader("glPopDebugGroup"));
+
+    return glDebugMessageCallback && glDebugMessageControl && glObjectLabel &&
+           glPushDebugGroup && glPopDebugGroup;
+}
+
+bool GLDebugOutput::Initialize(GLADloadproc loader) {
+    m_Available = false;
+
+    bool hasEntryPoints = glDebugMessageCallback && glDebugMessageControl && glObjectLabel &&
+                          glPushDebugGroup && glPopDebugGroup;
+    if (!hasEntryPoints && !LoadExtensionEntryPoints(loader)) {
+        SHADOW_LOG_INFO(Rendering, "KHR_debug not available; GL debug output disabled");
+        return false;
+    }
+
+    glEnable(GL_DEBUG_OUTPUT);
+    // Synchronous delivery runs the callback inside the offending GL call, which is
+    // what lets us attribute messages to the objects bound at that moment.
+    glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+    glDebugMessageCallback(&GLDebugOutput::MessageCallback, this);
+    glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_TRUE);
+
+    // Our own group push/pop notifications are noise
+    glDebugMessageControl(GL_DEBUG_SOURCE_APPLICATION, GL_DEBUG_TYPE_PUSH_GROUP, GL_DONT_CARE, 0, nullptr, GL_FALSE);
+    glDebugMessageControl(GL_DEBUG_SOURCE_APPLICATION, GL_DEBUG_TYPE_POP_GROUP, GL_DONT_CARE, 0, nullptr, GL_FALSE);
+
+    m_Available = true;
+
+    // Re-apply labels registered before the context supported them. GL is
+    // called outside the lock: with synchronous output, a label GL rejects
+    // runs HandleMessage on this thread, which takes the lock itself.
+    std::vector<std::pair<uint64_t, std::string>> labels;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        labels.assign(m_Labels.begin(), m_Labels.end());
+    }
+    for (const auto& entry : labels) {
+        GLenum identifier = static_cast<GLenum>(entry.first >> 32);
+        GLuint name = static_cast<GLuint>(entry.first & 0xFFFFFFFFu);
+        glObjectLabel(identifier, name, static_cast<GLsizei>(entry.second.size()), entry.second.c_str());
+    }
+    return true;
+}
+
+void GLDebugOutput::Shutdown() {
+    if (m_Available) {
+        glDebugMessageCallback(nullptr, nullptr);
+        glDisable(GL_DEBUG_OUTPUT);
+        m_Available = false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Labels.clear();
+    m_GroupStack.clear();
+}
+
+void GLDebugOutput::LabelObject(GLenum identifier, GLuint name, const std::string& label) {
+    if (name == 0) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Labels[MakeLabelKey(identifier, name)] = label;
+    }
+
+    if (m_Available) {
+        glObjectLabel(identifier, name, static_cast<GLsizei>(label.size()), label.c_str());
+    }
+}
+
+void GLDebugOutput::ForgetObject(GLenum identifier, GLuint name) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Labels.erase(MakeLabelKey(identifier, name));
+}
+
+std::string GLDebugOutput::GetLabel(GLenum identifier, GLuint name) const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = m_Labels.find(MakeLabelKey(identifier, name));
+    return it != m_Labels.end() ? it->second : std::string();
+}
+
+void GLDebugOutput::PushGroup(const char* name) {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_GroupStack.push_back(name);
+    }
+    if (m_Available) {
+        glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, name);
+    }
+}
+
+void GLDebugOutput::PopGroup() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (m_GroupStack.empty()) return;
+        m_GroupStack.pop_back();
+    }
+    if (m_Available) {
+        glPopDebugGroup();
+    }
+}
+
+GLDebugOutput::Counters GLDebugOutput::GetCounters() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Counters;
+}
+
+std::vector<GLDebugOutput::LogEntry> GLDebugOutput::GetLog() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::vector<LogEntry> entries;
+    entries.reserve(m_Log.size());
+    for (const auto& entry : m_Log) {
+        entries.push_back(entry.second);
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const LogEntry& a, const LogEntry& b) { return a.count > b.count; });
+    return entries;
+}
+
+void GLDebugOutput::PrintSummary() const {
+    Counters counters = GetCounters();
+    uint32_t total = counters.errors + counters.performance + counters.deprecated +
+                     counters.undefinedBehavior + counters.portability + counters.other;
+    if (total == 0) {
+        return;
+    }
+
+    // One message, so the table stays together
+    std::ostringstream summary;
+    summary << "GL debug output: " << counters.errors << " errors, "
+            << counters.performance << " performance, "
+            << counters.deprecated << " deprecated, "
+            << counters.undefinedBehavior << " undefined, "
+            << counters.portability << " portability, "
+            << counters.other << " other ("
+            << counters.duplicates << " duplicates folded)\n";
+
+    for (const LogEntry& entry : GetLog()) {
+        if (entry.type == GL_DEBUG_TYPE_OTHER && entry.severity == GL_DEBUG_SEVERITY_NOTIFICATION) {
+            continue;
+        }
+        summary << "  [" << TypeName(entry.type) << "/" << SeverityName(entry.severity)
+                << "] x" << entry.count << " id " << entry.id << ": " << entry.message;
+        if (!entry.attribution.empty()) {
+            summary << " (" << entry.attribution << ")";
+        }
+        summary << "\n";
+    }
+    SHADOW_LOG_INFO(Rendering, "{}", summary.str());
+}
+
+void APIENTRY GLDebugOutput::MessageCallback(GLenum source, GLenum type, GLuint id, GLenum severity,
+                                             GLsizei length, const GLchar* message, const void* userParam) {
+    auto* self = static_cast<GLDebugOutput*>(const_cast<void*>(userParam));
+    if (self) {
+        self->HandleMessage(source, type, id, severity, length, message);
+    }
+}
+
+std::string GLDebugOutput::DescribeBoundObjects() const {
+    // Called with m_Mutex held
+    const GLStateCache& state = GLStateCache::Get();
+    std::ostringstream out;
+    const char* separator = "";
+
+    if (!m_GroupStack.empty()) {
+        out << "pass '" << m_GroupStack.back() << "'";
+        separator = ", ";
+    }
+
+    // Every labelled object a draw, upload or readback could touch; buffer
+    // migrations and implicit syncs name the buffer or texture involved
+    auto describe = [&](const char* kind, GLenum identifier, GLuint name) {
+        auto it = m_Labels.find(MakeLabelKey(identifier, name));
+        if (it != m_Labels.end()) {
+            out << separator << kind << " '" << it->second << "'";
+            separator = ", ";
+        }
+    };
+    describe("program", GL_PROGRAM, state.GetBoundProgram());
+    describe("vao", GL_VERTEX_ARRAY, state.GetBoundVertexArray());
+    describe("array buffer", GL_BUFFER, state.GetBoundBuffer(GL_ARRAY_BUFFER));
+    describe("element buffer", GL_BUFFER, state.GetBoundBuffer(GL_ELEMENT_ARRAY_BUFFER));
+    describe("pixel pack buffer", GL_BUFFER, state.GetBoundBuffer(GL_PIXEL_PACK_BUFFER));
+    describe("pixel unpack buffer", GL_BUFFER, state.GetBoundBuffer(GL_PIXEL_UNPACK_BUFFER));
+    describe("texture", GL_TEXTURE, state.GetBoundTexture(GL_TEXTURE_2D));
+    describe("array texture", GL_TEXTURE, state.GetBoundTexture(GL_TEXTURE_2D_ARRAY));
+    describe("cube map", GL_TEXTURE, state.GetBoundTexture(GL_TEXTURE_CUBE_MAP));
+    describe("framebuffer", GL_FRAMEBUFFER, state.GetBoundDrawFramebuffer());
+    return out.str();
+}
+
+void GLDebugOutput::HandleMessage(GLenum source, GLenum type, GLuint id, GLenum severity,
+                                  GLsizei length, const GLchar* message) {
+    std::string text = length >= 0 ? std::string(message, static_cast<size_t>(length)) : std::string(message);
+    while (!text.empty() && (text.back() == '\n' || text.back() == '\r')) {
+        text.pop_back();
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    switch (type) {
+        case GL_DEBUG_TYPE_ERROR:               ++m_Counters.errors; break;
+        case GL_DEBUG_TYPE_PERFORMANCE:         ++m_Counters.performance; break;
+        case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: ++m_Counters.deprecated; break;
+        case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR:  ++m_Counters.undefinedBehavior; break;
+        case GL_DEBUG_TYPE_PORTABILITY:         ++m_Counters.portability; break;
+        default:                                ++m_Counters.other; break;
+    }
+
+    // Some drivers report every message with id 0, so the text is part of the
+    // key. Entries under the same hash are compared in full: a collision must
+    // not fold two different messages together.
+    std::string attribution = DescribeBoundObjects();
+    uint64_t key = std::hash<std::string>()(text) ^ (std::hash<std::string>()(attribution) << 1);
+    key ^= (static_cast<uint64_t>(source) << 48) ^ (static_cast<uint64_t>(type) << 32) ^ id;
+
+    auto range = m_Log.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        const LogEntry& existing = it->second;
+        if (existing.source == source && existing.type == type && existing.id == id &&
+            existing.message == text && existing.attribution == attribution) {
+            ++it->second.count;
+            ++m_Counters.duplicates;
+            return;
+        }
+    }
+
+    LogEntry& entry = m_Log.emplace(key, LogEntry())->second;
+    entry.source = source;
+    entry.type = type;
+    entry.severity = severity;
+    entry.id = id;
+    entry.message = text;
+    entry.attribution = attribution;
+    entry.count = 1;
+
+    // First occurrence of anything actionable is reported immediately
+    bool actionable = type == GL_DEBUG_TYPE_ERROR || type == GL_DEBUG_TYPE_PERFORMANCE ||
+                      type == GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR || severity == GL_DEBUG_SEVERITY_HIGH;
+    if (actionable) {
+        if (attribution.empty()) {
+            SHADOW_LOG_ERROR(Rendering, "GL {} {} ({}, id {}): {}", SourceName(source), TypeName(type),
+                             SeverityName(severity), id, text);
+        } else {
+            SHADOW_LOG_ERROR(Rendering, "GL {} {} ({}, id {}): {} [{}]", SourceName(source), TypeName(type),
+                             SeverityName(severity), id, text, attribution);
+        }
+    }
+}
+
+} // namespace Rendering
+} // namespace ShadowEngine
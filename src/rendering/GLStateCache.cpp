@@ -0,0 +1,530 @@
+#include "rendering/GLStateCache.hpp"
+#include "rendering/GLDebugOutput.hpp"
+#include "core/Log.hpp"
+
+namespace ShadowEngine {
+namespace Rendering {
+
+GLStateCache& GLStateCache::Get() {
+    static GLStateCache instance;
+    return instance;
+}
+
+GLStateCache::GLStateCache()
+#ifdef NDEBUG
+    : m_ValidationEnabled(false)
+#else
+    : m_ValidationEnabled(true)
+#endif
+    , m_TotalRedundant(0)
+    , m_TotalDesyncs(0)
+    , m_FrameCount(0)
+{
+    Reset();
+}
+
+void GLStateCache::Reset() {
+    m_Program = Unknown;
+    m_VertexArray = Unknown;
+    m_Buffers.fill(Unknown);
+    m_ActiveUnit = Unknown;
+    for (auto& unit : m_Textures) {
+        unit.fill(Unknown);
+    }
+    m_DrawFramebuffer = Unknown;
+    m_ReadFramebuffer = Unknown;
+    m_Capabilities.fill(-1);
+    m_BlendSrc = Unknown;
+    m_BlendDst = Unknown;
+    m_DepthFunc = Unknown;
+    m_DepthMask = -1;
+    m_CullFace = Unknown;
+    m_ViewportKnown = false;
+    m_ClearColorKnown = false;
+}
+
+void GLStateCache::BeginFrame() {
+    if (m_ValidationEnabled) {
+        Validate();
+    }
+
+    m_LastFrame = m_Frame;
+    m_TotalRedundant += m_Frame.redundantCalls;
+    m_TotalDesyncs += m_Frame.desyncs;
+    m_Frame = FrameStats();
+    ++m_FrameCount;
+}
+
+void GLStateCache::ResetStats() {
+    m_Frame = FrameStats();
+    m_LastFrame = FrameStats();
+    m_TotalRedundant = 0;
+    m_TotalDesyncs = 0;
+    m_FrameCount = 0;
+}
+
+// ---------------------------------------------------------------------------
+// Object bindings
+// ---------------------------------------------------------------------------
+
+void GLStateCache::UseProgram(GLuint program) {
+    if (m_Program == program) {
+        CountRedundant();
+        return;
+    }
+    glUseProgram(program);
+    m_Program = program;
+    CountIssued();
+
+    if (m_ValidationEnabled) {
+        CheckBinding("program", GL_CURRENT_PROGRAM, m_Program);
+    }
+}
+
+void GLStateCache::BindVertexArray(GLuint vao) {
+    if (m_VertexArray == vao) {
+        CountRedundant();
+        return;
+    }
+    glBindVertexArray(vao);
+    m_VertexArray = vao;
+    CountIssued();
+
+    // The element array binding is VAO state, so it changes with the VAO
+    m_Buffers[ElementArrayBufferSlot] = Unknown;
+
+    if (m_ValidationEnabled) {
+        CheckBinding("vertex array", GL_VERTEX_ARRAY_BINDING, m_VertexArray);
+    }
+}
+
+void GLStateCache::BindBuffer(GLenum target, GLuint buffer) {
+    int slot = BufferSlotFor(target);
+    if (slot < 0) {
+        // Target not tracked by the cache; forward unconditionally
+        glBindBuffer(target, buffer);
+        CountIssued();
+        return;
+    }
+
+    if (m_Buffers[slot] == buffer) {
+        CountRedundant();
+        return;
+    }
+    glBindBuffer(target, buffer);
+    m_Buffers[slot] = buffer;
+    CountIssued();
+
+    if (m_ValidationEnabled) {
+        CheckBinding("buffer", BufferBindingQuery(slot), buffer);
+    }
+}
+
+void GLStateCache::ActivateUnit(GLuint unit) {
+    if (m_ActiveUnit == unit) {
+        return;
+    }
+    glActiveTexture(GL_TEXTURE0 + unit);
+    m_ActiveUnit = unit;
+    CountIssued();
+}
+
+void GLStateCache::BindTexture(GLuint unit, GLenum target, GLuint texture) {
+    int slot = TextureSlotFor(target);
+    if (slot < 0 || unit >= static_cast<GLuint>(MaxTextureUnits)) {
+        ActivateUnit(unit);
+        glBindTexture(target, texture);
+        CountIssued();
+        return;
+    }
+
+    if (m_Textures[unit][slot] == texture) {
+        CountRedundant();
+        return;
+    }
+    ActivateUnit(unit);
+    glBindTexture(target, texture);
+    m_Textures[unit][slot] = texture;
+    CountIssued();
+
+    if (m_ValidationEnabled) {
+        CheckBinding("texture", TextureBindingQuery(slot), texture);
+    }
+}
+
+void GLStateCache::BindFramebuffer(GLenum target, GLuint framebuffer) {
+    bool draw = (target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER);
+    bool read = (target == GL_FRAMEBUFFER || target == GL_READ_FRAMEBUFFER);
+
+    if ((!draw || m_DrawFramebuffer == framebuffer) &&
+        (!read || m_ReadFramebuffer == framebuffer)) {
+        CountRedundant();
+        return;
+    }
+    glBindFramebuffer(target, framebuffer);
+    if (draw) m_DrawFramebuffer = framebuffer;
+    if (read) m_ReadFramebuffer = framebuffer;
+    CountIssued();
+
+    if (m_ValidationEnabled) {
+        if (draw) CheckBinding("draw framebuffer", GL_DRAW_FRAMEBUFFER_BINDING, framebuffer);
+        if (read) CheckBinding("read framebuffer", GL_READ_FRAMEBUFFER_BINDING, framebuffer);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Fixed-function state
+// ---------------------------------------------------------------------------
+
+void GLStateCache::SetCapability(GLenum cap, bool enabled) {
+    int slot = CapabilitySlotFor(cap);
+    int8_t value = enabled ? 1 : 0;
+
+    if (slot >= 0 && m_Capabilities[slot] == value) {
+        CountRedundant();
+        return;
+    }
+
+    if (enabled) {
+        glEnable(cap);
+    } else {
+        glDisable(cap);
+    }
+    CountIssued();
+
+    if (slot >= 0) {
+        m_Capabilities[slot] = value;
+        if (m_ValidationEnabled && (glIsEnabled(cap) == GL_TRUE) != enabled) {
+            SHADOW_LOG_ERROR(Rendering, "GLStateCache desync: capability 0x{:x} expected {}", cap,
+                             enabled ? "enabled" : "disabled");
+            ++m_Frame.desyncs;
+        }
+    }
+}
+
+void GLStateCache::BlendFunc(GLenum srcFactor, GLenum dstFactor) {
+    if (m_BlendSrc == srcFactor && m_BlendDst == dstFactor) {
+        CountRedundant();
+        return;
+    }
+    glBlendFunc(srcFactor, dstFactor);
+    m_BlendSrc = srcFactor;
+    m_BlendDst = dstFactor;
+    CountIssued();
+
+    if (m_ValidationEnabled) {
+        CheckBinding("blend src", GL_BLEND_SRC_RGB, srcFactor);
+        CheckBinding("blend dst", GL_BLEND_DST_RGB, dstFactor);
+    }
+}
+
+void GLStateCache::DepthFunc(GLenum func) {
+    if (m_DepthFunc == func) {
+        CountRedundant();
+        return;
+    }
+    glDepthFunc(func);
+    m_DepthFunc = func;
+    CountIssued();
+
+    if (m_ValidationEnabled) {
+        CheckBinding("depth func", GL_DEPTH_FUNC, func);
+    }
+}
+
+void GLStateCache::DepthMask(bool enabled) {
+    int8_t value = enabled ? 1 : 0;
+    if (m_DepthMask == value) {
+        CountRedundant();
+        return;
+    }
+    glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+    m_DepthMask = value;
+    CountIssued();
+}
+
+void GLStateCache::CullFace(GLenum mode) {
+    if (m_CullFace == mode) {
+        CountRedundant();
+        return;
+    }
+    glCullFace(mode);
+    m_CullFace = mode;
+    CountIssued();
+
+    if (m_ValidationEnabled) {
+        CheckBinding("cull face", GL_CULL_FACE_MODE, mode);
+    }
+}
+
+void GLStateCache::Viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    if (m_ViewportKnown &&
+        m_Viewport[0] == x && m_Viewport[1] == y &&
+        m_Viewport[2] == width && m_Viewport[3] == height) {
+        CountRedundant();
+        return;
+    }
+    glViewport(x, y, width, height);
+    m_Viewport = {x, y, width, height};
+    m_ViewportKnown = true;
+    CountIssued();
+}
+
+void GLStateCache::ClearColor(float r, float g, float b, float a) {
+    if (m_ClearColorKnown &&
+        m_ClearColor[0] == r && m_ClearColor[1] == g &&
+        m_ClearColor[2] == b && m_ClearColor[3] == a) {
+        CountRedundant();
+        return;
+    }
+    glClearColor(r, g, b, a);
+    m_ClearColor = {r, g, b, a};
+    m_ClearColorKnown = true;
+    CountIssued();
+
+    if (m_ValidationEnabled) {
+        CheckClearColor();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Deletion
+// ---------------------------------------------------------------------------
+
+void GLStateCache::DeleteProgram(GLuint program) {
+    if (program == 0) return;
+    glDeleteProgram(program);
+    GLDebugOutput::Get().ForgetObject(GL_PROGRAM, program);
+    // A program deleted while current stays in use until unbound, so only the
+    // name may be reused later; force the next UseProgram through.
+    if (m_Program == program) {
+        m_Program = Unknown;
+    }
+}
+
+void GLStateCache::DeleteVertexArray(GLuint vao) {
+    if (vao == 0) return;
+    glDeleteVertexArrays(1, &vao);
+    GLDebugOutput::Get().ForgetObject(GL_VERTEX_ARRAY, vao);
+    if (m_VertexArray == vao) {
+        m_VertexArray = 0;
+        m_Buffers[ElementArrayBufferSlot] = Unknown;
+    }
+}
+
+void GLStateCache::DeleteBuffer(GLuint buffer) {
+    if (buffer == 0) return;
+    glDeleteBuffers(1, &buffer);
+    GLDebugOutput::Get().ForgetObject(GL_BUFFER, buffer);
+    for (auto& bound : m_Buffers) {
+        if (bound == buffer) {
+            bound = 0;
+        }
+    }
+}
+
+void GLStateCache::DeleteTexture(GLuint texture) {
+    if (texture == 0) return;
+    glDeleteTextures(1, &texture);
+    GLDebugOutput::Get().ForgetObject(GL_TEXTURE, texture);
+    for (auto& unit : m_Textures) {
+        for (auto& bound : unit) {
+            if (bound == texture) {
+                bound = 0;
+            }
+        }
+    }
+}
+
+void GLStateCache::DeleteFramebuffer(GLuint framebuffer) {
+    if (framebuffer == 0) return;
+    glDeleteFramebuffers(1, &framebuffer);
+    GLDebugOutput::Get().ForgetObject(GL_FRAMEBUFFER, framebuffer);
+    if (m_DrawFramebuffer == framebuffer) m_DrawFramebuffer = 0;
+    if (m_ReadFramebuffer == framebuffer) m_ReadFramebuffer = 0;
+}
+
+// ---------------------------------------------------------------------------
+// Validation
+// ---------------------------------------------------------------------------
+
+void GLStateCache::CheckBinding(const char* what, GLenum query, GLuint expected) {
+    GLint actual = 0;
+    glGetIntegerv(query, &actual);
+    if (static_cast<GLuint>(actual) != expected) {
+        SHADOW_LOG_ERROR(Rendering, "GLStateCache desync: {} cached {} but GL reports {}", what, expected, actual);
+        ++m_Frame.desyncs;
+    }
+}
+
+void GLStateCache::CheckClearColor() {
+    GLfloat actual[4];
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, actual);
+    for (int i = 0; i < 4; ++i) {
+        if (actual[i] != m_ClearColor[i]) {
+            SHADOW_LOG_ERROR(Rendering, "GLStateCache desync: clear colour cached ({}, {}, {}, {}) but GL reports "
+                             "({}, {}, {}, {})", m_ClearColor[0], m_ClearColor[1], m_ClearColor[2], m_ClearColor[3],
+                             actual[0], actual[1], actual[2], actual[3]);
+            ++m_Frame.desyncs;
+            return;
+        }
+    }
+}
+
+bool GLStateCache::Validate() {
+    uint32_t before = m_Frame.desyncs;
+
+    if (m_Program != Unknown) CheckBinding("program", GL_CURRENT_PROGRAM, m_Program);
+    if (m_VertexArray != Unknown) CheckBinding("vertex array", GL_VERTEX_ARRAY_BINDING, m_VertexArray);
+
+    for (int slot = 0; slot < BufferSlotCount; ++slot) {
+        if (m_Buffers[slot] != Unknown) {
+            CheckBinding("buffer", BufferBindingQuery(slot), m_Buffers[slot]);
+        }
+    }
+
+    if (m_ActiveUnit != Unknown) {
+        CheckBinding("active texture", GL_ACTIVE_TEXTURE, GL_TEXTURE0 + m_ActiveUnit);
+    }
+
+    // Texture bindings can only be queried for the active unit; walk the units
+    // and restore the active one afterwards (validation is a debug-only path).
+    GLint activeUnit = 0;
+    glGetIntegerv(GL_ACTIVE_TEXTURE, &activeUnit);
+    for (int unit = 0; unit < MaxTextureUnits; ++unit) {
+        for (int slot = 0; slot < TextureSlotCount; ++slot) {
+            if (m_Textures[unit][slot] == Unknown) continue;
+            glActiveTexture(GL_TEXTURE0 + unit);
+            CheckBinding("texture", TextureBindingQuery(slot), m_Textures[unit][slot]);
+        }
+    }
+    glActiveTexture(static_cast<GLenum>(activeUnit));
+
+    if (m_DrawFramebuffer != Unknown) {
+        CheckBinding("draw framebuffer", GL_DRAW_FRAMEBUFFER_BINDING, m_DrawFramebuffer);
+    }
+    if (m_ReadFramebuffer != Unknown) {
+        CheckBinding("read framebuffer", GL_READ_FRAMEBUFFER_BINDING, m_ReadFramebuffer);
+    }
+
+    static const GLenum capabilities[CapabilitySlotCount] = {
+        GL_DEPTH_TEST, GL_BLEND, GL_CULL_FACE, GL_SCISSOR_TEST, GL_STENCIL_TEST, GL_FRAMEBUFFER_SRGB
+    };
+    for (int slot = 0; slot < CapabilitySlotCount; ++slot) {
+        if (m_Capabilities[slot] < 0) continue;
+        bool enabled = glIsEnabled(capabilities[slot]) == GL_TRUE;
+        if (enabled != (m_Capabilities[slot] == 1)) {
+            SHADOW_LOG_ERROR(Rendering, "GLStateCache desync: capability 0x{:x} cached {} but GL reports {}",
+                             capabilities[slot], static_cast<int>(m_Capabilities[slot]), enabled);
+            ++m_Frame.desyncs;
+        }
+    }
+
+    if (m_BlendSrc != Unknown) CheckBinding("blend src", GL_BLEND_SRC_RGB, m_BlendSrc);
+    if (m_BlendDst != Unknown) CheckBinding("blend dst", GL_BLEND_DST_RGB, m_BlendDst);
+    if (m_DepthFunc != Unknown) CheckBinding("depth func", GL_DEPTH_FUNC, m_DepthFunc);
+    if (m_CullFace != Unknown) CheckBinding("cull face", GL_CULL_FACE_MODE, m_CullFace);
+
+    if (m_DepthMask >= 0) {
+        GLboolean mask = GL_FALSE;
+        glGetBooleanv(GL_DEPTH_WRITEMASK, &mask);
+        if ((mask == GL_TRUE) != (m_DepthMask == 1)) {
+            SHADOW_LOG_ERROR(Rendering, "GLStateCache desync: depth mask");
+            ++m_Frame.desyncs;
+        }
+    }
+
+    if (m_ViewportKnown) {
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        for (int i = 0; i < 4; ++i) {
+            if (viewport[i] != m_Viewport[i]) {
+                SHADOW_LOG_ERROR(Rendering, "GLStateCache desync: viewport");
+                ++m_Frame.desyncs;
+                break;
+            }
+        }
+    }
+
+    if (m_ClearColorKnown) {
+        CheckClearColor();
+    }
+
+    return m_Frame.desyncs == before;
+}
+
+// ---------------------------------------------------------------------------
+// Slot lookup
+// ---------------------------------------------------------------------------
+
+GLuint GLStateCache::GetBoundBuffer(GLenum target) const {
+    const int slot = BufferSlotFor(target);
+    return slot >= 0 ? Known(m_Buffers[slot]) : 0;
+}
+
+GLuint GLStateCache::GetBoundTexture(GLenum target) const {
+    const int slot = TextureSlotFor(target);
+    if (slot < 0 || m_ActiveUnit == Unknown || m_ActiveUnit >= MaxTextureUnits) {
+        return 0;
+    }
+    return Known(m_Textures[m_ActiveUnit][slot]);
+}
+
+int GLStateCache::BufferSlotFor(GLenum target) {
+    switch (target) {
+        case GL_ARRAY_BUFFER:         return ArrayBufferSlot;
+        case GL_ELEMENT_ARRAY_BUFFER: return ElementArrayBufferSlot;
+        case GL_PIXEL_PACK_BUFFER:    return PixelPackBufferSlot;
+        case GL_PIXEL_UNPACK_BUFFER:  return PixelUnpackBufferSlot;
+        case GL_UNIFORM_BUFFER:       return UniformBufferSlot;
+        case GL_COPY_READ_BUFFER:     return CopyReadBufferSlot;
+        case GL_COPY_WRITE_BUFFER:    return CopyWriteBufferSlot;
+        default:                      return -1;
+    }
+}
+
+GLenum GLStateCache::BufferBindingQuery(int slot) {
+    switch (slot) {
+        case ArrayBufferSlot:         return GL_ARRAY_BUFFER_BINDING;
+        case ElementArrayBufferSlot:  return GL_ELEMENT_ARRAY_BUFFER_BINDING;
+        case PixelPackBufferSlot:     return GL_PIXEL_PACK_BUFFER_BINDING;
+        case PixelUnpackBufferSlot:   return GL_PIXEL_UNPACK_BUFFER_BINDING;
+        case UniformBufferSlot:       return GL_UNIFORM_BUFFER_BINDING;
+        case CopyReadBufferSlot:      return GL_COPY_READ_BUFFER_BINDING;
+        case CopyWriteBufferSlot:     return GL_COPY_WRITE_BUFFER_BINDING;
+        default:                      return 0;
+    }
+}
+
+int GLStateCache::TextureSlotFor(GLenum target) {
+    switch (target) {
+        case GL_TEXTURE_2D:       return Texture2DSlot;
+        case GL_TEXTURE_2D_ARRAY: return Texture2DArraySlot;
+        case GL_TEXTURE_CUBE_MAP: return TextureCubeMapSlot;
+        default:                  return -1;
+    }
+}
+
+GLenum GLStateCache::TextureBindingQuery(int slot) {
+    switch (slot) {
+        case Texture2DSlot:      return GL_TEXTURE_BINDING_2D;
+        case Texture2DArraySlot: return GL_TEXTURE_BINDING_2D_ARRAY;
+        case TextureCubeMapSlot: return GL_TEXTURE_BINDING_CUBE_MAP;
+        default:                 return 0;
+    }
+}
+
+int GLStateCache::CapabilitySlotFor(GLenum cap) {
+    switch (cap) {
+        case GL_DEPTH_TEST:        return DepthTestSlot;
+        case GL_BLEND:             return BlendSlot;
+        case GL_CULL_FACE:         return CullFaceSlot;
+        case GL_SCISSOR_TEST:      return ScissorTestSlot;
+        case GL_STENCIL_TEST:      return StencilTestSlot;
+        case GL_FRAMEBUFFER_SRGB:  return FramebufferSRGBSlot;
+        default:                   return -1;
+    }
+}
+
+} // namespace Rendering
+} // namespace ShadowEngine
@@ -0,0 +1,80 @@
+#include "rendering/GPUTimer.hpp"
+
+namespace ShadowEngine {
+namespace Rendering {
+
+GPUTimer::GPUTimer()
+    : m_Queries{}
+    , m_Oldest(0)
+    , m_Pending(0)
+    , m_Active(false)
+    , m_Primed(false)
+{
+}
+
+GPUTimer::~GPUTimer() {
+    Shutdown();
+}
+
+bool GPUTimer::Initialize() {
+    Shutdown();
+    glGenQueries(QueryCount, m_Queries);
+    return m_Queries[0] != 0;
+}
+
+void GPUTimer::Shutdown() {
+    if (m_Queries[0] != 0) {
+        glDeleteQueries(QueryCount, m_Queries);
+        for (GLuint& query : m_Queries) {
+            query = 0;
+        }
+    }
+    m_Oldest = 0;
+    m_Pending = 0;
+    m_Active = false;
+    m_Primed = false;
+}
+
+void GPUTimer::Begin() {
+    if (m_Queries[0] == 0 || m_Pending == QueryCount) {
+        return;
+    }
+    glBeginQuery(GL_TIME_ELAPSED, m_Queries[(m_Oldest + m_Pending) % QueryCount]);
+    m_Active = true;
+}
+
+void GPUTimer::End() {
+    if (!m_Active) {
+        return;
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    m_Active = false;
+    ++m_Pending;
+}
+
+bool GPUTimer::Poll(double& outMilliseconds) {
+    while (m_Pending > 0) {
+        GLuint query = m_Queries[m_Oldest];
+        GLint available = 0;
+        glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            return false;
+        }
+
+        GLuint64 nanoseconds = 0;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds);
+        m_Oldest = (m_Oldest + 1) % QueryCount;
+        --m_Pending;
+
+        if (!m_Primed) {
+            m_Primed = true;
+            continue;
+        }
+        outMilliseconds = static_cast<double>(nanoseconds) / 1.0e6;
+        return true;
+    }
+    return false;
+}
+
+} // namespace Rendering
+} // namespace ShadowEngine
@@ -0,0 +1,32 @@
+#include "rendering/Material.hpp"
+#include "rendering/Shader.hpp"
+#include "rendering/Texture.hpp"
+#include <string>
+#include <utility>
+
+namespace ShadowEngine {
+namespace Rendering {
+
+Material::Material(const std::string& name, std::shared_ptr<Shader> shader,
+                   std::vector<std::shared_ptr<Texture>> textures)
+    : m_Name(name)
+    , m_Shader(std::move(shader))
+    , m_Textures(std::move(textures)) {
+}
+
+void Material::Bind() const {
+    if (m_Shader) {
+        m_Shader->Use();
+    }
+    for (size_t i = 0; i < m_Textures.size(); ++i) {
+        if (m_Textures[i]) {
+            m_Textures[i]->Bind(static_cast<GLuint>(i));
+            if (m_Shader) {
+                m_Shader->SetUniform("uTexture" + std::to_string(i), static_cast<int>(i));
+            }
+        }
+    }
+}
+
+} // namespace Rendering
+} // namespace ShadowEngine
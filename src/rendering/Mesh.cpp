@@ -1,36 +1,61 @@
 #include "rendering/Mesh.hpp"
 #include "rendering/Shader.hpp"
+#include "rendering/GLStateCache.hpp"
+#include "rendering/GLDebugOutput.hpp"
+#include "core/MemoryTracker.hpp"
+#include <algorithm>
+#include <cmath>
+#include <string>
 #include <iostream>
 
 namespace ShadowEngine {
 namespace Rendering {
 
-Mesh::Mesh() : m_VAO(0), m_VBO(0), m_EBO(0), m_IndexCount(0) {}
+Mesh::Mesh()
+    : m_VAO(0), m_VBO(0), m_EBO(0), m_GpuBytes(0), m_IndexCount(0)
+    , m_BoundsCenter{0.0f, 0.0f, 0.0f}, m_BoundsRadius(0.0f)
+{
+    static uint32_t s_NextID = 0;
+    m_ID = s_NextID++;
+}
 
 Mesh::~Mesh() {
     Cleanup();
 }
 
 bool Mesh::Initialize(const std::vector<float>& vertices, 
-                     const std::vector<unsigned int>& indices) {
+                     const std::vector<unsigned int>& indices,
+                     bool createGPUBuffers) {
     m_IndexCount = indices.size();
+    m_Vertices = vertices;
+    m_Indices = indices;
+    ComputeBounds();
+
+    if (!createGPUBuffers) {
+        return true;
+    }
     
     // Generate buffers
     glGenVertexArrays(1, &m_VAO);
     glGenBuffers(1, &m_VBO);
     glGenBuffers(1, &m_EBO);
     
+    GLStateCache& state = GLStateCache::Get();
+
     // Bind VAO first
-    glBindVertexArray(m_VAO);
+    state.BindVertexArray(m_VAO);
     
     // Bind and set vertex buffer
-    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    state.BindBuffer(GL_ARRAY_BUFFER, m_VBO);
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
     
     // Bind and set index buffer
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+    state.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), 
                 indices.data(), GL_STATIC_DRAW);
+
+    m_GpuBytes = vertices.size() * sizeof(float) + indices.size() * sizeof(unsigned int);
+    MemoryTracker::Add(MemoryTag::Assets, MemoryDomain::Gpu, m_GpuBytes);
     
     // Position attribute
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
@@ -41,8 +66,15 @@ bool Mesh::Initialize(const std::vector<float>& vertices,
                          (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
     
-    // Unbind VAO
-    glBindVertexArray(0);
+    // Unbind VAO so later element buffer binds cannot leak into it
+    state.BindVertexArray(0);
+
+    // Label the objects so driver messages can be traced back to this mesh
+    std::string label = "Mesh#" + std::to_string(m_ID + 1);
+    GLDebugOutput& debug = GLDebugOutput::Get();
+    debug.LabelObject(GL_VERTEX_ARRAY, m_VAO, label);
+    debug.LabelObject(GL_BUFFER, m_VBO, label + " vertices");
+    debug.LabelObject(GL_BUFFER, m_EBO, label + " indices");
     
     return true;
 }
@@ -52,24 +84,55 @@ void Mesh::Render(const std::shared_ptr<Shader>& shader) {
         shader->Use();
     }
     
-    glBindVertexArray(m_VAO);
+    GLStateCache::Get().BindVertexArray(m_VAO);
     glDrawElements(GL_TRIANGLES, m_IndexCount, GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
+}
+
+void Mesh::ComputeBounds() {
+    // Sphere around the AABB centre: not minimal, but cheap and stable
+    const size_t vertexCount = m_Vertices.size() / 6;
+    if (vertexCount == 0) {
+        return;
+    }
+
+    float minimum[3] = {m_Vertices[0], m_Vertices[1], m_Vertices[2]};
+    float maximum[3] = {m_Vertices[0], m_Vertices[1], m_Vertices[2]};
+    for (size_t v = 1; v < vertexCount; ++v) {
+        for (int axis = 0; axis < 3; ++axis) {
+            minimum[axis] = std::min(minimum[axis], m_Vertices[v * 6 + axis]);
+            maximum[axis] = std::max(maximum[axis], m_Vertices[v * 6 + axis]);
+        }
+    }
+    for (int axis = 0; axis < 3; ++axis) {
+        m_BoundsCenter[axis] = 0.5f * (minimum[axis] + maximum[axis]);
+    }
+
+    float radiusSquared = 0.0f;
+    for (size_t v = 0; v < vertexCount; ++v) {
+        float dx = m_Vertices[v * 6 + 0] - m_BoundsCenter[0];
+        float dy = m_Vertices[v * 6 + 1] - m_BoundsCenter[1];
+        float dz = m_Vertices[v * 6 + 2] - m_BoundsCenter[2];
+        radiusSquared = std::max(radiusSquared, dx * dx + dy * dy + dz * dz);
+    }
+    m_BoundsRadius = std::sqrt(radiusSquared);
 }
 
 void Mesh::Cleanup() {
+    GLStateCache& state = GLStateCache::Get();
     if (m_VAO != 0) {
-        glDeleteVertexArrays(1, &m_VAO);
+        state.DeleteVertexArray(m_VAO);
         m_VAO = 0;
     }
     if (m_VBO != 0) {
-        glDeleteBuffers(1, &m_VBO);
+        state.DeleteBuffer(m_VBO);
         m_VBO = 0;
     }
     if (m_EBO != 0) {
-        glDeleteBuffers(1, &m_EBO);
+        state.DeleteBuffer(m_EBO);
         m_EBO = 0;
     }
+    MemoryTracker::Remove(MemoryTag::Assets, MemoryDomain::Gpu, m_GpuBytes);
+    m_GpuBytes = 0;
 }
 
 } // namespace Rendering
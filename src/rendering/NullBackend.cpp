@@ -0,0 +1,18 @@
+#include "rendering/NullBackend.hpp"
+#include "rendering/RenderQueue.hpp"
+#include "rendering/Mesh.hpp"
+
+namespace ShadowEngine {
+namespace Rendering {
+
+void NullBackend::Execute(const RenderQueue& queue, const RenderTarget& /*target*/) {
+    // Walk the packets like a real backend would, minus the driver calls
+    m_Stats = FrameStats();
+    for (const DrawPacket& packet : queue.GetPackets()) {
+        ++m_Stats.draws;
+        m_Stats.triangles += packet.mesh->GetIndexCount() / 3;
+    }
+}
+
+} // namespace Rendering
+} // namespace ShadowEngine
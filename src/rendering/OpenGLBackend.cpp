@@ -0,0 +1,72 @@
+#include "rendering/OpenGLBackend.hpp"
+#include "rendering/RenderQueue.hpp"
+#include "rendering/Framebuffer.hpp"
+#include "rendering/Material.hpp"
+#include "rendering/Mesh.hpp"
+#include "rendering/Shader.hpp"
+#include "rendering/GLStateCache.hpp"
+#include "rendering/GLDebugOutput.hpp"
+#include "core/Profiler.hpp"
+
+namespace ShadowEngine {
+namespace Rendering {
+
+void OpenGLBackend::Execute(const RenderQueue& queue, const RenderTarget& target) {
+    SHADOW_PROFILE_ZONE("OpenGLBackend::Execute");
+    GLStateCache& state = GLStateCache::Get();
+    if (target.framebuffer) {
+        target.framebuffer->Bind();
+    } else {
+        state.BindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+    state.Viewport(0, 0, target.width, target.height);
+
+    // Clear the screen. A target smaller than its framebuffer (dynamic
+    // resolution) clears only the part it renders to.
+    const bool partial = target.framebuffer && (target.width < target.framebuffer->GetWidth() ||
+                                                 target.height < target.framebuffer->GetHeight());
+    if (partial) {
+        state.Enable(GL_SCISSOR_TEST);
+        glScissor(0, 0, target.width, target.height);
+    }
+    state.ClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    if (partial) {
+        state.Disable(GL_SCISSOR_TEST);
+    }
+
+    ScopedDebugGroup scenePass("Scene");
+    const std::vector<DrawPacket>& packets = queue.GetPackets();
+    const std::vector<PerDrawUniforms>& uniforms = queue.GetUniforms();
+    Shader* currentShader = nullptr;
+    const Material* currentMaterial = nullptr;
+    for (size_t i = 0; i < packets.size(); ++i) {
+        const DrawPacket& packet = packets[i];
+
+        // Packets are sorted by shader, so camera uniforms change rarely
+        if (packet.shader != currentShader) {
+            currentShader = packet.shader;
+            currentShader->Use();
+            currentShader->SetUniform("projection", queue.GetProjection().GetData());
+            currentShader->SetUniform("view", queue.GetView().GetData());
+        }
+        // Textures stay bound across packets without a material; the state
+        // cache filters rebinding the ones a material shares with the last
+        if (packet.material && packet.material != currentMaterial) {
+            currentMaterial = packet.material;
+            currentMaterial->Bind();
+        }
+        currentShader->SetUniform("model", uniforms[i].model);
+
+        packet.mesh->Render(nullptr);
+    }
+
+    // Note: buffer swapping is handled by the window/engine main loop.
+}
+
+void OpenGLBackend::Finish() {
+    glFinish();
+}
+
+} // namespace Rendering
+} // namespace ShadowEngine
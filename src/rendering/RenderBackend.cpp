@@ -0,0 +1,42 @@
+#include "rendering/RenderBackend.hpp"
+#include "rendering/OpenGLBackend.hpp"
+#include "rendering/SoftwareBackend.hpp"
+#include "rendering/NullBackend.hpp"
+
+namespace ShadowEngine {
+namespace Rendering {
+
+const char* GetBackendName(BackendType type) {
+    switch (type) {
+        case BackendType::OpenGL:   return "gl";
+        case BackendType::Software: return "software";
+        case BackendType::Null:     return "null";
+    }
+    return "unknown";
+}
+
+bool ParseBackendType(const std::string& name, BackendType& outType) {
+    for (BackendType type : {BackendType::OpenGL, BackendType::Software, BackendType::Null}) {
+        if (name == GetBackendName(type)) {
+            outType = type;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool BackendRequiresContext(BackendType type) {
+    return type != BackendType::Null;
+}
+
+std::unique_ptr<RenderBackend> RenderBackend::Create(BackendType type, JobSystem* jobs) {
+    switch (type) {
+        case BackendType::OpenGL:   return std::make_unique<OpenGLBackend>();
+        case BackendType::Software: return std::make_unique<SoftwareBackend>(jobs);
+        case BackendType::Null:     return std::make_unique<NullBackend>();
+    }
+    return nullptr;
+}
+
+} // namespace Rendering
+} // namespace ShadowEngine
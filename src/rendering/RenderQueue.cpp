@@ -0,0 +1,211 @@
+#include "rendering/RenderQueue.hpp"
+#include "rendering/Material.hpp"
+#include "rendering/Mesh.hpp"
+#include "rendering/Shader.hpp"
+#include "core/JobSystem.hpp"
+#include "core/Profiler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace ShadowEngine {
+namespace Rendering {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double MillisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// out = a * b in Matrix4's operator order, without the identity-initialised temporary
+inline void Multiply(const float* a, const float* b, float* out) {
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            out[i * 4 + j] = a[i * 4 + 0] * b[0 * 4 + j] + a[i * 4 + 1] * b[1 * 4 + j] +
+                             a[i * 4 + 2] * b[2 * 4 + j] + a[i * 4 + 3] * b[3 * 4 + j];
+        }
+    }
+}
+
+struct FrustumPlane {
+    float x, y, z, w;
+};
+
+// Gribb/Hartmann extraction from the column-major view-projection matrix;
+// a point is inside when dot(plane, p) >= 0 for all six planes
+void ExtractPlanes(const float* m, FrustumPlane planes[6]) {
+    auto row = [m](int r) { return FrustumPlane{m[r], m[4 + r], m[8 + r], m[12 + r]}; };
+    const FrustumPlane r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+    planes[0] = {r3.x + r0.x, r3.y + r0.y, r3.z + r0.z, r3.w + r0.w};  // Left
+    planes[1] = {r3.x - r0.x, r3.y - r0.y, r3.z - r0.z, r3.w - r0.w};  // Right
+    planes[2] = {r3.x + r1.x, r3.y + r1.y, r3.z + r1.z, r3.w + r1.w};  // Bottom
+    planes[3] = {r3.x - r1.x, r3.y - r1.y, r3.z - r1.z, r3.w - r1.w};  // Top
+    planes[4] = {r3.x + r2.x, r3.y + r2.y, r3.z + r2.z, r3.w + r2.w};  // Near
+    planes[5] = {r3.x - r2.x, r3.y - r2.y, r3.z - r2.z, r3.w - r2.w};  // Far
+
+    // Normalise so plane distances compare against sphere radii
+    for (int i = 0; i < 6; ++i) {
+        FrustumPlane& p = planes[i];
+        float length = std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
+        if (length > 0.0f) {
+            p.x /= length;
+            p.y /= length;
+            p.z /= length;
+            p.w /= length;
+        }
+    }
+}
+
+// Below this a comparison sort beats clearing the radix histograms
+constexpr size_t RadixSortThreshold = 4096;
+constexpr int RadixBits = 16;
+constexpr size_t RadixBuckets = size_t(1) << RadixBits;
+constexpr int RadixPasses = 64 / RadixBits;
+
+// Draws per packing job; smaller batches cost more in scheduling than they save
+constexpr size_t PackGrainSize = 1024;
+
+} // namespace
+
+void RenderQueue::Submit(Mesh& mesh, Shader& shader, const Math::Matrix4& model) {
+    m_Items.push_back(Item{&mesh, &shader, nullptr, model});
+}
+
+void RenderQueue::Submit(Mesh& mesh, const Material& material, const Math::Matrix4& model) {
+    m_Items.push_back(Item{&mesh, material.GetShader().get(), &material, model});
+}
+
+void RenderQueue::Clear() {
+    m_Items.clear();
+}
+
+void RenderQueue::Prepare(const Math::Matrix4& view, const Math::Matrix4& projection) {
+    SHADOW_PROFILE_ZONE("RenderQueue::Prepare");
+    m_View = view;
+    m_Projection = projection;
+    m_Stats = Stats();
+    m_Stats.submitted = m_Items.size();
+
+    // Column-major operands multiply in reverse: this is projection * view
+    const Math::Matrix4 viewProjection = view * projection;
+    const float* vp = viewProjection.GetData();
+
+    // Cull bounding spheres and build sort keys for the survivors
+    Clock::time_point start = Clock::now();
+    FrustumPlane planes[6];
+    ExtractPlanes(vp, planes);
+
+    m_Entries.clear();
+    for (size_t i = 0; i < m_Items.size(); ++i) {
+        const Item& item = m_Items[i];
+        const float* m = item.model.GetData();
+        const float* c = item.mesh->GetBoundsCenter();
+
+        const float x = m[0] * c[0] + m[4] * c[1] + m[8] * c[2] + m[12];
+        const float y = m[1] * c[0] + m[5] * c[1] + m[9] * c[2] + m[13];
+        const float z = m[2] * c[0] + m[6] * c[1] + m[10] * c[2] + m[14];
+
+        // Scale the radius by the largest axis scale of the model matrix; exact
+        // for translate-rotate-scale transforms, not for shears
+        float scaleSquared = 0.0f;
+        for (int axis = 0; axis < 3; ++axis) {
+            const float* column = m + axis * 4;
+            scaleSquared = std::max(scaleSquared,
+                                    column[0] * column[0] + column[1] * column[1] + column[2] * column[2]);
+        }
+        const float radius = item.mesh->GetBoundsRadius() * std::sqrt(scaleSquared);
+
+        bool visible = true;
+        for (int p = 0; p < 6 && visible; ++p) {
+            visible = planes[p].x * x + planes[p].y * y + planes[p].z * z + planes[p].w >= -radius;
+        }
+        if (!visible) {
+            continue;
+        }
+
+        // Clip-space w is the view depth; non-negative floats order like their bits
+        float depth = std::max(0.0f, vp[3] * x + vp[7] * y + vp[11] * z + vp[15]);
+        uint32_t depthBits;
+        std::memcpy(&depthBits, &depth, sizeof(depthBits));
+
+        const uint64_t key = (static_cast<uint64_t>(item.shader->GetID() & 0xFFFF) << 48) |
+                             (static_cast<uint64_t>(item.mesh->GetID() & 0xFFFF) << 32) |
+                             depthBits;
+        m_Entries.emplace_back(key, static_cast<uint32_t>(i));
+    }
+    m_Stats.visible = m_Entries.size();
+    m_Stats.cullMs = MillisecondsSince(start);
+
+    start = Clock::now();
+    SortEntries();
+    m_Stats.sortMs = MillisecondsSince(start);
+
+    // Generate matrices and pack them in draw order
+    start = Clock::now();
+    m_Packets.resize(m_Entries.size());
+    m_Uniforms.resize(m_Entries.size());
+    if (m_Jobs) {
+        m_Jobs->ParallelFor(m_Entries.size(), PackGrainSize, [this, vp](size_t begin, size_t end) {
+            PackRange(begin, end, vp);
+        });
+    } else {
+        PackRange(0, m_Entries.size(), vp);
+    }
+    m_Stats.packMs = MillisecondsSince(start);
+}
+
+void RenderQueue::PackRange(size_t begin, size_t end, const float* viewProjection) {
+    for (size_t i = begin; i < end; ++i) {
+        const Item& item = m_Items[m_Entries[i].second];
+        m_Packets[i] = DrawPacket{item.mesh, item.shader, item.material, m_Entries[i].first};
+
+        PerDrawUniforms& uniforms = m_Uniforms[i];
+        std::memcpy(uniforms.model, item.model.GetData(), sizeof(uniforms.model));
+        Multiply(item.model.GetData(), viewProjection, uniforms.modelViewProjection);
+    }
+}
+
+void RenderQueue::SortEntries() {
+    const size_t count = m_Entries.size();
+    if (count < RadixSortThreshold) {
+        std::sort(m_Entries.begin(), m_Entries.end(),
+                  [](const SortEntry& a, const SortEntry& b) { return a.first < b.first; });
+        return;
+    }
+
+    // LSD radix sort; one read builds every digit's histogram
+    m_Histogram.assign(RadixBuckets * RadixPasses, 0);
+    for (const SortEntry& entry : m_Entries) {
+        for (int pass = 0; pass < RadixPasses; ++pass) {
+            ++m_Histogram[pass * RadixBuckets + ((entry.first >> (pass * RadixBits)) & (RadixBuckets - 1))];
+        }
+    }
+
+    m_SortScratch.resize(count);
+    for (int pass = 0; pass < RadixPasses; ++pass) {
+        uint32_t* histogram = m_Histogram.data() + pass * RadixBuckets;
+        const int shift = pass * RadixBits;
+
+        // Passes where every key shares the digit (one shader, one mesh) are no-ops
+        if (histogram[(m_Entries[0].first >> shift) & (RadixBuckets - 1)] == count) {
+            continue;
+        }
+
+        uint32_t offset = 0;
+        for (size_t bucket = 0; bucket < RadixBuckets; ++bucket) {
+            uint32_t bucketCount = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketCount;
+        }
+        for (const SortEntry& entry : m_Entries) {
+            m_SortScratch[histogram[(entry.first >> shift) & (RadixBuckets - 1)]++] = entry;
+        }
+        m_Entries.swap(m_SortScratch);
+    }
+}
+
+} // namespace Rendering
+} // namespace ShadowEngine
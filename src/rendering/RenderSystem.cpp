@@ -1,99 +1,451 @@
 #include "rendering/RenderSystem.hpp"
+#include "rendering/AssetManager.hpp"
+#include "rendering/ResourceCache.hpp"
 #include "rendering/Shader.hpp"
 #include "rendering/Mesh.hpp"
+#include "rendering/GLStateCache.hpp"
+#include "rendering/GLDebugOutput.hpp"
+#include "rendering/Texture.hpp"
+#include "rendering/TextureStreamer.hpp"
+#include "rendering/Framebuffer.hpp"
+#include "rendering/RenderQueue.hpp"
+#include "rendering/GPUTimer.hpp"
+#include "core/ImageLoader.hpp"
+#include "core/Log.hpp"
+#include "core/MemoryTracker.hpp"
+#include "core/Profiler.hpp"
+#include "core/VirtualFileSystem.hpp"
 #include "math/Matrix.hpp"
-#include <iostream>
+#include <algorithm>
+#include <cmath>
 
 namespace ShadowEngine {
 namespace Rendering {
 
-RenderSystem::RenderSystem() : m_Window(nullptr) {}
+RenderSystem::RenderSystem()
+    : m_Window(nullptr)
+    , m_ProcLoader(nullptr)
+    , m_HasContext(false)
+    , m_Width(0)
+    , m_Height(0)
+    , m_Jobs(nullptr)
+    , m_SubmitIndex(0)
+    , m_UpscaleVertexArray(0)
+    , m_CapturePaused(false)
+    , m_TextureStreamer(std::make_unique<TextureStreamer>())
+{
+    for (FrameSnapshot& snapshot : m_Snapshots) {
+        snapshot.queue = std::make_unique<RenderQueue>();
+    }
+}
 
 RenderSystem::~RenderSystem() {
     // Cleanup will be handled by the destructors of the member variables
+    if (m_AssetManager) {
+        SHADOW_LOG_REPORT(Info, Assets, [this](std::ostream& out) { m_AssetManager->PrintSummary(out); });
+        m_AssetManager.reset();
+    }
+    if (m_ResourceCache) {
+        SHADOW_LOG_REPORT(Info, Assets, [this](std::ostream& out) { m_ResourceCache->PrintSummary(out); });
+        m_ResourceCache.reset();
+    }
+    m_Textures.clear();
+    m_TextureStreamer->Shutdown();
+    DisableCapture();
+    DisableDynamicResolution();
+    m_Backend.reset();
+    m_OffscreenTarget.reset();
+
+    GLDebugOutput::Get().PrintSummary();
+    GLDebugOutput::Get().Shutdown();
+
+    const GLStateCache& state = GLStateCache::Get();
+    if (state.GetFrameCount() > 0) {
+        SHADOW_LOG_INFO(Rendering, "GL state cache filtered {} redundant calls over {} frames ({} per frame)",
+                        state.GetTotalRedundantCalls(), state.GetFrameCount(),
+                        state.GetTotalRedundantCalls() / state.GetFrameCount());
+        if (state.GetTotalDesyncs() > 0) {
+            SHADOW_LOG_WARNING(Rendering, "GL state validation: {} desyncs over {} frames", state.GetTotalDesyncs(),
+                               state.GetFrameCount());
+        } else if (state.IsValidationEnabled()) {
+            SHADOW_LOG_INFO(Rendering, "GL state validation: no desyncs over {} frames", state.GetFrameCount());
+        }
+    }
+}
+
+void RenderSystem::SetJobSystem(JobSystem* jobs) {
+    m_Jobs = jobs;
+    for (FrameSnapshot& snapshot : m_Snapshots) {
+        snapshot.queue->SetJobSystem(jobs);
+    }
 }
 
-bool RenderSystem::Initialize(GLFWwindow* window) {
+bool RenderSystem::Initialize(GLFWwindow* window, BackendType backend) {
     m_Window = window;
+    m_ProcLoader = (GLADloadproc)glfwGetProcAddress;
+    m_Backend = RenderBackend::Create(backend, m_Jobs);
+    m_HasContext = BackendRequiresContext(backend);
+    m_ResourceCache = std::make_unique<ResourceCache>(m_HasContext);
+    m_AssetManager = std::make_unique<AssetManager>(m_Jobs, m_TextureStreamer.get(), m_ResourceCache.get(),
+                                                    m_HasContext);
+    if (!m_HasContext) {
+        return true;
+    }
     
     if (!InitializeOpenGL()) {
-        std::cerr << "Failed to initialize OpenGL" << std::endl;
+        SHADOW_LOG_ERROR(Rendering, "Failed to initialize OpenGL");
         return false;
     }
     
     SetupDebugCallback();
+
+    if (!m_TextureStreamer->Initialize()) {
+        SHADOW_LOG_ERROR(Rendering, "Failed to initialize texture streamer");
+        return false;
+    }
     return true;
 }
 
-void RenderSystem::Render() {
-    // Clear the screen
-    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    
-    // Get window dimensions for aspect ratio
-    int width, height;
-    glfwGetFramebufferSize(m_Window, &width, &height);
-    float aspectRatio = static_cast<float>(width) / static_cast<float>(height);
-    
+bool RenderSystem::InitializeHeadless(GLADloadproc loader, int width, int height, BackendType backend) {
+    m_Window = nullptr;
+    m_ProcLoader = loader;
+    m_Width = width;
+    m_Height = height;
+    m_Backend = RenderBackend::Create(backend, m_Jobs);
+    m_HasContext = BackendRequiresContext(backend);
+    m_ResourceCache = std::make_unique<ResourceCache>(m_HasContext);
+    m_AssetManager = std::make_unique<AssetManager>(m_Jobs, m_TextureStreamer.get(), m_ResourceCache.get(),
+                                                    m_HasContext);
+    if (!m_HasContext) {
+        return true;
+    }
+
+    if (!InitializeOpenGL()) {
+        SHADOW_LOG_ERROR(Rendering, "Failed to initialize OpenGL");
+        return false;
+    }
+
+    SetupDebugCallback();
+
+    m_OffscreenTarget = std::make_unique<Framebuffer>();
+    if (!m_OffscreenTarget->Create(width, height)) {
+        SHADOW_LOG_ERROR(Rendering, "Failed to create offscreen render target");
+        return false;
+    }
+
+    if (!m_TextureStreamer->Initialize()) {
+        SHADOW_LOG_ERROR(Rendering, "Failed to initialize texture streamer");
+        return false;
+    }
+    return true;
+}
+
+void RenderSystem::Render(uint64_t frameIndex) {
+    SHADOW_PROFILE_ZONE("RenderSystem::Render");
+    PublishFrame(frameIndex);
+    RenderPublished();
+}
+
+void RenderSystem::PublishFrame(uint64_t frameIndex) {
+    SHADOW_PROFILE_ZONE("RenderSystem::PublishFrame");
+    MemoryScope memoryScope(MemoryTag::Rendering);
+    FrameSnapshot& snapshot = m_Snapshots[m_SubmitIndex];
+
+    // Get target dimensions for viewport and aspect ratio. GLFW only answers
+    // on the main thread, so the size travels with the snapshot.
+    if (m_OffscreenTarget) {
+        snapshot.width = m_OffscreenTarget->GetWidth();
+        snapshot.height = m_OffscreenTarget->GetHeight();
+    } else if (m_Window) {
+        glfwGetFramebufferSize(m_Window, &snapshot.width, &snapshot.height);
+    } else {
+        snapshot.width = m_Width;
+        snapshot.height = m_Height;
+    }
+
     // Create camera matrices
-    auto projection = ShadowEngine::Math::CreatePerspective(45.0f, aspectRatio, 0.1f, 100.0f);
-    Math::Matrix4 view = m_HasExternalView
+    if (snapshot.width > 0 && snapshot.height > 0) {
+        float aspectRatio = static_cast<float>(snapshot.width) / static_cast<float>(snapshot.height);
+        snapshot.projection = ShadowEngine::Math::CreatePerspective(45.0f, aspectRatio, 0.1f, 100.0f);
+    }
+    snapshot.view = m_HasExternalView
         ? m_ViewMatrix
         : ShadowEngine::Math::CreateLookAt(0.0f, 0.0f, 3.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f);
-    auto model = ShadowEngine::Math::CreateRotation(glfwGetTime() * 50.0f, 0.0f, 1.0f, 0.0f);
-    
-    // Render all meshes with their respective shaders
-    for (size_t i = 0; i < m_Meshes.size(); ++i) {
-        if (i < m_Shaders.size()) {
-            auto& shader = m_Shaders[i];
-            shader->Use();
-            
-            // Set transformation matrices
-            shader->SetUniform("projection", projection.GetData());
-            shader->SetUniform("view", view.GetData());
-            shader->SetUniform("model", model.GetData());
-            
-            m_Meshes[i]->Render(shader);
+    snapshot.frameIndex = frameIndex;
+
+    m_SubmitIndex ^= 1;
+}
+
+void RenderSystem::RenderPublished() {
+    SHADOW_PROFILE_ZONE("RenderSystem::RenderPublished");
+    MemoryScope memoryScope(MemoryTag::Rendering);
+    FrameSnapshot& snapshot = m_Snapshots[m_SubmitIndex ^ 1];
+    RenderQueue& queue = *snapshot.queue;
+
+    if (m_HasContext) {
+        GLStateCache::Get().BeginFrame();
+    }
+
+    // Create GPU objects for assets that finished loading, then stream pending
+    // mip levels before any draw samples them
+    m_AssetManager->ProcessUploads();
+    m_ResourceCache->Collect();
+    if (m_HasContext) {
+        m_TextureStreamer->Update();
+    }
+
+    if (snapshot.width <= 0 || snapshot.height <= 0) {
+        queue.Clear();
+        return;  // Minimized
+    }
+
+    RenderTarget target;
+    target.framebuffer = m_OffscreenTarget.get();
+    target.width = snapshot.width;
+    target.height = snapshot.height;
+
+    queue.Prepare(snapshot.view, snapshot.projection);
+    if (m_DynamicResolution) {
+        RenderScaled(queue, target);
+    } else {
+        m_Backend->Execute(queue, target);
+    }
+    if (m_Capture && !m_CapturePaused) {
+        m_Capture->Capture(target, snapshot.frameIndex);
+    }
+
+    // Empty and ready to be the submit side again after the next publish
+    queue.Clear();
+}
+
+void RenderSystem::RenderScaled(const RenderQueue& queue, const RenderTarget& output) {
+    // Feed every timing that has arrived; they lag the current frame
+    double gpuMilliseconds = 0.0;
+    while (m_GPUTimer->Poll(gpuMilliseconds)) {
+        m_DynamicResolution->Update(gpuMilliseconds);
+    }
+
+    // The scaled target is allocated at the largest scale once; lower scales
+    // render into its lower-left corner, so scale changes never reallocate
+    const float maxScale = m_DynamicResolution->GetSettings().maxScale;
+    const int capacityWidth = std::max(1, static_cast<int>(std::ceil(output.width * maxScale)));
+    const int capacityHeight = std::max(1, static_cast<int>(std::ceil(output.height * maxScale)));
+    if (m_ScaledTarget->GetWidth() != capacityWidth || m_ScaledTarget->GetHeight() != capacityHeight) {
+        if (!m_ScaledTarget->Create(capacityWidth, capacityHeight, "Dynamic resolution")) {
+            m_Backend->Execute(queue, output);
+            return;
         }
     }
-    
-    // Note: buffer swapping is handled by the window/engine main loop.
+
+    const float scale = m_DynamicResolution->GetScale();
+    RenderTarget scaled;
+    scaled.framebuffer = m_ScaledTarget.get();
+    scaled.width = std::min(capacityWidth, std::max(1, static_cast<int>(std::lround(output.width * scale))));
+    scaled.height = std::min(capacityHeight, std::max(1, static_cast<int>(std::lround(output.height * scale))));
+
+    // At full size the scene goes straight to the output; an upscale would
+    // only copy it
+    if (scaled.width == output.width && scaled.height == output.height) {
+        m_GPUTimer->Begin();
+        m_Backend->Execute(queue, output);
+        m_GPUTimer->End();
+        return;
+    }
+
+    // Only the scene pass is timed: the controller predicts its cost from the
+    // scale, and the upscale costs the same at every scale
+    m_GPUTimer->Begin();
+    m_Backend->Execute(queue, scaled);
+    m_GPUTimer->End();
+
+    // Upscale pass onto the real target. A fullscreen triangle sampling the
+    // scaled colour texture; drivers often take a slow path for a blit that
+    // stretches with filtering.
+    ScopedDebugGroup upscalePass("Upscale");
+    GLStateCache& state = GLStateCache::Get();
+    if (!m_UpscaleShader) {
+        state.BindFramebuffer(GL_READ_FRAMEBUFFER, m_ScaledTarget->GetID());
+        state.BindFramebuffer(GL_DRAW_FRAMEBUFFER, output.framebuffer ? output.framebuffer->GetID() : 0);
+        glBlitFramebuffer(0, 0, scaled.width, scaled.height, 0, 0, output.width, output.height,
+                          GL_COLOR_BUFFER_BIT, GL_LINEAR);
+        return;
+    }
+    if (output.framebuffer) {
+        output.framebuffer->Bind();
+    } else {
+        state.BindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+    state.Viewport(0, 0, output.width, output.height);
+    state.Disable(GL_DEPTH_TEST);
+    m_UpscaleShader->Use();
+    m_UpscaleShader->SetUniform("uvScale", static_cast<float>(scaled.width) / capacityWidth,
+                                static_cast<float>(scaled.height) / capacityHeight);
+    m_UpscaleShader->SetUniform("scene", 0);
+    state.BindTexture(0, GL_TEXTURE_2D, m_ScaledTarget->GetColorTexture());
+    state.BindVertexArray(m_UpscaleVertexArray);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    state.Enable(GL_DEPTH_TEST);
+}
+
+bool RenderSystem::EnableDynamicResolution(const DynamicResolution::Settings& settings) {
+    if (!m_HasContext) {
+        SHADOW_LOG_ERROR(Rendering, "Dynamic resolution needs a GL context; the {} backend has none",
+                         GetBackendName(m_Backend->GetType()));
+        return false;
+    }
+
+    DisableDynamicResolution();
+    m_GPUTimer = std::make_unique<GPUTimer>();
+    if (!m_GPUTimer->Initialize()) {
+        SHADOW_LOG_ERROR(Rendering, "Failed to create GPU timer queries");
+        m_GPUTimer.reset();
+        return false;
+    }
+    m_ScaledTarget = std::make_unique<Framebuffer>();
+    m_DynamicResolution = std::make_unique<DynamicResolution>(settings);
+
+    m_UpscaleShader = CreateShader("shaders/upscale.vert", "shaders/upscale.frag");
+    if (m_UpscaleShader) {
+        glGenVertexArrays(1, &m_UpscaleVertexArray);
+        GLDebugOutput::Get().LabelObject(GL_VERTEX_ARRAY, m_UpscaleVertexArray, "Upscale");
+    } else {
+        SHADOW_LOG_WARNING(Rendering, "Dynamic resolution: upscale shader unavailable, falling back to a blit");
+    }
+    return true;
+}
+
+void RenderSystem::DisableDynamicResolution() {
+    if (m_DynamicResolution) {
+        SHADOW_LOG_REPORT(Info, Rendering, [this](std::ostream& out) { m_DynamicResolution->PrintSummary(out); });
+    }
+    m_DynamicResolution.reset();
+    m_GPUTimer.reset();
+    m_ScaledTarget.reset();
+    m_UpscaleShader.reset();
+    if (m_UpscaleVertexArray != 0) {
+        GLStateCache::Get().DeleteVertexArray(m_UpscaleVertexArray);
+        m_UpscaleVertexArray = 0;
+    }
+}
+
+bool RenderSystem::EnableCapture(const FrameCapture::Settings& settings) {
+    if (!m_HasContext) {
+        SHADOW_LOG_ERROR(Rendering, "Frame capture needs a GL context; the {} backend has none",
+                         GetBackendName(m_Backend->GetType()));
+        return false;
+    }
+
+    DisableCapture();
+    m_Capture = std::make_unique<FrameCapture>();
+    if (!m_Capture->Initialize(settings)) {
+        m_Capture.reset();
+        return false;
+    }
+    return true;
+}
+
+void RenderSystem::DisableCapture() {
+    if (!m_Capture) {
+        return;
+    }
+    m_Capture->Shutdown();
+    SHADOW_LOG_REPORT(Info, Rendering, [this](std::ostream& out) { m_Capture->PrintSummary(out); });
+    m_Capture.reset();
+}
+
+void RenderSystem::ResetStats() {
+    if (m_HasContext) {
+        GLStateCache::Get().ResetStats();
+    }
+    if (m_DynamicResolution) {
+        m_DynamicResolution->ResetStats();
+    }
+}
+
+void RenderSystem::Finish() {
+    SHADOW_PROFILE_ZONE("RenderSystem::Finish");
+    m_Backend->Finish();
+}
+
+void RenderSystem::Submit(const std::shared_ptr<Mesh>& mesh, const std::shared_ptr<Shader>& shader,
+                          const Math::Matrix4& model) {
+    m_Snapshots[m_SubmitIndex].queue->Submit(*mesh, *shader, model);
+}
+
+void RenderSystem::Submit(const std::shared_ptr<Mesh>& mesh, const std::shared_ptr<Material>& material,
+                          const Math::Matrix4& model) {
+    m_Snapshots[m_SubmitIndex].queue->Submit(*mesh, *material, model);
 }
 
 std::shared_ptr<Shader> RenderSystem::CreateShader(const std::string& vertexPath, 
                                                  const std::string& fragmentPath) {
-    auto shader = std::make_shared<Shader>();
-    if (shader->LoadFromFiles(vertexPath, fragmentPath)) {
-        m_Shaders.push_back(shader);
-        return shader;
+    MemoryScope memoryScope(MemoryTag::Assets);
+
+    // The sources are read even without a context: they are the cache key
+    VirtualFileSystem& vfs = VirtualFileSystem::Get();
+    VirtualFileSystem::File vertexFile;
+    if (!vfs.Read(vertexPath, vertexFile)) {
+        SHADOW_LOG_ERROR(Rendering, "Failed to open vertex shader file: {}", vertexPath);
+        return nullptr;
     }
-    return nullptr;
+    VirtualFileSystem::File fragmentFile;
+    if (!vfs.Read(fragmentPath, fragmentFile)) {
+        SHADOW_LOG_ERROR(Rendering, "Failed to open fragment shader file: {}", fragmentPath);
+        return nullptr;
+    }
+    return m_ResourceCache->GetShader(vertexFile.GetText(), fragmentFile.GetText(), vertexPath + " + " + fragmentPath);
 }
 
 std::shared_ptr<Mesh> RenderSystem::CreateMesh(const std::vector<float>& vertices, 
                                              const std::vector<unsigned int>& indices) {
-    auto mesh = std::make_shared<Mesh>();
-    if (mesh->Initialize(vertices, indices)) {
-        m_Meshes.push_back(mesh);
-        return mesh;
+    MemoryScope memoryScope(MemoryTag::Assets);
+    return m_ResourceCache->GetMesh(vertices, indices);
+}
+
+std::shared_ptr<Texture> RenderSystem::CreateTexture(const std::string& imagePath) {
+    SHADOW_PROFILE_ZONE("RenderSystem::CreateTexture");
+    MemoryScope memoryScope(MemoryTag::Assets);
+    std::shared_ptr<Texture> texture;
+    if (!m_HasContext) {
+        return texture;  // Nothing samples textures without a GPU backend
     }
-    return nullptr;
+
+    // Cooked containers upload directly; anything else is decoded and streamed
+    const std::string cookedExtension = ".shtx";
+    if (imagePath.size() >= cookedExtension.size() &&
+        imagePath.compare(imagePath.size() - cookedExtension.size(), cookedExtension.size(), cookedExtension) == 0) {
+        texture = Texture::LoadCompressed(imagePath);
+    } else {
+        ImageLoader::ImageData image;
+        if (!ImageLoader::LoadImage(imagePath, image)) {
+            return nullptr;
+        }
+        texture = m_TextureStreamer->CreateTexture(imagePath, std::move(image));
+    }
+
+    if (texture) {
+        m_Textures.push_back(texture);
+    }
+    return texture;
 }
 
 bool RenderSystem::InitializeOpenGL() {
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
-        std::cerr << "Failed to initialize GLAD" << std::endl;
+    if (!gladLoadGLLoader(m_ProcLoader)) {
+        SHADOW_LOG_ERROR(Rendering, "Failed to initialize GLAD");
         return false;
     }
     
+    // Everything cached so far belongs to no context
+    GLStateCache::Get().Reset();
+
     // Enable depth testing
-    glEnable(GL_DEPTH_TEST);
+    GLStateCache::Get().Enable(GL_DEPTH_TEST);
 
     // NOTE: Backface culling is disabled for now so all cube faces are visible
     // while developing. Once all mesh winding orders are verified to be CCW,
     // you can re-enable this for better performance:
-    // glEnable(GL_CULL_FACE);
-    // glCullFace(GL_BACK);
+    // GLStateCache::Get().Enable(GL_CULL_FACE);
+    // GLStateCache::Get().CullFace(GL_BACK);
 
     return true;
 }
@@ -104,7 +456,7 @@ void RenderSystem::SetViewMatrix(const Math::Matrix4& viewMatrix) {
 }
 
 void RenderSystem::SetupDebugCallback() {
-    // TODO: Implement OpenGL debug callback for better error reporting
+    GLDebugOutput::Get().Initialize(m_ProcLoader);
 }
 
 } // namespace Rendering
@@ -0,0 +1,190 @@
+#include "rendering/ResourceCache.hpp"
+#include "rendering/Mesh.hpp"
+#include "rendering/Shader.hpp"
+#include "core/Hash.hpp"
+#include "core/Profiler.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <utility>
+
+namespace ShadowEngine {
+namespace Rendering {
+
+ResourceCache::ResourceCache(bool hasContext)
+    : m_HasContext(hasContext)
+    , m_Budget(64 * 1024 * 1024)
+    , m_ReleaseDelay(2)
+    , m_Frame(0) {
+}
+
+ResourceCache::~ResourceCache() = default;
+
+std::shared_ptr<Shader> ResourceCache::GetShader(std::string_view vertexCode, std::string_view fragmentCode,
+                                                 const std::string& label) {
+    SHADOW_PROFILE_ZONE("ResourceCache::GetShader");
+    const uint64_t vertexHash = Hash::Compute(vertexCode.data(), vertexCode.size(), static_cast<uint64_t>(Kind::Shader));
+    const uint64_t hash = Hash::Compute(fragmentCode.data(), fragmentCode.size(), vertexHash);
+
+    auto it = Lookup(Kind::Shader, hash);
+    if (it != m_Entries.end()) {
+        if (it->vertexCode == vertexCode && it->fragmentCode == fragmentCode) {
+            ++m_Stats.hits;
+            it->unusedSince = 0;
+            return it->shader;
+        }
+        ++m_Stats.collisions;
+    }
+    ++m_Stats.misses;
+
+    // Without a context the shader is only an identity for sorting
+    auto shader = std::make_shared<Shader>();
+    if (m_HasContext && !shader->LoadFromSource(vertexCode, fragmentCode, label)) {
+        return nullptr;
+    }
+
+    Entry entry;
+    entry.kind = Kind::Shader;
+    entry.hash = hash;
+    entry.shader = shader;
+    entry.vertexCode = std::string(vertexCode);
+    entry.fragmentCode = std::string(fragmentCode);
+    entry.bytes = shader->GetGpuBytes();
+    Insert(std::move(entry));
+    return shader;
+}
+
+std::shared_ptr<Mesh> ResourceCache::GetMesh(const std::vector<float>& vertices,
+                                             const std::vector<unsigned int>& indices) {
+    SHADOW_PROFILE_ZONE("ResourceCache::GetMesh");
+    const uint64_t vertexHash = Hash::Compute(vertices.data(), vertices.size() * sizeof(float),
+                                              static_cast<uint64_t>(Kind::Mesh));
+    const uint64_t hash = Hash::Compute(indices.data(), indices.size() * sizeof(unsigned int), vertexHash);
+
+    auto it = Lookup(Kind::Mesh, hash);
+    if (it != m_Entries.end()) {
+        if (it->mesh->GetVertices() == vertices && it->mesh->GetIndices() == indices) {
+            ++m_Stats.hits;
+            it->unusedSince = 0;
+            return it->mesh;
+        }
+        ++m_Stats.collisions;
+    }
+    ++m_Stats.misses;
+
+    auto mesh = std::make_shared<Mesh>();
+    if (!mesh->Initialize(vertices, indices, m_HasContext)) {
+        return nullptr;
+    }
+
+    Entry entry;
+    entry.kind = Kind::Mesh;
+    entry.hash = hash;
+    entry.mesh = mesh;
+    entry.bytes = mesh->GetGpuBytes() + vertices.size() * sizeof(float) + indices.size() * sizeof(unsigned int);
+    Insert(std::move(entry));
+    return mesh;
+}
+
+bool ResourceCache::IsUsed(const Entry& entry) const {
+    return entry.kind == Kind::Shader ? entry.shader.use_count() > 1 : entry.mesh.use_count() > 1;
+}
+
+ResourceCache::EntryList::iterator ResourceCache::Lookup(Kind kind, uint64_t hash) {
+    auto found = m_Index.find(hash);
+    if (found == m_Index.end() || found->second->kind != kind) {
+        return m_Entries.end();
+    }
+
+    // Most recently requested goes last
+    m_Entries.splice(m_Entries.end(), m_Entries, found->second);
+    return found->second;
+}
+
+void ResourceCache::Insert(Entry entry) {
+    // On a collision the older entry keeps the slot; the new object is simply
+    // not shared
+    if (m_Index.count(entry.hash) > 0) {
+        return;
+    }
+    m_Stats.bytes += entry.bytes;
+    m_Stats.peakBytes = std::max(m_Stats.peakBytes, m_Stats.bytes);
+    const uint64_t hash = entry.hash;
+    m_Entries.push_back(std::move(entry));
+    m_Index[hash] = std::prev(m_Entries.end());
+}
+
+ResourceCache::EntryList::iterator ResourceCache::Evict(EntryList::iterator it) {
+    m_Stats.bytes -= it->bytes;
+    ++m_Stats.evictions;
+    m_Index.erase(it->hash);
+    return m_Entries.erase(it);
+}
+
+void ResourceCache::Collect() {
+    SHADOW_PROFILE_ZONE("ResourceCache::Collect");
+    ++m_Frame;
+    for (Entry& entry : m_Entries) {
+        if (IsUsed(entry)) {
+            entry.unusedSince = 0;
+        } else if (entry.unusedSince == 0) {
+            entry.unusedSince = m_Frame;
+        }
+    }
+
+    // Over budget: release the least recently requested entries that have been
+    // unused long enough
+    const uint64_t delay = static_cast<uint64_t>(m_ReleaseDelay);
+    for (auto it = m_Entries.begin(); it != m_Entries.end() && (m_Budget == 0 || m_Stats.bytes > m_Budget);) {
+        if (it->unusedSince != 0 && m_Frame - it->unusedSince >= delay) {
+            it = Evict(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ResourceCache::ReleaseUnused() {
+    for (auto it = m_Entries.begin(); it != m_Entries.end();) {
+        if (!IsUsed(*it)) {
+            it = Evict(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+ResourceCache::Stats ResourceCache::GetStats() const {
+    Stats stats = m_Stats;
+    stats.entries = m_Entries.size();
+    for (const Entry& entry : m_Entries) {
+        stats.unused += IsUsed(entry) ? 0 : 1;
+    }
+    return stats;
+}
+
+void ResourceCache::PrintSummary(std::ostream& out) const {
+    const Stats stats = GetStats();
+    const uint64_t requests = stats.hits + stats.misses;
+    if (requests == 0) {
+        return;
+    }
+
+    const std::ios::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(1)
+        << "Resource cache: " << stats.hits << " hits, " << stats.misses << " misses ("
+        << 100.0 * static_cast<double>(stats.hits) / static_cast<double>(requests) << "% hit rate), "
+        << stats.evictions << " evicted, " << stats.entries << " entries (" << stats.unused << " unused) in "
+        << stats.bytes / 1024 << " KB, peak " << stats.peakBytes / 1024 << " KB";
+    if (stats.collisions > 0) {
+        out << ", " << stats.collisions << " hash collisions";
+    }
+    out << std::endl;
+    out.flags(flags);
+    out.precision(precision);
+}
+
+} // namespace Rendering
+} // namespace ShadowEngine
@@ -1,46 +1,46 @@
 #include "rendering/Shader.hpp"
-#include <fstream>
-#include <sstream>
-#include <iostream>
+#include "rendering/GLStateCache.hpp"
+#include "rendering/GLDebugOutput.hpp"
+#include "core/Log.hpp"
+#include "core/MemoryTracker.hpp"
+#include "core/Profiler.hpp"
+#include "core/VirtualFileSystem.hpp"
 
 namespace ShadowEngine {
 namespace Rendering {
 
-Shader::Shader() : m_ProgramID(0) {}
+Shader::Shader() : m_ProgramID(0), m_GpuBytes(0) {
+    static uint32_t s_NextID = 0;
+    m_ID = s_NextID++;
+}
 
 Shader::~Shader() {
     if (m_ProgramID != 0) {
-        glDeleteProgram(m_ProgramID);
+        GLStateCache::Get().DeleteProgram(m_ProgramID);
     }
+    MemoryTracker::Remove(MemoryTag::Assets, MemoryDomain::Gpu, m_GpuBytes);
 }
 
 bool Shader::LoadFromFiles(const std::string& vertexPath, const std::string& fragmentPath) {
-    // Read vertex shader
-    std::string vertexCode;
-    std::ifstream vertexFile(vertexPath);
-    if (vertexFile.is_open()) {
-        std::stringstream vertexStream;
-        vertexStream << vertexFile.rdbuf();
-        vertexCode = vertexStream.str();
-        vertexFile.close();
-    } else {
-        std::cerr << "Failed to open vertex shader file: " << vertexPath << std::endl;
+    SHADOW_PROFILE_ZONE("Shader::LoadFromFiles");
+    // Sources are compiled straight from the VFS, with explicit lengths
+    VirtualFileSystem& vfs = VirtualFileSystem::Get();
+    VirtualFileSystem::File vertexFile;
+    if (!vfs.Read(vertexPath, vertexFile)) {
+        SHADOW_LOG_ERROR(Rendering, "Failed to open vertex shader file: {}", vertexPath);
         return false;
     }
 
-    // Read fragment shader
-    std::string fragmentCode;
-    std::ifstream fragmentFile(fragmentPath);
-    if (fragmentFile.is_open()) {
-        std::stringstream fragmentStream;
-        fragmentStream << fragmentFile.rdbuf();
-        fragmentCode = fragmentStream.str();
-        fragmentFile.close();
-    } else {
-        std::cerr << "Failed to open fragment shader file: " << fragmentPath << std::endl;
+    VirtualFileSystem::File fragmentFile;
+    if (!vfs.Read(fragmentPath, fragmentFile)) {
+        SHADOW_LOG_ERROR(Rendering, "Failed to open fragment shader file: {}", fragmentPath);
         return false;
     }
 
+    return LoadFromSource(vertexFile.GetText(), fragmentFile.GetText(), vertexPath + " + " + fragmentPath);
+}
+
+bool Shader::LoadFromSource(std::string_view vertexCode, std::string_view fragmentCode, const std::string& label) {
     // Compile shaders
     GLuint vertexShader, fragmentShader;
     if (!CompileShader(vertexShader, vertexCode, GL_VERTEX_SHADER) ||
@@ -58,11 +58,25 @@ bool Shader::LoadFromFiles(const std::string& vertexPath, const std::string& fra
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
 
-    return LinkProgram();
+    if (!LinkProgram()) {
+        return false;
+    }
+
+    // The driver does not report program sizes; the linked binary is the closest
+    // figure where program binaries exist, the source size otherwise
+    GLint binaryLength = 0;
+    if (GLAD_GL_VERSION_4_1) {
+        glGetProgramiv(m_ProgramID, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+    }
+    m_GpuBytes = binaryLength > 0 ? static_cast<size_t>(binaryLength) : vertexCode.size() + fragmentCode.size();
+    MemoryTracker::Add(MemoryTag::Assets, MemoryDomain::Gpu, m_GpuBytes);
+
+    GLDebugOutput::Get().LabelObject(GL_PROGRAM, m_ProgramID, label);
+    return true;
 }
 
 void Shader::Use() const {
-    glUseProgram(m_ProgramID);
+    GLStateCache::Get().UseProgram(m_ProgramID);
 }
 
 void Shader::SetUniform(const std::string& name, int value) {
@@ -73,14 +87,20 @@ void Shader::SetUniform(const std::string& name, float value) {
     glUniform1f(GetUniformLocation(name), value);
 }
 
+void Shader::SetUniform(const std::string& name, float x, float y) {
+    glUniform2f(GetUniformLocation(name), x, y);
+}
+
 void Shader::SetUniform(const std::string& name, const float* matrix) {
     glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, matrix);
 }
 
-bool Shader::CompileShader(GLuint& shaderID, const std::string& shaderCode, GLenum shaderType) {
+bool Shader::CompileShader(GLuint& shaderID, std::string_view shaderCode, GLenum shaderType) {
+    SHADOW_PROFILE_ZONE("Shader::CompileShader");
     shaderID = glCreateShader(shaderType);
-    const char* code = shaderCode.c_str();
-    glShaderSource(shaderID, 1, &code, nullptr);
+    const char* code = shaderCode.data();
+    const GLint length = static_cast<GLint>(shaderCode.size());
+    glShaderSource(shaderID, 1, &code, &length);
     glCompileShader(shaderID);
 
     // Check for compilation errors
@@ -89,7 +109,7 @@ bool Shader::CompileShader(GLuint& shaderID, const std::string& shaderCode, GLen
     glGetShaderiv(shaderID, GL_COMPILE_STATUS, &success);
     if (!success) {
         glGetShaderInfoLog(shaderID, 512, nullptr, infoLog);
-        std::cerr << "Shader compilation error: " << infoLog << std::endl;
+        SHADOW_LOG_ERROR(Rendering, "Shader compilation error: {}", infoLog);
         return false;
     }
     return true;
@@ -101,7 +121,7 @@ bool Shader::LinkProgram() {
     glGetProgramiv(m_ProgramID, GL_LINK_STATUS, &success);
     if (!success) {
         glGetProgramInfoLog(m_ProgramID, 512, nullptr, infoLog);
-        std::cerr << "Shader program linking error: " << infoLog << std::endl;
+        SHADOW_LOG_ERROR(Rendering, "Shader program linking error: {}", infoLog);
         return false;
     }
     return true;
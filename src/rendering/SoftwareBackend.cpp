@@ -0,0 +1,68 @@
+#include "rendering/SoftwareBackend.hpp"
+#include "rendering/SoftwareRasterizer.hpp"
+#include "rendering/RenderQueue.hpp"
+#include "rendering/Framebuffer.hpp"
+#include "rendering/Mesh.hpp"
+#include "rendering/GLStateCache.hpp"
+#include "core/Log.hpp"
+#include <cstring>
+
+namespace ShadowEngine {
+namespace Rendering {
+
+SoftwareBackend::SoftwareBackend(JobSystem* jobs)
+    : m_Rasterizer(jobs ? std::make_unique<SoftwareRasterizer>(*jobs) : std::make_unique<SoftwareRasterizer>())
+{
+    SHADOW_LOG_INFO(Rendering, "Software rasterizer enabled ({} threads)", m_Rasterizer->GetThreadCount());
+}
+
+SoftwareBackend::~SoftwareBackend() = default;
+
+void SoftwareBackend::Execute(const RenderQueue& queue, const RenderTarget& target) {
+    const int width = target.width;
+    const int height = target.height;
+    m_Rasterizer->Resize(width, height);
+    m_Rasterizer->Clear(0.0f, 0.0f, 0.0f, 0.0f);
+
+    const std::vector<DrawPacket>& packets = queue.GetPackets();
+    const std::vector<PerDrawUniforms>& uniforms = queue.GetUniforms();
+    for (size_t i = 0; i < packets.size(); ++i) {
+        Math::Matrix4 mvp;
+        std::memcpy(mvp.data.data(), uniforms[i].modelViewProjection, sizeof(uniforms[i].modelViewProjection));
+
+        const auto& vertices = packets[i].mesh->GetVertices();
+        const auto& indices = packets[i].mesh->GetIndices();
+        m_Rasterizer->DrawIndexed(vertices.data(), vertices.size() / 6,
+                                  indices.data(), indices.size(), mvp);
+    }
+    m_Rasterizer->Flush();
+
+    // Present: upload the colour buffer and blit it onto the target
+    if (!m_Present) {
+        m_Present = std::make_unique<Framebuffer>();
+    }
+    if (m_Present->GetWidth() != width || m_Present->GetHeight() != height) {
+        if (!m_Present->Create(width, height)) {
+            return;
+        }
+    }
+
+    GLStateCache& state = GLStateCache::Get();
+    state.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    state.BindTexture(0, GL_TEXTURE_2D, m_Present->GetColorTexture());
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, m_Rasterizer->GetPitch());
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE,
+                    m_Rasterizer->GetColorBuffer());
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+    state.BindFramebuffer(GL_READ_FRAMEBUFFER, m_Present->GetID());
+    state.BindFramebuffer(GL_DRAW_FRAMEBUFFER, target.framebuffer ? target.framebuffer->GetID() : 0);
+    glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+}
+
+void SoftwareBackend::Finish() {
+    glFinish();
+}
+
+} // namespace Rendering
+} // namespace ShadowEngine
@@ -0,0 +1,582 @@
+#include "rendering/SoftwareRasterizer.hpp"
+#include "core/Profiler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SHADOW_RASTERIZER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace ShadowEngine {
+namespace Rendering {
+
+namespace {
+
+constexpr size_t VertexStride = 6;             // basic.vert: position + colour
+constexpr size_t VerticesPerJob = 4096;
+constexpr size_t TrianglesPerChunk = 1024;
+constexpr float GuardBand = 2.0f;              // Clip x/y only beyond twice the viewport
+constexpr float SubpixelScale = 256.0f;        // Vertices snap to 1/256 pixel
+
+// Clip planes as dot products with (x, y, z, w)
+constexpr float ClipPlanes[6][4] = {
+    { 0.0f,  0.0f,  1.0f, 1.0f},        // Near:   z >= -w
+    { 0.0f,  0.0f, -1.0f, 1.0f},        // Far:    z <=  w
+    { 1.0f,  0.0f,  0.0f, GuardBand},   // Left
+    {-1.0f,  0.0f,  0.0f, GuardBand},   // Right
+    { 0.0f,  1.0f,  0.0f, GuardBand},   // Bottom
+    { 0.0f, -1.0f,  0.0f, GuardBand},   // Top
+};
+
+uint32_t PackColor(float r, float g, float b, float a) {
+    auto toByte = [](float value) {
+        return static_cast<uint32_t>(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+    };
+    return toByte(r) | (toByte(g) << 8) | (toByte(b) << 16) | (toByte(a) << 24);
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// SoftwareRasterizer
+// ---------------------------------------------------------------------------
+
+SoftwareRasterizer::SoftwareRasterizer(unsigned threadCount)
+    : m_Width(0)
+    , m_Height(0)
+    , m_Pitch(0)
+    , m_TilesX(0)
+    , m_TilesY(0)
+    , m_ClearPending(false)
+    , m_ClearColor(0)
+    , m_ClearDepth(1.0f)
+    , m_CullBackFaces(false)
+    , m_ActiveChunks(0)
+    , m_SetupPerTriangle(1)
+    , m_BinsPerTriangle(1)
+    , m_Jobs(nullptr)
+{
+    JobSystem::Settings settings;
+    if (threadCount > 0) {
+        settings.workerCount = static_cast<int>(threadCount) - 1;
+    }
+    m_OwnedJobs = std::make_unique<JobSystem>(settings);
+    m_Jobs = m_OwnedJobs.get();
+}
+
+SoftwareRasterizer::SoftwareRasterizer(JobSystem& jobs)
+    : m_Width(0)
+    , m_Height(0)
+    , m_Pitch(0)
+    , m_TilesX(0)
+    , m_TilesY(0)
+    , m_ClearPending(false)
+    , m_ClearColor(0)
+    , m_ClearDepth(1.0f)
+    , m_CullBackFaces(false)
+    , m_ActiveChunks(0)
+    , m_SetupPerTriangle(1)
+    , m_BinsPerTriangle(1)
+    , m_Jobs(&jobs)
+{
+}
+
+SoftwareRasterizer::~SoftwareRasterizer() = default;
+
+unsigned SoftwareRasterizer::GetThreadCount() const {
+    return m_Jobs->GetThreadCount();
+}
+
+bool SoftwareRasterizer::Resize(int width, int height) {
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+    if (width == m_Width && height == m_Height) {
+        return true;
+    }
+
+    m_Width = width;
+    m_Height = height;
+    m_TilesX = (width + TileSize - 1) / TileSize;
+    m_TilesY = (height + TileSize - 1) / TileSize;
+    m_Pitch = m_TilesX * TileSize;
+
+    // Padded to whole tiles so the 4-wide inner loop never needs a tail
+    const size_t pixels = static_cast<size_t>(m_Pitch) * m_TilesY * TileSize;
+    m_Color.assign(pixels, m_ClearColor);
+    m_Depth.assign(pixels, m_ClearDepth);
+    return true;
+}
+
+void SoftwareRasterizer::Clear(float r, float g, float b, float a, float depth) {
+    m_ClearPending = true;
+    m_ClearColor = PackColor(r, g, b, a);
+    m_ClearDepth = depth;
+}
+
+void SoftwareRasterizer::DrawIndexed(const float* vertices, size_t vertexCount,
+                                     const unsigned int* indices, size_t indexCount,
+                                     const Math::Matrix4& mvp) {
+    if (!vertices || !indices || vertexCount == 0 || indexCount < 3) {
+        return;
+    }
+    DrawCommand draw;
+    draw.vertices = vertices;
+    draw.vertexCount = vertexCount;
+    draw.indices = indices;
+    draw.triangleCount = indexCount / 3;
+    draw.mvp = mvp;
+    draw.firstVertex = 0;
+    m_Draws.push_back(draw);
+}
+
+void SoftwareRasterizer::Flush() {
+    SHADOW_PROFILE_ZONE("SoftwareRasterizer::Flush");
+    m_Stats = FrameStats();
+    if (m_Width == 0 || (m_Draws.empty() && !m_ClearPending)) {
+        m_Draws.clear();
+        return;
+    }
+
+    auto frontEndStart = std::chrono::steady_clock::now();
+
+    // Phase 1: vertex transform, split into fixed-size ranges across all draws
+    size_t totalVertices = 0;
+    m_VertexJobs.clear();
+    for (size_t d = 0; d < m_Draws.size(); ++d) {
+        m_Draws[d].firstVertex = totalVertices;
+        totalVertices += m_Draws[d].vertexCount;
+        for (size_t v = 0; v < m_Draws[d].vertexCount; v += VerticesPerJob) {
+            m_VertexJobs.emplace_back(d, v);
+        }
+    }
+    m_ClipVertices.resize(totalVertices);
+    // Ranges are often whole small meshes, so let the job system batch them
+    m_Jobs->ParallelFor(m_VertexJobs.size(), 0, [this](size_t first, size_t last) {
+        for (size_t job = first; job < last; ++job) {
+            const DrawCommand& draw = m_Draws[m_VertexJobs[job].first];
+            size_t begin = m_VertexJobs[job].second;
+            TransformVertices(draw, begin, std::min(begin + VerticesPerJob, draw.vertexCount));
+        }
+    });
+
+    // Phase 2: clip, set up and bin triangles. Each chunk bins privately; the
+    // per-tile lists are then gathered chunk by chunk, so submission order is
+    // preserved per tile.
+    m_ActiveChunks = 0;
+    const size_t tileCount = static_cast<size_t>(m_TilesX) * m_TilesY;
+    for (size_t d = 0; d < m_Draws.size(); ++d) {
+        for (size_t t = 0; t < m_Draws[d].triangleCount; t += TrianglesPerChunk) {
+            if (m_ActiveChunks == m_Chunks.size()) {
+                m_Chunks.emplace_back();
+            }
+            Chunk& chunk = m_Chunks[m_ActiveChunks++];
+            chunk.draw = d;
+            chunk.firstTriangle = t;
+            chunk.triangleCount = std::min(TrianglesPerChunk, m_Draws[d].triangleCount - t);
+            m_Stats.submittedTriangles += chunk.triangleCount;
+        }
+    }
+    m_Jobs->ParallelFor(m_ActiveChunks, 1, [this](size_t first, size_t last) {
+        for (size_t index = first; index < last; ++index) {
+            ProcessChunk(m_Chunks[index]);
+        }
+    });
+
+    GatherTileLists();
+    m_Stats.frontEndMs = MillisecondsSince(frontEndStart);
+
+    // Phase 3: rasterize tiles independently
+    auto backEndStart = std::chrono::steady_clock::now();
+    m_Jobs->ParallelFor(tileCount, 1, [this](size_t first, size_t last) {
+        for (size_t tile = first; tile < last; ++tile) {
+            RasterizeTile(static_cast<int>(tile));
+        }
+    });
+    m_Stats.backEndMs = MillisecondsSince(backEndStart);
+
+    m_ClearPending = false;
+    m_Draws.clear();
+}
+
+void SoftwareRasterizer::TransformVertices(const DrawCommand& draw, size_t begin, size_t end) {
+    // Column-major, as uploaded to GL: clip = M * (x, y, z, 1)
+    const float* m = draw.mvp.GetData();
+    for (size_t i = begin; i < end; ++i) {
+        const float* in = draw.vertices + i * VertexStride;
+        ClipVertex& out = m_ClipVertices[draw.firstVertex + i];
+        out.x = m[0] * in[0] + m[4] * in[1] + m[8] * in[2] + m[12];
+        out.y = m[1] * in[0] + m[5] * in[1] + m[9] * in[2] + m[13];
+        out.z = m[2] * in[0] + m[6] * in[1] + m[10] * in[2] + m[14];
+        out.w = m[3] * in[0] + m[7] * in[1] + m[11] * in[2] + m[15];
+        out.r = in[3];
+        out.g = in[4];
+        out.b = in[5];
+    }
+}
+
+void SoftwareRasterizer::ProcessChunk(Chunk& chunk) {
+    chunk.triangles.clear();
+    chunk.bins.clear();
+    chunk.triangles.reserve(chunk.triangleCount * m_SetupPerTriangle);
+    chunk.bins.reserve(chunk.triangleCount * m_BinsPerTriangle);
+
+    const DrawCommand& draw = m_Draws[chunk.draw];
+    const ClipVertex* vertices = &m_ClipVertices[draw.firstVertex];
+
+    for (size_t t = chunk.firstTriangle; t < chunk.firstTriangle + chunk.triangleCount; ++t) {
+        unsigned int i0 = draw.indices[t * 3 + 0];
+        unsigned int i1 = draw.indices[t * 3 + 1];
+        unsigned int i2 = draw.indices[t * 3 + 2];
+        if (i0 >= draw.vertexCount || i1 >= draw.vertexCount || i2 >= draw.vertexCount) {
+            continue;
+        }
+
+        const ClipVertex* triangle[3] = {&vertices[i0], &vertices[i1], &vertices[i2]};
+
+        // Outcodes against every clip plane
+        unsigned codes[3] = {0, 0, 0};
+        for (int v = 0; v < 3; ++v) {
+            for (int p = 0; p < 6; ++p) {
+                const float* plane = ClipPlanes[p];
+                float distance = plane[0] * triangle[v]->x + plane[1] * triangle[v]->y +
+                                 plane[2] * triangle[v]->z + plane[3] * triangle[v]->w;
+                if (distance < 0.0f) codes[v] |= 1u << p;
+            }
+        }
+        if (codes[0] & codes[1] & codes[2]) {
+            continue;  // Entirely outside one plane
+        }
+        if ((codes[0] | codes[1] | codes[2]) == 0) {
+            SetupAndBin(*triangle[0], *triangle[1], *triangle[2], chunk);
+            continue;
+        }
+
+        // Sutherland-Hodgman against the planes that are actually crossed
+        ClipVertex polygon[9];
+        ClipVertex scratch[9];
+        int count = 3;
+        for (int v = 0; v < 3; ++v) polygon[v] = *triangle[v];
+
+        unsigned crossed = codes[0] | codes[1] | codes[2];
+        for (int p = 0; p < 6 && count >= 3; ++p) {
+            if (!(crossed & (1u << p))) continue;
+            const float* plane = ClipPlanes[p];
+            auto distanceTo = [plane](const ClipVertex& v) {
+                return plane[0] * v.x + plane[1] * v.y + plane[2] * v.z + plane[3] * v.w;
+            };
+
+            int outCount = 0;
+            for (int v = 0; v < count; ++v) {
+                const ClipVertex& a = polygon[v];
+                const ClipVertex& b = polygon[(v + 1) % count];
+                float da = distanceTo(a);
+                float db = distanceTo(b);
+                if (da >= 0.0f) scratch[outCount++] = a;
+                if ((da >= 0.0f) != (db >= 0.0f)) {
+                    float s = da / (da - db);
+                    ClipVertex& c = scratch[outCount++];
+                    c.x = a.x + (b.x - a.x) * s;
+                    c.y = a.y + (b.y - a.y) * s;
+                    c.z = a.z + (b.z - a.z) * s;
+                    c.w = a.w + (b.w - a.w) * s;
+                    c.r = a.r + (b.r - a.r) * s;
+                    c.g = a.g + (b.g - a.g) * s;
+                    c.b = a.b + (b.b - a.b) * s;
+                }
+            }
+            std::copy(scratch, scratch + outCount, polygon);
+            count = outCount;
+        }
+
+        for (int v = 1; v + 1 < count; ++v) {
+            SetupAndBin(polygon[0], polygon[v], polygon[v + 1], chunk);
+        }
+    }
+}
+
+void SoftwareRasterizer::SetupAndBin(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2,
+                                     Chunk& chunk) {
+    const ClipVertex* in[3] = {&v0, &v1, &v2};
+    float sx[3], sy[3], sz[3], invW[3];
+    for (int v = 0; v < 3; ++v) {
+        if (in[v]->w <= 0.0f) return;
+        invW[v] = 1.0f / in[v]->w;
+        float ndcX = in[v]->x * invW[v];
+        float ndcY = in[v]->y * invW[v];
+        float ndcZ = in[v]->z * invW[v];
+        sx[v] = std::floor((ndcX * 0.5f + 0.5f) * m_Width * SubpixelScale + 0.5f) / SubpixelScale;
+        sy[v] = std::floor((ndcY * 0.5f + 0.5f) * m_Height * SubpixelScale + 0.5f) / SubpixelScale;
+        sz[v] = ndcZ * 0.5f + 0.5f;
+    }
+
+    // Counter-clockwise (GL's default front face) has positive area with y up
+    float area = (sx[1] - sx[0]) * (sy[2] - sy[0]) - (sx[2] - sx[0]) * (sy[1] - sy[0]);
+    if (area == 0.0f) return;
+    int order[3] = {0, 1, 2};
+    if (area < 0.0f) {
+        if (m_CullBackFaces) return;
+        std::swap(order[1], order[2]);
+        area = -area;
+    }
+
+    SetupTriangle tri;
+
+    // Edge i is opposite vertex i: E(p) = (b - a) x (p - a), positive inside
+    for (int e = 0; e < 3; ++e) {
+        int a = order[(e + 1) % 3];
+        int b = order[(e + 2) % 3];
+        Plane& edge = tri.edges[e];
+        edge.a = sy[a] - sy[b];
+        edge.b = sx[b] - sx[a];
+        edge.c = -(edge.a * sx[a] + edge.b * sy[a]);
+        // Left edges run downward and top edges run right-to-left when y is up
+        tri.topLeft[e] = edge.a > 0.0f || (edge.a == 0.0f && edge.b < 0.0f);
+    }
+
+    // Barycentric weight of vertex i is edge i / area, so any attribute is a plane
+    const float invArea = 1.0f / area;
+    auto makePlane = [&](const float values[3]) {
+        Plane plane;
+        plane.a = (tri.edges[0].a * values[order[0]] + tri.edges[1].a * values[order[1]] +
+                   tri.edges[2].a * values[order[2]]) * invArea;
+        plane.b = (tri.edges[0].b * values[order[0]] + tri.edges[1].b * values[order[1]] +
+                   tri.edges[2].b * values[order[2]]) * invArea;
+        plane.c = (tri.edges[0].c * values[order[0]] + tri.edges[1].c * values[order[1]] +
+                   tri.edges[2].c * values[order[2]]) * invArea;
+        return plane;
+    };
+
+    // Depth is affine in screen space; colours are interpolated as c/w and 1/w
+    tri.depth = makePlane(sz);
+    tri.invW = makePlane(invW);
+    float red[3], green[3], blue[3];
+    for (int v = 0; v < 3; ++v) {
+        red[v] = in[v]->r * invW[v];
+        green[v] = in[v]->g * invW[v];
+        blue[v] = in[v]->b * invW[v];
+    }
+    tri.color[0] = makePlane(red);
+    tri.color[1] = makePlane(green);
+    tri.color[2] = makePlane(blue);
+
+    float minX = std::min({sx[0], sx[1], sx[2]});
+    float maxX = std::max({sx[0], sx[1], sx[2]});
+    float minY = std::min({sy[0], sy[1], sy[2]});
+    float maxY = std::max({sy[0], sy[1], sy[2]});
+    tri.minX = std::max(0, static_cast<int>(std::floor(minX)));
+    tri.minY = std::max(0, static_cast<int>(std::floor(minY)));
+    tri.maxX = std::min(m_Width, static_cast<int>(std::ceil(maxX)));
+    tri.maxY = std::min(m_Height, static_cast<int>(std::ceil(maxY)));
+    if (tri.minX >= tri.maxX || tri.minY >= tri.maxY) return;
+
+    const uint32_t index = static_cast<uint32_t>(chunk.triangles.size());
+    chunk.triangles.push_back(tri);
+
+    const int tileX0 = tri.minX / TileSize;
+    const int tileY0 = tri.minY / TileSize;
+    const int tileX1 = (tri.maxX - 1) / TileSize;
+    const int tileY1 = (tri.maxY - 1) / TileSize;
+    const bool singleTile = tileX0 == tileX1 && tileY0 == tileY1;
+
+    for (int ty = tileY0; ty <= tileY1; ++ty) {
+        for (int tx = tileX0; tx <= tileX1; ++tx) {
+            if (!singleTile) {
+                // Reject tiles that lie wholly outside one edge, using the tile
+                // corner where that edge function is largest
+                float left = tx * TileSize + 0.5f;
+                float right = (tx + 1) * TileSize - 0.5f;
+                float bottom = ty * TileSize + 0.5f;
+                float top = (ty + 1) * TileSize - 0.5f;
+                bool outside = false;
+                for (int e = 0; e < 3 && !outside; ++e) {
+                    const Plane& edge = tri.edges[e];
+                    float x = edge.a > 0.0f ? right : left;
+                    float y = edge.b > 0.0f ? top : bottom;
+                    outside = edge.a * x + edge.b * y + edge.c < 0.0f;
+                }
+                if (outside) continue;
+            }
+            chunk.bins.push_back(BinEntry{static_cast<uint32_t>(ty * m_TilesX + tx), index});
+        }
+    }
+}
+
+void SoftwareRasterizer::GatherTileLists() {
+    // Counting sort of every bin entry by tile. Flat lists keep the memory
+    // proportional to the entries rather than chunks times tiles, and reach a
+    // steady size after a few frames.
+    const size_t tileCount = static_cast<size_t>(m_TilesX) * m_TilesY;
+    m_TileOffsets.assign(tileCount + 1, 0);
+    for (size_t c = 0; c < m_ActiveChunks; ++c) {
+        const Chunk& chunk = m_Chunks[c];
+        m_Stats.rasterizedTriangles += chunk.triangles.size();
+        while (chunk.triangleCount * m_SetupPerTriangle < chunk.triangles.size()) {
+            m_SetupPerTriangle *= 2;
+        }
+        while (chunk.triangleCount * m_BinsPerTriangle < chunk.bins.size()) {
+            m_BinsPerTriangle *= 2;
+        }
+        for (const BinEntry& entry : chunk.bins) {
+            ++m_TileOffsets[entry.tile + 1];
+        }
+    }
+    for (size_t tile = 0; tile < tileCount; ++tile) {
+        m_TileOffsets[tile + 1] += m_TileOffsets[tile];
+    }
+    m_Stats.binnedTiles = m_TileOffsets[tileCount];
+
+    m_TileCursors.assign(m_TileOffsets.begin(), m_TileOffsets.end() - 1);
+    m_TileEntries.resize(m_TileOffsets[tileCount]);
+    for (size_t c = 0; c < m_ActiveChunks; ++c) {
+        for (const BinEntry& entry : m_Chunks[c].bins) {
+            m_TileEntries[m_TileCursors[entry.tile]++] = TileEntry{static_cast<uint32_t>(c), entry.triangle};
+        }
+    }
+}
+
+void SoftwareRasterizer::RasterizeTile(int tileIndex) {
+    const int tileX = tileIndex % m_TilesX;
+    const int tileY = tileIndex / m_TilesX;
+    const int x0 = tileX * TileSize;
+    const int y0 = tileY * TileSize;
+
+    if (m_ClearPending) {
+        for (int y = y0; y < y0 + TileSize; ++y) {
+            size_t row = static_cast<size_t>(y) * m_Pitch + x0;
+            std::fill(&m_Color[row], &m_Color[row] + TileSize, m_ClearColor);
+            std::fill(&m_Depth[row], &m_Depth[row] + TileSize, m_ClearDepth);
+        }
+    }
+
+    const uint32_t end = m_TileOffsets[static_cast<size_t>(tileIndex) + 1];
+    for (uint32_t i = m_TileOffsets[static_cast<size_t>(tileIndex)]; i < end; ++i) {
+        const TileEntry& entry = m_TileEntries[i];
+        const SetupTriangle& tri = m_Chunks[entry.chunk].triangles[entry.triangle];
+        RasterizeTriangle(tri,
+                          std::max(tri.minX, x0), std::max(tri.minY, y0),
+                          std::min(tri.maxX, x0 + TileSize), std::min(tri.maxY, y0 + TileSize));
+    }
+}
+
+void SoftwareRasterizer::RasterizeTriangle(const SetupTriangle& tri, int x0, int y0, int x1, int y1) {
+#ifdef SHADOW_RASTERIZER_SSE2
+    // Four pixels per step; the row start is aligned down, which stays inside the
+    // tile because tiles are multiples of four wide
+    const int xStart = x0 & ~3;
+    const __m128 laneOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(255.0f);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+
+    __m128 edgeA[3], topLeft[3];
+    for (int e = 0; e < 3; ++e) {
+        edgeA[e] = _mm_set1_ps(tri.edges[e].a);
+        topLeft[e] = _mm_castsi128_ps(_mm_set1_epi32(tri.topLeft[e] ? -1 : 0));
+    }
+    const __m128 depthA = _mm_set1_ps(tri.depth.a);
+    const __m128 invWA = _mm_set1_ps(tri.invW.a);
+    const __m128 colorA[3] = {_mm_set1_ps(tri.color[0].a), _mm_set1_ps(tri.color[1].a),
+                              _mm_set1_ps(tri.color[2].a)};
+
+    for (int y = y0; y < y1; ++y) {
+        const float py = y + 0.5f;
+        __m128 edgeRow[3];
+        for (int e = 0; e < 3; ++e) {
+            edgeRow[e] = _mm_set1_ps(tri.edges[e].b * py + tri.edges[e].c);
+        }
+        const __m128 depthRow = _mm_set1_ps(tri.depth.b * py + tri.depth.c);
+        const __m128 invWRow = _mm_set1_ps(tri.invW.b * py + tri.invW.c);
+        const __m128 colorRow[3] = {_mm_set1_ps(tri.color[0].b * py + tri.color[0].c),
+                                    _mm_set1_ps(tri.color[1].b * py + tri.color[1].c),
+                                    _mm_set1_ps(tri.color[2].b * py + tri.color[2].c)};
+
+        uint32_t* colorOut = &m_Color[static_cast<size_t>(y) * m_Pitch];
+        float* depthOut = &m_Depth[static_cast<size_t>(y) * m_Pitch];
+
+        for (int x = xStart; x < x1; x += 4) {
+            const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffsets);
+
+            __m128 mask = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (int e = 0; e < 3; ++e) {
+                __m128 value = _mm_add_ps(_mm_mul_ps(edgeA[e], px), edgeRow[e]);
+                __m128 inside = _mm_or_ps(_mm_cmpgt_ps(value, zero),
+                                          _mm_and_ps(_mm_cmpeq_ps(value, zero), topLeft[e]));
+                mask = _mm_and_ps(mask, inside);
+            }
+            if (_mm_movemask_ps(mask) == 0) continue;
+
+            const __m128 z = _mm_add_ps(_mm_mul_ps(depthA, px), depthRow);
+            const __m128 oldZ = _mm_loadu_ps(depthOut + x);
+            mask = _mm_and_ps(mask, _mm_cmplt_ps(z, oldZ));
+            if (_mm_movemask_ps(mask) == 0) continue;
+
+            _mm_storeu_ps(depthOut + x, _mm_or_ps(_mm_and_ps(mask, z), _mm_andnot_ps(mask, oldZ)));
+
+            const __m128 w = _mm_div_ps(one, _mm_add_ps(_mm_mul_ps(invWA, px), invWRow));
+            __m128i packed = alpha;
+            for (int channel = 0; channel < 3; ++channel) {
+                __m128 value = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(colorA[channel], px), colorRow[channel]), w);
+                value = _mm_mul_ps(_mm_min_ps(_mm_max_ps(value, zero), one), scale);
+                packed = _mm_or_si128(packed, _mm_slli_epi32(_mm_cvtps_epi32(value), channel * 8));
+            }
+
+            __m128i* target = reinterpret_cast<__m128i*>(colorOut + x);
+            const __m128i oldColor = _mm_loadu_si128(target);
+            const __m128i maskBits = _mm_castps_si128(mask);
+            _mm_storeu_si128(target, _mm_or_si128(_mm_and_si128(maskBits, packed),
+                                                  _mm_andnot_si128(maskBits, oldColor)));
+        }
+    }
+#else
+    for (int y = y0; y < y1; ++y) {
+        const float py = y + 0.5f;
+        uint32_t* colorOut = &m_Color[static_cast<size_t>(y) * m_Pitch];
+        float* depthOut = &m_Depth[static_cast<size_t>(y) * m_Pitch];
+
+        for (int x = x0; x < x1; ++x) {
+            const float px = x + 0.5f;
+            bool inside = true;
+            for (int e = 0; e < 3 && inside; ++e) {
+                float value = tri.edges[e].a * px + tri.edges[e].b * py + tri.edges[e].c;
+                inside = value > 0.0f || (value == 0.0f && tri.topLeft[e]);
+            }
+            if (!inside) continue;
+
+            float z = tri.depth.a * px + tri.depth.b * py + tri.depth.c;
+            if (!(z < depthOut[x])) continue;
+            depthOut[x] = z;
+
+            float w = 1.0f / (tri.invW.a * px + tri.invW.b * py + tri.invW.c);
+            float rgb[3];
+            for (int channel = 0; channel < 3; ++channel) {
+                const Plane& plane = tri.color[channel];
+                rgb[channel] = (plane.a * px + plane.b * py + plane.c) * w;
+            }
+            colorOut[x] = PackColor(rgb[0], rgb[1], rgb[2], 1.0f);
+        }
+    }
+#endif
+}
+
+void SoftwareRasterizer::ReadPixels(ImageLoader::ImageData& out) const {
+    out.width = m_Width;
+    out.height = m_Height;
+    out.channels = 4;
+    out.data.resize(static_cast<size_t>(m_Width) * m_Height * 4);
+    for (int y = 0; y < m_Height; ++y) {
+        std::memcpy(&out.data[static_cast<size_t>(y) * m_Width * 4],
+                    &m_Color[static_cast<size_t>(y) * m_Pitch], static_cast<size_t>(m_Width) * 4);
+    }
+}
+
+} // namespace Rendering
+} // namespace ShadowEngine
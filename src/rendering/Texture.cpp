@@ -0,0 +1,151 @@
+#include "rendering/Texture.hpp"
+#include "rendering/GLStateCache.hpp"
+#include "rendering/GLDebugOutput.hpp"
+#include "core/CompressedTextureFile.hpp"
+#include "core/Log.hpp"
+#include "core/MemoryTracker.hpp"
+#include "core/Profiler.hpp"
+#include <cstring>
+
+namespace ShadowEngine {
+namespace Rendering {
+
+namespace {
+
+// S3TC enums come from GL_EXT_texture_compression_s3tc / GL_EXT_texture_sRGB,
+// which the core-only glad loader does not define
+constexpr GLenum COMPRESSED_RGB_S3TC_DXT1 = 0x83F0;
+constexpr GLenum COMPRESSED_RGBA_S3TC_DXT5 = 0x83F3;
+constexpr GLenum COMPRESSED_SRGB_S3TC_DXT1 = 0x8C4C;
+constexpr GLenum COMPRESSED_SRGB_ALPHA_S3TC_DXT5 = 0x8C4F;
+
+GLenum GetInternalFormat(BlockCompression::Format format, bool srgb) {
+    switch (format) {
+        case BlockCompression::Format::BC1: return srgb ? COMPRESSED_SRGB_S3TC_DXT1 : COMPRESSED_RGB_S3TC_DXT1;
+        case BlockCompression::Format::BC3: return srgb ? COMPRESSED_SRGB_ALPHA_S3TC_DXT5 : COMPRESSED_RGBA_S3TC_DXT5;
+        case BlockCompression::Format::BC4: return GL_COMPRESSED_RED_RGTC1;
+        case BlockCompression::Format::BC5: return GL_COMPRESSED_RG_RGTC2;
+        case BlockCompression::Format::BC7: return srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+    }
+    return 0;
+}
+
+bool HasExtension(const char* name) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i) {
+        const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+        if (extension && std::strcmp(extension, name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool IsFormatSupported(BlockCompression::Format format) {
+    switch (format) {
+        case BlockCompression::Format::BC1:
+        case BlockCompression::Format::BC3: {
+            static const bool s3tc = HasExtension("GL_EXT_texture_compression_s3tc");
+            return s3tc;
+        }
+        case BlockCompression::Format::BC4:
+        case BlockCompression::Format::BC5:
+            return true;  // Core since GL 3.0
+        case BlockCompression::Format::BC7: {
+            static const bool bptc = GLAD_GL_VERSION_4_2 || HasExtension("GL_ARB_texture_compression_bptc");
+            return bptc;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+Texture::Texture()
+    : m_TextureID(0)
+    , m_Width(0)
+    , m_Height(0)
+    , m_LevelCount(0)
+    , m_FinestResidentLevel(0)
+    , m_ResidentBytes(0)
+    , m_PendingFormat(PixelConversion::Format::RGBA8)
+{
+}
+
+Texture::~Texture() {
+    if (m_TextureID != 0) {
+        GLStateCache::Get().DeleteTexture(m_TextureID);
+    }
+    MemoryTracker::Remove(MemoryTag::Assets, MemoryDomain::Gpu, m_ResidentBytes);
+}
+
+void Texture::AddResidentBytes(size_t bytes) {
+    m_ResidentBytes += bytes;
+    MemoryTracker::Add(MemoryTag::Assets, MemoryDomain::Gpu, bytes);
+}
+
+void Texture::Bind(GLuint unit) const {
+    GLStateCache::Get().BindTexture(unit, GL_TEXTURE_2D, m_TextureID);
+}
+
+size_t Texture::GetPendingBytes() const {
+    size_t bytes = 0;
+    for (const ImageLoader::ImageData& level : m_PendingLevels) {
+        bytes += level.data.size();
+    }
+    return bytes;
+}
+
+std::shared_ptr<Texture> Texture::LoadCompressed(const std::string& path) {
+    SHADOW_PROFILE_ZONE("Texture::LoadCompressed");
+    CompressedTextureFile file;
+    if (!file.Open(path)) {
+        return nullptr;
+    }
+    return CreateCompressed(path, file);
+}
+
+std::shared_ptr<Texture> Texture::CreateCompressed(const std::string& name, const CompressedTextureFile& file) {
+    if (!IsFormatSupported(file.GetFormat())) {
+        SHADOW_LOG_ERROR(Rendering, "Driver does not support {} textures: {}",
+                         BlockCompression::GetFormatName(file.GetFormat()), name);
+        return nullptr;
+    }
+
+    auto texture = std::make_shared<Texture>();
+    texture->m_Name = name;
+    texture->m_Width = file.GetWidth();
+    texture->m_Height = file.GetHeight();
+    texture->m_LevelCount = file.GetMipCount();
+    texture->m_FinestResidentLevel = 0;
+
+    GLStateCache& state = GLStateCache::Get();
+    glGenTextures(1, &texture->m_TextureID);
+    texture->Bind(0);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                    texture->m_LevelCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, texture->m_LevelCount - 1);
+
+    // Payloads are already in the driver's block layout, so each mip range of the
+    // mapping goes straight to the driver with no decode or staging copy.
+    const GLenum internalFormat = GetInternalFormat(file.GetFormat(), file.IsSRGB());
+    state.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    for (int level = 0; level < file.GetMipCount(); ++level) {
+        const CompressedTextureFile::Mip& mip = file.GetMip(level);
+        glCompressedTexImage2D(GL_TEXTURE_2D, level, internalFormat, mip.width, mip.height, 0,
+                               static_cast<GLsizei>(mip.size), mip.data);
+        texture->AddResidentBytes(mip.size);
+    }
+
+    GLDebugOutput::Get().LabelObject(GL_TEXTURE, texture->m_TextureID, name);
+    return texture;
+}
+
+} // namespace Rendering
+} // namespace ShadowEngine
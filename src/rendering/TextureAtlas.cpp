@@ -0,0 +1,245 @@
+#include "rendering/TextureAtlas.hpp"
+#include "core/Log.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace ShadowEngine {
+namespace Rendering {
+
+namespace {
+
+struct Rect {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+};
+
+bool Contains(const Rect& outer, const Rect& inner) {
+    return inner.x >= outer.x && inner.y >= outer.y &&
+           inner.x + inner.width <= outer.x + outer.width &&
+           inner.y + inner.height <= outer.y + outer.height;
+}
+
+bool Intersects(const Rect& a, const Rect& b) {
+    return a.x < b.x + b.width && b.x < a.x + a.width &&
+           a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+// MaxRects bin packer with the best short side fit heuristic
+class MaxRectsPacker {
+public:
+    explicit MaxRectsPacker(int size) {
+        m_FreeRects.push_back({0, 0, size, size});
+    }
+
+    bool Insert(int width, int height, Rect& placed) {
+        int bestShort = std::numeric_limits<int>::max();
+        int bestLong = std::numeric_limits<int>::max();
+        bool found = false;
+
+        for (const Rect& free : m_FreeRects) {
+            if (free.width < width || free.height < height) continue;
+            int leftoverX = free.width - width;
+            int leftoverY = free.height - height;
+            int shortSide = std::min(leftoverX, leftoverY);
+            int longSide = std::max(leftoverX, leftoverY);
+            if (shortSide < bestShort || (shortSide == bestShort && longSide < bestLong)) {
+                placed = {free.x, free.y, width, height};
+                bestShort = shortSide;
+                bestLong = longSide;
+                found = true;
+            }
+        }
+
+        if (!found) {
+            return false;
+        }
+
+        SplitFreeRects(placed);
+        PruneFreeRects();
+        return true;
+    }
+
+private:
+    void SplitFreeRects(const Rect& used) {
+        std::vector<Rect> next;
+        next.reserve(m_FreeRects.size() + 4);
+        for (const Rect& free : m_FreeRects) {
+            if (!Intersects(free, used)) {
+                next.push_back(free);
+                continue;
+            }
+            // Keep the maximal remainders on each side of the used rect
+            if (used.x > free.x) {
+                next.push_back({free.x, free.y, used.x - free.x, free.height});
+            }
+            if (used.x + used.width < free.x + free.width) {
+                next.push_back({used.x + used.width, free.y,
+                                free.x + free.width - (used.x + used.width), free.height});
+            }
+            if (used.y > free.y) {
+                next.push_back({free.x, free.y, free.width, used.y - free.y});
+            }
+            if (used.y + used.height < free.y + free.height) {
+                next.push_back({free.x, used.y + used.height, free.width,
+                                free.y + free.height - (used.y + used.height)});
+            }
+        }
+        m_FreeRects.swap(next);
+    }
+
+    void PruneFreeRects() {
+        for (size_t i = 0; i < m_FreeRects.size(); ++i) {
+            for (size_t j = i + 1; j < m_FreeRects.size(); ++j) {
+                if (Contains(m_FreeRects[j], m_FreeRects[i])) {
+                    m_FreeRects.erase(m_FreeRects.begin() + static_cast<std::ptrdiff_t>(i));
+                    --i;
+                    break;
+                }
+                if (Contains(m_FreeRects[i], m_FreeRects[j])) {
+                    m_FreeRects.erase(m_FreeRects.begin() + static_cast<std::ptrdiff_t>(j));
+                    --j;
+                }
+            }
+        }
+    }
+
+    std::vector<Rect> m_FreeRects;
+};
+
+int AlignUp(int value, int alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// Copy the image into the cell and extrude its edge texels across the gutter
+void BlitWithGutter(const ImageLoader::ImageData& image, const Rect& cell, int gutter,
+                    ImageLoader::ImageData& page) {
+    for (int y = 0; y < cell.height; ++y) {
+        int sy = std::min(std::max(y - gutter, 0), image.height - 1);
+        unsigned char* dst = &page.data[(static_cast<size_t>(cell.y + y) * page.width + cell.x) * 4];
+        for (int x = 0; x < cell.width; ++x) {
+            int sx = std::min(std::max(x - gutter, 0), image.width - 1);
+            std::memcpy(dst + x * 4, &image.data[(static_cast<size_t>(sy) * image.width + sx) * 4], 4);
+        }
+    }
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// TextureAtlas
+// ---------------------------------------------------------------------------
+
+const AtlasRegion* TextureAtlas::FindRegion(const std::string& name) const {
+    auto it = m_Regions.find(name);
+    return it != m_Regions.end() ? &it->second : nullptr;
+}
+
+// ---------------------------------------------------------------------------
+// TextureAtlasBuilder
+// ---------------------------------------------------------------------------
+
+void TextureAtlasBuilder::Add(const std::string& name, ImageLoader::ImageData image) {
+    m_Images.push_back({name, std::move(image)});
+}
+
+bool TextureAtlasBuilder::AddFromFile(const std::string& path) {
+    ImageLoader::ImageData image;
+    if (!ImageLoader::LoadImage(path, image)) {
+        return false;
+    }
+    Add(path, std::move(image));
+    return true;
+}
+
+bool TextureAtlasBuilder::Build(const Options& options, TextureAtlas& outAtlas) const {
+    const int mipLevels = std::max(1, options.mipLevels);
+    // Cells aligned to 2^(levels-1) texels map to whole texels on every protected
+    // level, and a gutter of that size keeps bilinear taps inside the cell.
+    const int alignment = 1 << (mipLevels - 1);
+    const int gutter = std::max(options.padding, alignment);
+
+    if (options.pageSize <= 0 || options.pageSize % alignment != 0) {
+        SHADOW_LOG_ERROR(Rendering, "Atlas page size {} must be a multiple of {}", options.pageSize, alignment);
+        return false;
+    }
+
+    // Largest first packs tighter
+    std::vector<size_t> order(m_Images.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        const auto& ia = m_Images[a].image;
+        const auto& ib = m_Images[b].image;
+        int maxA = std::max(ia.width, ia.height);
+        int maxB = std::max(ib.width, ib.height);
+        return maxA != maxB ? maxA > maxB : ia.width * ia.height > ib.width * ib.height;
+    });
+
+    outAtlas = TextureAtlas();
+    outAtlas.m_PageSize = options.pageSize;
+    outAtlas.m_MipLevels = mipLevels;
+
+    std::vector<MaxRectsPacker> packers;
+    for (size_t index : order) {
+        const Entry& entry = m_Images[index];
+        const ImageLoader::ImageData& image = entry.image;
+        if (image.channels != 4 || image.width <= 0 || image.height <= 0) {
+            SHADOW_LOG_ERROR(Rendering, "Atlas input must be RGBA8: {}", entry.name);
+            return false;
+        }
+
+        int cellWidth = AlignUp(image.width + 2 * gutter, alignment);
+        int cellHeight = AlignUp(image.height + 2 * gutter, alignment);
+        if (cellWidth > options.pageSize || cellHeight > options.pageSize) {
+            SHADOW_LOG_ERROR(Rendering, "Image does not fit an atlas page: {}", entry.name);
+            return false;
+        }
+
+        Rect cell;
+        int page = -1;
+        for (size_t p = 0; p < packers.size() && page < 0; ++p) {
+            if (packers[p].Insert(cellWidth, cellHeight, cell)) {
+                page = static_cast<int>(p);
+            }
+        }
+        if (page < 0) {
+            if (static_cast<int>(packers.size()) >= options.maxPages) {
+                SHADOW_LOG_ERROR(Rendering, "Atlas exceeded {} pages", options.maxPages);
+                return false;
+            }
+            packers.emplace_back(options.pageSize);
+            packers.back().Insert(cellWidth, cellHeight, cell);
+            page = static_cast<int>(packers.size()) - 1;
+
+            ImageLoader::ImageData blank;
+            blank.width = options.pageSize;
+            blank.height = options.pageSize;
+            blank.channels = 4;
+            blank.data.assign(static_cast<size_t>(options.pageSize) * options.pageSize * 4, 0);
+            outAtlas.m_Pages.push_back(std::move(blank));
+        }
+
+        BlitWithGutter(image, cell, gutter, outAtlas.m_Pages[static_cast<size_t>(page)]);
+
+        AtlasRegion& region = outAtlas.m_Regions[entry.name];
+        region.page = page;
+        region.x = cell.x + gutter;
+        region.y = cell.y + gutter;
+        region.width = image.width;
+        region.height = image.height;
+        const float invSize = 1.0f / static_cast<float>(options.pageSize);
+        region.uvOffset[0] = region.x * invSize;
+        region.uvOffset[1] = region.y * invSize;
+        region.uvScale[0] = region.width * invSize;
+        region.uvScale[1] = region.height * invSize;
+    }
+
+    return true;
+}
+
+} // namespace Rendering
+} // namespace ShadowEngine
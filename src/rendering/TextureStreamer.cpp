@@ -0,0 +1,265 @@
+#include "rendering/TextureStreamer.hpp"
+#include "rendering/Texture.hpp"
+#include "rendering/GLStateCache.hpp"
+#include "rendering/GLDebugOutput.hpp"
+#include "core/Log.hpp"
+#include "core/MemoryTracker.hpp"
+#include "core/MipGenerator.hpp"
+#include "core/Profiler.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace ShadowEngine {
+namespace Rendering {
+
+namespace {
+
+// Define a level of the bound texture from pixels in format, read from client
+// memory or, with an unpack buffer bound, from an offset into it
+void TexImage(PixelConversion::Format format, int level, int width, int height, const void* pixels) {
+    switch (format) {
+        case PixelConversion::Format::RGBA8:
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+            break;
+        case PixelConversion::Format::RGBA16F:
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA16F, width, height, 0, GL_RGBA, GL_HALF_FLOAT, pixels);
+            break;
+        case PixelConversion::Format::RGB565:
+            // GL_RGB565 is core from 4.1; before that GL_RGB5 is the nearest
+            // sized format. Two-byte texels leave odd-width rows off the
+            // default four-byte row alignment.
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+            glTexImage2D(GL_TEXTURE_2D, level, GLAD_GL_VERSION_4_1 ? GL_RGB565 : GL_RGB5, width, height, 0,
+                         GL_RGB, GL_UNSIGNED_SHORT_5_6_5, pixels);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+            break;
+    }
+}
+
+} // namespace
+
+TextureStreamer::TextureStreamer()
+    : m_NextSlot(0)
+    , m_FrameBudget(0)
+    , m_IsInitialized(false)
+{
+}
+
+TextureStreamer::~TextureStreamer() {
+    Shutdown();
+}
+
+bool TextureStreamer::Initialize(size_t frameBudgetBytes, int stagingSlots) {
+    if (m_IsInitialized) {
+        return true;
+    }
+    if (stagingSlots <= 0) {
+        SHADOW_LOG_ERROR(Rendering, "TextureStreamer: at least one staging buffer is required");
+        return false;
+    }
+
+    m_FrameBudget = frameBudgetBytes;
+    m_Slots.resize(static_cast<size_t>(stagingSlots));
+    for (size_t i = 0; i < m_Slots.size(); ++i) {
+        glGenBuffers(1, &m_Slots[i].buffer);
+        // Buffers are sized on first use; binding once creates the object for labeling
+        GLStateCache::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, m_Slots[i].buffer);
+        GLDebugOutput::Get().LabelObject(GL_BUFFER, m_Slots[i].buffer,
+                                         "Texture staging " + std::to_string(i));
+    }
+    GLStateCache::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    m_NextSlot = 0;
+    m_IsInitialized = true;
+    return true;
+}
+
+void TextureStreamer::Shutdown() {
+    if (!m_IsInitialized) {
+        return;
+    }
+
+    for (StagingSlot& slot : m_Slots) {
+        if (slot.fence) {
+            glDeleteSync(slot.fence);
+        }
+        GLStateCache::Get().DeleteBuffer(slot.buffer);
+        MemoryTracker::Remove(MemoryTag::Rendering, MemoryDomain::Gpu, slot.capacity);
+    }
+    m_Slots.clear();
+    m_Queue.clear();
+    m_Textures.clear();
+    m_IsInitialized = false;
+}
+
+std::shared_ptr<Texture> TextureStreamer::CreateTexture(const std::string& name, ImageLoader::ImageData image) {
+    if (!m_IsInitialized || image.width <= 0 || image.height <= 0 || image.channels != 4) {
+        return nullptr;
+    }
+
+    return CreateTexture(name, MipGenerator::Build(std::move(image)));
+}
+
+std::shared_ptr<Texture> TextureStreamer::CreateTexture(const std::string& name,
+                                                        std::vector<ImageLoader::ImageData> levels,
+                                                        PixelConversion::Format format) {
+    if (!m_IsInitialized || levels.empty() || levels[0].width <= 0 || levels[0].height <= 0 ||
+        levels[0].data.size() != static_cast<size_t>(levels[0].width) * levels[0].height *
+                                 PixelConversion::GetBytesPerPixel(format)) {
+        return nullptr;
+    }
+
+    auto texture = std::make_shared<Texture>();
+    texture->m_Name = name;
+    texture->m_Width = levels[0].width;
+    texture->m_Height = levels[0].height;
+    texture->m_PendingLevels = std::move(levels);
+    texture->m_PendingFormat = format;
+    texture->m_LevelCount = static_cast<int>(texture->m_PendingLevels.size());
+
+    GLStateCache& state = GLStateCache::Get();
+    glGenTextures(1, &texture->m_TextureID);
+    texture->Bind(0);
+
+    const int tailLevel = texture->m_LevelCount - 1;
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, tailLevel);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, tailLevel);
+
+    // The tail (normally 1x1, a few bytes) is uploaded from client memory right away
+    // to make the texture complete, so draws can sample it before streaming starts.
+    const ImageLoader::ImageData& tail = texture->m_PendingLevels.back();
+    state.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    TexImage(format, tailLevel, tail.width, tail.height, tail.data.data());
+    texture->AddResidentBytes(tail.data.size());
+    texture->m_FinestResidentLevel = tailLevel;
+    texture->m_PendingLevels.pop_back();
+
+    GLDebugOutput::Get().LabelObject(GL_TEXTURE, texture->m_TextureID, name);
+
+    if (!texture->m_PendingLevels.empty()) {
+        m_Queue.push_back(texture);
+    }
+
+    m_Textures.erase(std::remove_if(m_Textures.begin(), m_Textures.end(),
+                                    [](const std::weak_ptr<Texture>& weak) { return weak.expired(); }),
+                     m_Textures.end());
+    m_Textures.push_back(texture);
+    return texture;
+}
+
+TextureStreamer::StagingSlot* TextureStreamer::AcquireSlot(size_t bytes) {
+    // Slots are used strictly in ring order, so if the oldest one is still in
+    // flight every other one is too.
+    StagingSlot& slot = m_Slots[m_NextSlot];
+    if (slot.fence) {
+        GLenum status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        if (status == GL_TIMEOUT_EXPIRED) {
+            return nullptr;
+        }
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+    }
+
+    GLStateCache::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+    if (slot.capacity < bytes) {
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_DRAW);
+        MemoryTracker::Remove(MemoryTag::Rendering, MemoryDomain::Gpu, slot.capacity);
+        MemoryTracker::Add(MemoryTag::Rendering, MemoryDomain::Gpu, bytes);
+        slot.capacity = bytes;
+    }
+
+    m_NextSlot = (m_NextSlot + 1) % m_Slots.size();
+    return &slot;
+}
+
+bool TextureStreamer::UploadNextLevel(Texture& texture) {
+    const int levelIndex = texture.m_FinestResidentLevel - 1;
+    const ImageLoader::ImageData& level = texture.m_PendingLevels.back();
+    const size_t bytes = level.data.size();
+
+    StagingSlot* slot = AcquireSlot(bytes);
+    if (!slot) {
+        ++m_LastFrame.stalledSlots;
+        return false;
+    }
+
+    // The fence guarantees the GPU is done with this range, so skip the driver's sync
+    void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(bytes),
+                                    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (!mapped) {
+        SHADOW_LOG_ERROR(Rendering, "TextureStreamer: failed to map staging buffer for {}", texture.m_Name);
+        return false;
+    }
+    std::memcpy(mapped, level.data.data(), bytes);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+    // Sourcing from the bound unpack buffer makes this an asynchronous copy
+    texture.Bind(0);
+    TexImage(texture.m_PendingFormat, levelIndex, level.width, level.height, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, levelIndex);
+    slot->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    texture.m_FinestResidentLevel = levelIndex;
+    texture.AddResidentBytes(bytes);
+    texture.m_PendingLevels.pop_back();
+
+    m_LastFrame.uploadedBytes += bytes;
+    ++m_LastFrame.uploadedLevels;
+    return true;
+}
+
+void TextureStreamer::Update() {
+    SHADOW_PROFILE_ZONE("TextureStreamer::Update");
+    if (!m_IsInitialized) {
+        return;
+    }
+
+    m_LastFrame = FrameStats();
+
+    while (!m_Queue.empty()) {
+        std::shared_ptr<Texture> texture = m_Queue.front().lock();
+        if (!texture || texture->m_PendingLevels.empty()) {
+            m_Queue.pop_front();
+            continue;
+        }
+
+        // A level larger than the whole budget still goes through when it is the
+        // first upload of the frame, otherwise big textures would never finish.
+        size_t bytes = texture->m_PendingLevels.back().data.size();
+        if (m_LastFrame.uploadedBytes > 0 && m_LastFrame.uploadedBytes + bytes > m_FrameBudget) {
+            break;
+        }
+
+        if (!UploadNextLevel(*texture)) {
+            break;
+        }
+
+        // Round-robin so every queued texture gets its coarse levels before any
+        // texture gets its finest ones
+        m_Queue.pop_front();
+        if (!texture->m_PendingLevels.empty()) {
+            m_Queue.push_back(texture);
+        } else {
+            texture->m_PendingLevels.shrink_to_fit();
+        }
+    }
+
+    GLStateCache::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+size_t TextureStreamer::GetTotalResidentBytes() const {
+    size_t total = 0;
+    for (const auto& weak : m_Textures) {
+        if (auto texture = weak.lock()) {
+            total += texture->GetResidentBytes();
+        }
+    }
+    return total;
+}
+
+} // namespace Rendering
+} // namespace ShadowEngine
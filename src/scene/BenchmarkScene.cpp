@@ -0,0 +1,108 @@
+#include "scene/Scene.hpp"
+#include "rendering/RenderSystem.hpp"
+#include "rendering/Mesh.hpp"
+#include "rendering/Shader.hpp"
+#include "core/Log.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace ShadowEngine {
+
+namespace {
+
+constexpr float GridSpacing = 3.0f;
+constexpr unsigned int MeshVariants = 4;
+
+} // namespace
+
+BenchmarkScene::BenchmarkScene(Rendering::RenderSystem& renderSystem, size_t objectCount)
+    : m_RenderSystem(renderSystem)
+    , m_ObjectCount(objectCount) {}
+
+void BenchmarkScene::OnAttach() {
+    // Cube variants differing only in tint, so draws sort into several mesh runs
+    const float corners[8][3] = {
+        {-0.5f, -0.5f,  0.5f}, { 0.5f, -0.5f,  0.5f}, { 0.5f,  0.5f,  0.5f}, {-0.5f,  0.5f,  0.5f},
+        {-0.5f, -0.5f, -0.5f}, { 0.5f, -0.5f, -0.5f}, { 0.5f,  0.5f, -0.5f}, {-0.5f,  0.5f, -0.5f},
+    };
+    const std::vector<unsigned int> indices = {
+        0, 1, 2, 2, 3, 0,  5, 4, 7, 7, 6, 5,  4, 0, 3, 3, 7, 4,
+        1, 5, 6, 6, 2, 1,  3, 2, 6, 6, 7, 3,  4, 5, 1, 1, 0, 4,
+    };
+    for (unsigned int variant = 0; variant < MeshVariants; ++variant) {
+        std::vector<float> vertices;
+        for (int i = 0; i < 8; ++i) {
+            vertices.insert(vertices.end(), {corners[i][0], corners[i][1], corners[i][2],
+                                             (variant & 1) ? 1.0f : 0.3f + 0.1f * i,
+                                             (variant & 2) ? 1.0f : 0.3f + 0.05f * i,
+                                             0.4f + 0.15f * variant});
+        }
+        auto mesh = m_RenderSystem.CreateMesh(vertices, indices);
+        if (!mesh) {
+            return;
+        }
+        m_Meshes.push_back(mesh);
+    }
+
+    m_Shader = m_RenderSystem.CreateShader("shaders/basic.vert", "shaders/basic.frag");
+    if (!m_Shader) {
+        return;
+    }
+
+    // Fill a cube-shaped grid centred on the origin
+    const size_t side = static_cast<size_t>(std::ceil(std::cbrt(static_cast<double>(m_ObjectCount))));
+    m_Extent = 0.5f * GridSpacing * static_cast<float>(side);
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    m_Objects.resize(m_ObjectCount);
+    for (size_t i = 0; i < m_ObjectCount; ++i) {
+        Object& object = m_Objects[i];
+        object.position[0] = (static_cast<float>(i % side) + 0.5f) * GridSpacing - m_Extent;
+        object.position[1] = (static_cast<float>((i / side) % side) + 0.5f) * GridSpacing - m_Extent;
+        object.position[2] = (static_cast<float>(i / (side * side)) + 0.5f) * GridSpacing - m_Extent;
+        object.axis[0] = unit(rng);
+        object.axis[1] = unit(rng) + 2.0f;  // Never degenerate
+        object.axis[2] = unit(rng);
+        object.phase = 180.0f * unit(rng);
+        object.speed = 60.0f * unit(rng);
+        object.variant = static_cast<unsigned int>(i % MeshVariants);
+    }
+
+    SHADOW_LOG_INFO(Scene, "Benchmark scene: {} objects in a {}^3 grid", m_ObjectCount, side);
+}
+
+void BenchmarkScene::FixedUpdate(float fixedDeltaTime) {
+    m_PreviousTime = m_Time;
+    m_Time += fixedDeltaTime;
+}
+
+void BenchmarkScene::Update(float /*deltaTime*/) {
+    if (!m_Shader) {
+        return;
+    }
+
+    // Motion is a pure function of time, so blending the simulated clock is
+    // equivalent to blending every object's transform
+    const double renderTime = m_PreviousTime + (m_Time - m_PreviousTime) * GetInterpolationAlpha();
+
+    // Orbit inside the grid, looking at its centre
+    const float orbit = std::max(5.0f, 0.5f * m_Extent);
+    const float angle = static_cast<float>(renderTime) * 0.2f;
+    m_RenderSystem.SetViewMatrix(Math::CreateLookAt(orbit * std::cos(angle), 0.3f * orbit, orbit * std::sin(angle),
+                                                    0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f));
+
+    // Every object gets a new model matrix every frame, as animated objects would
+    const float time = static_cast<float>(renderTime);
+    for (const Object& object : m_Objects) {
+        Math::Matrix4 model = Math::CreateRotation(object.phase + object.speed * time,
+                                                   object.axis[0], object.axis[1], object.axis[2]);
+        model.data[12] = object.position[0];
+        model.data[13] = object.position[1];
+        model.data[14] = object.position[2];
+        m_RenderSystem.Submit(m_Meshes[object.variant], m_Shader, model);
+    }
+}
+
+} // namespace ShadowEngine
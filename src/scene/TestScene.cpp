@@ -1,6 +1,7 @@
 #include "scene/Scene.hpp"
 #include "scene/Camera.hpp"
 #include "rendering/RenderSystem.hpp"
+#include "rendering/Material.hpp"
 #include "rendering/Mesh.hpp"
 #include "rendering/Shader.hpp"
 #include "input/InputManager.hpp"
@@ -13,104 +14,63 @@ TestScene::TestScene(Rendering::RenderSystem& renderSystem, Input::InputManager&
     , m_Camera(std::make_unique<SceneSystem::Camera>()) {}
 
 void TestScene::OnAttach() {
+    // The cube and its material load in the background; Update draws the cube
+    // once both are ready
+    Rendering::AssetManager& assets = m_RenderSystem.GetAssetManager();
+    if (!m_MeshAsset.IsValid()) {
+        m_MeshAsset = assets.LoadMesh("assets/meshes/cube.obj", Rendering::AssetPriority::High);
+        m_MaterialAsset = assets.LoadMaterial("assets/materials/cube.shmat", Rendering::AssetPriority::High);
+    }
+
     if (m_IsInitialized) {
         return;
     }
 
-    // Simple cube geometry (position + color) and indices set up inside the render system.
-    // The RenderSystem will own the created mesh and shader and render them every frame.
-
-    // Cube vertices (position + color)
-    std::vector<float> cubeVertices = {
-        // Front face (red)
-        -0.5f, -0.5f,  0.5f,  1.0f, 0.0f, 0.0f,
-         0.5f, -0.5f,  0.5f,  1.0f, 0.0f, 0.0f,
-         0.5f,  0.5f,  0.5f,  1.0f, 0.0f, 0.0f,
-        -0.5f,  0.5f,  0.5f,  1.0f, 0.0f, 0.0f,
-
-        // Back face (green)
-        -0.5f, -0.5f, -0.5f,  0.0f, 1.0f, 0.0f,
-         0.5f, -0.5f, -0.5f,  0.0f, 1.0f, 0.0f,
-         0.5f,  0.5f, -0.5f,  0.0f, 1.0f, 0.0f,
-        -0.5f,  0.5f, -0.5f,  0.0f, 1.0f, 0.0f,
-
-        // Left face (blue)
-        -0.5f, -0.5f, -0.5f,  0.0f, 0.0f, 1.0f,
-        -0.5f, -0.5f,  0.5f,  0.0f, 0.0f, 1.0f,
-        -0.5f,  0.5f,  0.5f,  0.0f, 0.0f, 1.0f,
-        -0.5f,  0.5f, -0.5f,  0.0f, 0.0f, 1.0f,
-
-        // Right face (yellow)
-         0.5f, -0.5f, -0.5f,  1.0f, 1.0f, 0.0f,
-         0.5f, -0.5f,  0.5f,  1.0f, 1.0f, 0.0f,
-         0.5f,  0.5f,  0.5f,  1.0f, 1.0f, 0.0f,
-         0.5f,  0.5f, -0.5f,  1.0f, 1.0f, 0.0f,
-
-        // Top face (magenta)
-        -0.5f,  0.5f, -0.5f,  1.0f, 0.0f, 1.0f,
-         0.5f,  0.5f, -0.5f,  1.0f, 0.0f, 1.0f,
-         0.5f,  0.5f,  0.5f,  1.0f, 0.0f, 1.0f,
-        -0.5f,  0.5f,  0.5f,  1.0f, 0.0f, 1.0f,
-
-        // Bottom face (cyan)
-        -0.5f, -0.5f, -0.5f,  0.0f, 1.0f, 1.0f,
-         0.5f, -0.5f, -0.5f,  0.0f, 1.0f, 1.0f,
-         0.5f, -0.5f,  0.5f,  0.0f, 1.0f, 1.0f,
-        -0.5f, -0.5f,  0.5f,  0.0f, 1.0f, 1.0f
-    };
-
-    // Cube indices
-    std::vector<unsigned int> cubeIndices = {
-        // Front face
-        0, 1, 2,  2, 3, 0,
-        // Back face
-        4, 7, 6,  6, 5, 4,
-        // Left face
-        8, 11, 10,  10, 9, 8,
-        // Right face
-        12, 13, 14,  14, 15, 12,
-        // Top face
-        16, 19, 18,  18, 17, 16,
-        // Bottom face
-        20, 21, 22,  22, 23, 20
-    };
-
-    auto mesh = m_RenderSystem.CreateMesh(cubeVertices, cubeIndices);
-    auto shader = m_RenderSystem.CreateShader("shaders/basic.vert", "shaders/basic.frag");
-
-    if (mesh && shader) {
-        // Set up input mappings for movement (reusing mappings from input_demo)
-        using namespace ShadowEngine::Input;
-
-        InputMapping moveForward;
-        moveForward.actionName = "MoveForward";
-        moveForward.keys = {KeyCode::W, KeyCode::Up};
-        m_InputManager.AddInputMapping(moveForward);
-
-        InputMapping moveBackward;
-        moveBackward.actionName = "MoveBackward";
-        moveBackward.keys = {KeyCode::S, KeyCode::Down};
-        m_InputManager.AddInputMapping(moveBackward);
-
-        InputMapping moveLeft;
-        moveLeft.actionName = "MoveLeft";
-        moveLeft.keys = {KeyCode::A, KeyCode::Left};
-        m_InputManager.AddInputMapping(moveLeft);
-
-        InputMapping moveRight;
-        moveRight.actionName = "MoveRight";
-        moveRight.keys = {KeyCode::D, KeyCode::Right};
-        m_InputManager.AddInputMapping(moveRight);
-
-        // Optionally capture the cursor for FPS-style camera
-        // m_InputManager.SetCursorMode(GLFW_CURSOR_DISABLED);
-
-        m_IsInitialized = true;
-    }
+    // Set up input mappings for movement (reusing mappings from input_demo)
+    using namespace ShadowEngine::Input;
+
+    InputMapping moveForward;
+    moveForward.actionName = "MoveForward";
+    moveForward.keys = {KeyCode::W, KeyCode::Up};
+    m_InputManager.AddInputMapping(moveForward);
+
+    InputMapping moveBackward;
+    moveBackward.actionName = "MoveBackward";
+    moveBackward.keys = {KeyCode::S, KeyCode::Down};
+    m_InputManager.AddInputMapping(moveBackward);
+
+    InputMapping moveLeft;
+    moveLeft.actionName = "MoveLeft";
+    moveLeft.keys = {KeyCode::A, KeyCode::Left};
+    m_InputManager.AddInputMapping(moveLeft);
+
+    InputMapping moveRight;
+    moveRight.actionName = "MoveRight";
+    moveRight.keys = {KeyCode::D, KeyCode::Right};
+    m_InputManager.AddInputMapping(moveRight);
+
+    // Optionally capture the cursor for FPS-style camera
+    // m_InputManager.SetCursorMode(GLFW_CURSOR_DISABLED);
+
+    m_IsInitialized = true;
 }
 
 void TestScene::OnDetach() {
-    // For now, rely on RenderSystem and Mesh/Shader destructors to clean up.
+    // The mesh, shader and texture live on while anything else uses them
+    Rendering::AssetManager& assets = m_RenderSystem.GetAssetManager();
+    assets.Release(m_MeshAsset);
+    assets.Release(m_MaterialAsset);
+    m_MeshAsset = Rendering::AssetHandle();
+    m_MaterialAsset = Rendering::AssetHandle();
+    m_Mesh.reset();
+    m_Material.reset();
+}
+
+void TestScene::FixedUpdate(float fixedDeltaTime) {
+    // Spin the cube about Y at 50 degrees per second
+    m_Time += fixedDeltaTime;
+    m_PreviousModel = m_Model;
+    m_Model = Math::CreateRotation(static_cast<float>(m_Time) * 50.0f, 0.0f, 1.0f, 0.0f);
 }
 
 void TestScene::Update(float deltaTime) {
@@ -155,6 +115,17 @@ void TestScene::Update(float deltaTime) {
     // Update view matrix in the render system
     auto view = m_Camera->GetViewMatrix();
     m_RenderSystem.SetViewMatrix(view);
+
+    // Draw the cube between its last two simulated poses, once it has loaded
+    if (!m_Mesh || !m_Material) {
+        Rendering::AssetManager& assets = m_RenderSystem.GetAssetManager();
+        m_Mesh = assets.GetMesh(m_MeshAsset);
+        m_Material = assets.GetMaterial(m_MaterialAsset);
+    }
+    if (m_Mesh && m_Material) {
+        m_RenderSystem.Submit(m_Mesh, m_Material,
+                              Math::InterpolateTransforms(m_PreviousModel, m_Model, GetInterpolationAlpha()));
+    }
 }
 
 } // namespace ShadowEngine
@@ -0,0 +1,150 @@
+// Asset packer: bundles files into a .shpk pack for the engine's virtual
+// filesystem.
+//
+//   PackTool <output.shpk> <file or directory>... [--store]
+//   PackTool --list <pack.shpk>
+//
+// Directories are added recursively. Entries are named by the path given on
+// the command line, with forward slashes, which is how the engine asks for
+// them: run from the directory the engine runs in, e.g.
+//
+//   PackTool data.shpk shaders assets
+//
+// Entries are LZ4 compressed where that pays off; --store keeps every entry
+// uncompressed so all reads are zero-copy.
+
+#include "core/PackFile.hpp"
+#include "core/VirtualFileSystem.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ShadowEngine;
+
+namespace {
+
+void PrintUsage() {
+    std::cerr << "Usage: PackTool <output.shpk> <file or directory>... [--store]\n"
+              << "       PackTool --list <pack.shpk>" << std::endl;
+}
+
+bool ReadWholeFile(const std::string& path, std::vector<uint8_t>& out) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open: " << path << std::endl;
+        return false;
+    }
+    out.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(out.size()));
+    if (!file.good() && !out.empty()) {
+        std::cerr << "Failed to read: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool AddPath(const std::string& path, std::vector<PackFile::Source>& files) {
+    namespace fs = std::filesystem;
+    std::error_code error;
+    if (fs::is_regular_file(path, error)) {
+        PackFile::Source source;
+        source.path = VirtualFileSystem::NormalizePath(path);
+        if (!ReadWholeFile(path, source.data)) {
+            return false;
+        }
+        files.push_back(std::move(source));
+        return true;
+    }
+    if (!fs::is_directory(path, error)) {
+        std::cerr << "No such file or directory: " << path << std::endl;
+        return false;
+    }
+
+    // Sorted so the same tree always produces the same pack
+    std::vector<std::string> children;
+    for (const fs::directory_entry& entry : fs::recursive_directory_iterator(path, error)) {
+        if (entry.is_regular_file()) {
+            children.push_back(entry.path().generic_string());
+        }
+    }
+    if (error) {
+        std::cerr << "Failed to list " << path << ": " << error.message() << std::endl;
+        return false;
+    }
+    std::sort(children.begin(), children.end());
+    for (const std::string& child : children) {
+        if (!AddPath(child, files)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int List(const std::string& path) {
+    PackFile pack;
+    if (!pack.Open(path)) {
+        return 1;
+    }
+    size_t stored = 0;
+    size_t size = 0;
+    for (size_t i = 0; i < pack.GetEntryCount(); ++i) {
+        const PackFile::Entry entry = pack.GetEntry(i);
+        std::cout << (entry.compressed ? "lz4   " : "store ") << entry.size << " -> " << entry.storedSize
+                  << "  " << entry.path << "\n";
+        stored += entry.storedSize;
+        size += entry.size;
+    }
+    std::cout << pack.GetEntryCount() << " entries, " << size / 1024 << " KB stored in " << stored / 1024
+              << " KB" << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc == 3 && std::strcmp(argv[1], "--list") == 0) {
+        return List(argv[2]);
+    }
+    if (argc < 3) {
+        PrintUsage();
+        return 1;
+    }
+
+    const std::string outputPath = argv[1];
+    bool compress = true;
+    std::vector<PackFile::Source> files;
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--store") == 0) {
+            compress = false;
+        } else if (!AddPath(argv[i], files)) {
+            return 1;
+        }
+    }
+
+    if (!PackFile::Write(outputPath, files, compress)) {
+        return 1;
+    }
+
+    // Report what the pack ended up holding
+    PackFile pack;
+    if (!pack.Open(outputPath)) {
+        return 1;
+    }
+    size_t size = 0;
+    size_t stored = 0;
+    size_t compressedEntries = 0;
+    for (size_t i = 0; i < pack.GetEntryCount(); ++i) {
+        const PackFile::Entry entry = pack.GetEntry(i);
+        size += entry.size;
+        stored += entry.storedSize;
+        compressedEntries += entry.compressed ? 1 : 0;
+    }
+    std::cout << "Packed " << pack.GetEntryCount() << " files (" << compressedEntries << " compressed): "
+              << size / 1024 << " KB -> " << stored / 1024 << " KB in " << outputPath << std::endl;
+    return 0;
+}
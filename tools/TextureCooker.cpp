@@ -0,0 +1,266 @@
+// Offline texture cooker: converts images to block-compressed .shtx containers
+// with a precomputed mip chain.
+//
+//   TextureCooker <input> <output.shtx> [--format bc1|bc3|bc4|bc5|bc7] [--srgb]
+//                 [--filter box|kaiser|lanczos] [--alpha-cutoff A] [--compare]
+//   TextureCooker --atlas <output> <input>... [--page-size N] [--mip-levels N]
+//                 [--format ...] [--srgb] [--filter ...] [--alpha-cutoff A]
+//
+// Mips are built with a Kaiser filter by default, in linear light when --srgb
+// is given. --alpha-cutoff keeps the alpha-tested coverage of every level equal
+// to the full-size image's.
+//
+// --compare times the runtime PNG path (decode + mip build) against mapping the
+// cooked container, and reports the VRAM each path would need.
+//
+// --atlas packs the inputs into pages with TextureAtlasBuilder and cooks each
+// page to <output>_<page>.shtx, its mip chain cut at the bleed-free levels. The
+// remap table goes to <output>.atlas, one line per input:
+//   <input> <page> <x> <y> <width> <height> <u offset> <v offset> <u scale> <v scale>
+
+#include "core/BlockCompression.hpp"
+#include "core/CompressedTextureFile.hpp"
+#include "core/ImageLoader.hpp"
+#include "core/JobSystem.hpp"
+#include "core/MipGenerator.hpp"
+#include "rendering/TextureAtlas.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ShadowEngine;
+
+namespace {
+
+bool ParseFormat(const std::string& name, BlockCompression::Format& format) {
+    if (name == "bc1") { format = BlockCompression::Format::BC1; return true; }
+    if (name == "bc3") { format = BlockCompression::Format::BC3; return true; }
+    if (name == "bc4") { format = BlockCompression::Format::BC4; return true; }
+    if (name == "bc5") { format = BlockCompression::Format::BC5; return true; }
+    if (name == "bc7") { format = BlockCompression::Format::BC7; return true; }
+    return false;
+}
+
+bool ParseFilter(const std::string& name, MipGenerator::Filter& filter) {
+    if (name == "box") { filter = MipGenerator::Filter::Box; return true; }
+    if (name == "kaiser") { filter = MipGenerator::Filter::Kaiser; return true; }
+    if (name == "lanczos") { filter = MipGenerator::Filter::Lanczos; return true; }
+    return false;
+}
+
+void PrintUsage() {
+    std::cerr << "Usage: TextureCooker <input> <output.shtx> [--format bc1|bc3|bc4|bc5|bc7] [--srgb]" << std::endl
+              << "                     [--filter box|kaiser|lanczos] [--alpha-cutoff A] [--compare]" << std::endl
+              << "       TextureCooker --atlas <output> <input>... [--page-size N] [--mip-levels N]" << std::endl
+              << "                     [--format ...] [--srgb] [--filter ...] [--alpha-cutoff A]" << std::endl;
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Build the mip chain, compress every level and write the container
+bool Cook(ImageLoader::ImageData image, const MipGenerator::Settings& mipSettings, BlockCompression::Format format,
+          uint32_t flags, JobSystem& jobs, const std::string& outputPath, size_t& outMipCount) {
+    const int width = image.width;
+    const int height = image.height;
+    std::vector<ImageLoader::ImageData> levels = MipGenerator::Build(std::move(image), mipSettings, &jobs);
+
+    std::vector<std::vector<uint8_t>> mips(levels.size());
+    for (size_t level = 0; level < levels.size(); ++level) {
+        BlockCompression::CompressImage(format, levels[level].data.data(),
+                                        levels[level].width, levels[level].height, mips[level]);
+    }
+    outMipCount = mips.size();
+    return CompressedTextureFile::Write(outputPath, format, width, height, flags, mips);
+}
+
+bool CookAtlas(const std::vector<std::string>& inputs, const std::string& outputPath,
+               const Rendering::TextureAtlasBuilder::Options& options, MipGenerator::Settings mipSettings,
+               BlockCompression::Format format, uint32_t flags, JobSystem& jobs) {
+    Rendering::TextureAtlasBuilder builder;
+    for (const std::string& input : inputs) {
+        if (!builder.AddFromFile(input)) {
+            return false;
+        }
+    }
+    Rendering::TextureAtlas atlas;
+    if (!builder.Build(options, atlas)) {
+        return false;
+    }
+
+    mipSettings.maxLevels = atlas.GetMipLevels();
+    const std::vector<ImageLoader::ImageData>& pages = atlas.GetPages();
+    for (size_t page = 0; page < pages.size(); ++page) {
+        const std::string pagePath = outputPath + "_" + std::to_string(page) + ".shtx";
+        size_t mipCount = 0;
+        if (!Cook(pages[page], mipSettings, format, flags, jobs, pagePath, mipCount)) {
+            return false;
+        }
+        std::cout << "Cooked atlas page " << pagePath << " (" << atlas.GetPageSize() << "x" << atlas.GetPageSize()
+                  << ", " << mipCount << " mips)" << std::endl;
+    }
+
+    const std::string tablePath = outputPath + ".atlas";
+    std::ofstream table(tablePath);
+    if (!table) {
+        std::cerr << "Failed to write " << tablePath << std::endl;
+        return false;
+    }
+    table << std::setprecision(9) << "# " << pages.size() << " pages of " << atlas.GetPageSize() << "x" << atlas.GetPageSize() << ", "
+          << atlas.GetMipLevels() << " mips" << std::endl;
+    for (const std::string& input : inputs) {
+        const Rendering::AtlasRegion* region = atlas.FindRegion(input);
+        table << input << " " << region->page << " " << region->x << " " << region->y << " "
+              << region->width << " " << region->height << " " << region->uvOffset[0] << " "
+              << region->uvOffset[1] << " " << region->uvScale[0] << " " << region->uvScale[1] << std::endl;
+    }
+    std::cout << "Packed " << inputs.size() << " images into " << pages.size() << " pages; remap table "
+              << tablePath << std::endl;
+    return true;
+}
+
+void Compare(const std::string& inputPath, const std::string& outputPath) {
+    const int iterations = 5;
+
+    // Runtime PNG path: decode, build the RGBA8 mip chain
+    double pngMs = 0.0;
+    size_t pngBytes = 0;
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        ImageLoader::ImageData image;
+        if (!ImageLoader::LoadImage(inputPath, image)) {
+            return;
+        }
+        std::vector<ImageLoader::ImageData> levels = MipGenerator::Build(std::move(image));
+        pngMs += MillisecondsSince(start);
+
+        pngBytes = 0;
+        for (const auto& level : levels) {
+            pngBytes += level.data.size();
+        }
+    }
+
+    // Cooked path: map and validate, then touch every payload byte the way the
+    // driver copy would
+    double cookedMs = 0.0;
+    size_t cookedBytes = 0;
+    unsigned checksum = 0;
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        CompressedTextureFile file;
+        if (!file.Open(outputPath)) {
+            return;
+        }
+        for (int level = 0; level < file.GetMipCount(); ++level) {
+            const CompressedTextureFile::Mip& mip = file.GetMip(level);
+            for (size_t b = 0; b < mip.size; b += 64) {
+                checksum += mip.data[b];
+            }
+        }
+        cookedMs += MillisecondsSince(start);
+        cookedBytes = file.GetTotalPayloadSize();
+    }
+
+    std::cout << "Load time:  PNG " << pngMs / iterations << " ms, cooked "
+              << cookedMs / iterations << " ms (checksum " << checksum << ")" << std::endl;
+    std::cout << "VRAM:       RGBA8 " << pngBytes / 1024 << " KB, cooked "
+              << cookedBytes / 1024 << " KB (" << static_cast<double>(pngBytes) / cookedBytes
+              << "x smaller)" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        PrintUsage();
+        return 1;
+    }
+
+    // --atlas <output> <input>...; otherwise <input> <output>
+    const bool atlas = std::strcmp(argv[1], "--atlas") == 0;
+    std::vector<std::string> inputPaths;
+    std::string outputPath = argv[2];
+    if (!atlas) {
+        inputPaths.push_back(argv[1]);
+    }
+    BlockCompression::Format format = BlockCompression::Format::BC7;
+    uint32_t flags = 0;
+    MipGenerator::Settings mipSettings;
+    mipSettings.filter = MipGenerator::Filter::Kaiser;
+    Rendering::TextureAtlasBuilder::Options atlasOptions;
+    bool compare = false;
+
+    for (int i = 3; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            if (!ParseFormat(argv[++i], format)) {
+                std::cerr << "Unknown format: " << argv[i] << std::endl;
+                PrintUsage();
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--srgb") == 0) {
+            flags |= CompressedTextureFile::FlagSRGB;
+        } else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            if (!ParseFilter(argv[++i], mipSettings.filter)) {
+                std::cerr << "Unknown filter: " << argv[i] << std::endl;
+                PrintUsage();
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--alpha-cutoff") == 0 && i + 1 < argc) {
+            mipSettings.alphaCutoff = static_cast<float>(std::atof(argv[++i]));
+        } else if (std::strcmp(argv[i], "--compare") == 0 && !atlas) {
+            compare = true;
+        } else if (std::strcmp(argv[i], "--page-size") == 0 && atlas && i + 1 < argc) {
+            atlasOptions.pageSize = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--mip-levels") == 0 && atlas && i + 1 < argc) {
+            atlasOptions.mipLevels = std::atoi(argv[++i]);
+        } else if (atlas && argv[i][0] != '-') {
+            inputPaths.push_back(argv[i]);
+        } else {
+            std::cerr << "Unknown option: " << argv[i] << std::endl;
+            PrintUsage();
+            return 1;
+        }
+    }
+    if (inputPaths.empty()) {
+        PrintUsage();
+        return 1;
+    }
+
+    // Data not flagged sRGB (normal maps, masks) is filtered as stored
+    mipSettings.srgb = (flags & CompressedTextureFile::FlagSRGB) != 0;
+    JobSystem jobs;
+
+    if (atlas) {
+        return CookAtlas(inputPaths, outputPath, atlasOptions, mipSettings, format, flags, jobs) ? 0 : 1;
+    }
+
+    const std::string& inputPath = inputPaths[0];
+    ImageLoader::ImageData image;
+    if (!ImageLoader::LoadImage(inputPath, image)) {
+        return 1;
+    }
+    const int width = image.width;
+    const int height = image.height;
+
+    auto start = std::chrono::steady_clock::now();
+    size_t mipCount = 0;
+    if (!Cook(std::move(image), mipSettings, format, flags, jobs, outputPath, mipCount)) {
+        return 1;
+    }
+
+    std::cout << "Cooked " << inputPath << " (" << width << "x" << height << ", "
+              << mipCount << " mips, " << MipGenerator::GetFilterName(mipSettings.filter)
+              << " filter) to " << BlockCompression::GetFormatName(format)
+              << " in " << MillisecondsSince(start) << " ms" << std::endl;
+
+    if (compare) {
+        Compare(inputPath, outputPath);
+    }
+    return 0;
+}